@@ -9,7 +9,6 @@ use bitcoin::Transaction;
 use bitcoin::{PrivateKey, XOnlyPublicKey};
 use bitcoinkernel::Block;
 use bitcoinkernel::BlockSpentOutputs;
-use bitcoinkernel::BlockTreeEntry;
 use bitcoinkernel::TransactionSpentOutputsRef;
 use bitcoinkernel::{
     prelude::*, ChainType, ChainstateManager, ChainstateManagerOptions, Context, ContextBuilder,
@@ -92,11 +91,16 @@ impl SilentPaymentScanner {
 
         log::info!("Starting scan from genesis to tip {}", tip_height);
 
-        for block_index in chain.iter() {
-            if block_index.height() % 10 == 0 {
-                log::info!("Scanning block {} / {}", block_index.height(), tip_height);
+        for read_block in chainman.block_reader(0..=tip_height).build()? {
+            let read_block = read_block?;
+            let height = read_block.entry.height();
+            if height % 10 == 0 {
+                log::info!("Scanning block {} / {}", height, tip_height);
             }
-            self.scan_block(chainman, &block_index)?;
+            let spent_outputs = read_block
+                .spent_outputs
+                .ok_or_else(|| ScanError::InvalidInput("Missing spent outputs".to_string()))?;
+            self.scan_block(&read_block.block, &spent_outputs)?;
         }
 
         Ok(())
@@ -104,12 +108,9 @@ impl SilentPaymentScanner {
 
     fn scan_block(
         &mut self,
-        chainman: &ChainstateManager,
-        block_index: &BlockTreeEntry,
+        block: &Block,
+        spent_outputs: &BlockSpentOutputs,
     ) -> Result<(), ScanError> {
-        let spent_outputs: BlockSpentOutputs = chainman.read_spent_outputs(block_index)?;
-        let block: Block = chainman.read_block_data(block_index)?;
-
         for (index, tx_spent_output) in spent_outputs.iter().enumerate() {
             let tx_index = index + 1;
             let tx_bytes = block.transaction(tx_index).unwrap().consensus_encode()?;
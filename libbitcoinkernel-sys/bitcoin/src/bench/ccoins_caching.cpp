@@ -8,6 +8,7 @@
 #include <key.h>
 #include <policy/policy.h>
 #include <primitives/transaction.h>
+#include <random.h>
 #include <script/script.h>
 #include <script/signingprovider.h>
 #include <test/util/transaction_utils.h>
@@ -54,4 +55,71 @@ static void CCoinsCaching(benchmark::Bench& bench)
     });
 }
 
+//! Create coins with P2WPKH outputs, the most common output type in the UTXO
+//! set, which script compression does not shrink.
+static std::vector<std::pair<COutPoint, Coin>> CreateCoins(size_t count)
+{
+    FastRandomContext rng{/*fDeterministic=*/true};
+    std::vector<std::pair<COutPoint, Coin>> coins;
+    coins.reserve(count);
+    for (size_t i{0}; i < count; ++i) {
+        CScript script{CScript() << OP_0 << rng.randbytes(20)};
+        coins.emplace_back(COutPoint{Txid::FromUint256(rng.rand256()), static_cast<uint32_t>(rng.randrange(4))},
+                           Coin{CTxOut{static_cast<CAmount>(rng.randrange(COIN)), std::move(script)}, static_cast<int>(rng.randrange(900'000)), false});
+    }
+    return coins;
+}
+
+static constexpr size_t NUM_CACHED_COINS{100'000};
+
+// Reading coins from a CCoinsMap, as the coins cache holds them, and from a
+// CompactCoinsMap of the same coins, which stores them in their compressed serialization.
+static void CCoinsMapLookup(benchmark::Bench& bench)
+{
+    const auto coins{CreateCoins(NUM_CACHED_COINS)};
+    CCoinsMapMemoryResource resource;
+    CCoinsMap map{0, SaltedOutpointHasher{/*deterministic=*/true}, CCoinsMap::key_equal{}, &resource};
+    for (const auto& [outpoint, coin] : coins) map.try_emplace(outpoint, Coin{coin});
+
+    size_t i{0};
+    bench.run([&] {
+        const auto it{map.find(coins[i++ % coins.size()].first)};
+        assert(it != map.end());
+        ankerl::nanobench::doNotOptimizeAway(it->second.coin.out.nValue);
+    });
+}
+
+static void CompactCoinsMapLookup(benchmark::Bench& bench)
+{
+    const auto coins{CreateCoins(NUM_CACHED_COINS)};
+    CompactCoinsMap map{NUM_CACHED_COINS * 100, /*deterministic=*/true};
+    for (const auto& [outpoint, coin] : coins) assert(map.Insert(outpoint, coin));
+
+    size_t i{0};
+    bench.run([&] {
+        const auto coin{map.Get(coins[i++ % coins.size()].first)};
+        assert(coin);
+        ankerl::nanobench::doNotOptimizeAway(coin->out.nValue);
+    });
+}
+
+static void CompactCoinsMapInsert(benchmark::Bench& bench)
+{
+    const auto coins{CreateCoins(NUM_CACHED_COINS)};
+    CompactCoinsMap map{NUM_CACHED_COINS * 100, /*deterministic=*/true};
+
+    size_t i{0};
+    bench.run([&] {
+        if (i == coins.size()) {
+            map.Clear();
+            i = 0;
+        }
+        const auto& [outpoint, coin]{coins[i++]};
+        assert(map.Insert(outpoint, coin));
+    });
+}
+
 BENCHMARK(CCoinsCaching, benchmark::PriorityLevel::HIGH);
+BENCHMARK(CCoinsMapLookup, benchmark::PriorityLevel::HIGH);
+BENCHMARK(CompactCoinsMapLookup, benchmark::PriorityLevel::HIGH);
+BENCHMARK(CompactCoinsMapInsert, benchmark::PriorityLevel::HIGH);
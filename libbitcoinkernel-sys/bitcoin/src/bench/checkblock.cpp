@@ -19,6 +19,7 @@
 #include <cstddef>
 #include <memory>
 #include <optional>
+#include <span>
 #include <vector>
 
 // These are the two major time-sinks which happen after we have fully received
@@ -39,6 +40,44 @@ static void DeserializeBlockTest(benchmark::Bench& bench)
     });
 }
 
+static void DeserializeBlockSpanReaderTest(benchmark::Bench& bench)
+{
+    bench.unit("block").run([&] {
+        CBlock block;
+        SpanReader{benchmark::data::block413567} >> TX_WITH_WITNESS(block);
+        assert(block.vtx.size() > 1);
+    });
+}
+
+/** Reads from a SpanReader without exposing its memory, so that transactions are
+ *  serialized again to compute their txid and wtxid. */
+class OpaqueSpanReader
+{
+    SpanReader m_reader;
+
+public:
+    explicit OpaqueSpanReader(std::span<const std::byte> data) : m_reader{data} {}
+
+    template <typename T>
+    OpaqueSpanReader& operator>>(T&& obj)
+    {
+        ::Unserialize(*this, obj);
+        return *this;
+    }
+
+    void read(std::span<std::byte> dst) { m_reader.read(dst); }
+    void ignore(size_t n) { m_reader.ignore(n); }
+};
+
+static void DeserializeBlockReserializeTest(benchmark::Bench& bench)
+{
+    bench.unit("block").run([&] {
+        CBlock block;
+        OpaqueSpanReader{benchmark::data::block413567} >> TX_WITH_WITNESS(block);
+        assert(block.vtx.size() > 1);
+    });
+}
+
 static void DeserializeAndCheckBlockTest(benchmark::Bench& bench)
 {
     DataStream stream(benchmark::data::block413567);
@@ -61,4 +100,6 @@ static void DeserializeAndCheckBlockTest(benchmark::Bench& bench)
 }
 
 BENCHMARK(DeserializeBlockTest, benchmark::PriorityLevel::HIGH);
+BENCHMARK(DeserializeBlockSpanReaderTest, benchmark::PriorityLevel::HIGH);
+BENCHMARK(DeserializeBlockReserializeTest, benchmark::PriorityLevel::HIGH);
 BENCHMARK(DeserializeAndCheckBlockTest, benchmark::PriorityLevel::HIGH);
@@ -62,6 +62,65 @@ CBlock CreateTestBlock(
     return test_setup.CreateBlock(txs, coinbase_spk, chainstate);
 }
 
+/*
+ * Creates a test block whose transactions only spend outputs confirmed in an
+ * earlier block, so that all of its inputs have to be read from the coins
+ * database when the coins cache is cold:
+ * - A fan-out transaction creating num_txs copies of the given outputs is
+ *   confirmed first
+ * - Each transaction of the test block spends one copy of the outputs
+ */
+CBlock CreateColdInputsTestBlock(
+    TestChain100Setup& test_setup,
+    const std::vector<CKey>& keys,
+    const std::vector<CTxOut>& outputs,
+    int num_txs = 200)
+{
+    Chainstate& chainstate{test_setup.m_node.chainman->ActiveChainstate()};
+
+    const WitnessV1Taproot coinbase_taproot{XOnlyPubKey(test_setup.coinbaseKey.GetPubKey())};
+    const CScript coinbase_spk{GetScriptForDestination(coinbase_taproot)};
+
+    std::vector<CTxOut> fan_out_outputs;
+    fan_out_outputs.reserve(num_txs * outputs.size());
+    for (int i{0}; i < num_txs; i++) {
+        for (const auto& output : outputs) {
+            fan_out_outputs.emplace_back(COIN / 100, output.scriptPubKey);
+        }
+    }
+    auto& coinbase_to_spend{test_setup.m_coinbase_txns[0]};
+    const auto [fan_out_tx, _]{test_setup.CreateValidTransaction(
+        {coinbase_to_spend},
+        {COutPoint(coinbase_to_spend->GetHash(), 0)},
+        chainstate.m_chain.Height() + 1, keys, fan_out_outputs, {}, {})};
+    test_setup.CreateAndProcessBlock({fan_out_tx}, coinbase_spk, &chainstate);
+    const CTransactionRef fan_out{MakeTransactionRef(fan_out_tx)};
+
+    std::vector<CTxOut> spend_outputs;
+    spend_outputs.reserve(outputs.size());
+    for (const auto& output : outputs) {
+        spend_outputs.emplace_back(COIN / 200, output.scriptPubKey);
+    }
+
+    std::vector<CMutableTransaction> txs;
+    txs.reserve(num_txs);
+    for (int i{0}; i < num_txs; i++) {
+        std::vector<COutPoint> inputs;
+        inputs.reserve(outputs.size());
+        for (size_t j{0}; j < outputs.size(); j++) {
+            inputs.emplace_back(fan_out->GetHash(), i * outputs.size() + j);
+        }
+        const auto [tx, _]{test_setup.CreateValidTransaction(
+            {fan_out}, inputs, chainstate.m_chain.Height(), keys, spend_outputs, {}, {})};
+        txs.emplace_back(tx);
+    }
+
+    // Write the fan-out outputs to the coins database
+    chainstate.ForceFlushStateToDisk();
+
+    return test_setup.CreateBlock(txs, coinbase_spk, chainstate);
+}
+
 /*
  * Creates key pairs and corresponding outputs for the benchmark transactions.
  * - For Schnorr signatures: Creates simple key path spendable outputs
@@ -104,6 +163,23 @@ void BenchmarkConnectBlock(benchmark::Bench& bench, std::vector<CKey>& keys, std
     });
 }
 
+void BenchmarkConnectBlockColdCache(benchmark::Bench& bench, std::vector<CKey>& keys, std::vector<CTxOut>& outputs, TestChain100Setup& test_setup)
+{
+    const auto& test_block{CreateColdInputsTestBlock(test_setup, keys, outputs)};
+    bench.unit("block").run([&] {
+        LOCK(cs_main);
+        auto& chainman{test_setup.m_node.chainman};
+        auto& chainstate{chainman->ActiveChainstate()};
+        // Nothing is dirty, so this only empties the coins cache
+        assert(chainstate.CoinsTip().Flush());
+        BlockValidationState test_block_state;
+        auto* pindex{chainman->m_blockman.AddToBlockIndex(test_block, chainman->m_best_header)}; // Doing this here doesn't impact the benchmark
+        CCoinsViewCache viewNew{&chainstate.CoinsTip()};
+
+        assert(chainstate.ConnectBlock(test_block, test_block_state, pindex, viewNew));
+    });
+}
+
 static void ConnectBlockAllSchnorr(benchmark::Bench& bench)
 {
     const auto test_setup{MakeNoLogFileContext<TestChain100Setup>()};
@@ -126,6 +202,22 @@ static void ConnectBlockAllEcdsa(benchmark::Bench& bench)
     BenchmarkConnectBlock(bench, keys, outputs, *test_setup);
 }
 
+static void ConnectBlockColdCache(benchmark::Bench& bench)
+{
+    const auto test_setup{MakeNoLogFileContext<TestChain100Setup>(ChainType::REGTEST, {.coins_db_in_memory = false})};
+    auto [keys, outputs]{CreateKeysAndOutputs(test_setup->coinbaseKey, /*num_schnorr=*/1, /*num_ecdsa=*/4)};
+    BenchmarkConnectBlockColdCache(bench, keys, outputs, *test_setup);
+}
+
+static void ConnectBlockColdCacheNoInputFetch(benchmark::Bench& bench)
+{
+    const auto test_setup{MakeNoLogFileContext<TestChain100Setup>(ChainType::REGTEST, {.coins_db_in_memory = false, .input_fetch = false})};
+    auto [keys, outputs]{CreateKeysAndOutputs(test_setup->coinbaseKey, /*num_schnorr=*/1, /*num_ecdsa=*/4)};
+    BenchmarkConnectBlockColdCache(bench, keys, outputs, *test_setup);
+}
+
 BENCHMARK(ConnectBlockAllSchnorr, benchmark::PriorityLevel::HIGH);
 BENCHMARK(ConnectBlockMixedEcdsaSchnorr, benchmark::PriorityLevel::HIGH);
 BENCHMARK(ConnectBlockAllEcdsa, benchmark::PriorityLevel::HIGH);
+BENCHMARK(ConnectBlockColdCache, benchmark::PriorityLevel::HIGH);
+BENCHMARK(ConnectBlockColdCacheNoInputFetch, benchmark::PriorityLevel::HIGH);
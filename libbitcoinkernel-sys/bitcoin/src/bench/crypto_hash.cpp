@@ -11,6 +11,7 @@
 #include <crypto/sha3.h>
 #include <crypto/sha512.h>
 #include <crypto/siphash.h>
+#include <hash.h>
 #include <random.h>
 #include <span.h>
 #include <tinyformat.h>
@@ -181,6 +182,35 @@ static void SHA256D64_1024_SHANI(benchmark::Bench& bench)
     SHA256AutoDetect();
 }
 
+/* Transaction sized messages, as hashed when reading a block */
+static const size_t MULTI_MESSAGES = 1024;
+static const size_t MULTI_MESSAGE_SIZE = 250;
+
+static void SHA256D_1024x250_SINGLE(benchmark::Bench& bench)
+{
+    std::vector<uint8_t> in(MULTI_MESSAGES * MULTI_MESSAGE_SIZE, 0);
+    std::vector<uint8_t> out(MULTI_MESSAGES * CHash256::OUTPUT_SIZE);
+    bench.batch(in.size()).unit("byte").run([&] {
+        for (size_t i = 0; i < MULTI_MESSAGES; ++i) {
+            CHash256().Write(std::span{in}.subspan(i * MULTI_MESSAGE_SIZE, MULTI_MESSAGE_SIZE)).Finalize(std::span{out}.subspan(i * CHash256::OUTPUT_SIZE, CHash256::OUTPUT_SIZE));
+        }
+    });
+}
+
+static void SHA256DMulti_1024x250(benchmark::Bench& bench)
+{
+    std::vector<uint8_t> in(MULTI_MESSAGES * MULTI_MESSAGE_SIZE, 0);
+    std::vector<uint8_t> out(MULTI_MESSAGES * CHash256::OUTPUT_SIZE);
+    std::vector<const unsigned char*> inputs;
+    for (size_t i = 0; i < MULTI_MESSAGES; ++i) {
+        inputs.push_back(in.data() + i * MULTI_MESSAGE_SIZE);
+    }
+    const std::vector<size_t> sizes(MULTI_MESSAGES, MULTI_MESSAGE_SIZE);
+    bench.batch(in.size()).unit("byte").run([&] {
+        SHA256DMulti(out.data(), inputs.data(), sizes.data(), MULTI_MESSAGES);
+    });
+}
+
 static void SHA512(benchmark::Bench& bench)
 {
     uint8_t hash[CSHA512::OUTPUT_SIZE];
@@ -280,6 +310,8 @@ BENCHMARK(SHA256D64_1024_STANDARD, benchmark::PriorityLevel::HIGH);
 BENCHMARK(SHA256D64_1024_SSE4, benchmark::PriorityLevel::HIGH);
 BENCHMARK(SHA256D64_1024_AVX2, benchmark::PriorityLevel::HIGH);
 BENCHMARK(SHA256D64_1024_SHANI, benchmark::PriorityLevel::HIGH);
+BENCHMARK(SHA256D_1024x250_SINGLE, benchmark::PriorityLevel::HIGH);
+BENCHMARK(SHA256DMulti_1024x250, benchmark::PriorityLevel::HIGH);
 
 BENCHMARK(MuHash, benchmark::PriorityLevel::HIGH);
 BENCHMARK(MuHashMul, benchmark::PriorityLevel::HIGH);
@@ -27,11 +27,12 @@
  * Create a test file that's similar to a datadir/blocks/blk?????.dat file,
  * It contains around 134 copies of the same block (typical size of real block files).
  * For each block in the file, LoadExternalBlockFile() won't find its parent,
- * and so will skip the block. (In the real system, it will re-read the block
- * from disk later when it encounters its parent.)
+ * and so will skip the block. (In the real system, it will keep the block in
+ * memory, or re-read it from disk, and process it when it encounters its
+ * parent.)
  *
- * This benchmark measures the performance of deserializing the block (or just
- * its header, beginning with PR 16981).
+ * This benchmark measures the performance of framing, deserializing and
+ * checking the blocks, which is done on the worker threads.
  */
 static void LoadExternalBlockFile(benchmark::Bench& bench)
 {
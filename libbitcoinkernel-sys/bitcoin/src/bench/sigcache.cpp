@@ -0,0 +1,66 @@
+// Copyright (c) 2025 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <random.h>
+#include <script/sigcache.h>
+#include <uint256.h>
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+static constexpr size_t SIGCACHE_ENTRIES{10000};
+
+static std::vector<uint256> FillSignatureCache(SignatureCache& cache)
+{
+    FastRandomContext rng{/*fDeterministic=*/true};
+    std::vector<uint256> entries;
+    entries.reserve(SIGCACHE_ENTRIES);
+    for (size_t i{0}; i < SIGCACHE_ENTRIES; ++i) {
+        cache.Set(entries.emplace_back(rng.rand256()));
+    }
+    return entries;
+}
+
+static void SignatureCacheLookups(benchmark::Bench& bench, size_t background_threads)
+{
+    SignatureCache cache{DEFAULT_SIGNATURE_CACHE_BYTES};
+    const std::vector<uint256> entries{FillSignatureCache(cache)};
+
+    // Script check workers looking up entries at the same time as the
+    // measured thread.
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> threads;
+    for (size_t n{0}; n < background_threads; ++n) {
+        threads.emplace_back([&, n] {
+            size_t i{n};
+            while (!stop.load(std::memory_order_relaxed)) {
+                cache.Get(entries[i++ % entries.size()], /*erase=*/false);
+            }
+        });
+    }
+    size_t i{0};
+    bench.run([&] {
+        cache.Get(entries[i++ % entries.size()], /*erase=*/false);
+    });
+    stop = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+static void SignatureCacheLookup(benchmark::Bench& bench)
+{
+    SignatureCacheLookups(bench, /*background_threads=*/0);
+}
+
+static void SignatureCacheLookupContended(benchmark::Bench& bench)
+{
+    SignatureCacheLookups(bench, /*background_threads=*/3);
+}
+
+BENCHMARK(SignatureCacheLookup, benchmark::PriorityLevel::HIGH);
+BENCHMARK(SignatureCacheLookupContended, benchmark::PriorityLevel::HIGH);
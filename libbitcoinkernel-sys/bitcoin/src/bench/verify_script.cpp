@@ -7,6 +7,7 @@
 #include <key.h>
 #include <primitives/transaction.h>
 #include <pubkey.h>
+#include <random.h>
 #include <script/interpreter.h>
 #include <script/script.h>
 #include <span.h>
@@ -87,5 +88,40 @@ static void VerifyNestedIfScript(benchmark::Bench& bench)
     });
 }
 
+// Verification of as many Schnorr signatures as a script check worker takes
+// at once, either one by one or as a batch.
+static void VerifySchnorr(benchmark::Bench& bench, bool batch)
+{
+    ECC_Context ecc_context{};
+    FastRandomContext rng{/*fDeterministic=*/true};
+
+    constexpr size_t NUM_SIGS{128};
+    std::vector<XOnlyPubKey> pubkeys;
+    std::vector<uint256> msgs;
+    std::vector<std::array<unsigned char, 64>> sigs(NUM_SIGS);
+    for (size_t i{0}; i < NUM_SIGS; ++i) {
+        const CKey key{GenerateRandomKey()};
+        pubkeys.emplace_back(key.GetPubKey());
+        msgs.push_back(rng.rand256());
+        assert(key.SignSchnorr(msgs.back(), sigs[i], /*merkle_root=*/nullptr, rng.rand256()));
+    }
+
+    SchnorrSignatureBatch sig_batch;
+    bench.batch(NUM_SIGS).unit("signature").run([&] {
+        if (batch) {
+            sig_batch.Clear();
+            for (size_t i{0}; i < NUM_SIGS; ++i) sig_batch.Add(pubkeys[i], msgs[i], sigs[i]);
+            assert(sig_batch.Verify());
+        } else {
+            for (size_t i{0}; i < NUM_SIGS; ++i) assert(pubkeys[i].VerifySchnorr(msgs[i], sigs[i]));
+        }
+    });
+}
+
+static void VerifySchnorrIndividual(benchmark::Bench& bench) { VerifySchnorr(bench, /*batch=*/false); }
+static void VerifySchnorrBatch(benchmark::Bench& bench) { VerifySchnorr(bench, /*batch=*/true); }
+
 BENCHMARK(VerifyScriptBench, benchmark::PriorityLevel::HIGH);
 BENCHMARK(VerifyNestedIfScript, benchmark::PriorityLevel::HIGH);
+BENCHMARK(VerifySchnorrIndividual, benchmark::PriorityLevel::HIGH);
+BENCHMARK(VerifySchnorrBatch, benchmark::PriorityLevel::HIGH);
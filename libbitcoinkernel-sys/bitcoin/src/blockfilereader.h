@@ -0,0 +1,289 @@
+// Copyright (c) 2025 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_BLOCKFILEREADER_H
+#define BITCOIN_BLOCKFILEREADER_H
+
+#include <consensus/consensus.h>
+#include <primitives/block.h>
+#include <protocol.h>
+#include <serialize.h>
+#include <span.h>
+#include <streams.h>
+#include <sync.h>
+#include <tinyformat.h>
+#include <uint256.h>
+#include <util/threadnames.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * Reads the blocks stored in a block file (as written by BlockManager, or
+ * passed with -loadblock) ahead of the thread importing them.
+ *
+ * One thread scans the file for the network magic and frames the serialized
+ * blocks, a pool of worker threads deserializes them and runs the
+ * context-free checks on them, and the importing thread receives them in file
+ * order through Next(). At most max_in_flight blocks are held in memory ahead
+ * of the importing thread.
+ *
+ * Without worker threads, blocks are framed and deserialized on the importing
+ * thread when it calls Next().
+ */
+class BlockFileReader
+{
+public:
+    //! A block framed in the file.
+    struct Item {
+        //! Position of the block in the file, after its magic and size
+        uint64_t pos{0};
+        //! Serialized size of the block
+        uint32_t size{0};
+        uint256 hash;
+        uint256 prev_hash;
+        //! The deserialized block, or null if it failed to deserialize or
+        //! was skipped.
+        std::shared_ptr<CBlock> block;
+        //! The serialized block. Only kept if the block was skipped, so that
+        //! the caller can deserialize it on demand.
+        std::vector<std::byte> data;
+        //! Set if the block could not be read or deserialized.
+        std::string error;
+    };
+
+    //! Returns true if the block with the given hash does not need to be
+    //! deserialized. Called from the worker threads.
+    using SkipFn = std::function<bool(const uint256& hash)>;
+    //! Runs context-free checks on a deserialized block. Called from the
+    //! worker threads.
+    using CheckFn = std::function<void(const CBlock& block)>;
+
+private:
+    const MessageStartChars m_message_start;
+    const SkipFn m_skip;
+    const CheckFn m_check;
+    const size_t m_max_in_flight;
+
+    //! Framing state, only accessed by the framing thread, or by the caller
+    //! of Next() if there are no worker threads.
+    BufferedFile m_blkdat;
+    //! Where to resume scanning in case something goes wrong, such as a
+    //! block that fails to deserialize.
+    uint64_t m_rewind;
+
+    Mutex m_mutex;
+    //! The framing thread blocks on this while max_in_flight blocks are held
+    std::condition_variable m_framer_cv;
+    //! Worker threads block on this when out of work
+    std::condition_variable m_worker_cv;
+    //! The caller of Next() blocks on this until the next block is ready
+    std::condition_variable m_reader_cv;
+
+    //! Framed blocks waiting to be deserialized, with their sequence number
+    std::deque<std::pair<uint64_t, Item>> m_framed GUARDED_BY(m_mutex);
+    //! Deserialized blocks, keyed by sequence number
+    std::map<uint64_t, Item> m_ready GUARDED_BY(m_mutex);
+    //! Number of blocks framed so far
+    uint64_t m_frame_count GUARDED_BY(m_mutex){0};
+    //! Sequence number of the next block returned by Next()
+    uint64_t m_next GUARDED_BY(m_mutex){0};
+    //! Whether the framing thread reached the end of the file
+    bool m_eof GUARDED_BY(m_mutex){false};
+    bool m_request_stop GUARDED_BY(m_mutex){false};
+
+    std::thread m_framer_thread;
+    std::vector<std::thread> m_worker_threads;
+
+    std::optional<Item> ReadFrame()
+    {
+        while (!m_blkdat.eof()) {
+            m_blkdat.SetPos(m_rewind);
+            m_rewind++; // start one byte further next time, in case of failure
+            m_blkdat.SetLimit(); // remove former limit
+            unsigned int size{0};
+            try {
+                // locate a header
+                MessageStartChars buf;
+                m_blkdat.FindByte(std::byte(m_message_start[0]));
+                m_rewind = m_blkdat.GetPos() + 1;
+                m_blkdat >> buf;
+                if (buf != m_message_start) {
+                    continue;
+                }
+                // read size
+                m_blkdat >> size;
+                if (size < 80 || size > MAX_BLOCK_SERIALIZED_SIZE) {
+                    continue;
+                }
+            } catch (const std::exception&) {
+                // no valid block header found; don't complain
+                // (this happens at the end of every blk.dat file)
+                break;
+            }
+            Item item;
+            item.pos = m_blkdat.GetPos();
+            item.size = size;
+            // Resume scanning after this block, even if it fails to deserialize.
+            m_rewind = item.pos + size;
+            try {
+                m_blkdat.SetLimit(item.pos + size);
+                item.data.resize(size);
+                m_blkdat.read(item.data);
+            } catch (const std::exception& e) {
+                item.data.clear();
+                item.error = e.what();
+            }
+            return item;
+        }
+        return std::nullopt;
+    }
+
+    void Deserialize(Item& item) const noexcept
+    {
+        if (!item.error.empty()) return;
+        try {
+            SpanReader reader{item.data};
+            CBlockHeader header;
+            reader >> header;
+            item.hash = header.GetHash();
+            item.prev_hash = header.hashPrevBlock;
+            if (m_skip && m_skip(item.hash)) return;
+
+            item.block = std::make_shared<CBlock>();
+            SpanReader{item.data} >> TX_WITH_WITNESS(*item.block);
+            if (m_check) m_check(*item.block);
+            item.data = {};
+        } catch (const std::exception& e) {
+            item.block.reset();
+            item.data = {};
+            item.error = e.what();
+        }
+    }
+
+    void FramerLoop() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        while (true) {
+            {
+                WAIT_LOCK(m_mutex, lock);
+                m_framer_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_request_stop || m_frame_count - m_next < m_max_in_flight; });
+                if (m_request_stop) return;
+            }
+            std::optional<Item> item{ReadFrame()};
+            {
+                LOCK(m_mutex);
+                if (!item) {
+                    m_eof = true;
+                } else {
+                    m_framed.emplace_back(m_frame_count++, std::move(*item));
+                }
+            }
+            if (!item) {
+                m_worker_cv.notify_all();
+                m_reader_cv.notify_one();
+                return;
+            }
+            m_worker_cv.notify_one();
+        }
+    }
+
+    void WorkerLoop() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        while (true) {
+            m_worker_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_request_stop || m_eof || !m_framed.empty(); });
+            if (m_request_stop || m_framed.empty()) return;
+            auto [seq, item]{std::move(m_framed.front())};
+            m_framed.pop_front();
+            {
+                REVERSE_LOCK(lock, m_mutex);
+                Deserialize(item);
+            }
+            m_ready.emplace(seq, std::move(item));
+            if (seq == m_next) m_reader_cv.notify_one();
+        }
+    }
+
+public:
+    //! Create a reader for the blocks in file, starting at its current position.
+    BlockFileReader(AutoFile& file, const MessageStartChars& message_start, SkipFn skip, CheckFn check, int worker_threads_num, size_t max_in_flight)
+        : m_message_start{message_start},
+          m_skip{std::move(skip)},
+          m_check{std::move(check)},
+          m_max_in_flight{std::max<size_t>(max_in_flight, 1)},
+          m_blkdat{file, 2 * MAX_BLOCK_SERIALIZED_SIZE, MAX_BLOCK_SERIALIZED_SIZE + 8},
+          m_rewind{m_blkdat.GetPos()}
+    {
+        if (worker_threads_num <= 0) return;
+        m_framer_thread = std::thread([this]() {
+            util::ThreadRename("blockframe");
+            FramerLoop();
+        });
+        m_worker_threads.reserve(worker_threads_num);
+        for (int n = 0; n < worker_threads_num; ++n) {
+            m_worker_threads.emplace_back([this, n]() {
+                util::ThreadRename(strprintf("blockparse.%i", n));
+                WorkerLoop();
+            });
+        }
+    }
+
+    // Since this class manages its own resources, which are the framing
+    // thread and the worker threads, copy and move operations are not
+    // appropriate.
+    BlockFileReader(const BlockFileReader&) = delete;
+    BlockFileReader& operator=(const BlockFileReader&) = delete;
+    BlockFileReader(BlockFileReader&&) = delete;
+    BlockFileReader& operator=(BlockFileReader&&) = delete;
+
+    ~BlockFileReader()
+    {
+        WITH_LOCK(m_mutex, m_request_stop = true);
+        m_framer_cv.notify_all();
+        m_worker_cv.notify_all();
+        if (m_framer_thread.joinable()) m_framer_thread.join();
+        for (std::thread& t : m_worker_threads) {
+            t.join();
+        }
+    }
+
+    /**
+     * Return the next block of the file, or std::nullopt once the end of the
+     * file is reached. Data that does not deserialize cleanly is returned
+     * with its error set.
+     */
+    std::optional<Item> Next() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        if (m_worker_threads.empty()) {
+            std::optional<Item> item{ReadFrame()};
+            if (item) Deserialize(*item);
+            return item;
+        }
+        std::optional<Item> item;
+        {
+            WAIT_LOCK(m_mutex, lock);
+            m_reader_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_ready.contains(m_next) || (m_eof && m_next == m_frame_count); });
+            auto node{m_ready.extract(m_next)};
+            if (node.empty()) return std::nullopt;
+            item = std::move(node.mapped());
+            ++m_next;
+        }
+        m_framer_cv.notify_one();
+        return item;
+    }
+};
+
+#endif // BITCOIN_BLOCKFILEREADER_H
@@ -11,10 +11,24 @@
 #include <util/threadnames.h>
 
 #include <algorithm>
+#include <concepts>
 #include <iterator>
 #include <optional>
+#include <utility>
 #include <vector>
 
+/**
+ * A check that can defer part of its work to a batch shared with the other
+ * checks a worker processes at once, such as signatures that are cheaper to
+ * verify together. Running a check against a batch returns its result under
+ * the assumption that the batch verifies.
+ */
+template <typename T, typename R>
+concept BatchableCheck = requires(T& check, typename T::Batch& batch) {
+    { check(batch) } -> std::same_as<std::optional<R>>;
+    { std::as_const(batch).Verify() } -> std::same_as<bool>;
+};
+
 /**
  * Queue for verifications that have to be performed.
   * The verifications are represented by a type T, which must provide an
@@ -23,6 +37,11 @@
   * The overall result of the computation is std::nullopt if all invocations
   * return std::nullopt, or one of the other results otherwise.
   *
+  * If T is a BatchableCheck, the checks a worker takes from the queue at once
+  * share a batch. When the batch or one of the checks fails, the checks are
+  * run again without a batch, so the result is the same as if batching was
+  * not used.
+  *
   * One thread (the master) is assumed to push batches of verifications
   * onto the queue, where they are processed by N-1 worker threads. When
   * the master is done adding work, it temporarily joins the worker pool
@@ -68,6 +87,27 @@ private:
     std::vector<std::thread> m_worker_threads;
     bool m_request_stop GUARDED_BY(m_mutex){false};
 
+    //! Run checks until one fails, returning its result.
+    static std::optional<R> RunChecks(std::vector<T>& checks)
+    {
+        if constexpr (BatchableCheck<T, R>) {
+            typename T::Batch batch;
+            bool ok{true};
+            for (T& check : checks) {
+                if (check(batch).has_value()) {
+                    ok = false;
+                    break;
+                }
+            }
+            if (ok && batch.Verify()) return std::nullopt;
+            // Something failed; find out which check it was.
+        }
+        for (T& check : checks) {
+            if (auto result{check()}) return result;
+        }
+        return std::nullopt;
+    }
+
     /** Internal function that does bulk of the verification work. If fMaster, return the final result. */
     std::optional<R> Loop(bool fMaster) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
     {
@@ -83,8 +123,9 @@ private:
                 // first do the clean-up of the previous loop run (allowing us to do it in the same critsect)
                 if (nNow) {
                     if (local_result.has_value() && !m_result.has_value()) {
-                        std::swap(local_result, m_result);
+                        m_result = std::move(local_result);
                     }
+                    local_result.reset();
                     nTodo -= nNow;
                     if (nTodo == 0 && !fMaster) {
                         // We processed the last element; inform the master it can exit and return the result
@@ -127,10 +168,7 @@ private:
             }
             // execute work
             if (do_work) {
-                for (T& check : vChecks) {
-                    local_result = check();
-                    if (local_result.has_value()) break;
-                }
+                local_result = RunChecks(vChecks);
             }
             vChecks.clear();
         } while (true);
@@ -5,10 +5,16 @@
 #include <coins.h>
 
 #include <consensus/consensus.h>
+#include <crypto/common.h>
 #include <logging.h>
 #include <random.h>
+#include <streams.h>
 #include <util/trace.h>
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
 TRACEPOINT_SEMAPHORE(utxocache, add);
 TRACEPOINT_SEMAPHORE(utxocache, spent);
 TRACEPOINT_SEMAPHORE(utxocache, uncache);
@@ -119,6 +125,14 @@ void CCoinsViewCache::EmplaceCoinInternalDANGER(COutPoint&& outpoint, Coin&& coi
     }
 }
 
+void CCoinsViewCache::EmplaceFetchedCoin(const COutPoint& outpoint, Coin&& coin) {
+    assert(!coin.IsSpent());
+    const auto mem_usage{coin.DynamicMemoryUsage()};
+    if (cacheCoins.try_emplace(outpoint, std::move(coin)).second) {
+        cachedCoinsUsage += mem_usage;
+    }
+}
+
 void AddCoins(CCoinsViewCache& cache, const CTransaction &tx, int nHeight, bool check_for_overwrite) {
     bool fCoinbase = tx.IsCoinBase();
     const Txid& txid = tx.GetHash();
@@ -173,6 +187,12 @@ bool CCoinsViewCache::HaveCoinInCache(const COutPoint &outpoint) const {
     return (it != cacheCoins.end() && !it->second.coin.IsSpent());
 }
 
+const Coin* CCoinsViewCache::GetCoinInCache(const COutPoint& outpoint) const
+{
+    CCoinsMap::const_iterator it = cacheCoins.find(outpoint);
+    return it != cacheCoins.end() ? &it->second.coin : nullptr;
+}
+
 uint256 CCoinsViewCache::GetBestBlock() const {
     if (hashBlock.IsNull())
         hashBlock = base->GetBestBlock();
@@ -363,6 +383,143 @@ const Coin& AccessByTxid(const CCoinsViewCache& view, const Txid& txid)
     return coinEmpty;
 }
 
+//! Expected average size of an entry in the arena of a CompactCoinsMap. It
+//! determines how its memory is split between the table and the arena.
+static constexpr size_t COMPACT_COIN_ENTRY_BYTES{72};
+
+CompactCoinsMap::CompactCoinsMap(size_t max_memory_bytes, bool deterministic) : m_hasher{deterministic}
+{
+    // The table is kept at most 3/4 full.
+    const size_t slot_count{std::min<size_t>(max_memory_bytes / (sizeof(Slot) + COMPACT_COIN_ENTRY_BYTES * 3 / 4),
+                                             std::numeric_limits<uint32_t>::max())};
+    m_slots.resize(slot_count);
+    m_arena.reserve(max_memory_bytes - slot_count * sizeof(Slot));
+}
+
+CompactCoinsMap::Key CompactCoinsMap::MakeKey(const COutPoint& outpoint) noexcept
+{
+    Key key;
+    std::memcpy(key.data(), outpoint.hash.data(), uint256::size());
+    WriteLE32(key.data() + uint256::size(), outpoint.n);
+    return key;
+}
+
+size_t CompactCoinsMap::Find(const Key& key, uint32_t hash) const noexcept
+{
+    size_t pos{Home(hash)};
+    while (m_slots[pos].size != 0) {
+        const Slot& slot{m_slots[pos]};
+        if (slot.hash == hash && std::equal(key.begin(), key.end(), m_arena.begin() + slot.pos)) break;
+        pos = Next(pos);
+    }
+    return pos;
+}
+
+std::optional<Coin> CompactCoinsMap::Get(const COutPoint& outpoint) const
+{
+    if (m_count == 0) return std::nullopt;
+    const Slot& slot{m_slots[Find(MakeKey(outpoint), Hash(outpoint))]};
+    if (slot.size == 0) return std::nullopt;
+    Coin coin;
+    SpanReader{std::span{m_arena}.subspan(slot.pos + KEY_SIZE, slot.size - KEY_SIZE)} >> coin;
+    return coin;
+}
+
+bool CompactCoinsMap::Contains(const COutPoint& outpoint) const noexcept
+{
+    if (m_count == 0) return false;
+    return m_slots[Find(MakeKey(outpoint), Hash(outpoint))].size != 0;
+}
+
+bool CompactCoinsMap::Insert(const COutPoint& outpoint, const Coin& coin)
+{
+    if (m_slots.empty()) return false;
+    m_buffer.clear();
+    VectorWriter{m_buffer, 0, coin};
+    const size_t size{KEY_SIZE + m_buffer.size()};
+    const Key key{MakeKey(outpoint)};
+    const uint32_t hash{Hash(outpoint)};
+
+    size_t pos{Find(key, hash)};
+    if (m_slots[pos].size == size) {
+        // Most replacements are of the same coin, so this is the common case.
+        std::copy(m_buffer.begin(), m_buffer.end(), m_arena.begin() + m_slots[pos].pos + KEY_SIZE);
+        return true;
+    }
+    if (m_slots[pos].size != 0) {
+        EraseAt(pos);
+        pos = Find(key, hash);
+    }
+    if ((m_count + 1) * 4 > m_slots.size() * 3) return false;
+    if (m_arena.size() + size > m_arena.capacity()) {
+        // Only reclaim the garbage if that frees a meaningful part of the
+        // arena, so that a nearly full map is not compacted on every insert.
+        if (m_garbage < m_arena.capacity() / 8 || m_arena.size() - m_garbage + size > m_arena.capacity()) return false;
+        Compact();
+    }
+
+    m_slots[pos] = Slot{.hash = hash, .size = static_cast<uint32_t>(size), .pos = m_arena.size()};
+    m_arena.insert(m_arena.end(), key.begin(), key.end());
+    m_arena.insert(m_arena.end(), m_buffer.begin(), m_buffer.end());
+    ++m_count;
+    return true;
+}
+
+void CompactCoinsMap::EraseAt(size_t pos) noexcept
+{
+    m_garbage += m_slots[pos].size;
+    --m_count;
+    // Move back the entries that follow in the same run of occupied slots
+    // and may start probing at or before the emptied slot, so that all
+    // entries stay reachable from their home slot.
+    const auto distance{[&](size_t from, size_t to) { return to >= from ? to - from : to + m_slots.size() - from; }};
+    for (size_t next{Next(pos)}; m_slots[next].size != 0; next = Next(next)) {
+        if (distance(Home(m_slots[next].hash), next) >= distance(pos, next)) {
+            m_slots[pos] = m_slots[next];
+            pos = next;
+        }
+    }
+    m_slots[pos] = Slot{};
+}
+
+void CompactCoinsMap::Erase(const COutPoint& outpoint) noexcept
+{
+    if (m_count == 0) return;
+    const size_t pos{Find(MakeKey(outpoint), Hash(outpoint))};
+    if (m_slots[pos].size != 0) EraseAt(pos);
+}
+
+void CompactCoinsMap::Compact()
+{
+    std::vector<Slot*> entries;
+    entries.reserve(m_count);
+    for (Slot& slot : m_slots) {
+        if (slot.size != 0) entries.push_back(&slot);
+    }
+    std::sort(entries.begin(), entries.end(), [](const Slot* a, const Slot* b) { return a->pos < b->pos; });
+    uint64_t end{0};
+    for (Slot* slot : entries) {
+        std::memmove(m_arena.data() + end, m_arena.data() + slot->pos, slot->size);
+        slot->pos = end;
+        end += slot->size;
+    }
+    m_arena.resize(end);
+    m_garbage = 0;
+}
+
+void CompactCoinsMap::Clear() noexcept
+{
+    std::fill(m_slots.begin(), m_slots.end(), Slot{});
+    m_arena.clear();
+    m_count = 0;
+    m_garbage = 0;
+}
+
+size_t CompactCoinsMap::DynamicMemoryUsage() const
+{
+    return memusage::DynamicUsage(m_slots) + memusage::DynamicUsage(m_arena) + memusage::DynamicUsage(m_buffer);
+}
+
 template <typename ReturnType, typename Func>
 static ReturnType ExecuteBackedWrapper(Func func, const std::vector<std::function<void()>>& err_callbacks)
 {
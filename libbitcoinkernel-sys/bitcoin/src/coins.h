@@ -19,8 +19,11 @@
 #include <cassert>
 #include <cstdint>
 
+#include <array>
 #include <functional>
+#include <optional>
 #include <unordered_map>
+#include <vector>
 
 /**
  * A UTXO entry.
@@ -230,6 +233,90 @@ using CCoinsMap = std::unordered_map<COutPoint,
 
 using CCoinsMapMemoryResource = CCoinsMap::allocator_type::ResourceType;
 
+/**
+ * A map of unspent coins in the compressed serialization that is also used in
+ * the coins database.
+ *
+ * Where a CCoinsMap allocates a node holding a full Coin for every entry, this
+ * is a flat hash table with linear probing whose slots point into a single
+ * arena holding the serialized outpoints and coins, so that the same amount of
+ * memory holds considerably more coins. All memory is allocated up front.
+ * Coins are decompressed when they are read, and the memory of erased or
+ * replaced entries is reclaimed once the arena runs full. When the arena or
+ * the table is full, Insert fails, and the caller has to make room by clearing
+ * the map.
+ */
+class CompactCoinsMap
+{
+private:
+    struct Slot {
+        //! Low bits of the hash of the outpoint, which determine where the
+        //! probing for it starts.
+        uint32_t hash{0};
+        //! Size of the entry in the arena, or zero if the slot is empty.
+        uint32_t size{0};
+        //! Position of the entry in the arena.
+        uint64_t pos{0};
+    };
+
+    //! Size of an outpoint at the start of every entry in the arena.
+    static constexpr size_t KEY_SIZE{uint256::size() + sizeof(uint32_t)};
+    using Key = std::array<unsigned char, KEY_SIZE>;
+
+    const SaltedOutpointHasher m_hasher;
+    std::vector<Slot> m_slots;
+    //! Entries are an outpoint's KEY_SIZE bytes followed by its serialized coin.
+    std::vector<unsigned char> m_arena;
+    //! Number of entries.
+    size_t m_count{0};
+    //! Number of arena bytes taken by erased or replaced entries.
+    size_t m_garbage{0};
+    //! Buffer for serializing the coin being inserted.
+    std::vector<unsigned char> m_buffer;
+
+    static Key MakeKey(const COutPoint& outpoint) noexcept;
+    uint32_t Hash(const COutPoint& outpoint) const noexcept { return static_cast<uint32_t>(m_hasher(outpoint)); }
+    size_t Home(uint32_t hash) const noexcept { return (uint64_t{hash} * m_slots.size()) >> 32; }
+    size_t Next(size_t pos) const noexcept { return pos + 1 == m_slots.size() ? 0 : pos + 1; }
+    //! Return the position of the slot of the outpoint, or of the empty slot
+    //! where it would be inserted.
+    size_t Find(const Key& key, uint32_t hash) const noexcept;
+    //! Empty the slot at pos, moving back the entries probed after it.
+    void EraseAt(size_t pos) noexcept;
+    //! Move the entries in the arena together, dropping the garbage.
+    void Compact();
+
+public:
+    //! Reserve memory for a map using at most about max_memory_bytes.
+    explicit CompactCoinsMap(size_t max_memory_bytes, bool deterministic = false);
+
+    CompactCoinsMap(const CompactCoinsMap&) = delete;
+    CompactCoinsMap& operator=(const CompactCoinsMap&) = delete;
+
+    //! Return the coin of the outpoint, if it is in the map.
+    std::optional<Coin> Get(const COutPoint& outpoint) const;
+
+    bool Contains(const COutPoint& outpoint) const noexcept;
+
+    //! Insert the unspent coin of an outpoint, or replace the coin the map
+    //! holds for it.
+    //!
+    //! @returns false if there is no room for it. The map then holds no coin
+    //!          for the outpoint.
+    bool Insert(const COutPoint& outpoint, const Coin& coin);
+
+    //! Remove the coin of the outpoint, if it is in the map.
+    void Erase(const COutPoint& outpoint) noexcept;
+
+    //! Remove all coins, keeping the memory reserved.
+    void Clear() noexcept;
+
+    //! Number of coins in the map.
+    size_t size() const noexcept { return m_count; }
+
+    size_t DynamicMemoryUsage() const;
+};
+
 /** Cursor for iterating over CoinsView state */
 class CCoinsViewCursor
 {
@@ -401,6 +488,13 @@ public:
      */
     bool HaveCoinInCache(const COutPoint &outpoint) const;
 
+    /**
+     * Return a pointer to the coin in the cache, which may be spent, or
+     * nullptr if the utxo is not loaded in this cache. No calls to the
+     * backing CCoinsView are made.
+     */
+    const Coin* GetCoinInCache(const COutPoint& outpoint) const;
+
     /**
      * Return a reference to Coin in the cache, or coinEmpty if not found. This is
      * more efficient than GetCoin.
@@ -428,6 +522,15 @@ public:
      */
     void EmplaceCoinInternalDANGER(COutPoint&& outpoint, Coin&& coin);
 
+    /**
+     * Insert an unspent coin that was read from the backing view ahead of
+     * time, exactly as if it had been fetched from there on a cache miss. Has
+     * no effect if the outpoint is already present in the cache.
+     *
+     * @sa InputFetcher
+     */
+    void EmplaceFetchedCoin(const COutPoint& outpoint, Coin&& coin);
+
     /**
      * Spend a coin. Pass moveto in order to get the deleted data.
      * If no unspent output exists for the passed outpoint, this call
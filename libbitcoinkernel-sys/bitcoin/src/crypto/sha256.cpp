@@ -34,11 +34,21 @@ namespace sha256d64_sse41
 void Transform_4way(unsigned char* out, const unsigned char* in);
 }
 
+namespace sha256_sse41
+{
+void Transform_4way(uint32_t* s, const unsigned char* const* chunks);
+}
+
 namespace sha256d64_avx2
 {
 void Transform_8way(unsigned char* out, const unsigned char* in);
 }
 
+namespace sha256_avx2
+{
+void Transform_8way(uint32_t* s, const unsigned char* const* chunks);
+}
+
 namespace sha256d64_x86_shani
 {
 void Transform_2way(unsigned char* out, const unsigned char* in);
@@ -47,6 +57,7 @@ void Transform_2way(unsigned char* out, const unsigned char* in);
 namespace sha256_x86_shani
 {
 void Transform(uint32_t* s, const unsigned char* chunk, size_t blocks);
+void Transform_2way(uint32_t* s, const unsigned char* const* chunks);
 }
 
 namespace sha256_arm_shani
@@ -437,6 +448,8 @@ void TransformD64(unsigned char* out, const unsigned char* in)
 
 typedef void (*TransformType)(uint32_t*, const unsigned char*, size_t);
 typedef void (*TransformD64Type)(unsigned char*, const unsigned char*);
+/** Transform one 64-byte chunk for each of several consecutive 8-word states. */
+typedef void (*TransformMultiType)(uint32_t*, const unsigned char* const*);
 
 template<TransformType tr>
 void TransformD64Wrapper(unsigned char* out, const unsigned char* in)
@@ -482,6 +495,28 @@ TransformD64Type TransformD64 = sha256::TransformD64;
 TransformD64Type TransformD64_2way = nullptr;
 TransformD64Type TransformD64_4way = nullptr;
 TransformD64Type TransformD64_8way = nullptr;
+TransformMultiType TransformMulti_2way = nullptr;
+TransformMultiType TransformMulti_4way = nullptr;
+TransformMultiType TransformMulti_8way = nullptr;
+
+/** Test a multi-way transform on the input data, where lane i hashes the (8-i)*64 first bytes. */
+bool SelfTestMulti(TransformMultiType transform, size_t ways, const uint32_t init[8], const unsigned char* data, const uint32_t result[9][8])
+{
+    uint32_t states[8 * 8];
+    const unsigned char* chunks[8];
+    for (size_t step = 0; step < 8; ++step) {
+        for (size_t lane = 0; lane < ways; ++lane) {
+            // Lanes start over at different steps, so that each ends up with a different state.
+            if (step == lane) std::copy(init, init + 8, states + 8 * lane);
+            chunks[lane] = data + 64 * (step >= lane ? step - lane : 7 - step);
+        }
+        transform(states, chunks);
+    }
+    for (size_t lane = 0; lane < ways; ++lane) {
+        if (!std::equal(states + 8 * lane, states + 8 * lane + 8, result[8 - lane])) return false;
+    }
+    return true;
+}
 
 bool SelfTest() {
     // Input state (equal to the initial SHA256 state)
@@ -565,6 +600,11 @@ bool SelfTest() {
         if (!std::equal(out, out + 256, result_d64)) return false;
     }
 
+    // Test the multi-way transforms, if available.
+    if (TransformMulti_2way && !SelfTestMulti(TransformMulti_2way, 2, init, data + 1, result)) return false;
+    if (TransformMulti_4way && !SelfTestMulti(TransformMulti_4way, 4, init, data + 1, result)) return false;
+    if (TransformMulti_8way && !SelfTestMulti(TransformMulti_8way, 8, init, data + 1, result)) return false;
+
     return true;
 }
 
@@ -590,6 +630,9 @@ std::string SHA256AutoDetect(sha256_implementation::UseImplementation use_implem
     TransformD64_2way = nullptr;
     TransformD64_4way = nullptr;
     TransformD64_8way = nullptr;
+    TransformMulti_2way = nullptr;
+    TransformMulti_4way = nullptr;
+    TransformMulti_8way = nullptr;
 
 #if !defined(DISABLE_OPTIMIZED_SHA256)
 #if defined(HAVE_GETCPUID)
@@ -625,6 +668,7 @@ std::string SHA256AutoDetect(sha256_implementation::UseImplementation use_implem
         Transform = sha256_x86_shani::Transform;
         TransformD64 = TransformD64Wrapper<sha256_x86_shani::Transform>;
         TransformD64_2way = sha256d64_x86_shani::Transform_2way;
+        TransformMulti_2way = sha256_x86_shani::Transform_2way;
         ret = "x86_shani(1way;2way)";
         have_sse4 = false; // Disable SSE4/AVX2;
         have_avx2 = false;
@@ -639,6 +683,7 @@ std::string SHA256AutoDetect(sha256_implementation::UseImplementation use_implem
 #endif
 #if defined(ENABLE_SSE41)
         TransformD64_4way = sha256d64_sse41::Transform_4way;
+        TransformMulti_4way = sha256_sse41::Transform_4way;
         ret += ";sse41(4way)";
 #endif
     }
@@ -646,6 +691,7 @@ std::string SHA256AutoDetect(sha256_implementation::UseImplementation use_implem
 #if defined(ENABLE_AVX2)
     if (have_avx2 && have_avx && enabled_avx) {
         TransformD64_8way = sha256d64_avx2::Transform_8way;
+        TransformMulti_8way = sha256_avx2::Transform_8way;
         ret += ";avx2(8way)";
     }
 #endif
@@ -779,3 +825,151 @@ void SHA256D64(unsigned char* out, const unsigned char* in, size_t blocks)
         --blocks;
     }
 }
+
+namespace {
+/** A message being hashed in one lane of a multi-way transform. */
+class LaneMessage
+{
+    //! Full chunks of the message not transformed yet
+    const unsigned char* m_data;
+    size_t m_blocks;
+    //! The rest of the message followed by its padding, in one or two chunks
+    unsigned char m_tail[128];
+    size_t m_tail_blocks;
+    size_t m_tail_pos;
+
+public:
+    void Start(const unsigned char* data, size_t size)
+    {
+        m_data = data;
+        m_blocks = size / 64;
+        const size_t rest{size % 64};
+        if (rest) memcpy(m_tail, data + m_blocks * 64, rest);
+        memset(m_tail + rest, 0, sizeof(m_tail) - rest);
+        m_tail[rest] = 0x80;
+        m_tail_blocks = rest + 9 > 64 ? 2 : 1;
+        WriteBE64(m_tail + 64 * m_tail_blocks - 8, uint64_t{size} << 3);
+        m_tail_pos = 0;
+    }
+
+    const unsigned char* Next()
+    {
+        if (m_blocks) {
+            --m_blocks;
+            m_data += 64;
+            return m_data - 64;
+        }
+        return m_tail + 64 * m_tail_pos++;
+    }
+
+    bool Done() const { return m_blocks == 0 && m_tail_pos == m_tail_blocks; }
+
+    /** Transform all chunks left on their own. */
+    void Complete(uint32_t* s)
+    {
+        Transform(s, m_data, m_blocks);
+        Transform(s, m_tail + 64 * m_tail_pos, m_tail_blocks - m_tail_pos);
+        m_blocks = 0;
+        m_tail_pos = m_tail_blocks;
+    }
+};
+
+void WriteState(unsigned char* out, const uint32_t* s)
+{
+    for (int i = 0; i < 8; ++i) {
+        WriteBE32(out + 4 * i, s[i]);
+    }
+}
+
+void SHA256MultiImpl(unsigned char* output, const unsigned char* const* inputs, const size_t* sizes, size_t count, bool double_hash)
+{
+    static constexpr size_t MAX_WAYS{8};
+    TransformMultiType transform{nullptr};
+    size_t ways{1};
+    if (TransformMulti_8way && count >= 8) {
+        transform = TransformMulti_8way;
+        ways = 8;
+    } else if (TransformMulti_4way && count >= 4) {
+        transform = TransformMulti_4way;
+        ways = 4;
+    } else if (TransformMulti_2way && count >= 2) {
+        transform = TransformMulti_2way;
+        ways = 2;
+    }
+
+    uint32_t s[8 * MAX_WAYS];
+    const unsigned char* chunks[MAX_WAYS];
+    LaneMessage lanes[MAX_WAYS];
+    size_t lane_msg[MAX_WAYS];
+    bool lane_second[MAX_WAYS];
+    bool lane_active[MAX_WAYS];
+    size_t next{0};
+
+    const auto start{[&](size_t lane) {
+        lanes[lane].Start(inputs[next], sizes[next]);
+        sha256::Initialize(s + 8 * lane);
+        lane_msg[lane] = next++;
+        lane_second[lane] = false;
+        lane_active[lane] = true;
+    }};
+    // Move a lane whose message is fully transformed on to its second hash or the next
+    // message. Returns false if there is nothing left to hash in this lane.
+    const auto advance{[&](size_t lane) {
+        unsigned char* out{output + 32 * lane_msg[lane]};
+        WriteState(out, s + 8 * lane);
+        if (double_hash && !lane_second[lane]) {
+            lanes[lane].Start(out, CSHA256::OUTPUT_SIZE);
+            sha256::Initialize(s + 8 * lane);
+            lane_second[lane] = true;
+            return true;
+        }
+        if (next < count && ways > 1) {
+            start(lane);
+            return true;
+        }
+        lane_active[lane] = false;
+        return false;
+    }};
+
+    if (ways > 1) {
+        for (size_t lane = 0; lane < ways; ++lane) {
+            start(lane);
+        }
+        // Run all lanes together until the first of them runs out of messages.
+        bool all_active{true};
+        while (all_active) {
+            for (size_t lane = 0; lane < ways; ++lane) {
+                chunks[lane] = lanes[lane].Next();
+            }
+            transform(s, chunks);
+            for (size_t lane = 0; lane < ways; ++lane) {
+                if (lanes[lane].Done() && !advance(lane)) all_active = false;
+            }
+        }
+        // Finish the other lanes one at a time.
+        for (size_t lane = 0; lane < ways; ++lane) {
+            while (lane_active[lane]) {
+                lanes[lane].Complete(s + 8 * lane);
+                advance(lane);
+            }
+        }
+    } else {
+        while (next < count) {
+            start(0);
+            do {
+                lanes[0].Complete(s);
+            } while (advance(0));
+        }
+    }
+}
+} // namespace
+
+void SHA256Multi(unsigned char* output, const unsigned char* const* inputs, const size_t* sizes, size_t count)
+{
+    SHA256MultiImpl(output, inputs, sizes, count, /*double_hash=*/false);
+}
+
+void SHA256DMulti(unsigned char* output, const unsigned char* const* inputs, const size_t* sizes, size_t count)
+{
+    SHA256MultiImpl(output, inputs, sizes, count, /*double_hash=*/true);
+}
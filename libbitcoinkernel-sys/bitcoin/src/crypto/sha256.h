@@ -50,4 +50,16 @@ std::string SHA256AutoDetect(sha256_implementation::UseImplementation use_implem
  */
 void SHA256D64(unsigned char* output, const unsigned char* input, size_t blocks);
 
+/** Compute the SHA256's of multiple messages of any size, transforming several of them
+ *  at once in SIMD lanes where the implementation supports it.
+ *  output:  pointer to a count*32 byte output buffer
+ *  inputs:  pointers to the count messages
+ *  sizes:   the sizes in bytes of the count messages
+ *  count:   the number of hashes to compute.
+ */
+void SHA256Multi(unsigned char* output, const unsigned char* const* inputs, const size_t* sizes, size_t count);
+
+/** Like SHA256Multi, but compute double-SHA256's. */
+void SHA256DMulti(unsigned char* output, const unsigned char* const* inputs, const size_t* sizes, size_t count);
+
 #endif // BITCOIN_CRYPTO_SHA256_H
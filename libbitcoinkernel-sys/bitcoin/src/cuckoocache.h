@@ -11,6 +11,8 @@
 #include <array>
 #include <atomic>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <limits>
 #include <memory>
@@ -117,6 +119,18 @@ public:
     }
 };
 
+/** cache_stats holds the counters of a @ref cache, see cache::stats(). */
+struct cache_stats {
+    /** Number of contains() calls that found the element */
+    uint64_t hits{0};
+    /** Number of contains() calls that did not find the element */
+    uint64_t misses{0};
+    /** Number of insert() calls for elements that were not in the table yet */
+    uint64_t inserts{0};
+    /** Number of elements dropped by insert() because it ran out of depth */
+    uint64_t evictions{0};
+};
+
 /** @ref cache implements a cache with properties similar to a cuckoo-set.
  *
  *  The cache is able to hold up to `(~(uint32_t)0) - 1` elements.
@@ -205,6 +219,34 @@ private:
      */
     const Hash hash_function;
 
+    /** Counters for stats(). They are only ever read for reporting, so all
+     * operations on them are `std::memory_order_relaxed`.
+     *
+     * contains() is called concurrently by the script check threads, so the
+     * lookup counters are sharded over cache lines, each thread counting in
+     * its own shard, and summed by stats(). They are mutable because
+     * contains() may be called from const methods.
+     */
+    struct alignas(64) lookup_counters {
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+    };
+    static constexpr size_t LOOKUP_COUNTER_SHARDS{16};
+    mutable std::array<lookup_counters, LOOKUP_COUNTER_SHARDS> lookup_counts;
+    std::atomic<uint64_t> insert_count{0};
+    std::atomic<uint64_t> eviction_count{0};
+
+    /** lookup_counter_shard returns the lookup counters of the calling thread.
+     * Threads are assigned shards round-robin on their first lookup in any
+     * cache.
+     */
+    lookup_counters& lookup_counter_shard() const
+    {
+        static std::atomic<size_t> next_shard{0};
+        thread_local const size_t shard{next_shard.fetch_add(1, std::memory_order_relaxed) % LOOKUP_COUNTER_SHARDS};
+        return lookup_counts[shard];
+    }
+
     /** compute_hashes is convenience for not having to write out this
      * expression everywhere we use the hash values of an Element.
      *
@@ -408,6 +450,7 @@ public:
                 epoch_flags[loc] = last_epoch;
                 return;
             }
+        insert_count.fetch_add(1, std::memory_order_relaxed);
         for (uint8_t depth = 0; depth < depth_limit; ++depth) {
             // First try to insert to an empty slot, if one exists
             for (const uint32_t loc : locs) {
@@ -442,6 +485,8 @@ public:
             // Recompute the locs -- unfortunately happens one too many times!
             locs = compute_hashes(e);
         }
+        // The element we are left holding is dropped.
+        eviction_count.fetch_add(1, std::memory_order_relaxed);
     }
 
     /** contains iterates through the hash locations for a given element
@@ -478,10 +523,33 @@ public:
             if (table[loc] == e) {
                 if (erase)
                     allow_erase(loc);
+                lookup_counter_shard().hits.fetch_add(1, std::memory_order_relaxed);
                 return true;
             }
+        lookup_counter_shard().misses.fetch_add(1, std::memory_order_relaxed);
         return false;
     }
+
+    /** stats returns the counters of lookups and inserts since the cache was
+     * created. Threadsafe, but the counters are not read atomically as a whole.
+     *
+     * @returns the hit, miss, insert and eviction counters
+     */
+    cache_stats stats() const
+    {
+        uint64_t hits{0};
+        uint64_t misses{0};
+        for (const lookup_counters& shard : lookup_counts) {
+            hits += shard.hits.load(std::memory_order_relaxed);
+            misses += shard.misses.load(std::memory_order_relaxed);
+        }
+        return {
+            .hits = hits,
+            .misses = misses,
+            .inserts = insert_count.load(std::memory_order_relaxed),
+            .evictions = eviction_count.load(std::memory_order_relaxed),
+        };
+    }
 };
 } // namespace CuckooCache
 
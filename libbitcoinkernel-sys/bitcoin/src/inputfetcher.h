@@ -0,0 +1,190 @@
+// Copyright (c) 2025 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_INPUTFETCHER_H
+#define BITCOIN_INPUTFETCHER_H
+
+#include <coins.h>
+#include <logging.h>
+#include <primitives/block.h>
+#include <primitives/transaction.h>
+#include <sync.h>
+#include <tinyformat.h>
+#include <util/hasher.h>
+#include <util/threadnames.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Fetches the coins spent by a block from the coins database on a pool of
+ * worker threads and inserts them into the coins cache before the block is
+ * connected. This turns the serial cache misses of the connect loop into
+ * parallel database reads.
+ *
+ * Inputs spending outputs created earlier in the same block, and inputs that
+ * are already cached, are skipped. Coins that could not be found are not
+ * inserted, so the connect loop reports missing inputs as it would without
+ * prefetching.
+ *
+ * One thread (the master) calls FetchInputs, which distributes the reads over
+ * the worker threads and joins them as an additional worker until all reads
+ * are done.
+ */
+class InputFetcher
+{
+private:
+    //! Mutex to protect the inner state
+    Mutex m_mutex;
+
+    //! Worker threads block on this when out of work
+    std::condition_variable m_worker_cv;
+
+    //! Master thread blocks on this until all workers are done
+    std::condition_variable m_master_cv;
+
+    //! The outpoints to fetch and the fetched coins, indexed alike. Only
+    //! written by the master while no workers are active.
+    std::vector<COutPoint> m_outpoints;
+    std::vector<std::optional<Coin>> m_coins;
+
+    //! The database being read from during the current round.
+    const CCoinsView* m_db{nullptr};
+
+    //! Index of the next outpoint to be claimed by a thread.
+    std::atomic<size_t> m_next{0};
+
+    //! Incremented for each round of work handed to the workers.
+    uint64_t m_round GUARDED_BY(m_mutex){0};
+
+    //! The number of workers that have not finished the current round yet.
+    int m_active GUARDED_BY(m_mutex){0};
+
+    //! The maximum number of outpoints claimed by a thread at once
+    const size_t m_batch_size;
+
+    std::vector<std::thread> m_worker_threads;
+    bool m_request_stop GUARDED_BY(m_mutex){false};
+
+    void Work() noexcept
+    {
+        while (true) {
+            const size_t start{m_next.fetch_add(m_batch_size, std::memory_order_relaxed)};
+            if (start >= m_outpoints.size()) return;
+            const size_t end{std::min(start + m_batch_size, m_outpoints.size())};
+            for (size_t i{start}; i < end; ++i) {
+                try {
+                    m_coins[i] = m_db->GetCoin(m_outpoints[i]);
+                } catch (const std::exception&) {
+                    // Leave the coin to be read, and the error to be
+                    // handled, by the connect loop.
+                }
+            }
+        }
+    }
+
+    void Loop() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        uint64_t round{0};
+        WAIT_LOCK(m_mutex, lock);
+        while (true) {
+            m_worker_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_request_stop || m_round != round; });
+            if (m_request_stop) return;
+            round = m_round;
+            {
+                REVERSE_LOCK(lock, m_mutex);
+                Work();
+            }
+            if (--m_active == 0) m_master_cv.notify_one();
+        }
+    }
+
+public:
+    //! Create a new input fetcher
+    explicit InputFetcher(size_t batch_size, int worker_threads_num)
+        : m_batch_size(batch_size)
+    {
+        LogInfo("Block input fetching uses %d additional threads", worker_threads_num);
+        m_worker_threads.reserve(worker_threads_num);
+        for (int n = 0; n < worker_threads_num; ++n) {
+            m_worker_threads.emplace_back([this, n]() {
+                util::ThreadRename(strprintf("inputfetch.%i", n));
+                Loop();
+            });
+        }
+    }
+
+    // Since this class manages its own resources, which is a thread
+    // pool `m_worker_threads`, copy and move operations are not appropriate.
+    InputFetcher(const InputFetcher&) = delete;
+    InputFetcher& operator=(const InputFetcher&) = delete;
+    InputFetcher(InputFetcher&&) = delete;
+    InputFetcher& operator=(InputFetcher&&) = delete;
+
+    ~InputFetcher()
+    {
+        WITH_LOCK(m_mutex, m_request_stop = true);
+        m_worker_cv.notify_all();
+        for (std::thread& t : m_worker_threads) {
+            t.join();
+        }
+    }
+
+    bool HasThreads() const { return !m_worker_threads.empty(); }
+
+    /**
+     * Read the coins spent by the block that are not in the cache yet from db
+     * and insert them into the cache. The cache must be backed by db, and db
+     * must not be written to during the call.
+     */
+    void FetchInputs(CCoinsViewCache& cache, const CCoinsView& db, const CBlock& block) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        if (!HasThreads()) return;
+
+        std::unordered_set<Txid, SaltedTxidHasher> block_txids;
+        block_txids.reserve(block.vtx.size());
+        m_outpoints.clear();
+        for (const auto& tx : block.vtx) {
+            if (!tx->IsCoinBase()) {
+                for (const CTxIn& txin : tx->vin) {
+                    const COutPoint& prevout{txin.prevout};
+                    if (block_txids.contains(prevout.hash) || cache.HaveCoinInCache(prevout)) continue;
+                    m_outpoints.push_back(prevout);
+                }
+            }
+            block_txids.insert(tx->GetHash());
+        }
+        if (m_outpoints.empty()) return;
+
+        m_coins.assign(m_outpoints.size(), std::nullopt);
+        m_db = &db;
+        m_next.store(0, std::memory_order_relaxed);
+        {
+            LOCK(m_mutex);
+            m_active = m_worker_threads.size();
+            ++m_round;
+        }
+        m_worker_cv.notify_all();
+        Work();
+        {
+            WAIT_LOCK(m_mutex, lock);
+            m_master_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_active == 0; });
+        }
+        m_db = nullptr;
+
+        for (size_t i{0}; i < m_outpoints.size(); ++i) {
+            if (m_coins[i]) cache.EmplaceFetchedCoin(m_outpoints[i], std::move(*m_coins[i]));
+        }
+        m_coins.clear();
+    }
+};
+
+#endif // BITCOIN_INPUTFETCHER_H
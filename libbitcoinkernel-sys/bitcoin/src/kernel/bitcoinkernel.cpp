@@ -6,47 +6,71 @@
 
 #include <kernel/bitcoinkernel.h>
 
+#include <arith_uint256.h>
 #include <chain.h>
 #include <coins.h>
 #include <consensus/amount.h>
 #include <consensus/validation.h>
+#include <cuckoocache.h>
 #include <kernel/caches.h>
 #include <kernel/chainparams.h>
 #include <kernel/checks.h>
+#include <kernel/coinstats.h>
 #include <kernel/context.h>
 #include <kernel/cs_main.h>
+#include <kernel/mempool_entry.h>
+#include <kernel/mempool_options.h>
+#include <kernel/mempool_removal_reason.h>
 #include <kernel/notifications_interface.h>
+#include <kernel/validation_stats.h>
 #include <kernel/warning.h>
 #include <logging.h>
 #include <node/blockstorage.h>
 #include <node/chainstate.h>
+#include <node/utxo_snapshot.h>
+#include <policy/packages.h>
+#include <pow.h>
 #include <primitives/block.h>
 #include <primitives/transaction.h>
+#include <scheduler.h>
 #include <script/interpreter.h>
 #include <script/script.h>
+#include <script/sigcache.h>
 #include <serialize.h>
 #include <streams.h>
 #include <sync.h>
 #include <tinyformat.h>
+#include <txdb.h>
+#include <txmempool.h>
 #include <uint256.h>
 #include <undo.h>
 #include <util/fs.h>
 #include <util/result.h>
 #include <util/signalinterrupt.h>
 #include <util/task_runner.h>
+#include <util/threadnames.h>
+#include <util/time.h>
 #include <util/translation.h>
 #include <validation.h>
 #include <validationinterface.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
 #include <cstddef>
 #include <cstring>
 #include <exception>
 #include <functional>
+#include <future>
 #include <list>
+#include <map>
 #include <memory>
+#include <optional>
 #include <span>
 #include <string>
+#include <system_error>
+#include <thread>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -142,6 +166,8 @@ struct Handle {
 struct btck_BlockTreeEntry: Handle<btck_BlockTreeEntry, CBlockIndex> {};
 struct btck_Block : Handle<btck_Block, std::shared_ptr<const CBlock>> {};
 struct btck_BlockValidationState : Handle<btck_BlockValidationState, BlockValidationState> {};
+struct btck_Transaction : Handle<btck_Transaction, std::shared_ptr<const CTransaction>> {};
+struct btck_ValidationStats : Handle<btck_ValidationStats, kernel::ValidationStats> {};
 
 namespace {
 
@@ -214,6 +240,22 @@ btck_SynchronizationState cast_state(SynchronizationState state)
     assert(false);
 }
 
+kernel::CoinStatsHashType get_coin_stats_hash_type(btck_UtxoSetHashType hash_type)
+{
+    switch (hash_type) {
+    case btck_UtxoSetHashType_HASH_SERIALIZED: {
+        return kernel::CoinStatsHashType::HASH_SERIALIZED;
+    }
+    case btck_UtxoSetHashType_MUHASH: {
+        return kernel::CoinStatsHashType::MUHASH;
+    }
+    case btck_UtxoSetHashType_NONE: {
+        return kernel::CoinStatsHashType::NONE;
+    }
+    }
+    assert(false);
+}
+
 btck_Warning cast_btck_warning(kernel::Warning warning)
 {
     switch (warning) {
@@ -225,6 +267,145 @@ btck_Warning cast_btck_warning(kernel::Warning warning)
     assert(false);
 }
 
+btck_ChainstateVerificationResult cast_verification_result(node::ChainstateLoadStatus status)
+{
+    switch (status) {
+    case node::ChainstateLoadStatus::SUCCESS:
+        return btck_ChainstateVerificationResult_SUCCESS;
+    case node::ChainstateLoadStatus::INTERRUPTED:
+        return btck_ChainstateVerificationResult_INTERRUPTED;
+    case node::ChainstateLoadStatus::FAILURE_INSUFFICIENT_DBCACHE:
+        return btck_ChainstateVerificationResult_INSUFFICIENT_DBCACHE;
+    case node::ChainstateLoadStatus::FAILURE:
+    case node::ChainstateLoadStatus::FAILURE_FATAL:
+    case node::ChainstateLoadStatus::FAILURE_INCOMPATIBLE_DB:
+        return btck_ChainstateVerificationResult_FAILURE;
+    } // no default case, so the compiler can warn about missing cases
+    assert(false);
+}
+
+SteadyClock::duration get_phase_time(const kernel::ValidationStats& stats, btck_ValidationPhase phase)
+{
+    switch (phase) {
+    case btck_ValidationPhase_LOAD_BLOCK:
+        return stats.time_load;
+    case btck_ValidationPhase_CHECK_BLOCK:
+        return stats.time_check;
+    case btck_ValidationPhase_FORK_CHECKS:
+        return stats.time_forks;
+    case btck_ValidationPhase_CONNECT_TRANSACTIONS:
+        return stats.time_connect;
+    case btck_ValidationPhase_VERIFY:
+        return stats.time_verify;
+    case btck_ValidationPhase_WRITE_UNDO:
+        return stats.time_undo;
+    case btck_ValidationPhase_WRITE_INDEX:
+        return stats.time_index;
+    case btck_ValidationPhase_CONNECT_BLOCK:
+        return stats.time_connect_total;
+    case btck_ValidationPhase_FLUSH_VIEW:
+        return stats.time_flush;
+    case btck_ValidationPhase_WRITE_CHAINSTATE:
+        return stats.time_chainstate;
+    case btck_ValidationPhase_POST_CONNECT:
+        return stats.time_post_connect;
+    case btck_ValidationPhase_TOTAL:
+        return stats.time_total;
+    }
+    assert(false);
+}
+
+btck_BlockValidationResult cast_block_validation_result(BlockValidationResult result)
+{
+    switch (result) {
+    case BlockValidationResult::BLOCK_RESULT_UNSET:
+        return btck_BlockValidationResult_UNSET;
+    case BlockValidationResult::BLOCK_CONSENSUS:
+        return btck_BlockValidationResult_CONSENSUS;
+    case BlockValidationResult::BLOCK_CACHED_INVALID:
+        return btck_BlockValidationResult_CACHED_INVALID;
+    case BlockValidationResult::BLOCK_INVALID_HEADER:
+        return btck_BlockValidationResult_INVALID_HEADER;
+    case BlockValidationResult::BLOCK_MUTATED:
+        return btck_BlockValidationResult_MUTATED;
+    case BlockValidationResult::BLOCK_MISSING_PREV:
+        return btck_BlockValidationResult_MISSING_PREV;
+    case BlockValidationResult::BLOCK_INVALID_PREV:
+        return btck_BlockValidationResult_INVALID_PREV;
+    case BlockValidationResult::BLOCK_TIME_FUTURE:
+        return btck_BlockValidationResult_TIME_FUTURE;
+    case BlockValidationResult::BLOCK_HEADER_LOW_WORK:
+        return btck_BlockValidationResult_HEADER_LOW_WORK;
+    } // no default case, so the compiler can warn about missing cases
+    assert(false);
+}
+
+btck_MempoolRemovalReason cast_mempool_removal_reason(MemPoolRemovalReason reason)
+{
+    switch (reason) {
+    case MemPoolRemovalReason::EXPIRY:
+        return btck_MempoolRemovalReason_EXPIRY;
+    case MemPoolRemovalReason::SIZELIMIT:
+        return btck_MempoolRemovalReason_SIZE_LIMIT;
+    case MemPoolRemovalReason::REORG:
+        return btck_MempoolRemovalReason_REORG;
+    case MemPoolRemovalReason::BLOCK:
+        return btck_MempoolRemovalReason_BLOCK;
+    case MemPoolRemovalReason::CONFLICT:
+        return btck_MempoolRemovalReason_CONFLICT;
+    case MemPoolRemovalReason::REPLACED:
+        return btck_MempoolRemovalReason_REPLACED;
+    } // no default case, so the compiler can warn about missing cases
+    assert(false);
+}
+
+btck_MempoolAcceptStatus cast_mempool_accept_status(MempoolAcceptResult::ResultType result_type)
+{
+    switch (result_type) {
+    case MempoolAcceptResult::ResultType::VALID:
+        return btck_MempoolAcceptStatus_ACCEPTED;
+    case MempoolAcceptResult::ResultType::MEMPOOL_ENTRY:
+    case MempoolAcceptResult::ResultType::DIFFERENT_WITNESS:
+        return btck_MempoolAcceptStatus_ALREADY_IN_MEMPOOL;
+    case MempoolAcceptResult::ResultType::INVALID:
+        return btck_MempoolAcceptStatus_REJECTED;
+    } // no default case, so the compiler can warn about missing cases
+    assert(false);
+}
+
+btck_TxValidationResult cast_tx_validation_result(TxValidationResult result)
+{
+    switch (result) {
+    case TxValidationResult::TX_RESULT_UNSET:
+        return btck_TxValidationResult_UNSET;
+    case TxValidationResult::TX_CONSENSUS:
+        return btck_TxValidationResult_CONSENSUS;
+    case TxValidationResult::TX_INPUTS_NOT_STANDARD:
+        return btck_TxValidationResult_INPUTS_NOT_STANDARD;
+    case TxValidationResult::TX_NOT_STANDARD:
+        return btck_TxValidationResult_NOT_STANDARD;
+    case TxValidationResult::TX_MISSING_INPUTS:
+        return btck_TxValidationResult_MISSING_INPUTS;
+    case TxValidationResult::TX_PREMATURE_SPEND:
+        return btck_TxValidationResult_PREMATURE_SPEND;
+    case TxValidationResult::TX_WITNESS_MUTATED:
+        return btck_TxValidationResult_WITNESS_MUTATED;
+    case TxValidationResult::TX_WITNESS_STRIPPED:
+        return btck_TxValidationResult_WITNESS_STRIPPED;
+    case TxValidationResult::TX_CONFLICT:
+        return btck_TxValidationResult_CONFLICT;
+    case TxValidationResult::TX_MEMPOOL_POLICY:
+        return btck_TxValidationResult_MEMPOOL_POLICY;
+    case TxValidationResult::TX_NO_MEMPOOL:
+        return btck_TxValidationResult_NO_MEMPOOL;
+    case TxValidationResult::TX_RECONSIDERABLE:
+        return btck_TxValidationResult_RECONSIDERABLE;
+    case TxValidationResult::TX_UNKNOWN:
+        return btck_TxValidationResult_UNKNOWN;
+    } // no default case, so the compiler can warn about missing cases
+    assert(false);
+}
+
 struct LoggingConnection {
     std::unique_ptr<std::list<std::function<void(const std::string&)>>::iterator> m_connection;
     void* m_user_data;
@@ -298,6 +479,18 @@ public:
         if (m_cbs.block_tip) m_cbs.block_tip(m_cbs.user_data, cast_state(state), btck_BlockTreeEntry::ref(&index), verification_progress);
         return {};
     }
+    void backgroundBlockTip(const CBlockIndex& index, double verification_progress) override
+    {
+        if (m_cbs.background_block_tip) m_cbs.background_block_tip(m_cbs.user_data, btck_BlockTreeEntry::ref(&index), verification_progress);
+    }
+    void blockConnectedStats(const CBlockIndex& index, const kernel::ValidationStats& stats) override
+    {
+        if (m_cbs.block_connected_stats) m_cbs.block_connected_stats(m_cbs.user_data, btck_BlockTreeEntry::ref(&index), btck_ValidationStats::ref(&stats));
+    }
+    void scriptChecks(const CBlockIndex& index, bool enabled, std::string_view reason) override
+    {
+        if (m_cbs.script_checks) m_cbs.script_checks(m_cbs.user_data, btck_BlockTreeEntry::ref(&index), enabled ? 1 : 0, reason.data(), reason.length());
+    }
     void headerTip(SynchronizationState state, int64_t height, int64_t timestamp, bool presync) override
     {
         if (m_cbs.header_tip) m_cbs.header_tip(m_cbs.user_data, cast_state(state), height, timestamp, presync ? 1 : 0);
@@ -322,6 +515,10 @@ public:
     {
         if (m_cbs.fatal_error) m_cbs.fatal_error(m_cbs.user_data, message.original.c_str(), message.original.length());
     }
+    void chainstateVerified(node::ChainstateLoadStatus status, const bilingual_str& message)
+    {
+        if (m_cbs.chainstate_verified) m_cbs.chainstate_verified(m_cbs.user_data, cast_verification_result(status), message.original.c_str(), message.original.length());
+    }
 };
 
 class KernelValidationInterface final : public CValidationInterface
@@ -376,6 +573,35 @@ protected:
                                      btck_BlockTreeEntry::ref(pindex));
         }
     }
+
+    void TransactionAddedToMempool(const NewMempoolTransactionInfo& tx, uint64_t mempool_sequence) override
+    {
+        if (m_cbs.transaction_added_to_mempool) {
+            m_cbs.transaction_added_to_mempool(m_cbs.user_data,
+                                               btck_Transaction::ref(new std::shared_ptr<const CTransaction>{tx.info.m_tx}));
+        }
+    }
+
+    void TransactionRemovedFromMempool(const CTransactionRef& tx, MemPoolRemovalReason reason, uint64_t mempool_sequence) override
+    {
+        if (m_cbs.transaction_removed_from_mempool) {
+            m_cbs.transaction_removed_from_mempool(m_cbs.user_data,
+                                                   btck_Transaction::ref(new std::shared_ptr<const CTransaction>{tx}),
+                                                   cast_mempool_removal_reason(reason));
+        }
+    }
+
+    void MempoolTransactionsRemovedForBlock(const std::vector<RemovedMempoolTransactionInfo>& txs_removed_for_block, unsigned int nBlockHeight) override
+    {
+        // Transactions included in a block are not announced through
+        // TransactionRemovedFromMempool, so announce them here.
+        if (!m_cbs.transaction_removed_from_mempool) return;
+        for (const auto& removed : txs_removed_for_block) {
+            m_cbs.transaction_removed_from_mempool(m_cbs.user_data,
+                                                   btck_Transaction::ref(new std::shared_ptr<const CTransaction>{removed.info.m_tx}),
+                                                   btck_MempoolRemovalReason_BLOCK);
+        }
+    }
 };
 
 struct ContextOptions {
@@ -383,6 +609,8 @@ struct ContextOptions {
     std::unique_ptr<const CChainParams> m_chainparams GUARDED_BY(m_mutex);
     std::shared_ptr<KernelNotifications> m_notifications GUARDED_BY(m_mutex);
     std::shared_ptr<KernelValidationInterface> m_validation_interface GUARDED_BY(m_mutex);
+    //! If non-zero, validation interface callbacks are delivered asynchronously with this queue depth.
+    size_t m_validation_queue_depth GUARDED_BY(m_mutex){0};
 };
 
 class Context
@@ -394,16 +622,21 @@ public:
 
     std::unique_ptr<util::SignalInterrupt> m_interrupt;
 
+    //! Only set if validation interface callbacks are delivered asynchronously.
+    //! Has to outlive m_signals, whose task runner holds a reference to it.
+    std::unique_ptr<CScheduler> m_scheduler;
+
     std::unique_ptr<ValidationSignals> m_signals;
 
     std::unique_ptr<const CChainParams> m_chainparams;
 
     std::shared_ptr<KernelValidationInterface> m_validation_interface;
 
+    size_t m_validation_queue_depth{0};
+
     Context(const ContextOptions* options, bool& sane)
         : m_context{std::make_unique<kernel::Context>()},
-          m_interrupt{std::make_unique<util::SignalInterrupt>()},
-          m_signals{std::make_unique<ValidationSignals>(std::make_unique<ImmediateTaskRunner>())}
+          m_interrupt{std::make_unique<util::SignalInterrupt>()}
     {
         if (options) {
             LOCK(options->m_mutex);
@@ -413,10 +646,22 @@ public:
             if (options->m_notifications) {
                 m_notifications = options->m_notifications;
             }
-            if (options->m_validation_interface) {
-                m_validation_interface = options->m_validation_interface;
-                m_signals->RegisterSharedValidationInterface(m_validation_interface);
-            }
+            m_validation_interface = options->m_validation_interface;
+            m_validation_queue_depth = options->m_validation_queue_depth;
+        }
+
+        if (m_validation_queue_depth > 0) {
+            m_scheduler = std::make_unique<CScheduler>();
+            m_scheduler->m_service_thread = std::thread([scheduler = m_scheduler.get()] {
+                util::ThreadRename("scheduler");
+                scheduler->serviceQueue();
+            });
+            m_signals = std::make_unique<ValidationSignals>(std::make_unique<SerialTaskRunner>(*m_scheduler));
+        } else {
+            m_signals = std::make_unique<ValidationSignals>(std::make_unique<ImmediateTaskRunner>());
+        }
+        if (m_validation_interface) {
+            m_signals->RegisterSharedValidationInterface(m_validation_interface);
         }
 
         if (!m_chainparams) {
@@ -424,7 +669,7 @@ public:
         }
         if (!m_notifications) {
             m_notifications = std::make_shared<KernelNotifications>(btck_NotificationInterfaceCallbacks{
-                nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr});
+                nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr});
         }
 
         if (!kernel::SanityChecks(*m_context)) {
@@ -434,6 +679,11 @@ public:
 
     ~Context()
     {
+        if (m_scheduler) {
+            // Stop the service thread and deliver any callbacks that are still queued.
+            m_scheduler->stop();
+            m_signals->FlushBackgroundCallbacks();
+        }
         m_signals->UnregisterSharedValidationInterface(m_validation_interface);
     }
 };
@@ -441,41 +691,300 @@ public:
 //! Helper struct to wrap the ChainstateManager-related Options
 struct ChainstateManagerOptions {
     mutable Mutex m_mutex;
+    kernel::CacheSizes m_cache_sizes GUARDED_BY(m_mutex){DEFAULT_KERNEL_CACHE};
     ChainstateManager::Options m_chainman_options GUARDED_BY(m_mutex);
     node::BlockManager::Options m_blockman_options GUARDED_BY(m_mutex);
     std::shared_ptr<const Context> m_context;
     node::ChainstateLoadOptions m_chainstate_load_options GUARDED_BY(m_mutex);
+    //! Whether the chainstate is verified on a thread after the chainstate
+    //! manager is created.
+    bool m_background_verification GUARDED_BY(m_mutex){false};
+    //! Whether the chainstate manager holds a mempool.
+    bool m_mempool GUARDED_BY(m_mutex){false};
 
     ChainstateManagerOptions(const std::shared_ptr<const Context>& context, const fs::path& data_dir, const fs::path& blocks_dir)
         : m_chainman_options{ChainstateManager::Options{
               .chainparams = *context->m_chainparams,
               .datadir = data_dir,
               .notifications = *context->m_notifications,
-              .signals = context->m_signals.get()}},
+              .signals = context->m_signals.get(),
+              .max_pending_validation_callbacks = context->m_validation_queue_depth > 0 ? context->m_validation_queue_depth : DEFAULT_MAX_PENDING_VALIDATION_CALLBACKS}},
           m_blockman_options{node::BlockManager::Options{
               .chainparams = *context->m_chainparams,
               .blocks_dir = blocks_dir,
               .notifications = *context->m_notifications,
               .block_tree_db_params = DBParams{
                   .path = data_dir / "blocks" / "index",
-                  .cache_bytes = kernel::CacheSizes{DEFAULT_KERNEL_CACHE}.block_tree_db,
+                  .cache_bytes = m_cache_sizes.block_tree_db,
               }}},
           m_context{context}, m_chainstate_load_options{node::ChainstateLoadOptions{}}
     {
     }
 };
 
+//! A mempool together with the chainstate manager whose active chainstate
+//! its transactions are validated against.
+struct Mempool {
+    CTxMemPool m_pool;
+    ChainstateManager* m_chainman{nullptr};
+
+    Mempool(CTxMemPool::Options opts, bilingual_str& error)
+        : m_pool{std::move(opts), error} {}
+};
+
 struct ChainMan {
+    //! Declared before the chainstate manager, whose chainstates reference
+    //! it, so it is destroyed after them.
+    std::unique_ptr<Mempool> m_mempool;
     std::unique_ptr<ChainstateManager> m_chainman;
     std::shared_ptr<const Context> m_context;
+    //! Whether the coins databases, including one of a loaded snapshot, are
+    //! kept in memory.
+    const bool m_coins_db_in_memory;
+    //! Verifies the chainstate and activates the best chain if background
+    //! verification is enabled. Joined before the chainstate is flushed.
+    std::thread m_verify_thread;
+
+    ChainMan(std::unique_ptr<Mempool> mempool, std::unique_ptr<ChainstateManager> chainman, std::shared_ptr<const Context> context, bool coins_db_in_memory)
+        : m_mempool(std::move(mempool)), m_chainman(std::move(chainman)), m_context(std::move(context)), m_coins_db_in_memory{coins_db_in_memory} {}
+};
+
+//! Verifies the blocks at the tip of the loaded chainstates and connects the
+//! best chain. If given, locked is set once cs_main is held for the
+//! verification.
+node::ChainstateLoadResult VerifyAndActivateChainstate(ChainstateManager& chainman, const node::ChainstateLoadOptions& options, std::promise<void>* locked = nullptr)
+{
+    node::ChainstateLoadResult result;
+    {
+        LOCK(chainman.GetMutex());
+        if (locked) locked->set_value();
+        result = node::VerifyLoadedChainstate(chainman, options);
+    }
+    if (std::get<0>(result) != node::ChainstateLoadStatus::SUCCESS) return result;
+
+    for (Chainstate* chainstate : WITH_LOCK(chainman.GetMutex(), return chainman.GetAll())) {
+        BlockValidationState state;
+        if (!chainstate->ActivateBestChain(state, nullptr)) {
+            return {node::ChainstateLoadStatus::FAILURE, Untranslated(strprintf("Failed to connect best block: %s", state.ToString()))};
+        }
+    }
+    return {node::ChainstateLoadStatus::SUCCESS, {}};
+}
+
+//! Reads a contiguous range of blocks, and optionally their undo data, on a
+//! pool of worker threads and hands them out in height order. At most
+//! m_max_in_flight blocks are read ahead of the one last handed out.
+class BlockReader
+{
+public:
+    struct Item {
+        const CBlockIndex* index;
+        //! Null if the block or its undo data could not be read.
+        std::shared_ptr<const CBlock> block;
+        std::shared_ptr<CBlockUndo> block_undo;
+    };
+
+private:
+    const node::BlockManager& m_blockman;
+    const std::vector<const CBlockIndex*> m_indexes;
+    const bool m_read_undo;
+    const size_t m_max_in_flight;
+
+    Mutex m_mutex;
+    std::condition_variable m_work_cv;
+    std::condition_variable m_ready_cv;
+    size_t m_next_dispatch GUARDED_BY(m_mutex){0};
+    size_t m_next_deliver GUARDED_BY(m_mutex){0};
+    std::map<size_t, Item> m_ready GUARDED_BY(m_mutex);
+    bool m_stop GUARDED_BY(m_mutex){false};
+    std::vector<std::thread> m_workers;
+
+    Item ReadItem(size_t pos) const
+    {
+        const CBlockIndex& index{*m_indexes[pos]};
+        Item item{.index = &index, .block = nullptr, .block_undo = nullptr};
+        auto block{std::make_shared<CBlock>()};
+        if (!m_blockman.ReadBlock(*block, index)) {
+            LogError("Failed to read block %s.", index.GetBlockHash().ToString());
+            return item;
+        }
+        if (m_read_undo) {
+            auto block_undo{std::make_shared<CBlockUndo>()};
+            if (index.nHeight > 0 && !m_blockman.ReadBlockUndo(*block_undo, index)) {
+                LogError("Failed to read spent outputs of block %s.", index.GetBlockHash().ToString());
+                return item;
+            }
+            item.block_undo = std::move(block_undo);
+        }
+        item.block = std::move(block);
+        return item;
+    }
+
+    void ThreadRead() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        while (true) {
+            m_work_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) {
+                return m_stop || (m_next_dispatch < m_indexes.size() && m_next_dispatch < m_next_deliver + m_max_in_flight);
+            });
+            if (m_stop) return;
+            const size_t pos{m_next_dispatch++};
+            Item item;
+            {
+                REVERSE_LOCK(lock, m_mutex);
+                item = ReadItem(pos);
+            }
+            m_ready.emplace(pos, std::move(item));
+            m_ready_cv.notify_all();
+        }
+    }
+
+    void Stop() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WITH_LOCK(m_mutex, m_stop = true);
+        m_work_cv.notify_all();
+        for (auto& worker : m_workers) {
+            worker.join();
+        }
+        m_workers.clear();
+    }
+
+public:
+    BlockReader(const node::BlockManager& blockman, std::vector<const CBlockIndex*> indexes, bool read_undo, size_t worker_threads, size_t max_in_flight)
+        : m_blockman{blockman}, m_indexes{std::move(indexes)}, m_read_undo{read_undo}, m_max_in_flight{max_in_flight}
+    {
+        m_workers.reserve(worker_threads);
+        try {
+            for (size_t n{0}; n < worker_threads; ++n) {
+                m_workers.emplace_back([this, n] {
+                    util::ThreadRename(strprintf("blockread.%i", n));
+                    ThreadRead();
+                });
+            }
+        } catch (const std::system_error&) {
+            // The destructor does not run for a throwing constructor, so stop the
+            // workers that were already started here.
+            Stop();
+            throw;
+        }
+    }
+
+    ~BlockReader()
+    {
+        Stop();
+    }
+
+    //! Returns the next item in height order, or nullopt once the range is exhausted.
+    std::optional<Item> Next() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        if (m_workers.empty()) {
+            const size_t pos{WITH_LOCK(m_mutex, return m_next_deliver < m_indexes.size() ? m_next_deliver++ : m_indexes.size())};
+            if (pos == m_indexes.size()) return std::nullopt;
+            return ReadItem(pos);
+        }
+        WAIT_LOCK(m_mutex, lock);
+        if (m_next_deliver == m_indexes.size()) return std::nullopt;
+        m_ready_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_ready.contains(m_next_deliver); });
+        auto node{m_ready.extract(m_next_deliver++)};
+        m_work_cv.notify_all();
+        return std::move(node.mapped());
+    }
+};
+
+//! Writes the coins cache of the chainstate to its database. Returns false if
+//! the database does not hold the coins of the tip afterwards.
+bool FlushCoinsToTip(Chainstate& chainstate) EXCLUSIVE_LOCKS_REQUIRED(::cs_main)
+{
+    chainstate.ForceFlushStateToDisk();
+    const CBlockIndex* tip{chainstate.m_chain.Tip()};
+    if (!tip || chainstate.CoinsDB().GetBestBlock() != tip->GetBlockHash()) {
+        LogError("Failed to write the coins of the chainstate to disk.");
+        return false;
+    }
+    return true;
+}
+
+//! Iterates over the coins database, split into shards of disjoint key
+//! ranges that can be iterated concurrently. The database iterators of all
+//! shards are created at once while cs_main is held, so they read the same
+//! state of the database.
+class CoinsCursor
+{
+public:
+    //! Shards are split by the first two bytes of the txid.
+    static constexpr size_t MAX_SHARDS{1 << 16};
+
+private:
+    struct Shard {
+        Mutex m_mutex;
+        std::unique_ptr<CCoinsViewCursor> m_cursor GUARDED_BY(m_mutex);
+        //! Exclusive end of the shard's range of txid prefixes.
+        uint32_t m_end;
+    };
+
+    Chainstate& m_chainstate;
+    const uint256 m_block_hash;
+    std::vector<std::unique_ptr<Shard>> m_shards;
+
+    static uint32_t Prefix(const Txid& txid)
+    {
+        return (uint32_t(txid.begin()[0]) << 8) | uint32_t(txid.begin()[1]);
+    }
+
+public:
+    CoinsCursor(Chainstate& chainstate, size_t shard_count) EXCLUSIVE_LOCKS_REQUIRED(::cs_main)
+        : m_chainstate{chainstate}, m_block_hash{chainstate.CoinsDB().GetBestBlock()}
+    {
+        const CCoinsViewDB& coins_db{chainstate.CoinsDB()};
+        m_shards.reserve(shard_count);
+        for (size_t i{0}; i < shard_count; ++i) {
+            const uint32_t begin(i * MAX_SHARDS / shard_count);
+            uint256 start;
+            start.data()[0] = begin >> 8;
+            start.data()[1] = begin & 0xff;
+            auto& shard{*m_shards.emplace_back(std::make_unique<Shard>())};
+            shard.m_end = (i + 1) * MAX_SHARDS / shard_count;
+            WITH_LOCK(shard.m_mutex, shard.m_cursor = coins_db.Cursor(COutPoint{Txid::FromUint256(start), 0}));
+        }
+        ++m_chainstate.m_coins_db_cursors;
+    }
 
-    ChainMan(std::unique_ptr<ChainstateManager> chainman, std::shared_ptr<const Context> context)
-        : m_chainman(std::move(chainman)), m_context(std::move(context)) {}
+    ~CoinsCursor()
+    {
+        m_shards.clear();
+        LOCK(::cs_main);
+        --m_chainstate.m_coins_db_cursors;
+    }
+
+    size_t ShardCount() const { return m_shards.size(); }
+
+    const uint256& GetBlockHash() const { return m_block_hash; }
+
+    //! Appends up to max_coins coins of the shard to coins, in database order.
+    //! Appends nothing once the shard is exhausted. Returns false if a coin
+    //! could not be read.
+    bool Next(size_t shard_index, size_t max_coins, std::vector<std::pair<COutPoint, Coin>>& coins)
+    {
+        Shard& shard{*m_shards.at(shard_index)};
+        LOCK(shard.m_mutex);
+        CCoinsViewCursor& cursor{*shard.m_cursor};
+        for (size_t i{0}; i < max_coins && cursor.Valid(); ++i) {
+            COutPoint outpoint;
+            if (!cursor.GetKey(outpoint) || Prefix(outpoint.hash) >= shard.m_end) break;
+            Coin coin;
+            if (!cursor.GetValue(coin)) {
+                LogError("Failed to read coin %s from the coins database.", outpoint.ToString());
+                return false;
+            }
+            coins.emplace_back(outpoint, std::move(coin));
+            cursor.Next();
+        }
+        return true;
+    }
 };
 
 } // namespace
 
-struct btck_Transaction : Handle<btck_Transaction, std::shared_ptr<const CTransaction>> {};
 struct btck_TransactionOutput : Handle<btck_TransactionOutput, CTxOut> {};
 struct btck_ScriptPubkey : Handle<btck_ScriptPubkey, CScript> {};
 struct btck_LoggingConnection : Handle<btck_LoggingConnection, LoggingConnection> {};
@@ -492,6 +1001,11 @@ struct btck_BlockHash : Handle<btck_BlockHash, uint256> {};
 struct btck_TransactionInput : Handle<btck_TransactionInput, CTxIn> {};
 struct btck_TransactionOutPoint: Handle<btck_TransactionOutPoint, COutPoint> {};
 struct btck_Txid: Handle<btck_Txid, Txid> {};
+struct btck_BlockReader : Handle<btck_BlockReader, BlockReader> {};
+struct btck_CoinsCursor : Handle<btck_CoinsCursor, CoinsCursor> {};
+struct btck_UtxoStats : Handle<btck_UtxoStats, kernel::CCoinsStats> {};
+struct btck_ValidationCacheStats : Handle<btck_ValidationCacheStats, CuckooCache::cache_stats> {};
+struct btck_Mempool : Handle<btck_Mempool, Mempool> {};
 
 btck_Transaction* btck_transaction_create(const void* raw_transaction, size_t raw_transaction_len)
 {
@@ -649,6 +1163,123 @@ int btck_script_pubkey_verify(const btck_ScriptPubkey* script_pubkey,
     return result ? 1 : 0;
 }
 
+namespace {
+
+//! Minimum number of input checks per additional thread. Starting a thread
+//! costs about as much as a few checks, so small batches are verified on the
+//! calling thread alone.
+constexpr size_t MIN_CHECKS_PER_THREAD{16};
+
+//! Verify all inputs of the passed in transactions. The signature hash data is
+//! precomputed once per transaction, and the input checks are then handed out
+//! to the calling thread and up to worker_threads additional threads.
+bool verify_all_inputs(std::span<const btck_Transaction* const> txs,
+                       std::span<const btck_TransactionOutput* const> spent_outputs_,
+                       const btck_ScriptVerificationFlags flags,
+                       const unsigned int worker_threads,
+                       std::span<int> results)
+{
+    std::vector<PrecomputedTransactionData> txdata(txs.size());
+    std::vector<std::pair<size_t, unsigned int>> checks;
+    checks.reserve(spent_outputs_.size());
+    size_t spent_outputs_pos{0};
+    for (size_t i = 0; i < txs.size(); ++i) {
+        const CTransaction& tx{*btck_Transaction::get(txs[i])};
+        assert(spent_outputs_pos + tx.vin.size() <= spent_outputs_.size());
+        std::vector<CTxOut> spent_outputs;
+        spent_outputs.reserve(tx.vin.size());
+        for (unsigned int input_index = 0; input_index < tx.vin.size(); ++input_index) {
+            spent_outputs.push_back(btck_TransactionOutput::get(spent_outputs_[spent_outputs_pos++]));
+            checks.emplace_back(i, input_index);
+        }
+        txdata[i].Init(tx, std::move(spent_outputs));
+    }
+    assert(spent_outputs_pos == spent_outputs_.size());
+    assert(results.size() == checks.size());
+
+    std::atomic<size_t> next_check{0};
+    std::atomic<bool> all_valid{true};
+    auto run_checks = [&] {
+        for (size_t pos; (pos = next_check.fetch_add(1, std::memory_order_relaxed)) < checks.size();) {
+            const auto [tx_index, input_index] = checks[pos];
+            const CTransaction& tx{*btck_Transaction::get(txs[tx_index])};
+            const CTxOut& spent_output{txdata[tx_index].m_spent_outputs[input_index]};
+            const bool valid{VerifyScript(tx.vin[input_index].scriptSig,
+                                          spent_output.scriptPubKey,
+                                          &tx.vin[input_index].scriptWitness,
+                                          script_verify_flags::from_int(flags),
+                                          TransactionSignatureChecker(&tx, input_index, spent_output.nValue, txdata[tx_index], MissingDataBehavior::FAIL),
+                                          nullptr)};
+            results[pos] = valid ? 1 : 0;
+            if (!valid) all_valid.store(false, std::memory_order_relaxed);
+        }
+    };
+
+    const size_t n_threads{std::min<size_t>({worker_threads, MAX_SCRIPTCHECK_THREADS, checks.size() / MIN_CHECKS_PER_THREAD})};
+    std::vector<std::thread> threads;
+    threads.reserve(n_threads);
+    for (size_t n = 0; n < n_threads; ++n) {
+        try {
+            threads.emplace_back([&run_checks, n]() {
+                util::ThreadRename(strprintf("verify.%i", n));
+                run_checks();
+            });
+        } catch (const std::system_error& e) {
+            // The calling thread picks up the remaining checks.
+            LogWarning("Failed to spawn script verification thread: %s", e.what());
+            break;
+        }
+    }
+    run_checks();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return all_valid.load();
+}
+
+} // namespace
+
+int btck_transaction_verify_all_inputs(const btck_Transaction* tx_to,
+                                       const btck_TransactionOutput** spent_outputs, size_t spent_outputs_len,
+                                       const btck_ScriptVerificationFlags flags,
+                                       const unsigned int worker_threads,
+                                       int* results, size_t results_len,
+                                       btck_ScriptVerifyStatus* status)
+{
+    assert(spent_outputs_len == btck_Transaction::get(tx_to)->vin.size());
+    return btck_transactions_verify_all_inputs(&tx_to, 1, spent_outputs, spent_outputs_len, flags, worker_threads, results, results_len, status);
+}
+
+int btck_transactions_verify_all_inputs(const btck_Transaction** txs, size_t txs_len,
+                                        const btck_TransactionOutput** spent_outputs, size_t spent_outputs_len,
+                                        const btck_ScriptVerificationFlags flags,
+                                        const unsigned int worker_threads,
+                                        int* results_, size_t results_len,
+                                        btck_ScriptVerifyStatus* status)
+{
+    // Assert that all specified flags are part of the interface before continuing
+    assert((flags & ~btck_ScriptVerificationFlags_ALL) == 0);
+
+    if (!is_valid_flag_combination(script_verify_flags::from_int(flags))) {
+        if (status) *status = btck_ScriptVerifyStatus_ERROR_INVALID_FLAGS_COMBINATION;
+        return 0;
+    }
+
+    if (status) *status = btck_ScriptVerifyStatus_OK;
+
+    std::vector<int> local_results;
+    std::span<int> results;
+    if (results_ != nullptr) {
+        assert(results_len == spent_outputs_len);
+        results = std::span{results_, results_len};
+    } else {
+        local_results.resize(spent_outputs_len);
+        results = local_results;
+    }
+
+    return verify_all_inputs(std::span{txs, txs_len}, std::span{spent_outputs, spent_outputs_len}, flags, worker_threads, results) ? 1 : 0;
+}
+
 btck_TransactionInput* btck_transaction_input_copy(const btck_TransactionInput* input)
 {
     return btck_TransactionInput::copy(input);
@@ -664,6 +1295,11 @@ void btck_transaction_input_destroy(btck_TransactionInput* input)
     delete input;
 }
 
+btck_TransactionOutPoint* btck_transaction_out_point_create(const btck_Txid* txid, uint32_t index)
+{
+    return btck_TransactionOutPoint::create(btck_Txid::get(txid), index);
+}
+
 btck_TransactionOutPoint* btck_transaction_out_point_copy(const btck_TransactionOutPoint* out_point)
 {
     return btck_TransactionOutPoint::copy(out_point);
@@ -684,6 +1320,11 @@ void btck_transaction_out_point_destroy(btck_TransactionOutPoint* out_point)
     delete out_point;
 }
 
+btck_Txid* btck_txid_create(const unsigned char txid[32])
+{
+    return btck_Txid::create(Txid::FromUint256(uint256{std::span<const unsigned char>{txid, 32}}));
+}
+
 btck_Txid* btck_txid_copy(const btck_Txid* txid)
 {
     return btck_Txid::copy(txid);
@@ -810,6 +1451,12 @@ void btck_context_options_set_validation_interface(btck_ContextOptions* options,
     btck_ContextOptions::get(options).m_validation_interface = std::make_shared<KernelValidationInterface>(vi_cbs);
 }
 
+void btck_context_options_set_validation_interface_queue_depth(btck_ContextOptions* options, size_t queue_depth)
+{
+    LOCK(btck_ContextOptions::get(options).m_mutex);
+    btck_ContextOptions::get(options).m_validation_queue_depth = queue_depth;
+}
+
 void btck_context_options_destroy(btck_ContextOptions* options)
 {
     delete options;
@@ -819,12 +1466,17 @@ btck_Context* btck_context_create(const btck_ContextOptions* options)
 {
     bool sane{true};
     const ContextOptions* opts = options ? &btck_ContextOptions::get(options) : nullptr;
-    auto context{std::make_shared<const Context>(opts, sane)};
-    if (!sane) {
-        LogError("Kernel context sanity check failed.");
+    try {
+        auto context{std::make_shared<const Context>(opts, sane)};
+        if (!sane) {
+            LogError("Kernel context sanity check failed.");
+            return nullptr;
+        }
+        return btck_Context::create(context);
+    } catch (const std::exception& e) {
+        LogError("Failed to create context: %s", e.what());
         return nullptr;
     }
-    return btck_Context::create(context);
 }
 
 btck_Context* btck_context_copy(const btck_Context* context)
@@ -837,6 +1489,11 @@ int btck_context_interrupt(btck_Context* context)
     return (*btck_Context::get(context)->m_interrupt)() ? 0 : -1;
 }
 
+void btck_context_sync_validation_interface_queue(const btck_Context* context)
+{
+    btck_Context::get(context)->m_signals->SyncWithValidationInterfaceQueue();
+}
+
 void btck_context_destroy(btck_Context* context)
 {
     delete context;
@@ -862,28 +1519,7 @@ btck_ValidationMode btck_block_validation_state_get_validation_mode(const btck_B
 
 btck_BlockValidationResult btck_block_validation_state_get_block_validation_result(const btck_BlockValidationState* block_validation_state_)
 {
-    auto& block_validation_state = btck_BlockValidationState::get(block_validation_state_);
-    switch (block_validation_state.GetResult()) {
-    case BlockValidationResult::BLOCK_RESULT_UNSET:
-        return btck_BlockValidationResult_UNSET;
-    case BlockValidationResult::BLOCK_CONSENSUS:
-        return btck_BlockValidationResult_CONSENSUS;
-    case BlockValidationResult::BLOCK_CACHED_INVALID:
-        return btck_BlockValidationResult_CACHED_INVALID;
-    case BlockValidationResult::BLOCK_INVALID_HEADER:
-        return btck_BlockValidationResult_INVALID_HEADER;
-    case BlockValidationResult::BLOCK_MUTATED:
-        return btck_BlockValidationResult_MUTATED;
-    case BlockValidationResult::BLOCK_MISSING_PREV:
-        return btck_BlockValidationResult_MISSING_PREV;
-    case BlockValidationResult::BLOCK_INVALID_PREV:
-        return btck_BlockValidationResult_INVALID_PREV;
-    case BlockValidationResult::BLOCK_TIME_FUTURE:
-        return btck_BlockValidationResult_TIME_FUTURE;
-    case BlockValidationResult::BLOCK_HEADER_LOW_WORK:
-        return btck_BlockValidationResult_HEADER_LOW_WORK;
-    } // no default case, so the compiler can warn about missing cases
-    assert(false);
+    return cast_block_validation_result(btck_BlockValidationState::get(block_validation_state_).GetResult());
 }
 
 btck_ChainstateManagerOptions* btck_chainstate_manager_options_create(const btck_Context* context, const char* data_dir, size_t data_dir_len, const char* blocks_dir, size_t blocks_dir_len)
@@ -902,8 +1538,10 @@ btck_ChainstateManagerOptions* btck_chainstate_manager_options_create(const btck
 
 void btck_chainstate_manager_options_set_worker_threads_num(btck_ChainstateManagerOptions* opts, int worker_threads)
 {
-    LOCK(btck_ChainstateManagerOptions::get(opts).m_mutex);
-    btck_ChainstateManagerOptions::get(opts).m_chainman_options.worker_threads_num = worker_threads;
+    auto& chainman_opts{btck_ChainstateManagerOptions::get(opts)};
+    LOCK(chainman_opts.m_mutex);
+    chainman_opts.m_chainman_options.worker_threads_num = worker_threads;
+    chainman_opts.m_chainman_options.input_fetch_threads_num = worker_threads;
 }
 
 void btck_chainstate_manager_options_destroy(btck_ChainstateManagerOptions* options)
@@ -942,52 +1580,225 @@ void btck_chainstate_manager_options_update_chainstate_db_in_memory(
     opts.m_chainstate_load_options.coins_db_in_memory = chainstate_db_in_memory == 1;
 }
 
-btck_ChainstateManager* btck_chainstate_manager_create(
-    const btck_ChainstateManagerOptions* chainman_opts)
+void btck_chainstate_manager_options_set_cache_size(
+    btck_ChainstateManagerOptions* chainman_opts,
+    size_t total_cache_bytes)
 {
     auto& opts{btck_ChainstateManagerOptions::get(chainman_opts)};
-    std::unique_ptr<ChainstateManager> chainman;
-    try {
-        LOCK(opts.m_mutex);
-        chainman = std::make_unique<ChainstateManager>(*opts.m_context->m_interrupt, opts.m_chainman_options, opts.m_blockman_options);
-    } catch (const std::exception& e) {
-        LogError("Failed to create chainstate manager: %s", e.what());
-        return nullptr;
-    }
-
-    try {
-        const auto chainstate_load_opts{WITH_LOCK(opts.m_mutex, return opts.m_chainstate_load_options)};
-
-        kernel::CacheSizes cache_sizes{DEFAULT_KERNEL_CACHE};
-        auto [status, chainstate_err]{node::LoadChainstate(*chainman, cache_sizes, chainstate_load_opts)};
-        if (status != node::ChainstateLoadStatus::SUCCESS) {
-            LogError("Failed to load chain state from your data directory: %s", chainstate_err.original);
-            return nullptr;
-        }
-        std::tie(status, chainstate_err) = node::VerifyLoadedChainstate(*chainman, chainstate_load_opts);
-        if (status != node::ChainstateLoadStatus::SUCCESS) {
-            LogError("Failed to verify loaded chain state from your datadir: %s", chainstate_err.original);
-            return nullptr;
-        }
-
-        for (Chainstate* chainstate : WITH_LOCK(chainman->GetMutex(), return chainman->GetAll())) {
-            BlockValidationState state;
-            if (!chainstate->ActivateBestChain(state, nullptr)) {
-                LogError("Failed to connect best block: %s", state.ToString());
-                return nullptr;
-            }
-        }
-    } catch (const std::exception& e) {
-        LogError("Failed to load chainstate: %s", e.what());
-        return nullptr;
-    }
-
-    return btck_ChainstateManager::create(std::move(chainman), opts.m_context);
+    LOCK(opts.m_mutex);
+    opts.m_cache_sizes = kernel::CacheSizes{total_cache_bytes};
+    opts.m_blockman_options.block_tree_db_params.cache_bytes = opts.m_cache_sizes.block_tree_db;
 }
 
-const btck_BlockTreeEntry* btck_chainstate_manager_get_block_tree_entry_by_hash(const btck_ChainstateManager* chainman, const btck_BlockHash* block_hash)
+int btck_chainstate_manager_options_set_cache_sizes(
+    btck_ChainstateManagerOptions* chainman_opts,
+    size_t block_tree_db_bytes,
+    size_t coins_db_bytes,
+    size_t coins_bytes)
 {
-    auto block_index = WITH_LOCK(btck_ChainstateManager::get(chainman).m_chainman->GetMutex(),
+    if (coins_db_bytes == 0 || coins_bytes == 0) {
+        LogError("The coins database and coins cache sizes must be non-zero.");
+        return -1;
+    }
+    auto& opts{btck_ChainstateManagerOptions::get(chainman_opts)};
+    LOCK(opts.m_mutex);
+    opts.m_cache_sizes.block_tree_db = block_tree_db_bytes;
+    opts.m_cache_sizes.coins_db = coins_db_bytes;
+    opts.m_cache_sizes.coins = coins_bytes;
+    opts.m_blockman_options.block_tree_db_params.cache_bytes = block_tree_db_bytes;
+    return 0;
+}
+
+void btck_chainstate_manager_options_set_validation_cache_sizes(
+    btck_ChainstateManagerOptions* chainman_opts,
+    size_t signature_cache_bytes,
+    size_t script_execution_cache_bytes)
+{
+    auto& opts{btck_ChainstateManagerOptions::get(chainman_opts)};
+    LOCK(opts.m_mutex);
+    opts.m_chainman_options.signature_cache_bytes = signature_cache_bytes;
+    opts.m_chainman_options.script_execution_cache_bytes = script_execution_cache_bytes;
+}
+
+void btck_chainstate_manager_options_set_assumed_valid_block(btck_ChainstateManagerOptions* chainman_opts, const btck_BlockHash* block_hash)
+{
+    auto& opts{btck_ChainstateManagerOptions::get(chainman_opts)};
+    LOCK(opts.m_mutex);
+    opts.m_chainman_options.assumed_valid_block = block_hash ? btck_BlockHash::get(block_hash) : uint256{};
+}
+
+void btck_chainstate_manager_options_set_minimum_chain_work(btck_ChainstateManagerOptions* chainman_opts, const unsigned char minimum_chain_work[32])
+{
+    auto& opts{btck_ChainstateManagerOptions::get(chainman_opts)};
+    LOCK(opts.m_mutex);
+    opts.m_chainman_options.minimum_chain_work = UintToArith256(uint256{std::span<const unsigned char>{minimum_chain_work, 32}});
+}
+
+void btck_chainstate_manager_options_set_background_coins_flush(btck_ChainstateManagerOptions* chainman_opts, int background_coins_flush)
+{
+    auto& opts{btck_ChainstateManagerOptions::get(chainman_opts)};
+    LOCK(opts.m_mutex);
+    opts.m_chainman_options.coins_view.background_flush = background_coins_flush == 1;
+}
+
+void btck_chainstate_manager_options_set_compact_coins_cache(btck_ChainstateManagerOptions* chainman_opts, int compact_coins_cache)
+{
+    auto& opts{btck_ChainstateManagerOptions::get(chainman_opts)};
+    LOCK(opts.m_mutex);
+    opts.m_chainman_options.coins_view.compact_cache = compact_coins_cache == 1;
+}
+
+int btck_chainstate_manager_options_set_prune_target(btck_ChainstateManagerOptions* chainman_opts, uint64_t prune_target_bytes)
+{
+    if (prune_target_bytes != 0 && prune_target_bytes != node::BlockManager::PRUNE_TARGET_MANUAL &&
+        prune_target_bytes < MIN_DISK_SPACE_FOR_BLOCK_FILES) {
+        LogError("The prune target must be at least %d MiB.", MIN_DISK_SPACE_FOR_BLOCK_FILES / 1024 / 1024);
+        return -1;
+    }
+    auto& opts{btck_ChainstateManagerOptions::get(chainman_opts)};
+    LOCK(opts.m_mutex);
+    opts.m_blockman_options.prune_target = prune_target_bytes;
+    // A block tree that was pruned before is only loaded in prune mode.
+    opts.m_chainstate_load_options.prune = prune_target_bytes != 0;
+    return 0;
+}
+
+void btck_chainstate_manager_options_set_fast_prune(btck_ChainstateManagerOptions* chainman_opts, int fast_prune)
+{
+    auto& opts{btck_ChainstateManagerOptions::get(chainman_opts)};
+    LOCK(opts.m_mutex);
+    opts.m_blockman_options.fast_prune = fast_prune == 1;
+}
+
+void btck_chainstate_manager_options_set_check_blocks(btck_ChainstateManagerOptions* chainman_opts, int64_t check_blocks)
+{
+    auto& opts{btck_ChainstateManagerOptions::get(chainman_opts)};
+    LOCK(opts.m_mutex);
+    opts.m_chainstate_load_options.check_blocks = check_blocks;
+}
+
+int btck_chainstate_manager_options_set_check_level(btck_ChainstateManagerOptions* chainman_opts, int check_level)
+{
+    if (check_level < 0 || check_level > 4) {
+        LogError("The check level must be between 0 and 4.");
+        return -1;
+    }
+    auto& opts{btck_ChainstateManagerOptions::get(chainman_opts)};
+    LOCK(opts.m_mutex);
+    opts.m_chainstate_load_options.check_level = check_level;
+    return 0;
+}
+
+void btck_chainstate_manager_options_set_require_full_verification(btck_ChainstateManagerOptions* chainman_opts, int require_full_verification)
+{
+    auto& opts{btck_ChainstateManagerOptions::get(chainman_opts)};
+    LOCK(opts.m_mutex);
+    opts.m_chainstate_load_options.require_full_verification = require_full_verification == 1;
+}
+
+void btck_chainstate_manager_options_set_background_verification(btck_ChainstateManagerOptions* chainman_opts, int background_verification)
+{
+    auto& opts{btck_ChainstateManagerOptions::get(chainman_opts)};
+    LOCK(opts.m_mutex);
+    opts.m_background_verification = background_verification == 1;
+}
+
+void btck_chainstate_manager_options_set_block_index_snapshot(btck_ChainstateManagerOptions* chainman_opts, int block_index_snapshot)
+{
+    auto& opts{btck_ChainstateManagerOptions::get(chainman_opts)};
+    LOCK(opts.m_mutex);
+    opts.m_blockman_options.block_index_snapshot = block_index_snapshot == 1;
+}
+
+void btck_chainstate_manager_options_set_mempool(btck_ChainstateManagerOptions* chainman_opts, int mempool)
+{
+    auto& opts{btck_ChainstateManagerOptions::get(chainman_opts)};
+    LOCK(opts.m_mutex);
+    opts.m_mempool = mempool == 1;
+}
+
+btck_ChainstateManager* btck_chainstate_manager_create(
+    const btck_ChainstateManagerOptions* chainman_opts)
+{
+    auto& opts{btck_ChainstateManagerOptions::get(chainman_opts)};
+    std::unique_ptr<ChainstateManager> chainman;
+    try {
+        LOCK(opts.m_mutex);
+        chainman = std::make_unique<ChainstateManager>(*opts.m_context->m_interrupt, opts.m_chainman_options, opts.m_blockman_options);
+    } catch (const std::exception& e) {
+        LogError("Failed to create chainstate manager: %s", e.what());
+        return nullptr;
+    }
+
+    auto chainstate_load_opts{WITH_LOCK(opts.m_mutex, return opts.m_chainstate_load_options)};
+    const bool background_verification{WITH_LOCK(opts.m_mutex, return opts.m_background_verification)};
+    std::unique_ptr<Mempool> mempool;
+    if (WITH_LOCK(opts.m_mutex, return opts.m_mempool)) {
+        bilingual_str error;
+        mempool = std::make_unique<Mempool>(CTxMemPool::Options{.signals = opts.m_context->m_signals.get()}, error);
+        if (!error.empty()) {
+            LogError("Failed to create mempool: %s", error.original);
+            return nullptr;
+        }
+        mempool->m_chainman = chainman.get();
+        chainstate_load_opts.mempool = &mempool->m_pool;
+    }
+    try {
+        const auto cache_sizes{WITH_LOCK(opts.m_mutex, return opts.m_cache_sizes)};
+
+        auto [status, chainstate_err]{node::LoadChainstate(*chainman, cache_sizes, chainstate_load_opts)};
+        if (status != node::ChainstateLoadStatus::SUCCESS) {
+            LogError("Failed to load chain state from your data directory: %s", chainstate_err.original);
+            return nullptr;
+        }
+        if (!background_verification) {
+            std::tie(status, chainstate_err) = VerifyAndActivateChainstate(*chainman, chainstate_load_opts);
+            if (status != node::ChainstateLoadStatus::SUCCESS) {
+                LogError("Failed to verify loaded chain state from your datadir: %s", chainstate_err.original);
+                return nullptr;
+            }
+        }
+    } catch (const std::exception& e) {
+        LogError("Failed to load chainstate: %s", e.what());
+        return nullptr;
+    }
+
+    auto result{btck_ChainstateManager::create(std::move(mempool), std::move(chainman), opts.m_context, chainstate_load_opts.coins_db_in_memory)};
+    if (background_verification) {
+        auto& chainman_wrapper{btck_ChainstateManager::get(result)};
+        // The verification expects the tip to be the one of the coins
+        // database, so the chainstate manager is only returned once the
+        // verification holds cs_main, and blocks are processed after it.
+        std::promise<void> locked;
+        auto verification_locked{locked.get_future()};
+        try {
+            chainman_wrapper.m_verify_thread = std::thread([&chainman_wrapper, chainstate_load_opts, locked = std::move(locked)]() mutable {
+                util::ThreadRename("verifydb");
+                node::ChainstateLoadResult verify_result;
+                try {
+                    verify_result = VerifyAndActivateChainstate(*chainman_wrapper.m_chainman, chainstate_load_opts, &locked);
+                } catch (const std::exception& e) {
+                    verify_result = {node::ChainstateLoadStatus::FAILURE, Untranslated(e.what())};
+                }
+                const auto& [status, error]{verify_result};
+                if (status != node::ChainstateLoadStatus::SUCCESS) {
+                    LogError("Failed to verify loaded chain state from your datadir: %s", error.original);
+                }
+                chainman_wrapper.m_context->m_notifications->chainstateVerified(status, error);
+            });
+        } catch (const std::system_error& e) {
+            LogError("Failed to spawn chainstate verification thread: %s", e.what());
+            btck_chainstate_manager_destroy(result);
+            return nullptr;
+        }
+        verification_locked.wait();
+    }
+    return result;
+}
+
+const btck_BlockTreeEntry* btck_chainstate_manager_get_block_tree_entry_by_hash(const btck_ChainstateManager* chainman, const btck_BlockHash* block_hash)
+{
+    auto block_index = WITH_LOCK(btck_ChainstateManager::get(chainman).m_chainman->GetMutex(),
                                  return btck_ChainstateManager::get(chainman).m_chainman->m_blockman.LookupBlockIndex(btck_BlockHash::get(block_hash)));
     if (!block_index) {
         LogDebug(BCLog::KERNEL, "A block with the given hash is not indexed.");
@@ -996,8 +1807,251 @@ const btck_BlockTreeEntry* btck_chainstate_manager_get_block_tree_entry_by_hash(
     return btck_BlockTreeEntry::ref(block_index);
 }
 
+const btck_BlockTreeEntry* btck_chainstate_manager_process_headers(btck_ChainstateManager* chainman, const void* headers, size_t headers_len, btck_BlockValidationResult* result)
+{
+    if (result) *result = btck_BlockValidationResult_UNSET;
+    constexpr size_t header_size{80};
+    if (headers_len % header_size != 0) {
+        LogError("Headers buffer length %d is not a multiple of the header size.", headers_len);
+        return nullptr;
+    }
+    std::vector<CBlockHeader> block_headers(headers_len / header_size);
+    SpanReader reader{std::span{reinterpret_cast<const std::byte*>(headers), headers_len}};
+    try {
+        for (CBlockHeader& header : block_headers) {
+            reader >> header;
+        }
+    } catch (const std::exception& e) {
+        LogError("Failed to deserialize block headers: %s", e.what());
+        return nullptr;
+    }
+    BlockValidationState state;
+    const CBlockIndex* last_accepted{nullptr};
+    if (!btck_ChainstateManager::get(chainman).m_chainman->ProcessNewBlockHeaders(block_headers, /*min_pow_checked=*/true, state, &last_accepted)) {
+        LogDebug(BCLog::KERNEL, "Block header rejected: %s", state.ToString());
+        if (result) *result = cast_block_validation_result(state.GetResult());
+    }
+    return last_accepted ? btck_BlockTreeEntry::ref(last_accepted) : nullptr;
+}
+
+int btck_chainstate_manager_get_coins(const btck_ChainstateManager* chainman, const btck_TransactionOutPoint* const* outpoints, size_t outpoints_len, btck_Coin** coins)
+{
+    auto& chainman_ref{*btck_ChainstateManager::get(chainman).m_chainman};
+    std::vector<std::optional<Coin>> results(outpoints_len);
+    try {
+        LOCK(chainman_ref.GetMutex());
+        Chainstate& chainstate{chainman_ref.ActiveChainstate()};
+        if (!chainstate.CanFlushToDisk()) {
+            LogError("The coins of the chainstate are not loaded.");
+            return -1;
+        }
+        const CCoinsViewCache& coins_tip{chainstate.CoinsTip()};
+        // Indices of the outpoints that are not in the cache.
+        std::vector<size_t> misses;
+        for (size_t i{0}; i < outpoints_len; ++i) {
+            if (const Coin* coin{coins_tip.GetCoinInCache(btck_TransactionOutPoint::get(outpoints[i]))}) {
+                if (!coin->IsSpent()) results[i] = *coin;
+            } else {
+                misses.push_back(i);
+            }
+        }
+        // Read the misses in key order, so that neighbouring coins are read
+        // from the same database blocks. They are read through the view
+        // below the cache, which also holds the coins that are still being
+        // written to the database in the background.
+        std::sort(misses.begin(), misses.end(), [&](size_t a, size_t b) {
+            return btck_TransactionOutPoint::get(outpoints[a]) < btck_TransactionOutPoint::get(outpoints[b]);
+        });
+        const CCoinsView& coins_base{chainstate.CoinsCacheBase()};
+        for (size_t i : misses) {
+            results[i] = coins_base.GetCoin(btck_TransactionOutPoint::get(outpoints[i]));
+        }
+    } catch (const std::exception& e) {
+        LogError("Failed to look up coins: %s", e.what());
+        return -1;
+    }
+    for (size_t i{0}; i < outpoints_len; ++i) {
+        coins[i] = results[i] ? btck_Coin::create(std::move(*results[i])) : nullptr;
+    }
+    return 0;
+}
+
+int btck_chainstate_manager_resize_caches(btck_ChainstateManager* chainman, size_t coins_db_bytes, size_t coins_bytes)
+{
+    if (coins_db_bytes == 0 || coins_bytes == 0) {
+        LogError("The coins database and coins cache sizes must be non-zero.");
+        return -1;
+    }
+    auto& chainman_ref{*btck_ChainstateManager::get(chainman).m_chainman};
+    try {
+        LOCK(chainman_ref.GetMutex());
+        for (const Chainstate* chainstate : chainman_ref.GetAll()) {
+            if (chainstate->m_coins_db_cursors > 0) {
+                LogError("The coins caches cannot be resized while a coins cursor exists.");
+                return -1;
+            }
+        }
+        chainman_ref.m_total_coinsdb_cache = coins_db_bytes;
+        chainman_ref.m_total_coinstip_cache = coins_bytes;
+        const auto chainstates{chainman_ref.GetAll()};
+        if (chainstates.size() == 1) {
+            // Resize directly to surface a failed flush to the caller.
+            return chainstates.front()->ResizeCoinsCaches(coins_bytes, coins_db_bytes) ? 0 : -1;
+        }
+        chainman_ref.MaybeRebalanceCaches();
+    } catch (const std::exception& e) {
+        LogError("Failed to resize coins caches: %s", e.what());
+        return -1;
+    }
+    return 0;
+}
+
+int btck_chainstate_manager_load_snapshot(btck_ChainstateManager* chainman, const char* path, size_t path_len)
+{
+    auto& chainman_wrapper{btck_ChainstateManager::get(chainman)};
+    auto& chainman_ref{*chainman_wrapper.m_chainman};
+    try {
+        const fs::path snapshot_path{fs::PathFromString({path, path_len})};
+        AutoFile afile{fsbridge::fopen(snapshot_path, "rb")};
+        if (afile.IsNull()) {
+            LogError("Failed to open snapshot file %s.", fs::PathToString(snapshot_path));
+            return -1;
+        }
+        node::SnapshotMetadata metadata{chainman_ref.GetParams().MessageStart()};
+        afile >> metadata;
+        auto result{chainman_ref.ActivateSnapshot(afile, metadata, chainman_wrapper.m_coins_db_in_memory)};
+        if (!result) {
+            LogError("Failed to load snapshot: %s", util::ErrorString(result).original);
+            return -1;
+        }
+    } catch (const std::exception& e) {
+        LogError("Failed to load snapshot: %s", e.what());
+        return -1;
+    }
+    return 0;
+}
+
+int btck_chainstate_manager_dump_snapshot(btck_ChainstateManager* chainman, const char* path, size_t path_len)
+{
+    auto& chainman_ref{*btck_ChainstateManager::get(chainman).m_chainman};
+    const fs::path snapshot_path{fs::PathFromString({path, path_len})};
+    const fs::path temp_path{snapshot_path + ".incomplete"};
+
+    Chainstate* cursor_chainstate{nullptr};
+    std::unique_ptr<CCoinsViewCursor> cursor;
+    uint256 base_hash;
+    try {
+        if (fs::exists(snapshot_path)) {
+            LogError("The snapshot file %s already exists.", fs::PathToString(snapshot_path));
+            return -1;
+        }
+        // The cursor iterates over a snapshot of the coins database, so it
+        // is only created under the lock, right after flushing, and blocks
+        // can be processed while the coins are written.
+        LOCK(chainman_ref.GetMutex());
+        Chainstate& chainstate{chainman_ref.ActiveChainstate()};
+        if (!chainstate.CanFlushToDisk()) {
+            LogError("The coins of the chainstate are not loaded.");
+            return -1;
+        }
+        if (!FlushCoinsToTip(chainstate)) return -1;
+        cursor = chainstate.CoinsDB().Cursor();
+        base_hash = chainstate.CoinsDB().GetBestBlock();
+        cursor_chainstate = &chainstate;
+        ++chainstate.m_coins_db_cursors;
+    } catch (const std::exception& e) {
+        LogError("Failed to dump snapshot: %s", e.what());
+        return -1;
+    }
+
+    int result{0};
+    try {
+        AutoFile afile{fsbridge::fopen(temp_path, "wb")};
+        if (afile.IsNull()) {
+            throw std::runtime_error(strprintf("failed to open %s", fs::PathToString(temp_path)));
+        }
+        // The number of coins is only known once they are written, so the
+        // metadata is written again at the end.
+        afile << node::SnapshotMetadata{chainman_ref.GetParams().MessageStart(), base_hash, 0};
+        const uint64_t coins_count{node::WriteSnapshotCoins(afile, *cursor, [&chainman_ref] {
+            if (chainman_ref.m_interrupt) throw std::runtime_error("interrupted");
+        })};
+        afile.seek(0, SEEK_SET);
+        afile << node::SnapshotMetadata{chainman_ref.GetParams().MessageStart(), base_hash, coins_count};
+        if (!afile.Commit() || afile.fclose() != 0) {
+            throw std::runtime_error(strprintf("failed to write %s", fs::PathToString(temp_path)));
+        }
+        fs::rename(temp_path, snapshot_path);
+    } catch (const std::exception& e) {
+        LogError("Failed to dump snapshot: %s", e.what());
+        std::error_code ec;
+        fs::remove(temp_path, ec);
+        result = -1;
+    }
+    cursor.reset();
+    WITH_LOCK(chainman_ref.GetMutex(), --cursor_chainstate->m_coins_db_cursors);
+    return result;
+}
+
+int btck_chainstate_manager_set_prune_lock(btck_ChainstateManager* chainman, const char* name, size_t name_len, int32_t height)
+{
+    if (height < 0) {
+        LogError("The prune lock height must not be negative.");
+        return -1;
+    }
+    auto& chainman_ref{*btck_ChainstateManager::get(chainman).m_chainman};
+    LOCK(chainman_ref.GetMutex());
+    chainman_ref.m_blockman.UpdatePruneLock({name, name_len}, node::PruneLockInfo{.height_first = height});
+    return 0;
+}
+
+int btck_chainstate_manager_delete_prune_lock(btck_ChainstateManager* chainman, const char* name, size_t name_len)
+{
+    auto& chainman_ref{*btck_ChainstateManager::get(chainman).m_chainman};
+    LOCK(chainman_ref.GetMutex());
+    return chainman_ref.m_blockman.DeletePruneLock({name, name_len}) ? 0 : -1;
+}
+
+int btck_chainstate_manager_prune_to_height(btck_ChainstateManager* chainman, int32_t height)
+{
+    auto& chainman_ref{*btck_ChainstateManager::get(chainman).m_chainman};
+    if (!chainman_ref.m_blockman.IsPruneMode()) {
+        LogError("Pruning is not enabled.");
+        return -1;
+    }
+    LOCK(chainman_ref.GetMutex());
+    auto& chainstate{chainman_ref.ActiveChainstate()};
+    const int chain_height{chainstate.m_chain.Height()};
+    if (chain_height < 0 || static_cast<uint64_t>(chain_height) < chainman_ref.GetParams().PruneAfterHeight()) {
+        LogError("The chain is too short for pruning.");
+        return -1;
+    }
+    if (height < 0 || height > chain_height) {
+        LogError("The prune height %d is not within the active chain.", height);
+        return -1;
+    }
+    // Always keep the blocks close to the tip, which may still be reorged.
+    height = std::min(height, chain_height - static_cast<int>(MIN_BLOCKS_TO_KEEP));
+    if (height <= 0) return 0;
+
+    BlockValidationState state;
+    if (!chainstate.FlushStateToDisk(state, FlushStateMode::NONE, height)) {
+        LogError("Failed to prune block files: %s", state.ToString());
+        return -1;
+    }
+    return 0;
+}
+
 void btck_chainstate_manager_destroy(btck_ChainstateManager* chainman)
 {
+    if (btck_ChainstateManager::get(chainman).m_verify_thread.get_id() == std::this_thread::get_id()) {
+        // The verification thread cannot join itself.
+        LogError("The chainstate manager must not be destroyed from its chainstate_verified notification.");
+        return;
+    }
+    if (btck_ChainstateManager::get(chainman).m_verify_thread.joinable()) {
+        btck_ChainstateManager::get(chainman).m_verify_thread.join();
+    }
     {
         LOCK(btck_ChainstateManager::get(chainman).m_chainman->GetMutex());
         for (Chainstate* chainstate : btck_ChainstateManager::get(chainman).m_chainman->GetAll()) {
@@ -1006,6 +2060,14 @@ void btck_chainstate_manager_destroy(btck_ChainstateManager* chainman)
                 chainstate->ResetCoinsViews();
             }
         }
+        if (!btck_ChainstateManager::get(chainman).m_chainman->m_blockman.WriteBlockIndexSnapshot()) {
+            LogError("Failed to write the block index snapshot.");
+        }
+    }
+    // Queued callbacks may still reference block tree entries owned by the
+    // chainstate manager, so deliver them before it is destroyed.
+    if (btck_ChainstateManager::get(chainman).m_context->m_scheduler) {
+        btck_ChainstateManager::get(chainman).m_context->m_signals->SyncWithValidationInterfaceQueue();
     }
 
     delete chainman;
@@ -1093,6 +2155,63 @@ btck_Block* btck_block_read(const btck_ChainstateManager* chainman, const btck_B
     return btck_Block::create(block);
 }
 
+namespace {
+bool check_raw_block_header(std::span<const std::byte> raw_block, const CBlockIndex& index, const Consensus::Params& consensus)
+{
+    CBlockHeader header;
+    try {
+        SpanReader{raw_block} >> header;
+    } catch (const std::exception& e) {
+        LogError("Failed to deserialize block header: %s", e.what());
+        return false;
+    }
+    const auto block_hash{header.GetHash()};
+    if (block_hash != index.GetBlockHash() || !CheckProofOfWork(block_hash, header.nBits, consensus)) {
+        LogError("Errors in block header of block %s", index.GetBlockHash().ToString());
+        return false;
+    }
+    return true;
+}
+} // namespace
+
+int btck_block_read_raw(const btck_ChainstateManager* chainman, const btck_BlockTreeEntry* entry, int check_header, btck_WriteBytes writer, void* user_data)
+{
+    const auto& chainman_ref{*btck_ChainstateManager::get(chainman).m_chainman};
+    const auto& block_index{btck_BlockTreeEntry::get(entry)};
+    const FlatFilePos block_pos{WITH_LOCK(chainman_ref.GetMutex(), return block_index.GetBlockPos())};
+    std::vector<std::byte> raw_block;
+    if (!chainman_ref.m_blockman.ReadRawBlock(raw_block, block_pos)) {
+        LogError("Failed to read block.");
+        return -1;
+    }
+    if (check_header == 1 && !check_raw_block_header(raw_block, block_index, chainman_ref.GetConsensus())) {
+        return -1;
+    }
+    return writer(raw_block.data(), raw_block.size(), user_data) == 0 ? 0 : -1;
+}
+
+int btck_block_read_raw_into(const btck_ChainstateManager* chainman, const btck_BlockTreeEntry* entry, int check_header, void* buffer, size_t buffer_len, size_t* block_len)
+{
+    const auto& chainman_ref{*btck_ChainstateManager::get(chainman).m_chainman};
+    const auto& block_index{btck_BlockTreeEntry::get(entry)};
+    const FlatFilePos block_pos{WITH_LOCK(chainman_ref.GetMutex(), return block_index.GetBlockPos())};
+    const std::span<std::byte> raw_block{static_cast<std::byte*>(buffer), buffer_len};
+    size_t block_size{0};
+    if (!chainman_ref.m_blockman.ReadRawBlock(raw_block, block_pos, block_size)) {
+        if (block_size > buffer_len) {
+            *block_len = block_size;
+        } else {
+            LogError("Failed to read block.");
+        }
+        return -1;
+    }
+    if (check_header == 1 && !check_raw_block_header(raw_block.first(block_size), block_index, chainman_ref.GetConsensus())) {
+        return -1;
+    }
+    *block_len = block_size;
+    return 0;
+}
+
 int32_t btck_block_tree_entry_get_height(const btck_BlockTreeEntry* entry)
 {
     return btck_BlockTreeEntry::get(entry).nHeight;
@@ -1164,6 +2283,282 @@ void btck_block_spent_outputs_destroy(btck_BlockSpentOutputs* block_spent_output
     delete block_spent_outputs;
 }
 
+btck_BlockReader* btck_block_reader_create(
+    const btck_ChainstateManager* chainman,
+    int32_t start_height,
+    int32_t end_height,
+    int read_spent_outputs,
+    int worker_threads,
+    size_t max_in_flight)
+{
+    if (worker_threads < 0 || max_in_flight == 0) {
+        LogError("Invalid block reader options.");
+        return nullptr;
+    }
+    auto& chainstate_manager{*btck_ChainstateManager::get(chainman).m_chainman};
+    std::vector<const CBlockIndex*> indexes;
+    {
+        LOCK(chainstate_manager.GetMutex());
+        const CChain& chain{chainstate_manager.ActiveChain()};
+        if (start_height < 0 || end_height < start_height || end_height > chain.Height()) {
+            LogError("Block reader range %d-%d is not within the active chain.", start_height, end_height);
+            return nullptr;
+        }
+        indexes.reserve(end_height - start_height + 1);
+        for (int32_t height{start_height}; height <= end_height; ++height) {
+            indexes.push_back(chain[height]);
+        }
+    }
+    try {
+        return btck_BlockReader::create(chainstate_manager.m_blockman, std::move(indexes), read_spent_outputs == 1, static_cast<size_t>(worker_threads), max_in_flight);
+    } catch (const std::system_error& e) {
+        LogError("Failed to spawn block reader threads: %s", e.what());
+        return nullptr;
+    }
+}
+
+int btck_block_reader_next(
+    btck_BlockReader* block_reader,
+    const btck_BlockTreeEntry** block_tree_entry,
+    btck_Block** block,
+    btck_BlockSpentOutputs** block_spent_outputs)
+{
+    *block_tree_entry = nullptr;
+    *block = nullptr;
+    if (block_spent_outputs) *block_spent_outputs = nullptr;
+
+    auto item{btck_BlockReader::get(block_reader).Next()};
+    if (!item) return 0;
+    *block_tree_entry = btck_BlockTreeEntry::ref(item->index);
+    if (!item->block) return -1;
+    *block = btck_Block::create(std::move(item->block));
+    if (block_spent_outputs && item->block_undo) {
+        *block_spent_outputs = btck_BlockSpentOutputs::create(std::move(item->block_undo));
+    }
+    return 0;
+}
+
+void btck_block_reader_destroy(btck_BlockReader* block_reader)
+{
+    delete block_reader;
+}
+
+btck_CoinsCursor* btck_coins_cursor_create(btck_ChainstateManager* chainman, size_t shard_count)
+{
+    if (shard_count == 0 || shard_count > CoinsCursor::MAX_SHARDS) {
+        LogError("Invalid coins cursor shard count %u.", shard_count);
+        return nullptr;
+    }
+    auto& chainstate_manager{*btck_ChainstateManager::get(chainman).m_chainman};
+    try {
+        LOCK(chainstate_manager.GetMutex());
+        Chainstate& chainstate{chainstate_manager.ActiveChainstate()};
+        if (!chainstate.CanFlushToDisk()) {
+            LogError("The coins database is not loaded.");
+            return nullptr;
+        }
+        // Write the coins cache to the database, so that it holds the coins
+        // of the current tip.
+        if (!FlushCoinsToTip(chainstate)) return nullptr;
+        return btck_CoinsCursor::create(chainstate, shard_count);
+    } catch (const std::exception& e) {
+        LogError("Failed to create coins cursor: %s", e.what());
+        return nullptr;
+    }
+}
+
+btck_BlockHash* btck_coins_cursor_get_block_hash(const btck_CoinsCursor* coins_cursor)
+{
+    return btck_BlockHash::create(btck_CoinsCursor::get(coins_cursor).GetBlockHash());
+}
+
+int btck_coins_cursor_next(
+    btck_CoinsCursor* coins_cursor,
+    size_t shard_index,
+    btck_TransactionOutPoint** outpoints,
+    btck_Coin** coins,
+    size_t capacity,
+    size_t* count)
+{
+    *count = 0;
+    auto& cursor{btck_CoinsCursor::get(coins_cursor)};
+    if (shard_index >= cursor.ShardCount()) {
+        LogError("Coins cursor shard %u out of range.", shard_index);
+        return -1;
+    }
+    std::vector<std::pair<COutPoint, Coin>> batch;
+    try {
+        batch.reserve(capacity);
+        if (!cursor.Next(shard_index, capacity, batch)) return -1;
+    } catch (const std::exception& e) {
+        LogError("Failed to read coins: %s", e.what());
+        return -1;
+    }
+    for (auto& [outpoint, coin] : batch) {
+        outpoints[*count] = btck_TransactionOutPoint::create(outpoint);
+        coins[*count] = btck_Coin::create(std::move(coin));
+        ++*count;
+    }
+    return 0;
+}
+
+void btck_coins_cursor_destroy(btck_CoinsCursor* coins_cursor)
+{
+    delete coins_cursor;
+}
+
+btck_UtxoStats* btck_chainstate_manager_compute_utxo_stats(btck_ChainstateManager* chainman, btck_UtxoSetHashType hash_type, int worker_threads)
+{
+    if (worker_threads < 0) {
+        LogError("The number of worker threads must not be negative.");
+        return nullptr;
+    }
+    auto& chainman_ref{*btck_ChainstateManager::get(chainman).m_chainman};
+    try {
+        LOCK(chainman_ref.GetMutex());
+        Chainstate& chainstate{chainman_ref.ActiveChainstate()};
+        if (!chainstate.CanFlushToDisk()) {
+            LogError("The coins of the chainstate are not loaded.");
+            return nullptr;
+        }
+        chainstate.ForceFlushStateToDisk();
+        auto stats{kernel::ComputeUTXOStats(get_coin_stats_hash_type(hash_type), chainstate.CoinsDB(), chainman_ref.m_blockman, worker_threads, [&chainman_ref] {
+            if (chainman_ref.m_interrupt) throw std::runtime_error("interrupted");
+        })};
+        if (!stats) {
+            LogError("Failed to compute UTXO set statistics.");
+            return nullptr;
+        }
+        return btck_UtxoStats::create(std::move(*stats));
+    } catch (const std::exception& e) {
+        LogError("Failed to compute UTXO set statistics: %s", e.what());
+        return nullptr;
+    }
+}
+
+btck_UtxoStats* btck_utxo_stats_copy(const btck_UtxoStats* utxo_stats)
+{
+    return btck_UtxoStats::copy(utxo_stats);
+}
+
+int32_t btck_utxo_stats_get_height(const btck_UtxoStats* utxo_stats)
+{
+    return btck_UtxoStats::get(utxo_stats).nHeight;
+}
+
+btck_BlockHash* btck_utxo_stats_get_block_hash(const btck_UtxoStats* utxo_stats)
+{
+    return btck_BlockHash::create(btck_UtxoStats::get(utxo_stats).hashBlock);
+}
+
+void btck_utxo_stats_get_hash(const btck_UtxoStats* utxo_stats, unsigned char output[32])
+{
+    std::memcpy(output, btck_UtxoStats::get(utxo_stats).hashSerialized.begin(), 32);
+}
+
+uint64_t btck_utxo_stats_get_coins_count(const btck_UtxoStats* utxo_stats)
+{
+    return btck_UtxoStats::get(utxo_stats).coins_count;
+}
+
+uint64_t btck_utxo_stats_get_transaction_count(const btck_UtxoStats* utxo_stats)
+{
+    return btck_UtxoStats::get(utxo_stats).nTransactions;
+}
+
+int64_t btck_utxo_stats_get_total_amount(const btck_UtxoStats* utxo_stats)
+{
+    return btck_UtxoStats::get(utxo_stats).total_amount.value_or(-1);
+}
+
+void btck_utxo_stats_destroy(btck_UtxoStats* utxo_stats)
+{
+    delete utxo_stats;
+}
+
+btck_ValidationStats* btck_chainstate_manager_get_validation_stats(const btck_ChainstateManager* chainman)
+{
+    auto& chainman_ref{*btck_ChainstateManager::get(chainman).m_chainman};
+    return btck_ValidationStats::create(WITH_LOCK(chainman_ref.GetMutex(), return chainman_ref.GetValidationStats()));
+}
+
+btck_ValidationStats* btck_validation_stats_copy(const btck_ValidationStats* validation_stats)
+{
+    return btck_ValidationStats::copy(validation_stats);
+}
+
+int64_t btck_validation_stats_get_time(const btck_ValidationStats* validation_stats, btck_ValidationPhase phase)
+{
+    return Ticks<std::chrono::microseconds>(get_phase_time(btck_ValidationStats::get(validation_stats), phase));
+}
+
+int64_t btck_validation_stats_get_block_count(const btck_ValidationStats* validation_stats)
+{
+    return btck_ValidationStats::get(validation_stats).blocks;
+}
+
+int64_t btck_validation_stats_get_transaction_count(const btck_ValidationStats* validation_stats)
+{
+    return btck_ValidationStats::get(validation_stats).transactions;
+}
+
+int64_t btck_validation_stats_get_input_count(const btck_ValidationStats* validation_stats)
+{
+    return btck_ValidationStats::get(validation_stats).inputs;
+}
+
+int64_t btck_validation_stats_get_sigops_cost(const btck_ValidationStats* validation_stats)
+{
+    return btck_ValidationStats::get(validation_stats).sigops_cost;
+}
+
+void btck_validation_stats_destroy(btck_ValidationStats* validation_stats)
+{
+    delete validation_stats;
+}
+
+btck_ValidationCacheStats* btck_chainstate_manager_get_validation_cache_stats(const btck_ChainstateManager* chainman, btck_ValidationCacheType cache_type)
+{
+    const auto& validation_cache{btck_ChainstateManager::get(chainman).m_chainman->m_validation_cache};
+    switch (cache_type) {
+    case btck_ValidationCacheType_SIGNATURE:
+        return btck_ValidationCacheStats::create(validation_cache.m_signature_cache.GetStats());
+    case btck_ValidationCacheType_SCRIPT_EXECUTION:
+        return btck_ValidationCacheStats::create(validation_cache.m_script_execution_cache.stats());
+    }
+    assert(false);
+}
+
+btck_ValidationCacheStats* btck_validation_cache_stats_copy(const btck_ValidationCacheStats* validation_cache_stats)
+{
+    return btck_ValidationCacheStats::copy(validation_cache_stats);
+}
+
+uint64_t btck_validation_cache_stats_get_hits(const btck_ValidationCacheStats* validation_cache_stats)
+{
+    return btck_ValidationCacheStats::get(validation_cache_stats).hits;
+}
+
+uint64_t btck_validation_cache_stats_get_misses(const btck_ValidationCacheStats* validation_cache_stats)
+{
+    return btck_ValidationCacheStats::get(validation_cache_stats).misses;
+}
+
+uint64_t btck_validation_cache_stats_get_inserts(const btck_ValidationCacheStats* validation_cache_stats)
+{
+    return btck_ValidationCacheStats::get(validation_cache_stats).inserts;
+}
+
+uint64_t btck_validation_cache_stats_get_evictions(const btck_ValidationCacheStats* validation_cache_stats)
+{
+    return btck_ValidationCacheStats::get(validation_cache_stats).evictions;
+}
+
+void btck_validation_cache_stats_destroy(btck_ValidationCacheStats* validation_cache_stats)
+{
+    delete validation_cache_stats;
+}
+
 btck_TransactionSpentOutputs* btck_transaction_spent_outputs_copy(const btck_TransactionSpentOutputs* transaction_spent_outputs)
 {
     return btck_TransactionSpentOutputs::copy(transaction_spent_outputs);
@@ -1229,6 +2624,85 @@ const btck_Chain* btck_chainstate_manager_get_active_chain(const btck_Chainstate
     return btck_Chain::ref(&WITH_LOCK(btck_ChainstateManager::get(chainman).m_chainman->GetMutex(), return btck_ChainstateManager::get(chainman).m_chainman->ActiveChain()));
 }
 
+btck_Mempool* btck_chainstate_manager_get_mempool(btck_ChainstateManager* chainman)
+{
+    auto& mempool{btck_ChainstateManager::get(chainman).m_mempool};
+    return mempool ? btck_Mempool::ref(mempool.get()) : nullptr;
+}
+
+int btck_mempool_accept_transactions(
+    btck_Mempool* mempool,
+    const btck_Transaction* const* transactions, size_t transactions_len,
+    int test_accept,
+    btck_MempoolAcceptStatus* statuses,
+    btck_TxValidationResult* results)
+{
+    auto& mempool_ref{btck_Mempool::get(mempool)};
+    bool all_accepted{true};
+    LOCK(mempool_ref.m_chainman->GetMutex());
+    for (size_t i{0}; i < transactions_len; ++i) {
+        const auto result{mempool_ref.m_chainman->ProcessTransaction(btck_Transaction::get(transactions[i]), test_accept == 1)};
+        statuses[i] = cast_mempool_accept_status(result.m_result_type);
+        if (results) results[i] = cast_tx_validation_result(result.m_state.GetResult());
+        if (statuses[i] == btck_MempoolAcceptStatus_REJECTED) {
+            LogDebug(BCLog::KERNEL, "Transaction rejected: %s", result.m_state.ToString());
+            all_accepted = false;
+        }
+    }
+    return all_accepted ? 0 : -1;
+}
+
+int btck_mempool_accept_package(
+    btck_Mempool* mempool,
+    const btck_Transaction* const* transactions, size_t transactions_len,
+    int test_accept,
+    btck_MempoolAcceptStatus* statuses,
+    btck_TxValidationResult* results)
+{
+    if (transactions_len == 0) {
+        LogError("A package has to contain at least one transaction.");
+        return -1;
+    }
+    auto& mempool_ref{btck_Mempool::get(mempool)};
+    Package package;
+    package.reserve(transactions_len);
+    for (size_t i{0}; i < transactions_len; ++i) {
+        package.push_back(btck_Transaction::get(transactions[i]));
+    }
+
+    LOCK(mempool_ref.m_chainman->GetMutex());
+    const auto result{ProcessNewPackage(mempool_ref.m_chainman->ActiveChainstate(), mempool_ref.m_pool, package, test_accept == 1, /*client_maxfeerate=*/std::nullopt)};
+    if (result.m_state.IsInvalid()) {
+        LogDebug(BCLog::KERNEL, "Package rejected: %s", result.m_state.ToString());
+    }
+    // Transactions without a result were not validated, because validation
+    // of the package stopped early or failed as a whole.
+    bool all_accepted{true};
+    for (size_t i{0}; i < transactions_len; ++i) {
+        const auto it{result.m_tx_results.find(package[i]->GetWitnessHash())};
+        if (it == result.m_tx_results.end()) {
+            statuses[i] = btck_MempoolAcceptStatus_NOT_PROCESSED;
+            if (results) results[i] = btck_TxValidationResult_UNKNOWN;
+            all_accepted = false;
+            continue;
+        }
+        statuses[i] = cast_mempool_accept_status(it->second.m_result_type);
+        if (results) results[i] = cast_tx_validation_result(it->second.m_state.GetResult());
+        if (statuses[i] == btck_MempoolAcceptStatus_REJECTED) all_accepted = false;
+    }
+    return all_accepted ? 0 : -1;
+}
+
+size_t btck_mempool_size(const btck_Mempool* mempool)
+{
+    return btck_Mempool::get(mempool).m_pool.size();
+}
+
+int btck_mempool_contains(const btck_Mempool* mempool, const btck_Txid* txid)
+{
+    return btck_Mempool::get(mempool).m_pool.exists(btck_Txid::get(txid)) ? 1 : 0;
+}
+
 const btck_BlockTreeEntry* btck_chain_get_tip(const btck_Chain* chain)
 {
     return btck_BlockTreeEntry::ref(btck_Chain::get(chain).Tip());
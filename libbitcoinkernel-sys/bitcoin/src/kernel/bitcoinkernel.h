@@ -273,6 +273,49 @@ typedef struct btck_TransactionOutPoint btck_TransactionOutPoint;
 
 typedef struct btck_Txid btck_Txid;
 
+/**
+ * Opaque data structure for reading a range of blocks of the active chain.
+ *
+ * Blocks, and optionally their spent outputs, are read ahead of the caller on
+ * a pool of worker threads and handed out in ascending height order.
+ */
+typedef struct btck_BlockReader btck_BlockReader;
+
+/**
+ * Opaque data structure for iterating over the coins (UTXO set) of the
+ * chainstate.
+ *
+ * The coins are read from a consistent state of the coins database, split into
+ * shards of disjoint ranges that can be iterated concurrently.
+ */
+typedef struct btck_CoinsCursor btck_CoinsCursor;
+
+/**
+ * Opaque data structure for holding statistics about the coins (UTXO set) of
+ * the chainstate, including a hash committing to them.
+ */
+typedef struct btck_UtxoStats btck_UtxoStats;
+
+/**
+ * Opaque data structure for holding the transaction memory pool of a
+ * chainstate manager. Transactions are validated against the active chainstate
+ * and the policy rules of the mempool before they are added to it.
+ */
+typedef struct btck_Mempool btck_Mempool;
+
+/**
+ * Opaque data structure for holding the time spent in the phases of connecting
+ * blocks and the work done while connecting them, either for a single block or
+ * the totals of a chainstate manager.
+ */
+typedef struct btck_ValidationStats btck_ValidationStats;
+
+/**
+ * Opaque data structure for holding the counters of one of the caches of
+ * successful script and signature validations.
+ */
+typedef struct btck_ValidationCacheStats btck_ValidationCacheStats;
+
 /** Current sync state passed to tip changed callbacks. */
 typedef uint8_t btck_SynchronizationState;
 #define btck_SynchronizationState_INIT_REINDEX ((btck_SynchronizationState)(0))
@@ -284,6 +327,33 @@ typedef uint8_t btck_Warning;
 #define btck_Warning_UNKNOWN_NEW_RULES_ACTIVATED ((btck_Warning)(0))
 #define btck_Warning_LARGE_WORK_INVALID_CHAIN ((btck_Warning)(1))
 
+/** The result of verifying the chainstate in the background. */
+typedef uint8_t btck_ChainstateVerificationResult;
+#define btck_ChainstateVerificationResult_SUCCESS ((btck_ChainstateVerificationResult)(0))
+#define btck_ChainstateVerificationResult_INTERRUPTED ((btck_ChainstateVerificationResult)(1))          //!< The verification was interrupted through the context
+#define btck_ChainstateVerificationResult_FAILURE ((btck_ChainstateVerificationResult)(2))              //!< The databases are corrupted, reindexing may fix this
+#define btck_ChainstateVerificationResult_INSUFFICIENT_DBCACHE ((btck_ChainstateVerificationResult)(3)) //!< The coins cache is too small to run all checks at the check level
+
+/** A phase of connecting a block to the chain, see btck_ValidationStats. */
+typedef uint8_t btck_ValidationPhase;
+#define btck_ValidationPhase_LOAD_BLOCK ((btck_ValidationPhase)(0))           //!< Reading the block from disk, if it was not passed in
+#define btck_ValidationPhase_CHECK_BLOCK ((btck_ValidationPhase)(1))          //!< Context-free checks of the block and the assumevalid lookup
+#define btck_ValidationPhase_FORK_CHECKS ((btck_ValidationPhase)(2))          //!< BIP30 and deployment checks
+#define btck_ValidationPhase_CONNECT_TRANSACTIONS ((btck_ValidationPhase)(3)) //!< Spending the inputs and queueing the script checks
+#define btck_ValidationPhase_VERIFY ((btck_ValidationPhase)(4))               //!< Connecting the transactions and waiting for the script checks
+#define btck_ValidationPhase_WRITE_UNDO ((btck_ValidationPhase)(5))           //!< Writing the undo data
+#define btck_ValidationPhase_WRITE_INDEX ((btck_ValidationPhase)(6))          //!< Updating the block index
+#define btck_ValidationPhase_CONNECT_BLOCK ((btck_ValidationPhase)(7))        //!< All of the checks and writes above
+#define btck_ValidationPhase_FLUSH_VIEW ((btck_ValidationPhase)(8))           //!< Flushing the block's coins into the coins cache
+#define btck_ValidationPhase_WRITE_CHAINSTATE ((btck_ValidationPhase)(9))     //!< Flushing the chainstate to disk, if needed
+#define btck_ValidationPhase_POST_CONNECT ((btck_ValidationPhase)(10))        //!< Updating the mempool and the chain tip
+#define btck_ValidationPhase_TOTAL ((btck_ValidationPhase)(11))               //!< All of the phases
+
+/** The caches of successful validations kept by a chainstate manager. */
+typedef uint8_t btck_ValidationCacheType;
+#define btck_ValidationCacheType_SIGNATURE ((btck_ValidationCacheType)(0))        //!< Valid signatures, keyed by signature hash, public key and signature
+#define btck_ValidationCacheType_SCRIPT_EXECUTION ((btck_ValidationCacheType)(1)) //!< Transactions whose scripts passed with a set of script verification flags
+
 /** Callback function types */
 
 /**
@@ -307,6 +377,19 @@ typedef void (*btck_NotifyWarningSet)(void* user_data, btck_Warning warning, con
 typedef void (*btck_NotifyWarningUnset)(void* user_data, btck_Warning warning);
 typedef void (*btck_NotifyFlushError)(void* user_data, const char* message, size_t message_len);
 typedef void (*btck_NotifyFatalError)(void* user_data, const char* message, size_t message_len);
+typedef void (*btck_NotifyBackgroundBlockTip)(void* user_data, const btck_BlockTreeEntry* entry, double verification_progress);
+typedef void (*btck_NotifyChainstateVerified)(void* user_data, btck_ChainstateVerificationResult result, const char* message, size_t message_len);
+typedef void (*btck_NotifyBlockConnectedStats)(void* user_data, const btck_BlockTreeEntry* entry, const btck_ValidationStats* stats);
+typedef void (*btck_NotifyScriptChecks)(void* user_data, const btck_BlockTreeEntry* entry, int enabled, const char* reason, size_t reason_len);
+
+/** Reason why a transaction was removed from the mempool. */
+typedef uint8_t btck_MempoolRemovalReason;
+#define btck_MempoolRemovalReason_EXPIRY ((btck_MempoolRemovalReason)(0))     //!< Expired from the mempool
+#define btck_MempoolRemovalReason_SIZE_LIMIT ((btck_MempoolRemovalReason)(1)) //!< Removed to keep the mempool within its size limit
+#define btck_MempoolRemovalReason_REORG ((btck_MempoolRemovalReason)(2))      //!< Removed for a reorganization
+#define btck_MempoolRemovalReason_BLOCK ((btck_MempoolRemovalReason)(3))      //!< Included in a connected block
+#define btck_MempoolRemovalReason_CONFLICT ((btck_MempoolRemovalReason)(4))   //!< Conflicts with a transaction of a connected block
+#define btck_MempoolRemovalReason_REPLACED ((btck_MempoolRemovalReason)(5))   //!< Replaced by a transaction paying a higher fee
 
 /**
  * Function signatures for the validation interface.
@@ -315,6 +398,8 @@ typedef void (*btck_ValidationInterfaceBlockChecked)(void* user_data, btck_Block
 typedef void (*btck_ValidationInterfacePoWValidBlock)(void* user_data, btck_Block* block, const btck_BlockTreeEntry* entry);
 typedef void (*btck_ValidationInterfaceBlockConnected)(void* user_data, btck_Block* block, const btck_BlockTreeEntry* entry);
 typedef void (*btck_ValidationInterfaceBlockDisconnected)(void* user_data, btck_Block* block, const btck_BlockTreeEntry* entry);
+typedef void (*btck_ValidationInterfaceTransactionAddedToMempool)(void* user_data, btck_Transaction* transaction);
+typedef void (*btck_ValidationInterfaceTransactionRemovedFromMempool)(void* user_data, btck_Transaction* transaction, btck_MempoolRemovalReason reason);
 
 /**
  * Function signature for serializing data.
@@ -344,6 +429,33 @@ typedef uint32_t btck_BlockValidationResult;
 #define btck_BlockValidationResult_TIME_FUTURE ((btck_BlockValidationResult)(7))     //!< block timestamp was > 2 hours in the future (or our clock is bad)
 #define btck_BlockValidationResult_HEADER_LOW_WORK ((btck_BlockValidationResult)(8)) //!< the block header may be on a too-little-work chain
 
+/**
+ * Whether a transaction submitted to the mempool was accepted.
+ */
+typedef uint8_t btck_MempoolAcceptStatus;
+#define btck_MempoolAcceptStatus_ACCEPTED ((btck_MempoolAcceptStatus)(0))           //!< the transaction is valid and was added to the mempool, or would have been
+#define btck_MempoolAcceptStatus_ALREADY_IN_MEMPOOL ((btck_MempoolAcceptStatus)(1)) //!< the transaction, or one with the same txid, is already in the mempool
+#define btck_MempoolAcceptStatus_REJECTED ((btck_MempoolAcceptStatus)(2))           //!< the transaction is invalid or does not meet the mempool policy
+#define btck_MempoolAcceptStatus_NOT_PROCESSED ((btck_MempoolAcceptStatus)(3))      //!< the transaction was not validated, because its package was rejected
+
+/**
+ * A granular "reason" why a transaction was rejected.
+ */
+typedef uint32_t btck_TxValidationResult;
+#define btck_TxValidationResult_UNSET ((btck_TxValidationResult)(0))               //!< initial value. Transaction has not yet been rejected
+#define btck_TxValidationResult_CONSENSUS ((btck_TxValidationResult)(1))           //!< invalid by consensus rules
+#define btck_TxValidationResult_INPUTS_NOT_STANDARD ((btck_TxValidationResult)(2)) //!< inputs failed policy rules
+#define btck_TxValidationResult_NOT_STANDARD ((btck_TxValidationResult)(3))        //!< otherwise didn't meet the local policy rules
+#define btck_TxValidationResult_MISSING_INPUTS ((btck_TxValidationResult)(4))      //!< transaction was missing some of its inputs
+#define btck_TxValidationResult_PREMATURE_SPEND ((btck_TxValidationResult)(5))     //!< spends a coinbase too early, or violates locktime/sequence locks
+#define btck_TxValidationResult_WITNESS_MUTATED ((btck_TxValidationResult)(6))     //!< witness is non-standard, or present prior to segwit activation
+#define btck_TxValidationResult_WITNESS_STRIPPED ((btck_TxValidationResult)(7))    //!< transaction is missing a witness
+#define btck_TxValidationResult_CONFLICT ((btck_TxValidationResult)(8))            //!< already in the mempool or conflicts with a transaction in the chain
+#define btck_TxValidationResult_MEMPOOL_POLICY ((btck_TxValidationResult)(9))      //!< violated the mempool's fee, size, descendant or replacement limits
+#define btck_TxValidationResult_NO_MEMPOOL ((btck_TxValidationResult)(10))         //!< there is no mempool to validate the transaction against
+#define btck_TxValidationResult_RECONSIDERABLE ((btck_TxValidationResult)(11))     //!< fails some policy, but might be acceptable in a different package
+#define btck_TxValidationResult_UNKNOWN ((btck_TxValidationResult)(12))            //!< transaction was not validated because its package failed
+
 /**
  * Holds the validation interface callbacks. The user data pointer may be used
  * to point to user-defined structures to make processing the validation
@@ -361,6 +473,9 @@ typedef struct {
                                                                   //!< and segwit merkle root.
     btck_ValidationInterfaceBlockConnected block_connected;       //!< Called when a block is valid and has now been connected to the best chain.
     btck_ValidationInterfaceBlockDisconnected block_disconnected; //!< Called during a re-org when a block has been removed from the best chain.
+    btck_ValidationInterfaceTransactionAddedToMempool transaction_added_to_mempool;         //!< Called when a transaction was added to the mempool.
+    btck_ValidationInterfaceTransactionRemovedFromMempool transaction_removed_from_mempool; //!< Called when a transaction was removed from the mempool,
+                                                                                            //!< including when it was included in a connected block.
 } btck_ValidationInterfaceCallbacks;
 
 /**
@@ -383,6 +498,16 @@ typedef struct {
     btck_NotifyWarningUnset warning_unset;  //!< A previous condition leading to the issuance of a warning is no longer given.
     btck_NotifyFlushError flush_error;      //!< An error encountered when flushing data to disk.
     btck_NotifyFatalError fatal_error;      //!< A un-recoverable system error encountered by the library.
+    btck_NotifyBackgroundBlockTip background_block_tip;   //!< The background chainstate validating the blocks below a loaded
+                                                          //!< snapshot connected blocks up to the provided block entry. The
+                                                          //!< progress is the fraction of the snapshot's transactions validated.
+    btck_NotifyChainstateVerified chainstate_verified;    //!< The chainstate of a chainstate manager created with background
+                                                          //!< verification was verified. The message describes a failure.
+    btck_NotifyBlockConnectedStats block_connected_stats; //!< A block was connected to a chainstate. The statistics hold the
+                                                          //!< time spent in each phase of connecting it and are only valid
+                                                          //!< for the duration of the callback.
+    btck_NotifyScriptChecks script_checks;                //!< Script verification was enabled or disabled, starting at the provided
+                                                          //!< block entry. The reason why scripts are verified is empty if they are not.
 } btck_NotificationInterfaceCallbacks;
 
 /**
@@ -457,6 +582,14 @@ typedef uint8_t btck_ChainType;
 #define btck_ChainType_SIGNET ((btck_ChainType)(3))
 #define btck_ChainType_REGTEST ((btck_ChainType)(4))
 
+/**
+ * The hash computed over the coins when computing UTXO set statistics.
+ */
+typedef uint8_t btck_UtxoSetHashType;
+#define btck_UtxoSetHashType_HASH_SERIALIZED ((btck_UtxoSetHashType)(0)) //!< SHA256 of the serialized coins, as committed to by assumeutxo.
+#define btck_UtxoSetHashType_MUHASH ((btck_UtxoSetHashType)(1))          //!< MuHash3072 of the coins, which does not depend on their order.
+#define btck_UtxoSetHashType_NONE ((btck_UtxoSetHashType)(2))            //!< No hash, only the other statistics are computed.
+
 /** @name Transaction
  * Functions for working with transactions.
  */
@@ -607,6 +740,68 @@ BITCOINKERNEL_API int BITCOINKERNEL_WARN_UNUSED_RESULT btck_script_pubkey_verify
     unsigned int flags,
     btck_ScriptVerifyStatus* status) BITCOINKERNEL_ARG_NONNULL(1, 3);
 
+/**
+ * @brief Verify all inputs of tx_to against the outputs they spend under the
+ * constraints specified by flags. In contrast to calling
+ * @ref btck_script_pubkey_verify for each input, the signature hash data of the
+ * transaction is only precomputed once and shared by all its inputs. The
+ * checks of the individual inputs are distributed over a pool of worker
+ * threads.
+ *
+ * @param[in] tx_to             Non-null, transaction whose inputs are verified.
+ * @param[in] spent_outputs     Non-null, points to an array of outputs spent by the transaction, in the
+ *                              order of the inputs spending them.
+ * @param[in] spent_outputs_len Length of the spent_outputs array. Has to match the number of inputs of tx_to.
+ * @param[in] flags             Bitfield of btck_ScriptFlags controlling validation constraints.
+ * @param[in] worker_threads    The number of worker threads that should be spawned for the verification.
+ *                              When set to 0 all inputs are verified on the calling thread. The value
+ *                              range is clamped internally between 0 and 15, and to one thread per 16
+ *                              inputs, so that few inputs are verified on the calling thread alone.
+ * @param[out] results          Nullable, array that will be set to 1 for every valid input and to 0 for
+ *                              every invalid input.
+ * @param[in] results_len       Length of the results array. Has to match the number of inputs of tx_to if
+ *                              results is not null.
+ * @param[out] status           Nullable, will be set to an error code if the operation fails, or OK otherwise.
+ * @return                      1 if all inputs are valid, 0 otherwise.
+ */
+BITCOINKERNEL_API int BITCOINKERNEL_WARN_UNUSED_RESULT btck_transaction_verify_all_inputs(
+    const btck_Transaction* tx_to,
+    const btck_TransactionOutput** spent_outputs, size_t spent_outputs_len,
+    unsigned int flags,
+    unsigned int worker_threads,
+    int* results, size_t results_len,
+    btck_ScriptVerifyStatus* status) BITCOINKERNEL_ARG_NONNULL(1, 2);
+
+/**
+ * @brief Verify all inputs of multiple transactions. The signature hash data
+ * is precomputed once per transaction and the checks of all inputs of all
+ * transactions are distributed over a single pool of worker threads.
+ *
+ * @param[in] txs               Non-null, array of transactions whose inputs are verified.
+ * @param[in] txs_len           Length of the txs array.
+ * @param[in] spent_outputs     Non-null, the outputs spent by all transactions concatenated. For each
+ *                              transaction the spent outputs are in the order of its inputs.
+ * @param[in] spent_outputs_len Length of the spent_outputs array. Has to match the total number of inputs.
+ * @param[in] flags             Bitfield of btck_ScriptFlags controlling validation constraints.
+ * @param[in] worker_threads    The number of worker threads that should be spawned for the verification.
+ *                              When set to 0 all inputs are verified on the calling thread. The value
+ *                              range is clamped internally between 0 and 15, and to one thread per 16
+ *                              inputs, so that few inputs are verified on the calling thread alone.
+ * @param[out] results          Nullable, array that will be set to 1 for every valid input and to 0 for
+ *                              every invalid input, in the same order as spent_outputs.
+ * @param[in] results_len       Length of the results array. Has to match the total number of inputs if
+ *                              results is not null.
+ * @param[out] status           Nullable, will be set to an error code if the operation fails, or OK otherwise.
+ * @return                      1 if all inputs of all transactions are valid, 0 otherwise.
+ */
+BITCOINKERNEL_API int BITCOINKERNEL_WARN_UNUSED_RESULT btck_transactions_verify_all_inputs(
+    const btck_Transaction** txs, size_t txs_len,
+    const btck_TransactionOutput** spent_outputs, size_t spent_outputs_len,
+    unsigned int flags,
+    unsigned int worker_threads,
+    int* results, size_t results_len,
+    btck_ScriptVerifyStatus* status) BITCOINKERNEL_ARG_NONNULL(1, 3);
+
 /*
  * @brief Serializes the script pubkey through the passed in callback to bytes.
  *
@@ -838,6 +1033,22 @@ BITCOINKERNEL_API void btck_context_options_set_validation_interface(
     btck_ContextOptions* context_options,
     btck_ValidationInterfaceCallbacks validation_interface_callbacks) BITCOINKERNEL_ARG_NONNULL(1);
 
+/**
+ * @brief Deliver validation interface callbacks asynchronously on a dedicated
+ * thread instead of synchronously on the validating thread. Block connection
+ * waits for the queue to drain once more than queue_depth callbacks are
+ * pending. The block tree entries passed to queued callbacks remain valid
+ * until the chainstate manager is destroyed, but may no longer be part of the
+ * best chain by the time the callback runs.
+ *
+ * @param[in] context_options Non-null, previously created by @ref btck_context_options_create.
+ * @param[in] queue_depth     Maximum number of pending callbacks. 0 (the default) delivers callbacks
+ *                            synchronously.
+ */
+BITCOINKERNEL_API void btck_context_options_set_validation_interface_queue_depth(
+    btck_ContextOptions* context_options,
+    size_t queue_depth) BITCOINKERNEL_ARG_NONNULL(1);
+
 /**
  * Destroy the context options.
  */
@@ -878,6 +1089,17 @@ BITCOINKERNEL_API btck_Context* BITCOINKERNEL_WARN_UNUSED_RESULT btck_context_co
 BITCOINKERNEL_API int BITCOINKERNEL_WARN_UNUSED_RESULT btck_context_interrupt(
     btck_Context* context) BITCOINKERNEL_ARG_NONNULL(1);
 
+/**
+ * @brief Block until all validation interface callbacks that were queued
+ * before this call have been delivered. Returns immediately if callbacks are
+ * delivered synchronously. Must not be called from within a validation
+ * interface callback.
+ *
+ * @param[in] context Non-null.
+ */
+BITCOINKERNEL_API void btck_context_sync_validation_interface_queue(
+    const btck_Context* context) BITCOINKERNEL_ARG_NONNULL(1);
+
 /**
  * Destroy the context.
  */
@@ -948,8 +1170,12 @@ BITCOINKERNEL_API btck_ChainstateManagerOptions* BITCOINKERNEL_WARN_UNUSED_RESUL
  *
  * @param[in] chainstate_manager_options Non-null, options to be set.
  * @param[in] worker_threads             The number of worker threads that should be spawned in the thread pool
- *                                       used for validation. When set to 0 no parallel verification is done.
- *                                       The value range is clamped internally between 0 and 15.
+ *                                       used for validation. The same number of threads is used for fetching
+ *                                       the coins spent by a block before connecting it, for deserializing
+ *                                       blocks when importing block files, and for writing the coins of a
+ *                                       snapshot when loading it. When set to 0 no parallel verification,
+ *                                       fetching, deserialization or writing is done. The value range is
+ *                                       clamped internally between 0 and 15.
  */
 BITCOINKERNEL_API void btck_chainstate_manager_options_set_worker_threads_num(
     btck_ChainstateManagerOptions* chainstate_manager_options,
@@ -990,6 +1216,236 @@ BITCOINKERNEL_API void btck_chainstate_manager_options_update_chainstate_db_in_m
     btck_ChainstateManagerOptions* chainstate_manager_options,
     int chainstate_db_in_memory) BITCOINKERNEL_ARG_NONNULL(1);
 
+/**
+ * @brief Sets the total amount of memory used for caching chainstate data.
+ * The budget is split between the block tree database, the coins database
+ * and the in-memory coins cache in the same way as the defaults are. If not
+ * set, a total of 450MiB is used.
+ *
+ * @param[in] chainstate_manager_options Non-null, created by @ref btck_chainstate_manager_options_create.
+ * @param[in] total_cache_bytes          Total cache budget in bytes.
+ */
+BITCOINKERNEL_API void btck_chainstate_manager_options_set_cache_size(
+    btck_ChainstateManagerOptions* chainstate_manager_options,
+    size_t total_cache_bytes) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Sets the size of each chainstate cache component individually,
+ * overriding a previously set total cache budget.
+ *
+ * @param[in] chainstate_manager_options Non-null, created by @ref btck_chainstate_manager_options_create.
+ * @param[in] block_tree_db_bytes        Cache size of the block tree database in bytes.
+ * @param[in] coins_db_bytes             Cache size of the coins database in bytes. Must be non-zero.
+ * @param[in] coins_bytes                Size of the in-memory coins cache in bytes. Must be non-zero.
+ * @return                               0 if the set was successful, non-zero if the set failed.
+ */
+BITCOINKERNEL_API int BITCOINKERNEL_WARN_UNUSED_RESULT btck_chainstate_manager_options_set_cache_sizes(
+    btck_ChainstateManagerOptions* chainstate_manager_options,
+    size_t block_tree_db_bytes,
+    size_t coins_db_bytes,
+    size_t coins_bytes) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Sets the sizes of the caches of successful signature and script
+ * validations. Valid signatures and scripts of transactions are cached, so
+ * they don't have to be checked again when a block containing them is
+ * connected. If not set, 16MiB are used for each cache. A size of zero
+ * results in a cache with the minimum number of entries.
+ *
+ * @param[in] chainstate_manager_options   Non-null, created by @ref btck_chainstate_manager_options_create.
+ * @param[in] signature_cache_bytes        Size of the signature cache in bytes.
+ * @param[in] script_execution_cache_bytes Size of the script execution cache in bytes.
+ */
+BITCOINKERNEL_API void btck_chainstate_manager_options_set_validation_cache_sizes(
+    btck_ChainstateManagerOptions* chainstate_manager_options,
+    size_t signature_cache_bytes,
+    size_t script_execution_cache_bytes) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Sets the block whose ancestors are assumed to have valid scripts.
+ * The scripts of a block are not verified if it is an ancestor of this block
+ * and of the best known header, the best header has at least the minimum
+ * chain work, and the block is more than two weeks of work below the best
+ * header. All other checks are still done. The `script_checks` notification
+ * reports when script verification is enabled or disabled. If not set, the
+ * default of the chain parameters is used.
+ *
+ * @param[in] chainstate_manager_options Non-null, created by @ref btck_chainstate_manager_options_create.
+ * @param[in] block_hash                 Hash of the assumed valid block. If null, the scripts of
+ *                                       all blocks are verified.
+ */
+BITCOINKERNEL_API void btck_chainstate_manager_options_set_assumed_valid_block(
+    btck_ChainstateManagerOptions* chainstate_manager_options,
+    const btck_BlockHash* block_hash) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Sets the minimum chain work a chain needs before its blocks are
+ * accepted during the initial block download and before script verification
+ * is skipped for blocks below the assumed valid block. If not set, the
+ * default of the chain parameters is used.
+ *
+ * @param[in] chainstate_manager_options Non-null, created by @ref btck_chainstate_manager_options_create.
+ * @param[in] minimum_chain_work         Non-null, the 256-bit work in little-endian byte order,
+ *                                       the same order as the raw data of a block hash.
+ */
+BITCOINKERNEL_API void btck_chainstate_manager_options_set_minimum_chain_work(
+    btck_ChainstateManagerOptions* chainstate_manager_options,
+    const unsigned char minimum_chain_work[32]) BITCOINKERNEL_ARG_NONNULL(1, 2);
+
+/**
+ * @brief Sets whether the coins cache is written to the coins database on a
+ * background thread. If enabled, the modified coins are moved out of the
+ * cache when it is flushed, and blocks can be processed while they are
+ * written. Coins being written are still read from memory. Flushes that are
+ * done to prune block files, or to make the database hold the coins of the
+ * tip, still wait for the write. At most one flush is written at a time, so
+ * the memory used may temporarily exceed the coins cache size by the size of
+ * the previous flush. If a write fails, its coins are still read from memory,
+ * but every later flush, and every read that needs the coins to be on disk,
+ * fails right away and sends the `fatal_error` notification. If not set, the
+ * coins are written synchronously.
+ *
+ * @param[in] chainstate_manager_options Non-null, created by @ref btck_chainstate_manager_options_create.
+ * @param[in] background_coins_flush     Set to 1 to write the coins in the background.
+ */
+BITCOINKERNEL_API void btck_chainstate_manager_options_set_background_coins_flush(
+    btck_ChainstateManagerOptions* chainstate_manager_options,
+    int background_coins_flush) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Sets whether half of the coins cache memory is used to keep coins in
+ * the compressed form they are stored in on disk. Coins read from or written
+ * to the coins database are kept there, so they can be read again without
+ * going to disk once they drop out of the rest of the coins cache. A coin
+ * takes a fraction of the memory there, so more of the UTXO set fits in
+ * memory, but the rest of the coins cache is flushed twice as often. If not
+ * set, all of the coins cache memory holds uncompressed coins.
+ *
+ * @param[in] chainstate_manager_options Non-null, created by @ref btck_chainstate_manager_options_create.
+ * @param[in] compact_coins_cache        Set to 1 to keep compressed coins.
+ */
+BITCOINKERNEL_API void btck_chainstate_manager_options_set_compact_coins_cache(
+    btck_ChainstateManagerOptions* chainstate_manager_options,
+    int compact_coins_cache) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Enables pruning of old block and undo files. Once the block files
+ * use more than the target, the oldest files are deleted when the state is
+ * flushed, while keeping at least the last 288 blocks. Blocks protected by a
+ * prune lock set with @ref btck_chainstate_manager_set_prune_lock are not
+ * deleted. If set to UINT64_MAX, blocks are only pruned through @ref
+ * btck_chainstate_manager_prune_to_height. Going back to an unpruned
+ * chainstate requires reindexing. If not set, pruning is disabled.
+ *
+ * @param[in] chainstate_manager_options Non-null, created by @ref btck_chainstate_manager_options_create.
+ * @param[in] prune_target_bytes         Disk space in bytes to use for the block and undo
+ *                                       files. Either zero, UINT64_MAX or at least 550MiB.
+ * @return                               0 if the target is valid, non-zero otherwise.
+ */
+BITCOINKERNEL_API int BITCOINKERNEL_WARN_UNUSED_RESULT btck_chainstate_manager_options_set_prune_target(
+    btck_ChainstateManagerOptions* chainstate_manager_options,
+    uint64_t prune_target_bytes) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Sets whether small block files of 64KiB are used instead of 128MiB
+ * ones, so that a short chain spans several files that can be pruned. Meant
+ * for testing. If not set, the usual block file size is used.
+ *
+ * @param[in] chainstate_manager_options Non-null, created by @ref btck_chainstate_manager_options_create.
+ * @param[in] fast_prune                 Set to 1 to use small block files.
+ */
+BITCOINKERNEL_API void btck_chainstate_manager_options_set_fast_prune(
+    btck_ChainstateManagerOptions* chainstate_manager_options,
+    int fast_prune) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Sets the number of blocks at the tip whose data is verified when the
+ * chainstate manager is created. If not set, the last 6 blocks are verified.
+ *
+ * @param[in] chainstate_manager_options Non-null, created by @ref btck_chainstate_manager_options_create.
+ * @param[in] check_blocks               Number of blocks to verify. If 0 or larger than the height of the
+ *                                       chain, all blocks are verified.
+ */
+BITCOINKERNEL_API void btck_chainstate_manager_options_set_check_blocks(
+    btck_ChainstateManagerOptions* chainstate_manager_options,
+    int64_t check_blocks) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Sets how thoroughly the blocks at the tip are verified when the
+ * chainstate manager is created. If not set, level 3 is used.
+ *
+ * The levels are: 0 reads the blocks from disk, 1 also checks their validity,
+ * 2 also reads their undo data, 3 also checks that disconnecting them from the
+ * coins cache succeeds, and 4 also reconnects them.
+ *
+ * @param[in] chainstate_manager_options Non-null, created by @ref btck_chainstate_manager_options_create.
+ * @param[in] check_level                The check level, between 0 and 4.
+ * @return                               0 if the set was successful, non-zero if the level is out of range.
+ */
+BITCOINKERNEL_API int BITCOINKERNEL_WARN_UNUSED_RESULT btck_chainstate_manager_options_set_check_level(
+    btck_ChainstateManagerOptions* chainstate_manager_options,
+    int check_level) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Sets whether all checks at the check level have to succeed for the
+ * verification to succeed. If unset, checks of level 3 and above are skipped
+ * when the coins cache is too small to run them. Set by default.
+ *
+ * @param[in] chainstate_manager_options Non-null, created by @ref btck_chainstate_manager_options_create.
+ * @param[in] require_full_verification  Set require full verification.
+ */
+BITCOINKERNEL_API void btck_chainstate_manager_options_set_require_full_verification(
+    btck_ChainstateManagerOptions* chainstate_manager_options,
+    int require_full_verification) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Sets whether the chainstate is verified on a background thread. If
+ * set, @ref btck_chainstate_manager_create returns once the chainstate is
+ * loaded and its verification has started, and the blocks at the tip are
+ * verified and the best chain is activated on a thread. The result is
+ * reported through the `chainstate_verified` notification. While the blocks
+ * are verified, functions of the chainstate manager that access the
+ * chainstate, such as processing blocks, wait for the verification to
+ * finish. On failure, the chainstate manager should be
+ * destroyed, though not from within the notification, and the chainstate
+ * reindexed.
+ *
+ * @param[in] chainstate_manager_options Non-null, created by @ref btck_chainstate_manager_options_create.
+ * @param[in] background_verification    Set background verification.
+ */
+BITCOINKERNEL_API void btck_chainstate_manager_options_set_background_verification(
+    btck_ChainstateManagerOptions* chainstate_manager_options,
+    int background_verification) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Sets whether the block index is written to a flat file next to the
+ * block tree database when the chainstate manager is destroyed, and read from
+ * it when the next chainstate manager is created. This is faster than reading
+ * it from the database. The file is only used if the block index did not
+ * change since it was written, otherwise the database is read as usual.
+ *
+ * @param[in] chainstate_manager_options Non-null, created by @ref btck_chainstate_manager_options_create.
+ * @param[in] block_index_snapshot       Set to 1 to write the block index snapshot file on destruction
+ *                                       and read it on creation. The file is ignored if it is missing,
+ *                                       corrupted, or the block tree database changed since it was written.
+ */
+BITCOINKERNEL_API void btck_chainstate_manager_options_set_block_index_snapshot(
+    btck_ChainstateManagerOptions* chainstate_manager_options,
+    int block_index_snapshot) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Sets whether the chainstate manager holds a mempool, which can be
+ * retrieved through @ref btck_chainstate_manager_get_mempool. Transactions
+ * in the mempool are removed when they are included in a connected block.
+ * The mempool is not persisted when the chainstate manager is destroyed.
+ *
+ * @param[in] chainstate_manager_options Non-null, created by @ref btck_chainstate_manager_options_create.
+ * @param[in] mempool                    Set mempool.
+ */
+BITCOINKERNEL_API void btck_chainstate_manager_options_set_mempool(
+    btck_ChainstateManagerOptions* chainstate_manager_options,
+    int mempool) BITCOINKERNEL_ARG_NONNULL(1);
+
 /**
  * Destroy the chainstate manager options.
  */
@@ -1066,6 +1522,17 @@ BITCOINKERNEL_API int BITCOINKERNEL_WARN_UNUSED_RESULT btck_chainstate_manager_p
 BITCOINKERNEL_API const btck_Chain* BITCOINKERNEL_WARN_UNUSED_RESULT btck_chainstate_manager_get_active_chain(
     const btck_ChainstateManager* chainstate_manager) BITCOINKERNEL_ARG_NONNULL(1);
 
+/**
+ * @brief Returns the mempool of the chainstate manager. Its lifetime is
+ * dependent on the chainstate manager.
+ *
+ * @param[in] chainstate_manager Non-null.
+ * @return                       The mempool, or null if the chainstate manager was created
+ *                               without one, see @ref btck_chainstate_manager_options_set_mempool.
+ */
+BITCOINKERNEL_API btck_Mempool* BITCOINKERNEL_WARN_UNUSED_RESULT btck_chainstate_manager_get_mempool(
+    btck_ChainstateManager* chainstate_manager) BITCOINKERNEL_ARG_NONNULL(1);
+
 /**
  * @brief Retrieve a block tree entry by its block hash.
  *
@@ -1079,12 +1546,242 @@ BITCOINKERNEL_API const btck_BlockTreeEntry* BITCOINKERNEL_WARN_UNUSED_RESULT bt
     const btck_BlockHash* block_hash) BITCOINKERNEL_ARG_NONNULL(1, 2);
 
 /**
- * Destroy the chainstate manager.
+ * @brief Validate a batch of block headers and add them to the block tree.
+ * The headers are validated in order, and processing stops at the first one
+ * that is rejected. The whole batch is processed while holding the validation
+ * lock once, and header tip notifications are issued once for the batch.
+ *
+ * @param[in] chainstate_manager Non-null.
+ * @param[in] headers            Non-null, consecutive serialized 80 byte block headers.
+ * @param[in] headers_len        Length of the headers buffer in bytes. Must be a multiple of 80.
+ * @param[out] result            Nullable, will be set to the validation result of the rejected
+ *                               header, or to btck_BlockValidationResult_UNSET if all headers were
+ *                               accepted.
+ * @return                       The block tree entry of the last accepted header, or null if no header
+ *                               was accepted or the headers could not be deserialized.
+ */
+BITCOINKERNEL_API const btck_BlockTreeEntry* BITCOINKERNEL_WARN_UNUSED_RESULT btck_chainstate_manager_process_headers(
+    btck_ChainstateManager* chainstate_manager,
+    const void* headers, size_t headers_len,
+    btck_BlockValidationResult* result) BITCOINKERNEL_ARG_NONNULL(1, 2);
+
+/**
+ * @brief Look up the unspent coins of a batch of out points in the active
+ * chainstate. Coins in the in-memory coins cache are served from it, the
+ * remaining ones are read from the coins database in key order. Coins read
+ * from the database are not added to the cache. Blocks are not processed
+ * while the batch is looked up, so all coins are as of the same tip.
+ *
+ * @param[in] chainstate_manager Non-null.
+ * @param[in] outpoints          Non-null, array of outpoints_len non-null out points.
+ * @param[in] outpoints_len      Number of out points.
+ * @param[out] coins             Non-null, array of outpoints_len entries. Set to the
+ *                               coin of the out point at the same index, or to null
+ *                               if it is spent or does not exist. The coins are owned
+ *                               by the caller.
+ * @return                       0 if the coins were looked up successfully, non-zero otherwise.
+ */
+BITCOINKERNEL_API int BITCOINKERNEL_WARN_UNUSED_RESULT btck_chainstate_manager_get_coins(
+    const btck_ChainstateManager* chainstate_manager,
+    const btck_TransactionOutPoint* const* outpoints,
+    size_t outpoints_len,
+    btck_Coin** coins) BITCOINKERNEL_ARG_NONNULL(1, 2, 4);
+
+/**
+ * @brief Resize the coins caches of a loaded chainstate manager. The state is
+ * flushed to disk if the new in-memory coins cache is smaller than its
+ * current contents. If a snapshot chainstate is in use, the budget is split
+ * between the chainstates. Fails while a coins cursor exists.
+ *
+ * @param[in] chainstate_manager Non-null.
+ * @param[in] coins_db_bytes     New cache size of the coins database in bytes. Must be non-zero.
+ * @param[in] coins_bytes        New size of the in-memory coins cache in bytes. Must be non-zero.
+ * @return                       0 if the caches were resized successfully, non-zero otherwise.
+ */
+BITCOINKERNEL_API int BITCOINKERNEL_WARN_UNUSED_RESULT btck_chainstate_manager_resize_caches(
+    btck_ChainstateManager* chainstate_manager,
+    size_t coins_db_bytes,
+    size_t coins_bytes) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Load an assumeutxo UTXO set snapshot, as written by @ref
+ * btck_chainstate_manager_dump_snapshot or the dumptxoutset RPC, into a new
+ * chainstate that becomes the active one. The snapshot's base block header
+ * has to be known to the chainstate manager, and the UTXO set hash of the
+ * base block has to be included in the assumeutxo data of the chain
+ * parameters. Loading a snapshot can take a long time.
+ *
+ * The blocks below the snapshot are subsequently validated by a background
+ * chainstate when they are processed, which reports its progress through the
+ * `background_block_tip` notification.
+ *
+ * @param[in] chainstate_manager Non-null.
+ * @param[in] path               Non-null, path of the snapshot file.
+ * @param[in] path_len           Length of the path.
+ * @return                       0 if the snapshot was loaded successfully, non-zero otherwise.
+ */
+BITCOINKERNEL_API int BITCOINKERNEL_WARN_UNUSED_RESULT btck_chainstate_manager_load_snapshot(
+    btck_ChainstateManager* chainstate_manager,
+    const char* path, size_t path_len) BITCOINKERNEL_ARG_NONNULL(1, 2);
+
+/**
+ * @brief Write the UTXO set of the active chainstate at its current tip to a
+ * snapshot file that can be loaded with @ref
+ * btck_chainstate_manager_load_snapshot. The state is flushed to disk first,
+ * and the snapshot is not written if that fails.
+ * Blocks may be processed while the coins are written. The file is written
+ * under a temporary name and only moved to the given path once complete.
+ *
+ * @param[in] chainstate_manager Non-null.
+ * @param[in] path               Non-null, path of the snapshot file. Must not exist yet.
+ * @param[in] path_len           Length of the path.
+ * @return                       0 if the snapshot was written successfully, non-zero otherwise.
+ */
+BITCOINKERNEL_API int BITCOINKERNEL_WARN_UNUSED_RESULT btck_chainstate_manager_dump_snapshot(
+    btck_ChainstateManager* chainstate_manager,
+    const char* path, size_t path_len) BITCOINKERNEL_ARG_NONNULL(1, 2);
+
+/**
+ * @brief Create or update a named prune lock. Blocks at and above the given
+ * height, and a small buffer below it, are not pruned until the lock is
+ * updated or deleted. This lets a consumer that processes blocks after they
+ * were connected, like an external index, keep the blocks it has not
+ * processed yet. A lock is lowered automatically if its blocks are
+ * disconnected. Locks are not persisted and have to be set again after the
+ * chainstate manager is created.
+ *
+ * @param[in] chainstate_manager Non-null.
+ * @param[in] name               Non-null, name identifying the lock.
+ * @param[in] name_len           Length of the name.
+ * @param[in] height             Height of the earliest block to keep. Must not be negative.
+ * @return                       0 if the lock was set, non-zero otherwise.
+ */
+BITCOINKERNEL_API int BITCOINKERNEL_WARN_UNUSED_RESULT btck_chainstate_manager_set_prune_lock(
+    btck_ChainstateManager* chainstate_manager,
+    const char* name, size_t name_len,
+    int32_t height) BITCOINKERNEL_ARG_NONNULL(1, 2);
+
+/**
+ * @brief Delete a named prune lock set with @ref
+ * btck_chainstate_manager_set_prune_lock.
+ *
+ * @param[in] chainstate_manager Non-null.
+ * @param[in] name               Non-null, name identifying the lock.
+ * @param[in] name_len           Length of the name.
+ * @return                       0 if the lock was deleted, non-zero if it did not exist.
+ */
+BITCOINKERNEL_API int BITCOINKERNEL_WARN_UNUSED_RESULT btck_chainstate_manager_delete_prune_lock(
+    btck_ChainstateManager* chainstate_manager,
+    const char* name, size_t name_len) BITCOINKERNEL_ARG_NONNULL(1, 2);
+
+/**
+ * @brief Delete the block and undo files containing only blocks up to the
+ * given height. The last 288 blocks and the blocks protected by prune locks
+ * are kept, so fewer blocks may be pruned. Requires pruning to be enabled
+ * with @ref btck_chainstate_manager_options_set_prune_target, and the chain
+ * to be longer than the prune-after height of the chain parameters.
+ *
+ * @param[in] chainstate_manager Non-null.
+ * @param[in] height             Height of the last block to prune. Must not be
+ *                               above the height of the active chain.
+ * @return                       0 if the files were pruned, non-zero otherwise.
+ */
+BITCOINKERNEL_API int BITCOINKERNEL_WARN_UNUSED_RESULT btck_chainstate_manager_prune_to_height(
+    btck_ChainstateManager* chainstate_manager,
+    int32_t height) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * Destroy the chainstate manager. Waits for a verification running in the
+ * background to finish, which can be cut short with @ref btck_context_interrupt.
+ * Must not be called from the `chainstate_verified` notification, which runs on
+ * the verification thread. Such a call is rejected and leaves the chainstate
+ * manager alive.
  */
 BITCOINKERNEL_API void btck_chainstate_manager_destroy(btck_ChainstateManager* chainstate_manager);
 
 ///@}
 
+/** @name Mempool
+ * Functions for working with the mempool.
+ */
+///@{
+
+/**
+ * @brief Validate a batch of transactions against the active chainstate and
+ * the mempool policy, and add the valid ones to the mempool. The transactions
+ * are validated one after the other while holding the validation lock once,
+ * so a transaction may spend the outputs of one accepted before it in the
+ * batch, unless test_accept is set. Accepted transactions are announced
+ * through the transaction_added_to_mempool validation interface callback.
+ *
+ * @param[in] mempool          Non-null.
+ * @param[in] transactions     Non-null, array of transactions_len non-null transactions.
+ * @param[in] transactions_len Number of transactions.
+ * @param[in] test_accept      If 1, the transactions are validated, but not added to the mempool.
+ * @param[out] statuses        Non-null, array of transactions_len entries. Set to whether the
+ *                             transaction at the same index was accepted.
+ * @param[out] results         Nullable, array of transactions_len entries. Set to the reason why the
+ *                             transaction at the same index was rejected.
+ * @return                     0 if all transactions were accepted or are already in the mempool,
+ *                             -1 otherwise.
+ */
+BITCOINKERNEL_API int btck_mempool_accept_transactions(
+    btck_Mempool* mempool,
+    const btck_Transaction* const* transactions, size_t transactions_len,
+    int test_accept,
+    btck_MempoolAcceptStatus* statuses,
+    btck_TxValidationResult* results) BITCOINKERNEL_ARG_NONNULL(1, 2, 5);
+
+/**
+ * @brief Validate a package of related transactions and add it to the
+ * mempool. Unlike transactions validated on their own, a package can pay for
+ * a parent below the minimum fee rate through the fee of its child. The
+ * transactions have to be sorted topologically. To be added to the mempool,
+ * the package has to consist of a child and its parents, see
+ * doc/policy/packages.md for the full rules. Accepted transactions are
+ * announced through the transaction_added_to_mempool validation interface
+ * callback.
+ *
+ * @param[in] mempool          Non-null.
+ * @param[in] transactions     Non-null, array of transactions_len non-null transactions.
+ * @param[in] transactions_len Number of transactions, must be greater than 0.
+ * @param[in] test_accept      If 1, the package is validated, but not added to the mempool.
+ * @param[out] statuses        Non-null, array of transactions_len entries. Set to whether the
+ *                             transaction at the same index was accepted.
+ * @param[out] results         Nullable, array of transactions_len entries. Set to the reason why the
+ *                             transaction at the same index was rejected.
+ * @return                     0 if all transactions were accepted or are already in the mempool,
+ *                             -1 otherwise.
+ */
+BITCOINKERNEL_API int btck_mempool_accept_package(
+    btck_Mempool* mempool,
+    const btck_Transaction* const* transactions, size_t transactions_len,
+    int test_accept,
+    btck_MempoolAcceptStatus* statuses,
+    btck_TxValidationResult* results) BITCOINKERNEL_ARG_NONNULL(1, 2, 5);
+
+/**
+ * @brief Returns the number of transactions in the mempool.
+ *
+ * @param[in] mempool Non-null.
+ * @return            The number of transactions.
+ */
+BITCOINKERNEL_API size_t BITCOINKERNEL_WARN_UNUSED_RESULT btck_mempool_size(
+    const btck_Mempool* mempool) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Check if a transaction is in the mempool.
+ *
+ * @param[in] mempool Non-null.
+ * @param[in] txid    Non-null.
+ * @return            1 if the transaction with the txid is in the mempool, 0 otherwise.
+ */
+BITCOINKERNEL_API int BITCOINKERNEL_WARN_UNUSED_RESULT btck_mempool_contains(
+    const btck_Mempool* mempool,
+    const btck_Txid* txid) BITCOINKERNEL_ARG_NONNULL(1, 2);
+
+///@}
+
 /** @name Block
  * Functions for working with blocks.
  */
@@ -1102,6 +1799,50 @@ BITCOINKERNEL_API btck_Block* BITCOINKERNEL_WARN_UNUSED_RESULT btck_block_read(
     const btck_ChainstateManager* chainstate_manager,
     const btck_BlockTreeEntry* block_tree_entry) BITCOINKERNEL_ARG_NONNULL(1, 2);
 
+/**
+ * @brief Reads the serialized block the passed in block tree entry points to
+ * from disk and passes the stored bytes to the writer without deserializing
+ * them.
+ *
+ * @param[in] chainstate_manager Non-null.
+ * @param[in] block_tree_entry   Non-null.
+ * @param[in] check_header       If 1, the header is checked against the entry's block hash and its
+ *                               proof of work. Can be 0 for blocks that are already known to be valid.
+ * @param[in] writer             Non-null, callback to a write bytes function.
+ * @param[in] user_data          Holds the user data passed to the writer.
+ * @return                       0 if the block was read successfully, non-zero otherwise.
+ */
+BITCOINKERNEL_API int BITCOINKERNEL_WARN_UNUSED_RESULT btck_block_read_raw(
+    const btck_ChainstateManager* chainstate_manager,
+    const btck_BlockTreeEntry* block_tree_entry,
+    int check_header,
+    btck_WriteBytes writer,
+    void* user_data) BITCOINKERNEL_ARG_NONNULL(1, 2, 4);
+
+/**
+ * @brief Reads the serialized block the passed in block tree entry points to
+ * from disk into a caller provided buffer. If the buffer is too small, nothing
+ * is read, block_len is set to the required size and a non-zero value is
+ * returned, so the call can be retried with a large enough buffer.
+ *
+ * @param[in] chainstate_manager Non-null.
+ * @param[in] block_tree_entry   Non-null.
+ * @param[in] check_header       If 1, the header is checked against the entry's block hash and its
+ *                               proof of work.
+ * @param[out] buffer            Nullable if buffer_len is 0, receives the serialized block.
+ * @param[in] buffer_len         Length of the buffer.
+ * @param[out] block_len         Non-null, set to the size of the serialized block if it was read or
+ *                               the buffer is too small, and left untouched otherwise.
+ * @return                       0 if the block was read successfully, non-zero otherwise.
+ */
+BITCOINKERNEL_API int BITCOINKERNEL_WARN_UNUSED_RESULT btck_block_read_raw_into(
+    const btck_ChainstateManager* chainstate_manager,
+    const btck_BlockTreeEntry* block_tree_entry,
+    int check_header,
+    void* buffer,
+    size_t buffer_len,
+    size_t* block_len) BITCOINKERNEL_ARG_NONNULL(1, 2, 6);
+
 /**
  * @brief Parse a serialized raw block into a new block object.
  *
@@ -1308,6 +2049,371 @@ BITCOINKERNEL_API void btck_block_spent_outputs_destroy(btck_BlockSpentOutputs*
 
 ///@}
 
+/** @name BlockReader
+ * Functions for reading a range of blocks in parallel.
+ */
+///@{
+
+/**
+ * @brief Create a block reader over the blocks of the active chain from
+ * start_height up to and including end_height. The chainstate manager must
+ * outlive the block reader.
+ *
+ * @param[in] chainstate_manager Non-null.
+ * @param[in] start_height       Height of the first block to read.
+ * @param[in] end_height         Height of the last block to read, must not exceed the active chain's height.
+ * @param[in] read_spent_outputs If 1, the spent outputs of each block are read too.
+ * @param[in] worker_threads     Number of threads reading ahead. If 0, each block is read when it is requested.
+ * @param[in] max_in_flight      Maximum number of blocks held in memory ahead of the caller, must be non-zero.
+ * @return                       The block reader, or null on error.
+ */
+BITCOINKERNEL_API btck_BlockReader* BITCOINKERNEL_WARN_UNUSED_RESULT btck_block_reader_create(
+    const btck_ChainstateManager* chainstate_manager,
+    int32_t start_height,
+    int32_t end_height,
+    int read_spent_outputs,
+    int worker_threads,
+    size_t max_in_flight) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Returns the next block of the range, blocking until it has been read.
+ * Once all blocks have been returned, 0 is returned and the block tree entry
+ * and block are set to null.
+ *
+ * @param[in] block_reader         Non-null.
+ * @param[out] block_tree_entry    Non-null, set to the entry of the block. The pointer is unowned and
+ *                                 only valid for the lifetime of the chainstate manager.
+ * @param[out] block               Non-null, set to the read block, or null if it could not be read.
+ * @param[out] block_spent_outputs Nullable, set to the read spent outputs of the block, or null if
+ *                                 the reader does not read spent outputs.
+ * @return                         0 on success or once the range is exhausted, non-zero if the
+ *                                 block could not be read. The reader advances past the failed block.
+ */
+BITCOINKERNEL_API int BITCOINKERNEL_WARN_UNUSED_RESULT btck_block_reader_next(
+    btck_BlockReader* block_reader,
+    const btck_BlockTreeEntry** block_tree_entry,
+    btck_Block** block,
+    btck_BlockSpentOutputs** block_spent_outputs) BITCOINKERNEL_ARG_NONNULL(1, 2, 3);
+
+/**
+ * Destroy the block reader. Stops its worker threads.
+ */
+BITCOINKERNEL_API void btck_block_reader_destroy(btck_BlockReader* block_reader);
+
+///@}
+
+/** @name CoinsCursor
+ * Functions for iterating over the coins of the chainstate.
+ */
+///@{
+
+/**
+ * @brief Create a cursor over the coins of the active chainstate. The
+ * in-memory coins cache is flushed to the coins database first, so that the
+ * cursor reads the coins as of the current tip. Fails if the flush does not
+ * succeed. Blocks processed while the cursor exists are not reflected in it.
+ *
+ * The coins are split into shard_count shards by the leading bytes of their
+ * txid, which may be iterated concurrently from different threads. The
+ * chainstate manager must outlive the cursor, and its caches cannot be resized
+ * while the cursor exists.
+ *
+ * @param[in] chainstate_manager Non-null.
+ * @param[in] shard_count        Number of shards, between 1 and 65536.
+ * @return                       The coins cursor, or null on error.
+ */
+BITCOINKERNEL_API btck_CoinsCursor* BITCOINKERNEL_WARN_UNUSED_RESULT btck_coins_cursor_create(
+    btck_ChainstateManager* chainstate_manager,
+    size_t shard_count) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Get the hash of the block up to which the coins of the cursor are
+ * current.
+ *
+ * @param[in] coins_cursor Non-null.
+ * @return                 The block hash.
+ */
+BITCOINKERNEL_API btck_BlockHash* BITCOINKERNEL_WARN_UNUSED_RESULT btck_coins_cursor_get_block_hash(
+    const btck_CoinsCursor* coins_cursor) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Read the next batch of coins of a shard, in database order. Once the
+ * shard is exhausted, 0 is returned with count set to 0. Calls for different
+ * shards may be made concurrently.
+ *
+ * @param[in] coins_cursor Non-null.
+ * @param[in] shard_index  Index of the shard, smaller than the cursor's shard count.
+ * @param[out] outpoints   Non-null, array of at least capacity elements that is filled with the
+ *                         owned outpoints of the read coins.
+ * @param[out] coins       Non-null, array of at least capacity elements that is filled with the
+ *                         owned read coins, at the same indexes as their outpoints.
+ * @param[in] capacity     Maximum number of coins to read.
+ * @param[out] count       Non-null, set to the number of coins read.
+ * @return                 0 on success, non-zero if the coins could not be read.
+ */
+BITCOINKERNEL_API int BITCOINKERNEL_WARN_UNUSED_RESULT btck_coins_cursor_next(
+    btck_CoinsCursor* coins_cursor,
+    size_t shard_index,
+    btck_TransactionOutPoint** outpoints,
+    btck_Coin** coins,
+    size_t capacity,
+    size_t* count) BITCOINKERNEL_ARG_NONNULL(1, 3, 4, 6);
+
+/**
+ * Destroy the coins cursor.
+ */
+BITCOINKERNEL_API void btck_coins_cursor_destroy(btck_CoinsCursor* coins_cursor);
+
+///@}
+
+/** @name UtxoStats
+ * Functions for computing statistics about the coins of the chainstate.
+ */
+///@{
+
+/**
+ * @brief Compute statistics about the coins (UTXO set) of the active
+ * chainstate. The in-memory coins cache is flushed to the coins database
+ * first, and blocks are not processed until the statistics are computed.
+ *
+ * With worker threads, the MuHash and the statistics are computed over ranges
+ * of the coins in parallel. The serialized hash depends on the order of the
+ * coins, so it is always computed on the calling thread. The computation can
+ * be aborted with btck_context_interrupt.
+ *
+ * @param[in] chainstate_manager Non-null.
+ * @param[in] hash_type          The hash to compute over the coins.
+ * @param[in] worker_threads     Number of threads to compute the statistics on. If 0,
+ *                               they are computed on the calling thread.
+ * @return                       The statistics, or null on error.
+ */
+BITCOINKERNEL_API btck_UtxoStats* BITCOINKERNEL_WARN_UNUSED_RESULT btck_chainstate_manager_compute_utxo_stats(
+    btck_ChainstateManager* chainstate_manager,
+    btck_UtxoSetHashType hash_type,
+    int worker_threads) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Copy the UTXO set statistics.
+ *
+ * @param[in] utxo_stats Non-null.
+ * @return               The copied statistics.
+ */
+BITCOINKERNEL_API btck_UtxoStats* BITCOINKERNEL_WARN_UNUSED_RESULT btck_utxo_stats_copy(
+    const btck_UtxoStats* utxo_stats) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Get the height of the block up to which the statistics were computed.
+ *
+ * @param[in] utxo_stats Non-null.
+ * @return               The block height.
+ */
+BITCOINKERNEL_API int32_t BITCOINKERNEL_WARN_UNUSED_RESULT btck_utxo_stats_get_height(
+    const btck_UtxoStats* utxo_stats) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Get the hash of the block up to which the statistics were computed.
+ *
+ * @param[in] utxo_stats Non-null.
+ * @return               The block hash.
+ */
+BITCOINKERNEL_API btck_BlockHash* BITCOINKERNEL_WARN_UNUSED_RESULT btck_utxo_stats_get_block_hash(
+    const btck_UtxoStats* utxo_stats) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Get the hash over the coins, of the type the statistics were computed
+ * with. Zero if the hash type was btck_UtxoSetHashType_NONE.
+ *
+ * @param[in] utxo_stats Non-null.
+ * @param[out] output    The serialized hash.
+ */
+BITCOINKERNEL_API void btck_utxo_stats_get_hash(
+    const btck_UtxoStats* utxo_stats, unsigned char output[32]) BITCOINKERNEL_ARG_NONNULL(1, 2);
+
+/**
+ * @brief Get the number of unspent coins.
+ *
+ * @param[in] utxo_stats Non-null.
+ * @return               The number of coins.
+ */
+BITCOINKERNEL_API uint64_t BITCOINKERNEL_WARN_UNUSED_RESULT btck_utxo_stats_get_coins_count(
+    const btck_UtxoStats* utxo_stats) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Get the number of transactions with unspent coins.
+ *
+ * @param[in] utxo_stats Non-null.
+ * @return               The number of transactions.
+ */
+BITCOINKERNEL_API uint64_t BITCOINKERNEL_WARN_UNUSED_RESULT btck_utxo_stats_get_transaction_count(
+    const btck_UtxoStats* utxo_stats) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Get the total amount of the unspent coins.
+ *
+ * @param[in] utxo_stats Non-null.
+ * @return               The total amount in satoshis, or -1 if it overflowed.
+ */
+BITCOINKERNEL_API int64_t BITCOINKERNEL_WARN_UNUSED_RESULT btck_utxo_stats_get_total_amount(
+    const btck_UtxoStats* utxo_stats) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * Destroy the UTXO set statistics.
+ */
+BITCOINKERNEL_API void btck_utxo_stats_destroy(btck_UtxoStats* utxo_stats);
+
+///@}
+
+/** @name ValidationStats
+ * Functions for working with the timers and counters of block validation.
+ */
+///@{
+
+/**
+ * @brief Get the totals of the validation timers and counters over all blocks
+ * connected by the chainstate manager so far. The statistics of single blocks
+ * are passed to the `block_connected_stats` notification.
+ *
+ * @param[in] chainstate_manager Non-null.
+ * @return                       A snapshot of the statistics.
+ */
+BITCOINKERNEL_API btck_ValidationStats* BITCOINKERNEL_WARN_UNUSED_RESULT btck_chainstate_manager_get_validation_stats(
+    const btck_ChainstateManager* chainstate_manager) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Copy the validation statistics.
+ *
+ * @param[in] validation_stats Non-null.
+ * @return                     The copied statistics.
+ */
+BITCOINKERNEL_API btck_ValidationStats* BITCOINKERNEL_WARN_UNUSED_RESULT btck_validation_stats_copy(
+    const btck_ValidationStats* validation_stats) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Get the time spent in a phase of connecting blocks.
+ *
+ * @param[in] validation_stats Non-null.
+ * @param[in] phase            The phase of connecting blocks.
+ * @return                     The time spent in microseconds.
+ */
+BITCOINKERNEL_API int64_t BITCOINKERNEL_WARN_UNUSED_RESULT btck_validation_stats_get_time(
+    const btck_ValidationStats* validation_stats, btck_ValidationPhase phase) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Get the number of blocks the statistics cover. This includes blocks
+ * that were only checked and not connected.
+ *
+ * @param[in] validation_stats Non-null.
+ * @return                     The number of blocks.
+ */
+BITCOINKERNEL_API int64_t BITCOINKERNEL_WARN_UNUSED_RESULT btck_validation_stats_get_block_count(
+    const btck_ValidationStats* validation_stats) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Get the number of connected transactions.
+ *
+ * @param[in] validation_stats Non-null.
+ * @return                     The number of transactions.
+ */
+BITCOINKERNEL_API int64_t BITCOINKERNEL_WARN_UNUSED_RESULT btck_validation_stats_get_transaction_count(
+    const btck_ValidationStats* validation_stats) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Get the number of spent inputs, including the coinbase inputs.
+ *
+ * @param[in] validation_stats Non-null.
+ * @return                     The number of inputs.
+ */
+BITCOINKERNEL_API int64_t BITCOINKERNEL_WARN_UNUSED_RESULT btck_validation_stats_get_input_count(
+    const btck_ValidationStats* validation_stats) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Get the signature operations cost of the connected transactions.
+ *
+ * @param[in] validation_stats Non-null.
+ * @return                     The signature operations cost.
+ */
+BITCOINKERNEL_API int64_t BITCOINKERNEL_WARN_UNUSED_RESULT btck_validation_stats_get_sigops_cost(
+    const btck_ValidationStats* validation_stats) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * Destroy the validation statistics.
+ */
+BITCOINKERNEL_API void btck_validation_stats_destroy(btck_ValidationStats* validation_stats);
+
+///@}
+
+/** @name ValidationCacheStats
+ * Functions for working with the counters of the validation caches.
+ */
+///@{
+
+/**
+ * @brief Get the counters of one of the caches of successful validations of
+ * the chainstate manager. The counters are read without stopping validation,
+ * so they may not be consistent with each other.
+ *
+ * @param[in] chainstate_manager Non-null.
+ * @param[in] cache_type         The cache to get the counters of.
+ * @return                       A snapshot of the counters.
+ */
+BITCOINKERNEL_API btck_ValidationCacheStats* BITCOINKERNEL_WARN_UNUSED_RESULT btck_chainstate_manager_get_validation_cache_stats(
+    const btck_ChainstateManager* chainstate_manager,
+    btck_ValidationCacheType cache_type) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Copy the validation cache counters.
+ *
+ * @param[in] validation_cache_stats Non-null.
+ * @return                           The copied counters.
+ */
+BITCOINKERNEL_API btck_ValidationCacheStats* BITCOINKERNEL_WARN_UNUSED_RESULT btck_validation_cache_stats_copy(
+    const btck_ValidationCacheStats* validation_cache_stats) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Get the number of lookups that found their entry in the cache.
+ *
+ * @param[in] validation_cache_stats Non-null.
+ * @return                           The number of hits.
+ */
+BITCOINKERNEL_API uint64_t BITCOINKERNEL_WARN_UNUSED_RESULT btck_validation_cache_stats_get_hits(
+    const btck_ValidationCacheStats* validation_cache_stats) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Get the number of lookups that did not find their entry in the cache.
+ *
+ * @param[in] validation_cache_stats Non-null.
+ * @return                           The number of misses.
+ */
+BITCOINKERNEL_API uint64_t BITCOINKERNEL_WARN_UNUSED_RESULT btck_validation_cache_stats_get_misses(
+    const btck_ValidationCacheStats* validation_cache_stats) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Get the number of entries added to the cache.
+ *
+ * @param[in] validation_cache_stats Non-null.
+ * @return                           The number of inserts.
+ */
+BITCOINKERNEL_API uint64_t BITCOINKERNEL_WARN_UNUSED_RESULT btck_validation_cache_stats_get_inserts(
+    const btck_ValidationCacheStats* validation_cache_stats) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * @brief Get the number of entries that were dropped from the cache to make
+ * room for new ones. A high number relative to the inserts means the cache is
+ * too small.
+ *
+ * @param[in] validation_cache_stats Non-null.
+ * @return                           The number of evictions.
+ */
+BITCOINKERNEL_API uint64_t BITCOINKERNEL_WARN_UNUSED_RESULT btck_validation_cache_stats_get_evictions(
+    const btck_ValidationCacheStats* validation_cache_stats) BITCOINKERNEL_ARG_NONNULL(1);
+
+/**
+ * Destroy the validation cache counters.
+ */
+BITCOINKERNEL_API void btck_validation_cache_stats_destroy(btck_ValidationCacheStats* validation_cache_stats);
+
+///@}
+
 /** @name TransactionSpentOutputs
  * Functions for working with the spent coins of a transaction
  */
@@ -1389,6 +2495,16 @@ BITCOINKERNEL_API void btck_transaction_input_destroy(btck_TransactionInput* tra
  */
 ///@{
 
+/**
+ * @brief Create a transaction out point from a txid and an output index.
+ *
+ * @param[in] txid  Non-null.
+ * @param[in] index The output index.
+ * @return          The transaction out point.
+ */
+BITCOINKERNEL_API btck_TransactionOutPoint* BITCOINKERNEL_WARN_UNUSED_RESULT btck_transaction_out_point_create(
+    const btck_Txid* txid, uint32_t index) BITCOINKERNEL_ARG_NONNULL(1);
+
 /**
  * @brief Copy a transaction out point.
  *
@@ -1429,6 +2545,12 @@ BITCOINKERNEL_API void btck_transaction_out_point_destroy(btck_TransactionOutPoi
  */
 ///@{
 
+/**
+ * @brief Create a txid from its raw data.
+ */
+BITCOINKERNEL_API btck_Txid* BITCOINKERNEL_WARN_UNUSED_RESULT btck_txid_create(
+    const unsigned char txid[32]) BITCOINKERNEL_ARG_NONNULL(1);
+
 /**
  * @brief Copy a txid.
  *
@@ -8,6 +8,7 @@
 #include <kernel/bitcoinkernel.h>
 
 #include <array>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -49,6 +50,12 @@ enum class ChainType : btck_ChainType {
     REGTEST = btck_ChainType_REGTEST
 };
 
+enum class UtxoSetHashType : btck_UtxoSetHashType {
+    HASH_SERIALIZED = btck_UtxoSetHashType_HASH_SERIALIZED,
+    MUHASH = btck_UtxoSetHashType_MUHASH,
+    NONE = btck_UtxoSetHashType_NONE
+};
+
 enum class SynchronizationState : btck_SynchronizationState {
     INIT_REINDEX = btck_SynchronizationState_INIT_REINDEX,
     INIT_DOWNLOAD = btck_SynchronizationState_INIT_DOWNLOAD,
@@ -60,6 +67,33 @@ enum class Warning : btck_Warning {
     LARGE_WORK_INVALID_CHAIN = btck_Warning_LARGE_WORK_INVALID_CHAIN
 };
 
+enum class ChainstateVerificationResult : btck_ChainstateVerificationResult {
+    SUCCESS = btck_ChainstateVerificationResult_SUCCESS,
+    INTERRUPTED = btck_ChainstateVerificationResult_INTERRUPTED,
+    FAILURE = btck_ChainstateVerificationResult_FAILURE,
+    INSUFFICIENT_DBCACHE = btck_ChainstateVerificationResult_INSUFFICIENT_DBCACHE
+};
+
+enum class ValidationPhase : btck_ValidationPhase {
+    LOAD_BLOCK = btck_ValidationPhase_LOAD_BLOCK,
+    CHECK_BLOCK = btck_ValidationPhase_CHECK_BLOCK,
+    FORK_CHECKS = btck_ValidationPhase_FORK_CHECKS,
+    CONNECT_TRANSACTIONS = btck_ValidationPhase_CONNECT_TRANSACTIONS,
+    VERIFY = btck_ValidationPhase_VERIFY,
+    WRITE_UNDO = btck_ValidationPhase_WRITE_UNDO,
+    WRITE_INDEX = btck_ValidationPhase_WRITE_INDEX,
+    CONNECT_BLOCK = btck_ValidationPhase_CONNECT_BLOCK,
+    FLUSH_VIEW = btck_ValidationPhase_FLUSH_VIEW,
+    WRITE_CHAINSTATE = btck_ValidationPhase_WRITE_CHAINSTATE,
+    POST_CONNECT = btck_ValidationPhase_POST_CONNECT,
+    TOTAL = btck_ValidationPhase_TOTAL
+};
+
+enum class ValidationCacheType : btck_ValidationCacheType {
+    SIGNATURE = btck_ValidationCacheType_SIGNATURE,
+    SCRIPT_EXECUTION = btck_ValidationCacheType_SCRIPT_EXECUTION
+};
+
 enum class ValidationMode : btck_ValidationMode {
     VALID = btck_ValidationMode_VALID,
     INVALID = btck_ValidationMode_INVALID,
@@ -78,6 +112,38 @@ enum class BlockValidationResult : btck_BlockValidationResult {
     HEADER_LOW_WORK = btck_BlockValidationResult_HEADER_LOW_WORK
 };
 
+enum class MempoolAcceptStatus : btck_MempoolAcceptStatus {
+    ACCEPTED = btck_MempoolAcceptStatus_ACCEPTED,
+    ALREADY_IN_MEMPOOL = btck_MempoolAcceptStatus_ALREADY_IN_MEMPOOL,
+    REJECTED = btck_MempoolAcceptStatus_REJECTED,
+    NOT_PROCESSED = btck_MempoolAcceptStatus_NOT_PROCESSED
+};
+
+enum class TxValidationResult : btck_TxValidationResult {
+    UNSET = btck_TxValidationResult_UNSET,
+    CONSENSUS = btck_TxValidationResult_CONSENSUS,
+    INPUTS_NOT_STANDARD = btck_TxValidationResult_INPUTS_NOT_STANDARD,
+    NOT_STANDARD = btck_TxValidationResult_NOT_STANDARD,
+    MISSING_INPUTS = btck_TxValidationResult_MISSING_INPUTS,
+    PREMATURE_SPEND = btck_TxValidationResult_PREMATURE_SPEND,
+    WITNESS_MUTATED = btck_TxValidationResult_WITNESS_MUTATED,
+    WITNESS_STRIPPED = btck_TxValidationResult_WITNESS_STRIPPED,
+    CONFLICT = btck_TxValidationResult_CONFLICT,
+    MEMPOOL_POLICY = btck_TxValidationResult_MEMPOOL_POLICY,
+    NO_MEMPOOL = btck_TxValidationResult_NO_MEMPOOL,
+    RECONSIDERABLE = btck_TxValidationResult_RECONSIDERABLE,
+    UNKNOWN = btck_TxValidationResult_UNKNOWN
+};
+
+enum class MempoolRemovalReason : btck_MempoolRemovalReason {
+    EXPIRY = btck_MempoolRemovalReason_EXPIRY,
+    SIZE_LIMIT = btck_MempoolRemovalReason_SIZE_LIMIT,
+    REORG = btck_MempoolRemovalReason_REORG,
+    BLOCK = btck_MempoolRemovalReason_BLOCK,
+    CONFLICT = btck_MempoolRemovalReason_CONFLICT,
+    REPLACED = btck_MempoolRemovalReason_REPLACED
+};
+
 enum class ScriptVerifyStatus : btck_ScriptVerifyStatus {
     OK = btck_ScriptVerifyStatus_OK,
     ERROR_INVALID_FLAGS_COMBINATION = btck_ScriptVerifyStatus_ERROR_INVALID_FLAGS_COMBINATION,
@@ -491,6 +557,9 @@ public:
 class Txid : public Handle<btck_Txid, btck_txid_copy, btck_txid_destroy>, public TxidApi<Txid>
 {
 public:
+    explicit Txid(const std::array<std::byte, 32>& txid)
+        : Handle{btck_txid_create(reinterpret_cast<const unsigned char*>(txid.data()))} {}
+
     Txid(const TxidView& view)
         : Handle(view) {}
 };
@@ -528,6 +597,11 @@ public:
 class OutPoint : public Handle<btck_TransactionOutPoint, btck_transaction_out_point_copy, btck_transaction_out_point_destroy>, public OutPointApi<OutPoint>
 {
 public:
+    OutPoint(const btck::Txid& txid, uint32_t index)
+        : Handle{btck_transaction_out_point_create(txid.get(), index)} {}
+
+    OutPoint(btck_TransactionOutPoint* outpoint) : Handle{outpoint} {}
+
     OutPoint(const OutPointView& view)
         : Handle(view) {}
 };
@@ -621,6 +695,8 @@ public:
     explicit Transaction(std::span<const std::byte> raw_transaction)
         : Handle{btck_transaction_create(raw_transaction.data(), raw_transaction.size())} {}
 
+    Transaction(btck_Transaction* transaction) : Handle{transaction} {}
+
     Transaction(const TransactionView& view)
         : Handle{view} {}
 };
@@ -654,6 +730,44 @@ bool ScriptPubkeyApi<Derived>::Verify(int64_t amount,
     return result == 1;
 }
 
+inline bool VerifyAllInputs(std::span<const Transaction> txs,
+                            std::span<const TransactionOutput> spent_outputs,
+                            ScriptVerificationFlags flags,
+                            unsigned int worker_threads,
+                            std::vector<int>& results,
+                            ScriptVerifyStatus& status)
+{
+    std::vector<const btck_Transaction*> raw_txs;
+    raw_txs.reserve(txs.size());
+    for (const auto& tx : txs) {
+        raw_txs.push_back(tx.get());
+    }
+    std::vector<const btck_TransactionOutput*> raw_spent_outputs;
+    raw_spent_outputs.reserve(spent_outputs.size());
+    for (const auto& output : spent_outputs) {
+        raw_spent_outputs.push_back(output.get());
+    }
+    results.assign(spent_outputs.size(), 0);
+    auto result = btck_transactions_verify_all_inputs(
+        raw_txs.data(), raw_txs.size(),
+        raw_spent_outputs.data(), raw_spent_outputs.size(),
+        static_cast<btck_ScriptVerificationFlags>(flags),
+        worker_threads,
+        results.data(), results.size(),
+        reinterpret_cast<btck_ScriptVerifyStatus*>(&status));
+    return result == 1;
+}
+
+inline bool VerifyAllInputs(const Transaction& tx_to,
+                            std::span<const TransactionOutput> spent_outputs,
+                            ScriptVerificationFlags flags,
+                            unsigned int worker_threads,
+                            std::vector<int>& results,
+                            ScriptVerifyStatus& status)
+{
+    return VerifyAllInputs(std::span<const Transaction>{&tx_to, 1}, spent_outputs, flags, worker_threads, results, status);
+}
+
 template <typename Derived>
 class BlockHashApi
 {
@@ -808,6 +922,47 @@ public:
     friend class Chain;
 };
 
+template <typename Derived>
+class ValidationStatsApi
+{
+private:
+    auto impl() const
+    {
+        return static_cast<const Derived*>(this)->get();
+    }
+
+    friend Derived;
+    ValidationStatsApi() = default;
+
+public:
+    std::chrono::microseconds GetTime(ValidationPhase phase) const
+    {
+        return std::chrono::microseconds{btck_validation_stats_get_time(impl(), static_cast<btck_ValidationPhase>(phase))};
+    }
+
+    int64_t GetBlockCount() const { return btck_validation_stats_get_block_count(impl()); }
+
+    int64_t GetTransactionCount() const { return btck_validation_stats_get_transaction_count(impl()); }
+
+    int64_t GetInputCount() const { return btck_validation_stats_get_input_count(impl()); }
+
+    int64_t GetSigopsCost() const { return btck_validation_stats_get_sigops_cost(impl()); }
+};
+
+class ValidationStatsView : public View<btck_ValidationStats>, public ValidationStatsApi<ValidationStatsView>
+{
+public:
+    explicit ValidationStatsView(const btck_ValidationStats* ptr) : View{ptr} {}
+};
+
+class ValidationStats : public Handle<btck_ValidationStats, btck_validation_stats_copy, btck_validation_stats_destroy>, public ValidationStatsApi<ValidationStats>
+{
+public:
+    ValidationStats(btck_ValidationStats* validation_stats) : Handle{validation_stats} {}
+
+    ValidationStats(const ValidationStatsView& view) : Handle{view} {}
+};
+
 class KernelNotifications
 {
 public:
@@ -826,6 +981,14 @@ public:
     virtual void FlushErrorHandler(std::string_view error) {}
 
     virtual void FatalErrorHandler(std::string_view error) {}
+
+    virtual void BackgroundBlockTipHandler(BlockTreeEntry entry, double verification_progress) {}
+
+    virtual void ChainstateVerifiedHandler(ChainstateVerificationResult result, std::string_view message) {}
+
+    virtual void BlockConnectedStatsHandler(BlockTreeEntry entry, ValidationStatsView stats) {}
+
+    virtual void ScriptChecksHandler(BlockTreeEntry entry, bool enabled, std::string_view reason) {}
 };
 
 class BlockValidationState
@@ -864,6 +1027,10 @@ public:
     virtual void BlockConnected(Block block, BlockTreeEntry entry) {}
 
     virtual void BlockDisconnected(Block block, BlockTreeEntry entry) {}
+
+    virtual void TransactionAddedToMempool(Transaction transaction) {}
+
+    virtual void TransactionRemovedFromMempool(Transaction transaction, MempoolRemovalReason reason) {}
 };
 
 class ChainParams : public Handle<btck_ChainParameters, btck_chain_parameters_copy, btck_chain_parameters_destroy>
@@ -901,6 +1068,10 @@ public:
                 .warning_unset = +[](void* user_data, btck_Warning warning) { (*static_cast<user_type>(user_data))->WarningUnsetHandler(static_cast<Warning>(warning)); },
                 .flush_error = +[](void* user_data, const char* error, size_t error_len) { (*static_cast<user_type>(user_data))->FlushErrorHandler({error, error_len}); },
                 .fatal_error = +[](void* user_data, const char* error, size_t error_len) { (*static_cast<user_type>(user_data))->FatalErrorHandler({error, error_len}); },
+                .background_block_tip = +[](void* user_data, const btck_BlockTreeEntry* entry, double verification_progress) { (*static_cast<user_type>(user_data))->BackgroundBlockTipHandler(BlockTreeEntry{entry}, verification_progress); },
+                .chainstate_verified = +[](void* user_data, btck_ChainstateVerificationResult result, const char* message, size_t message_len) { (*static_cast<user_type>(user_data))->ChainstateVerifiedHandler(static_cast<ChainstateVerificationResult>(result), {message, message_len}); },
+                .block_connected_stats = +[](void* user_data, const btck_BlockTreeEntry* entry, const btck_ValidationStats* stats) { (*static_cast<user_type>(user_data))->BlockConnectedStatsHandler(BlockTreeEntry{entry}, ValidationStatsView{stats}); },
+                .script_checks = +[](void* user_data, const btck_BlockTreeEntry* entry, int enabled, const char* reason, size_t reason_len) { (*static_cast<user_type>(user_data))->ScriptChecksHandler(BlockTreeEntry{entry}, enabled == 1, {reason, reason_len}); },
             });
     }
 
@@ -919,9 +1090,16 @@ public:
                 .pow_valid_block = +[](void* user_data, btck_Block* block, const btck_BlockTreeEntry* entry) { (*static_cast<user_type>(user_data))->PowValidBlock(BlockTreeEntry{entry}, Block{block}); },
                 .block_connected = +[](void* user_data, btck_Block* block, const btck_BlockTreeEntry* entry) { (*static_cast<user_type>(user_data))->BlockConnected(Block{block}, BlockTreeEntry{entry}); },
                 .block_disconnected = +[](void* user_data, btck_Block* block, const btck_BlockTreeEntry* entry) { (*static_cast<user_type>(user_data))->BlockDisconnected(Block{block}, BlockTreeEntry{entry}); },
+                .transaction_added_to_mempool = +[](void* user_data, btck_Transaction* transaction) { (*static_cast<user_type>(user_data))->TransactionAddedToMempool(Transaction{transaction}); },
+                .transaction_removed_from_mempool = +[](void* user_data, btck_Transaction* transaction, btck_MempoolRemovalReason reason) { (*static_cast<user_type>(user_data))->TransactionRemovedFromMempool(Transaction{transaction}, static_cast<MempoolRemovalReason>(reason)); },
             });
     }
 
+    void SetValidationInterfaceQueueDepth(size_t queue_depth)
+    {
+        btck_context_options_set_validation_interface_queue_depth(get(), queue_depth);
+    }
+
     friend class Context;
 };
 
@@ -938,6 +1116,11 @@ public:
     {
         return btck_context_interrupt(get()) == 0;
     }
+
+    void SyncValidationInterfaceQueue() const
+    {
+        btck_context_sync_validation_interface_queue(get());
+    }
 };
 
 class ChainstateManagerOptions : UniqueHandle<btck_ChainstateManagerOptions, btck_chainstate_manager_options_destroy>
@@ -968,6 +1151,81 @@ public:
         btck_chainstate_manager_options_update_chainstate_db_in_memory(get(), chainstate_db_in_memory);
     }
 
+    void SetCacheSize(size_t total_cache_bytes)
+    {
+        btck_chainstate_manager_options_set_cache_size(get(), total_cache_bytes);
+    }
+
+    bool SetCacheSizes(size_t block_tree_db_bytes, size_t coins_db_bytes, size_t coins_bytes)
+    {
+        return btck_chainstate_manager_options_set_cache_sizes(get(), block_tree_db_bytes, coins_db_bytes, coins_bytes) == 0;
+    }
+
+    void SetValidationCacheSizes(size_t signature_cache_bytes, size_t script_execution_cache_bytes)
+    {
+        btck_chainstate_manager_options_set_validation_cache_sizes(get(), signature_cache_bytes, script_execution_cache_bytes);
+    }
+
+    void SetAssumedValidBlock(const std::optional<BlockHash>& block_hash)
+    {
+        btck_chainstate_manager_options_set_assumed_valid_block(get(), block_hash ? block_hash->get() : nullptr);
+    }
+
+    void SetMinimumChainWork(const std::array<std::byte, 32>& minimum_chain_work)
+    {
+        btck_chainstate_manager_options_set_minimum_chain_work(get(), reinterpret_cast<const unsigned char*>(minimum_chain_work.data()));
+    }
+
+    void SetBackgroundCoinsFlush(bool background_coins_flush)
+    {
+        btck_chainstate_manager_options_set_background_coins_flush(get(), background_coins_flush);
+    }
+
+    void SetCompactCoinsCache(bool compact_coins_cache)
+    {
+        btck_chainstate_manager_options_set_compact_coins_cache(get(), compact_coins_cache);
+    }
+
+    bool SetPruneTarget(uint64_t prune_target_bytes)
+    {
+        return btck_chainstate_manager_options_set_prune_target(get(), prune_target_bytes) == 0;
+    }
+
+    void SetFastPrune(bool fast_prune)
+    {
+        btck_chainstate_manager_options_set_fast_prune(get(), fast_prune);
+    }
+
+    void SetCheckBlocks(int64_t check_blocks)
+    {
+        btck_chainstate_manager_options_set_check_blocks(get(), check_blocks);
+    }
+
+    bool SetCheckLevel(int check_level)
+    {
+        return btck_chainstate_manager_options_set_check_level(get(), check_level) == 0;
+    }
+
+    void SetRequireFullVerification(bool require_full_verification)
+    {
+        btck_chainstate_manager_options_set_require_full_verification(get(), require_full_verification);
+    }
+
+    void SetBackgroundVerification(bool background_verification)
+    {
+        btck_chainstate_manager_options_set_background_verification(get(), background_verification);
+    }
+
+    void SetBlockIndexSnapshot(bool block_index_snapshot)
+    {
+        btck_chainstate_manager_options_set_block_index_snapshot(get(), block_index_snapshot);
+    }
+
+    void SetMempool(bool mempool)
+    {
+        btck_chainstate_manager_options_set_mempool(get(), mempool);
+    }
+
     friend class ChainMan;
 };
 
@@ -1110,6 +1368,182 @@ public:
     MAKE_RANGE_METHOD(TxsSpentOutputs, BlockSpentOutputs, &BlockSpentOutputs::Count, &BlockSpentOutputs::GetTxSpentOutputs, *this)
 };
 
+struct BlockReaderItem {
+    BlockTreeEntry entry;
+    Block block;
+    std::optional<BlockSpentOutputs> spent_outputs;
+};
+
+class BlockReader : UniqueHandle<btck_BlockReader, btck_block_reader_destroy>
+{
+public:
+    BlockReader(btck_BlockReader* block_reader) : UniqueHandle{block_reader} {}
+
+    //! Returns the next block of the range, or nullopt once it is exhausted.
+    //! Throws if the block could not be read, after which the following block
+    //! can still be requested.
+    std::optional<BlockReaderItem> Next()
+    {
+        const btck_BlockTreeEntry* entry;
+        btck_Block* block;
+        btck_BlockSpentOutputs* spent_outputs;
+        if (btck_block_reader_next(get(), &entry, &block, &spent_outputs) != 0) {
+            throw std::runtime_error("Failed to read block");
+        }
+        if (!block) return std::nullopt;
+        std::optional<BlockSpentOutputs> spent;
+        if (spent_outputs) spent.emplace(spent_outputs);
+        return BlockReaderItem{BlockTreeEntry{entry}, Block{block}, std::move(spent)};
+    }
+};
+
+class CoinsCursor : UniqueHandle<btck_CoinsCursor, btck_coins_cursor_destroy>
+{
+public:
+    CoinsCursor(btck_CoinsCursor* coins_cursor) : UniqueHandle{coins_cursor} {}
+
+    BlockHash GetBlockHash() const
+    {
+        return BlockHash{btck_coins_cursor_get_block_hash(get())};
+    }
+
+    //! Returns the next batch of up to max_coins coins of the shard, which is
+    //! empty once the shard is exhausted. Throws if the coins could not be read.
+    std::vector<std::pair<OutPoint, Coin>> Next(size_t shard_index, size_t max_coins)
+    {
+        std::vector<btck_TransactionOutPoint*> outpoints(max_coins);
+        std::vector<btck_Coin*> coins(max_coins);
+        size_t count;
+        if (btck_coins_cursor_next(get(), shard_index, outpoints.data(), coins.data(), max_coins, &count) != 0) {
+            throw std::runtime_error("Failed to read coins");
+        }
+        std::vector<std::pair<OutPoint, Coin>> batch;
+        batch.reserve(count);
+        for (size_t i{0}; i < count; ++i) {
+            batch.emplace_back(OutPoint{outpoints[i]}, Coin{coins[i]});
+        }
+        return batch;
+    }
+};
+
+class UtxoStats : public Handle<btck_UtxoStats, btck_utxo_stats_copy, btck_utxo_stats_destroy>
+{
+public:
+    UtxoStats(btck_UtxoStats* utxo_stats) : Handle{utxo_stats} {}
+
+    int32_t GetHeight() const
+    {
+        return btck_utxo_stats_get_height(get());
+    }
+
+    BlockHash GetBlockHash() const
+    {
+        return BlockHash{btck_utxo_stats_get_block_hash(get())};
+    }
+
+    std::array<std::byte, 32> GetHash() const
+    {
+        std::array<std::byte, 32> hash;
+        btck_utxo_stats_get_hash(get(), reinterpret_cast<unsigned char*>(hash.data()));
+        return hash;
+    }
+
+    uint64_t GetCoinsCount() const
+    {
+        return btck_utxo_stats_get_coins_count(get());
+    }
+
+    uint64_t GetTransactionCount() const
+    {
+        return btck_utxo_stats_get_transaction_count(get());
+    }
+
+    int64_t GetTotalAmount() const
+    {
+        return btck_utxo_stats_get_total_amount(get());
+    }
+};
+
+class ValidationCacheStats : public Handle<btck_ValidationCacheStats, btck_validation_cache_stats_copy, btck_validation_cache_stats_destroy>
+{
+public:
+    ValidationCacheStats(btck_ValidationCacheStats* validation_cache_stats) : Handle{validation_cache_stats} {}
+
+    uint64_t GetHits() const
+    {
+        return btck_validation_cache_stats_get_hits(get());
+    }
+
+    uint64_t GetMisses() const
+    {
+        return btck_validation_cache_stats_get_misses(get());
+    }
+
+    uint64_t GetInserts() const
+    {
+        return btck_validation_cache_stats_get_inserts(get());
+    }
+
+    uint64_t GetEvictions() const
+    {
+        return btck_validation_cache_stats_get_evictions(get());
+    }
+};
+
+struct MempoolAcceptResult {
+    MempoolAcceptStatus status;
+    TxValidationResult result;
+};
+
+class Mempool
+{
+private:
+    btck_Mempool* m_mempool;
+
+    using AcceptFunc = int (*)(btck_Mempool*, const btck_Transaction* const*, size_t, int, btck_MempoolAcceptStatus*, btck_TxValidationResult*);
+
+    std::vector<MempoolAcceptResult> Accept(AcceptFunc accept, std::span<const Transaction> transactions, bool test_accept)
+    {
+        std::vector<const btck_Transaction*> c_transactions;
+        c_transactions.reserve(transactions.size());
+        for (const auto& transaction : transactions) {
+            c_transactions.push_back(transaction.get());
+        }
+        std::vector<btck_MempoolAcceptStatus> statuses(transactions.size());
+        std::vector<btck_TxValidationResult> results(transactions.size());
+        (void)accept(m_mempool, c_transactions.data(), c_transactions.size(), test_accept, statuses.data(), results.data());
+        std::vector<MempoolAcceptResult> accept_results;
+        accept_results.reserve(transactions.size());
+        for (size_t i{0}; i < transactions.size(); ++i) {
+            accept_results.push_back({static_cast<MempoolAcceptStatus>(statuses[i]), static_cast<TxValidationResult>(results[i])});
+        }
+        return accept_results;
+    }
+
+public:
+    explicit Mempool(btck_Mempool* mempool) : m_mempool{check(mempool)} {}
+
+    std::vector<MempoolAcceptResult> AcceptTransactions(std::span<const Transaction> transactions, bool test_accept = false)
+    {
+        return Accept(btck_mempool_accept_transactions, transactions, test_accept);
+    }
+
+    std::vector<MempoolAcceptResult> AcceptPackage(std::span<const Transaction> transactions, bool test_accept = false)
+    {
+        return Accept(btck_mempool_accept_package, transactions, test_accept);
+    }
+
+    size_t Size() const
+    {
+        return btck_mempool_size(m_mempool);
+    }
+
+    bool Contains(const Txid& txid) const
+    {
+        return btck_mempool_contains(m_mempool, txid.get()) == 1;
+    }
+};
+
 class ChainMan : UniqueHandle<btck_ChainstateManager, btck_chainstate_manager_destroy>
 {
 public:
@@ -1145,11 +1579,80 @@ public:
         return ChainView{btck_chainstate_manager_get_active_chain(get())};
     }
 
+    std::optional<Mempool> GetMempool()
+    {
+        auto mempool{btck_chainstate_manager_get_mempool(get())};
+        if (!mempool) return std::nullopt;
+        return Mempool{mempool};
+    }
+
     BlockTreeEntry GetBlockTreeEntry(const BlockHash& block_hash) const
     {
         return btck_chainstate_manager_get_block_tree_entry_by_hash(get(), block_hash.get());
     }
 
+    std::optional<BlockTreeEntry> ProcessHeaders(std::span<const std::byte> headers, BlockValidationResult* result = nullptr)
+    {
+        btck_BlockValidationResult _result;
+        auto entry{btck_chainstate_manager_process_headers(get(), headers.data(), headers.size(), &_result)};
+        if (result) *result = static_cast<BlockValidationResult>(_result);
+        if (!entry) return std::nullopt;
+        return entry;
+    }
+
+    std::optional<std::vector<std::optional<Coin>>> GetCoins(std::span<const OutPoint> outpoints) const
+    {
+        std::vector<const btck_TransactionOutPoint*> c_outpoints;
+        c_outpoints.reserve(outpoints.size());
+        for (const auto& outpoint : outpoints) {
+            c_outpoints.push_back(outpoint.get());
+        }
+        std::vector<btck_Coin*> c_coins(outpoints.size());
+        if (btck_chainstate_manager_get_coins(get(), c_outpoints.data(), c_outpoints.size(), c_coins.data()) != 0) {
+            return std::nullopt;
+        }
+        std::vector<std::optional<Coin>> coins;
+        coins.reserve(c_coins.size());
+        for (btck_Coin* coin : c_coins) {
+            if (coin) {
+                coins.emplace_back(coin);
+            } else {
+                coins.emplace_back(std::nullopt);
+            }
+        }
+        return coins;
+    }
+
+    bool ResizeCaches(size_t coins_db_bytes, size_t coins_bytes)
+    {
+        return btck_chainstate_manager_resize_caches(get(), coins_db_bytes, coins_bytes) == 0;
+    }
+
+    bool LoadSnapshot(std::string_view path)
+    {
+        return btck_chainstate_manager_load_snapshot(get(), path.data(), path.length()) == 0;
+    }
+
+    bool DumpSnapshot(std::string_view path)
+    {
+        return btck_chainstate_manager_dump_snapshot(get(), path.data(), path.length()) == 0;
+    }
+
+    bool SetPruneLock(std::string_view name, int32_t height)
+    {
+        return btck_chainstate_manager_set_prune_lock(get(), name.data(), name.length(), height) == 0;
+    }
+
+    bool DeletePruneLock(std::string_view name)
+    {
+        return btck_chainstate_manager_delete_prune_lock(get(), name.data(), name.length()) == 0;
+    }
+
+    bool PruneToHeight(int32_t height)
+    {
+        return btck_chainstate_manager_prune_to_height(get(), height) == 0;
+    }
+
     std::optional<Block> ReadBlock(const BlockTreeEntry& entry) const
     {
         auto block{btck_block_read(get(), entry.get())};
@@ -1157,10 +1660,57 @@ public:
         return block;
     }
 
+    std::optional<std::vector<std::byte>> ReadRawBlock(const BlockTreeEntry& entry, bool check_header = true) const
+    {
+        std::vector<std::byte> bytes;
+        constexpr auto const write = +[](const void* buffer, size_t len, void* user_data) -> int {
+            auto& bytes = *static_cast<std::vector<std::byte>*>(user_data);
+            try {
+                auto const* first = static_cast<const std::byte*>(buffer);
+                bytes.assign(first, first + len);
+                return 0;
+            } catch (...) {
+                return -1;
+            }
+        };
+        if (btck_block_read_raw(get(), entry.get(), check_header, write, &bytes) != 0) return std::nullopt;
+        return bytes;
+    }
+
+    bool ReadRawBlockInto(const BlockTreeEntry& entry, std::span<std::byte> buffer, size_t& block_len, bool check_header = true) const
+    {
+        return btck_block_read_raw_into(get(), entry.get(), check_header, buffer.data(), buffer.size(), &block_len) == 0;
+    }
+
     BlockSpentOutputs ReadBlockSpentOutputs(const BlockTreeEntry& entry) const
     {
         return btck_block_spent_outputs_read(get(), entry.get());
     }
+
+    BlockReader ReadBlocks(int32_t start_height, int32_t end_height, bool read_spent_outputs, int worker_threads, size_t max_in_flight) const
+    {
+        return btck_block_reader_create(get(), start_height, end_height, read_spent_outputs, worker_threads, max_in_flight);
+    }
+
+    CoinsCursor GetCoinsCursor(size_t shard_count = 1)
+    {
+        return btck_coins_cursor_create(get(), shard_count);
+    }
+
+    UtxoStats ComputeUtxoStats(UtxoSetHashType hash_type, int worker_threads = 0)
+    {
+        return btck_chainstate_manager_compute_utxo_stats(get(), static_cast<btck_UtxoSetHashType>(hash_type), worker_threads);
+    }
+
+    ValidationStats GetValidationStats() const
+    {
+        return btck_chainstate_manager_get_validation_stats(get());
+    }
+
+    ValidationCacheStats GetValidationCacheStats(ValidationCacheType cache_type) const
+    {
+        return btck_chainstate_manager_get_validation_cache_stats(get(), static_cast<btck_ValidationCacheType>(cache_type));
+    }
 };
 
 } // namespace btck
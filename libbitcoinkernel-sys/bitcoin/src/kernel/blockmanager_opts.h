@@ -29,6 +29,9 @@ struct BlockManagerOpts {
     const fs::path blocks_dir;
     Notifications& notifications;
     DBParams block_tree_db_params;
+    //! Whether to write the block index to a flat file next to the block tree
+    //! database on shutdown, and load it from there on the next start.
+    bool block_index_snapshot{false};
 };
 
 } // namespace kernel
@@ -22,6 +22,8 @@ class CChainParams;
 class ValidationSignals;
 
 static constexpr auto DEFAULT_MAX_TIP_AGE{24h};
+//! Default number of pending validation interface callbacks before validation waits for them.
+static constexpr size_t DEFAULT_MAX_PENDING_VALIDATION_CALLBACKS{10};
 
 namespace kernel {
 
@@ -44,8 +46,14 @@ struct ChainstateManagerOpts {
     CoinsViewOptions coins_view{};
     Notifications& notifications;
     ValidationSignals* signals{nullptr};
-    //! Number of script check worker threads. Zero means no parallel verification.
+    //! Number of pending validation interface callbacks at which block connection waits for them to be processed.
+    size_t max_pending_validation_callbacks{DEFAULT_MAX_PENDING_VALIDATION_CALLBACKS};
+    //! Number of script check worker threads, also used to deserialize blocks
+    //! when importing block files and to write the coins of a UTXO snapshot
+    //! when loading it. Zero means no parallel verification.
     int worker_threads_num{0};
+    //! Number of threads fetching the coins spent by a block before it is connected. Zero disables fetching ahead.
+    int input_fetch_threads_num{0};
     size_t script_execution_cache_bytes{DEFAULT_SCRIPT_EXECUTION_CACHE_BYTES};
     size_t signature_cache_bytes{DEFAULT_SIGNATURE_CACHE_BYTES};
 };
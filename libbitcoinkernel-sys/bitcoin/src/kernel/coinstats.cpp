@@ -17,18 +17,24 @@
 #include <streams.h>
 #include <sync.h>
 #include <tinyformat.h>
+#include <txdb.h>
 #include <uint256.h>
 #include <util/check.h>
 #include <util/overflow.h>
+#include <util/threadnames.h>
 #include <validation.h>
 
+#include <atomic>
 #include <cassert>
+#include <exception>
 #include <iosfwd>
 #include <iterator>
 #include <map>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace kernel {
 
@@ -60,6 +66,11 @@ static void ApplyCoinHash(HashWriter& ss, const COutPoint& outpoint, const Coin&
     TxOutSer(ss, outpoint, coin);
 }
 
+void SerializeCoinForHash(DataStream& ss, const COutPoint& outpoint, const Coin& coin)
+{
+    TxOutSer(ss, outpoint, coin);
+}
+
 void ApplyCoinHash(MuHash3072& muhash, const COutPoint& outpoint, const Coin& coin)
 {
     DataStream ss{};
@@ -111,20 +122,39 @@ static void ApplyStats(CCoinsStats& stats, const std::map<uint32_t, Coin>& outpu
     }
 }
 
-//! Calculate statistics about the unspent transaction output set
-template <typename T>
-static bool ComputeUTXOStats(CCoinsView* view, CCoinsStats& stats, T hash_obj, const std::function<void()>& interruption_point)
+static void CombineStats(CCoinsStats& stats, const CCoinsStats& part)
 {
-    std::unique_ptr<CCoinsViewCursor> pcursor(view->Cursor());
-    assert(pcursor);
+    stats.nTransactions += part.nTransactions;
+    stats.nTransactionOutputs += part.nTransactionOutputs;
+    stats.nBogoSize += part.nBogoSize;
+    stats.coins_count += part.coins_count;
+    if (stats.total_amount.has_value() && part.total_amount.has_value()) {
+        stats.total_amount = CheckedAdd(*stats.total_amount, *part.total_amount);
+    } else {
+        stats.total_amount = std::nullopt;
+    }
+}
+
+static void CombineHash(MuHash3072& muhash, const MuHash3072& part)
+{
+    muhash *= part;
+}
 
+static void CombineHash(std::nullptr_t, std::nullptr_t) {}
+
+//! Apply the coins from the position of the cursor up to, but excluding, the
+//! coins of the txid end, or up to the end of the view if end is not set.
+template <typename T>
+static bool ApplyCoins(CCoinsViewCursor& cursor, const std::optional<Txid>& end, CCoinsStats& stats, T& hash_obj, const std::function<void()>& interruption_point)
+{
     Txid prevkey;
     std::map<uint32_t, Coin> outputs;
-    while (pcursor->Valid()) {
+    while (cursor.Valid()) {
         if (interruption_point) interruption_point();
         COutPoint key;
         Coin coin;
-        if (pcursor->GetKey(key) && pcursor->GetValue(coin)) {
+        if (cursor.GetKey(key) && cursor.GetValue(coin)) {
+            if (end && !(key.hash < *end)) break;
             if (!outputs.empty() && key.hash != prevkey) {
                 ApplyStats(stats, outputs);
                 ApplyHash(hash_obj, prevkey, outputs);
@@ -137,12 +167,25 @@ static bool ComputeUTXOStats(CCoinsView* view, CCoinsStats& stats, T hash_obj, c
             LogError("%s: unable to read value\n", __func__);
             return false;
         }
-        pcursor->Next();
+        cursor.Next();
     }
     if (!outputs.empty()) {
         ApplyStats(stats, outputs);
         ApplyHash(hash_obj, prevkey, outputs);
     }
+    return true;
+}
+
+//! Calculate statistics about the unspent transaction output set
+template <typename T>
+static bool ComputeUTXOStats(CCoinsView* view, CCoinsStats& stats, T hash_obj, const std::function<void()>& interruption_point)
+{
+    std::unique_ptr<CCoinsViewCursor> pcursor(view->Cursor());
+    assert(pcursor);
+
+    if (!ApplyCoins(*pcursor, /*end=*/std::nullopt, stats, hash_obj, interruption_point)) {
+        return false;
+    }
 
     FinalizeHash(hash_obj, stats);
 
@@ -179,6 +222,86 @@ std::optional<CCoinsStats> ComputeUTXOStats(CoinStatsHashType hash_type, CCoinsV
     return stats;
 }
 
+//! Number of txid ranges the coins are split into when computing the
+//! statistics in parallel, by the first byte of the txid.
+static constexpr int UTXO_STATS_RANGES{256};
+
+//! Calculate statistics about the unspent transaction output set, reading
+//! ranges of txids on worker_threads_num threads. Only valid for hashes that
+//! do not depend on the order of the coins.
+template <typename T>
+static bool ComputeUTXOStatsParallel(CCoinsViewDB& view, CCoinsStats& stats, T hash_obj, int worker_threads_num, const std::function<void()>& interruption_point)
+{
+    std::atomic<int> next_range{0};
+    std::atomic<bool> failed{false};
+    Mutex mutex;
+    std::exception_ptr exception;
+
+    std::vector<std::thread> threads;
+    threads.reserve(worker_threads_num);
+    for (int n{0}; n < worker_threads_num; ++n) {
+        threads.emplace_back([&, n]() {
+            util::ThreadRename(strprintf("utxostats.%i", n));
+            CCoinsStats part;
+            T part_hash{};
+            try {
+                for (int range{next_range++}; range < UTXO_STATS_RANGES && !failed; range = next_range++) {
+                    uint256 start;
+                    start.data()[0] = range;
+                    std::optional<Txid> end;
+                    if (range + 1 < UTXO_STATS_RANGES) {
+                        uint256 end_txid;
+                        end_txid.data()[0] = range + 1;
+                        end = Txid::FromUint256(end_txid);
+                    }
+                    std::unique_ptr<CCoinsViewCursor> cursor{view.Cursor(COutPoint{Txid::FromUint256(start), 0})};
+                    if (!ApplyCoins(*cursor, end, part, part_hash, interruption_point)) {
+                        failed = true;
+                        return;
+                    }
+                }
+            } catch (...) {
+                LOCK(mutex);
+                if (!exception) exception = std::current_exception();
+                failed = true;
+                return;
+            }
+            LOCK(mutex);
+            CombineStats(stats, part);
+            CombineHash(hash_obj, part_hash);
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    if (exception) std::rethrow_exception(exception);
+    if (failed) return false;
+
+    FinalizeHash(hash_obj, stats);
+
+    stats.nDiskSize = view.EstimateSize();
+
+    return true;
+}
+
+std::optional<CCoinsStats> ComputeUTXOStats(CoinStatsHashType hash_type, CCoinsViewDB& view, node::BlockManager& blockman, int worker_threads_num, const std::function<void()>& interruption_point)
+{
+    if (worker_threads_num <= 0 || hash_type == CoinStatsHashType::HASH_SERIALIZED) {
+        return ComputeUTXOStats(hash_type, &view, blockman, interruption_point);
+    }
+
+    CBlockIndex* pindex = WITH_LOCK(::cs_main, return blockman.LookupBlockIndex(view.GetBestBlock()));
+    CCoinsStats stats{Assert(pindex)->nHeight, pindex->GetBlockHash()};
+
+    const bool success{hash_type == CoinStatsHashType::MUHASH ?
+                           ComputeUTXOStatsParallel(view, stats, MuHash3072{}, worker_threads_num, interruption_point) :
+                           ComputeUTXOStatsParallel(view, stats, nullptr, worker_threads_num, interruption_point)};
+    if (!success) {
+        return std::nullopt;
+    }
+    return stats;
+}
+
 static void FinalizeHash(HashWriter& ss, CCoinsStats& stats)
 {
     stats.hashSerialized = ss.GetHash();
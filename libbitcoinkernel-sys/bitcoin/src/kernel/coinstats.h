@@ -16,6 +16,7 @@
 #include <optional>
 
 class CCoinsView;
+class CCoinsViewDB;
 class Coin;
 class COutPoint;
 class CScript;
@@ -76,9 +77,25 @@ struct CCoinsStats {
 uint64_t GetBogoSize(const CScript& script_pub_key);
 
 void ApplyCoinHash(MuHash3072& muhash, const COutPoint& outpoint, const Coin& coin);
+//! Append the data of a coin that the serialized hash of the UTXO set
+//! (CoinStatsHashType::HASH_SERIALIZED) commits to. Hashing the data of all
+//! coins, ordered by outpoint, with a HashWriter yields hashSerialized.
+void SerializeCoinForHash(DataStream& ss, const COutPoint& outpoint, const Coin& coin);
 void RemoveCoinHash(MuHash3072& muhash, const COutPoint& outpoint, const Coin& coin);
 
 std::optional<CCoinsStats> ComputeUTXOStats(CoinStatsHashType hash_type, CCoinsView* view, node::BlockManager& blockman, const std::function<void()>& interruption_point = {});
+
+/**
+ * Compute the statistics of the coins database on worker_threads_num threads.
+ * The coins are split into ranges of txids that are read concurrently, and
+ * the partial MuHash accumulators of the ranges are combined. The serialized
+ * hash depends on the order of the coins, so it is always computed on the
+ * calling thread, as is everything if worker_threads_num is not positive.
+ *
+ * The database must not be written to until the function returns. The
+ * interruption point is called from the worker threads.
+ */
+std::optional<CCoinsStats> ComputeUTXOStats(CoinStatsHashType hash_type, CCoinsViewDB& view, node::BlockManager& blockman, int worker_threads_num, const std::function<void()>& interruption_point = {});
 } // namespace kernel
 
 #endif // BITCOIN_KERNEL_COINSTATS_H
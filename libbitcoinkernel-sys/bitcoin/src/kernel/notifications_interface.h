@@ -6,6 +6,7 @@
 #define BITCOIN_KERNEL_NOTIFICATIONS_INTERFACE_H
 
 #include <cstdint>
+#include <string_view>
 #include <variant>
 
 class CBlockIndex;
@@ -17,6 +18,7 @@ namespace kernel {
 //! Result type for use with std::variant to indicate that an operation should be interrupted.
 struct Interrupted{};
 enum class Warning;
+struct ValidationStats;
 
 
 //! Simple result type for functions that need to propagate an interrupt status and don't have other return values.
@@ -39,6 +41,18 @@ public:
 
     [[nodiscard]] virtual InterruptResult blockTip(SynchronizationState state, const CBlockIndex& index, double verification_progress) { return {}; }
     virtual void headerTip(SynchronizationState state, int64_t height, int64_t timestamp, bool presync) {}
+    //! Sent when the background chainstate, which validates the blocks below
+    //! a loaded assumeutxo snapshot, connects blocks. The progress is the
+    //! fraction of the transactions up to the snapshot block validated so far.
+    virtual void backgroundBlockTip(const CBlockIndex& index, double verification_progress) {}
+    //! Sent after a block was connected to a chainstate, with the time spent
+    //! in each phase of connecting it and the work done.
+    virtual void blockConnectedStats(const CBlockIndex& index, const ValidationStats& stats) {}
+    //! Sent when script verification is enabled or disabled while connecting
+    //! blocks to the normal chainstate, depending on whether the block is
+    //! covered by the assumed valid block. The reason why scripts are verified
+    //! is empty if they are not.
+    virtual void scriptChecks(const CBlockIndex& index, bool enabled, std::string_view reason) {}
     virtual void progress(const bilingual_str& title, int progress_percent, bool resume_possible) {}
     virtual void warningSet(Warning id, const bilingual_str& message) {}
     virtual void warningUnset(Warning id) {}
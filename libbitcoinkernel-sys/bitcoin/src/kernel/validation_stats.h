@@ -0,0 +1,71 @@
+// Copyright (c) 2025 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_KERNEL_VALIDATION_STATS_H
+#define BITCOIN_KERNEL_VALIDATION_STATS_H
+
+#include <util/time.h>
+
+#include <cstdint>
+
+namespace kernel {
+
+/**
+ * Time spent in the phases of connecting blocks to a chainstate, and the work
+ * done while connecting them. Holds either the totals of a chainstate manager
+ * or the statistics of a single block.
+ */
+struct ValidationStats {
+    //! Number of blocks passed to ConnectBlock, including blocks that were
+    //! only checked.
+    int64_t blocks{0};
+    //! Number of transactions, inputs (including the coinbase input) and the
+    //! signature operations cost of the connected transactions.
+    int64_t transactions{0};
+    int64_t inputs{0};
+    int64_t sigops_cost{0};
+
+    //! Phases of ConnectBlock.
+    SteadyClock::duration time_check{};
+    SteadyClock::duration time_forks{};
+    SteadyClock::duration time_connect{};
+    SteadyClock::duration time_verify{};
+    SteadyClock::duration time_undo{};
+    SteadyClock::duration time_index{};
+
+    //! Phases of ConnectTip. time_connect_total covers ConnectBlock and
+    //! time_total all of ConnectTip, including loading the block.
+    SteadyClock::duration time_load{};
+    SteadyClock::duration time_connect_total{};
+    SteadyClock::duration time_flush{};
+    SteadyClock::duration time_chainstate{};
+    SteadyClock::duration time_post_connect{};
+    SteadyClock::duration time_total{};
+
+    friend ValidationStats operator-(const ValidationStats& a, const ValidationStats& b)
+    {
+        return {
+            .blocks = a.blocks - b.blocks,
+            .transactions = a.transactions - b.transactions,
+            .inputs = a.inputs - b.inputs,
+            .sigops_cost = a.sigops_cost - b.sigops_cost,
+            .time_check = a.time_check - b.time_check,
+            .time_forks = a.time_forks - b.time_forks,
+            .time_connect = a.time_connect - b.time_connect,
+            .time_verify = a.time_verify - b.time_verify,
+            .time_undo = a.time_undo - b.time_undo,
+            .time_index = a.time_index - b.time_index,
+            .time_load = a.time_load - b.time_load,
+            .time_connect_total = a.time_connect_total - b.time_connect_total,
+            .time_flush = a.time_flush - b.time_flush,
+            .time_chainstate = a.time_chainstate - b.time_chainstate,
+            .time_post_connect = a.time_post_connect - b.time_post_connect,
+            .time_total = a.time_total - b.time_total,
+        };
+    }
+};
+
+} // namespace kernel
+
+#endif // BITCOIN_KERNEL_VALIDATION_STATS_H
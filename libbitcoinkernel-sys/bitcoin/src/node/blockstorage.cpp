@@ -31,6 +31,7 @@
 #include <util/batchpriority.h>
 #include <util/check.h>
 #include <util/fs.h>
+#include <util/fs_helpers.h>
 #include <util/obfuscation.h>
 #include <util/signalinterrupt.h>
 #include <util/strencodings.h>
@@ -38,10 +39,15 @@
 #include <util/translation.h>
 #include <validation.h>
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <exception>
+#include <limits>
 #include <map>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 namespace kernel {
 static constexpr uint8_t DB_BLOCK_FILES{'f'};
@@ -49,6 +55,7 @@ static constexpr uint8_t DB_BLOCK_INDEX{'b'};
 static constexpr uint8_t DB_FLAG{'F'};
 static constexpr uint8_t DB_REINDEX_FLAG{'R'};
 static constexpr uint8_t DB_LAST_BLOCK{'l'};
+static constexpr uint8_t DB_BLOCK_INDEX_SNAPSHOT{'s'};
 // Keys used in previous version that might still be found in the DB:
 // BlockTreeDB::DB_TXINDEX_BLOCK{'T'};
 // BlockTreeDB::DB_TXINDEX{'t'}
@@ -78,9 +85,62 @@ bool BlockTreeDB::ReadLastBlockFile(int& nFile)
     return Read(DB_LAST_BLOCK, nFile);
 }
 
+bool BlockTreeDB::ReadBlockIndexSnapshotId(uint256& id)
+{
+    return Read(DB_BLOCK_INDEX_SNAPSHOT, id);
+}
+
+bool BlockTreeDB::WriteBlockIndexSnapshotId(const uint256& id)
+{
+    return Write(DB_BLOCK_INDEX_SNAPSHOT, id, /*fSync=*/true);
+}
+
+namespace {
+//! Reads a database value as the bytes it is stored as.
+struct RawValue {
+    std::vector<std::byte> bytes;
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        bytes.resize(s.size());
+        s.read(bytes);
+    }
+};
+} // namespace
+
+bool BlockTreeDB::HashBlockTree(uint256& hash)
+{
+    HashWriter hasher{};
+    int last_file{-1};
+    (void)ReadLastBlockFile(last_file);
+    hasher << last_file;
+    std::unique_ptr<CDBIterator> pcursor(NewIterator());
+    pcursor->Seek(std::make_pair(DB_BLOCK_FILES, int{0}));
+    std::pair<uint8_t, int> key;
+    CBlockFileInfo info;
+    while (pcursor->Valid() && pcursor->GetKey(key) && key.first == DB_BLOCK_FILES) {
+        if (!pcursor->GetValue(info)) return false;
+        hasher << key.second << info;
+        pcursor->Next();
+    }
+    pcursor->Seek(std::make_pair(DB_BLOCK_INDEX, uint256()));
+    std::pair<uint8_t, uint256> index_key;
+    RawValue value;
+    while (pcursor->Valid() && pcursor->GetKey(index_key) && index_key.first == DB_BLOCK_INDEX) {
+        if (!pcursor->GetValue(value)) return false;
+        hasher << index_key.second << value.bytes;
+        pcursor->Next();
+    }
+    hash = hasher.GetHash();
+    return true;
+}
+
 bool BlockTreeDB::WriteBatchSync(const std::vector<std::pair<int, const CBlockFileInfo*>>& fileInfo, int nLastFile, const std::vector<const CBlockIndex*>& blockinfo)
 {
     CDBBatch batch(*this);
+    // Any block index snapshot no longer matches the database.
+    batch.Erase(DB_BLOCK_INDEX_SNAPSHOT);
     for (const auto& [file, info] : fileInfo) {
         batch.Write(std::make_pair(DB_BLOCK_FILES, file), *info);
     }
@@ -382,6 +442,12 @@ void BlockManager::UpdatePruneLock(const std::string& name, const PruneLockInfo&
     m_prune_locks[name] = lock_info;
 }
 
+bool BlockManager::DeletePruneLock(const std::string& name)
+{
+    AssertLockHeld(::cs_main);
+    return m_prune_locks.erase(name) > 0;
+}
+
 CBlockIndex* BlockManager::InsertBlockIndex(const uint256& hash)
 {
     AssertLockHeld(cs_main);
@@ -398,9 +464,145 @@ CBlockIndex* BlockManager::InsertBlockIndex(const uint256& hash)
     return pindex;
 }
 
+//! Identifies the file format of a block index snapshot.
+static constexpr std::array<uint8_t, 5> BLOCK_INDEX_SNAPSHOT_MAGIC{'b', 'i', 'd', 'x', 0xff};
+static constexpr uint16_t BLOCK_INDEX_SNAPSHOT_VERSION{3};
+//! Position of the previous entry of an entry without one.
+static constexpr uint32_t BLOCK_INDEX_SNAPSHOT_NO_PREV{std::numeric_limits<uint32_t>::max()};
+//! Size of an entry: the block hash and merkle root, and eleven 32 bit fields.
+static constexpr size_t BLOCK_INDEX_SNAPSHOT_ENTRY_SIZE{2 * uint256::size() + 11 * sizeof(uint32_t)};
+
+bool BlockManager::WriteBlockIndexSnapshot()
+{
+    AssertLockHeld(::cs_main);
+    if (!m_opts.block_index_snapshot) return true;
+    // The snapshot has to match the database, so write all changes first.
+    // This also erases the id of a previous snapshot.
+    if (!WriteBlockIndexDB()) return false;
+
+    // Entries are ordered by height, so an entry's previous entry comes first.
+    std::vector<CBlockIndex*> indexes{GetAllBlockIndices()};
+    std::sort(indexes.begin(), indexes.end(), CBlockIndexHeightOnlyComparator());
+    std::unordered_map<const CBlockIndex*, uint32_t> positions;
+    positions.reserve(indexes.size());
+
+    const uint256 id{GetRandHash()};
+    uint256 block_tree_hash;
+    if (!m_block_tree_db->HashBlockTree(block_tree_hash)) {
+        LogError("Failed to read the block tree database for the block index snapshot");
+        return false;
+    }
+    const fs::path path{BlockIndexSnapshotPath()};
+    const fs::path tmp_path{path + ".new"};
+    AutoFile file{fsbridge::fopen(tmp_path, "wb")};
+    if (file.IsNull()) {
+        LogError("Failed to open block index snapshot file %s for writing", fs::PathToString(tmp_path));
+        return false;
+    }
+    try {
+        HashedSourceWriter writer{file};
+        writer << BLOCK_INDEX_SNAPSHOT_MAGIC << BLOCK_INDEX_SNAPSHOT_VERSION << id << block_tree_hash << uint64_t(indexes.size());
+        for (const CBlockIndex* pindex : indexes) {
+            const uint32_t prev{pindex->pprev ? positions.at(pindex->pprev) : BLOCK_INDEX_SNAPSHOT_NO_PREV};
+            positions.emplace(pindex, positions.size());
+            writer << pindex->GetBlockHash() << prev << pindex->nHeight << pindex->nStatus << pindex->nTx
+                   << pindex->nFile << pindex->nDataPos << pindex->nUndoPos
+                   << pindex->nVersion << pindex->hashMerkleRoot << pindex->nTime << pindex->nBits << pindex->nNonce;
+        }
+        file << writer.GetHash();
+    } catch (const std::exception& e) {
+        LogError("Failed to write block index snapshot file %s: %s", fs::PathToString(tmp_path), e.what());
+        (void)file.fclose();
+        fs::remove(tmp_path);
+        return false;
+    }
+    if (!file.Commit() || file.fclose() != 0 || !RenameOver(tmp_path, path)) {
+        LogError("Failed to write block index snapshot file %s", fs::PathToString(path));
+        fs::remove(tmp_path);
+        return false;
+    }
+    // Only tie the file to the database once it is complete.
+    if (!m_block_tree_db->WriteBlockIndexSnapshotId(id)) return false;
+    LogInfo("Wrote %d block index entries to %s", indexes.size(), fs::PathToString(path));
+    return true;
+}
+
+bool BlockManager::LoadBlockIndexSnapshot()
+{
+    AssertLockHeld(cs_main);
+    uint256 id;
+    if (!m_block_tree_db->ReadBlockIndexSnapshotId(id)) {
+        LogInfo("No block index snapshot matches the block tree database");
+        return false;
+    }
+    const fs::path path{BlockIndexSnapshotPath()};
+    AutoFile file{fsbridge::fopen(path, "rb")};
+    if (file.IsNull()) {
+        LogInfo("Block index snapshot file %s not found", fs::PathToString(path));
+        return false;
+    }
+
+    const auto fail{[&](const std::string& reason) EXCLUSIVE_LOCKS_REQUIRED(cs_main) {
+        LogWarning("Ignoring block index snapshot file %s: %s", fs::PathToString(path), reason);
+        m_block_index.clear();
+        return false;
+    }};
+    try {
+        std::vector<std::byte> data(fs::file_size(path));
+        file.read(data);
+        if (data.size() < uint256::size()) return fail("file too short");
+        const auto content{std::span{data}.first(data.size() - uint256::size())};
+        uint256 checksum;
+        SpanReader{std::span{data}.last(uint256::size())} >> checksum;
+        if (Hash(content) != checksum) return fail("checksum mismatch");
+
+        SpanReader reader{content};
+        std::array<uint8_t, BLOCK_INDEX_SNAPSHOT_MAGIC.size()> magic;
+        uint16_t version;
+        uint256 file_id;
+        uint256 file_block_tree_hash;
+        uint64_t count;
+        reader >> magic >> version >> file_id >> file_block_tree_hash >> count;
+        if (magic != BLOCK_INDEX_SNAPSHOT_MAGIC || version != BLOCK_INDEX_SNAPSHOT_VERSION) return fail("unknown format");
+        if (file_id != id) return fail("written for a different block tree database state");
+        // Other software writing to the database, such as other versions,
+        // leaves the id in place, so the records themselves are compared too.
+        uint256 block_tree_hash;
+        if (!m_block_tree_db->HashBlockTree(block_tree_hash) || file_block_tree_hash != block_tree_hash) {
+            return fail("written for a different block tree state");
+        }
+        if (reader.size() != count * BLOCK_INDEX_SNAPSHOT_ENTRY_SIZE) return fail("unexpected size");
+
+        m_block_index.reserve(count);
+        std::vector<CBlockIndex*> indexes;
+        indexes.reserve(count);
+        while (indexes.size() < count) {
+            if (m_interrupt) return fail("interrupted");
+            uint256 hash;
+            uint32_t prev;
+            reader >> hash >> prev;
+            const auto [it, inserted]{m_block_index.try_emplace(hash)};
+            if (!inserted || (prev != BLOCK_INDEX_SNAPSHOT_NO_PREV && prev >= indexes.size())) return fail("invalid entry");
+            CBlockIndex* pindex{&it->second};
+            pindex->phashBlock = &it->first;
+            pindex->pprev = prev == BLOCK_INDEX_SNAPSHOT_NO_PREV ? nullptr : indexes[prev];
+            reader >> pindex->nHeight >> pindex->nStatus >> pindex->nTx
+                   >> pindex->nFile >> pindex->nDataPos >> pindex->nUndoPos
+                   >> pindex->nVersion >> pindex->hashMerkleRoot >> pindex->nTime >> pindex->nBits >> pindex->nNonce;
+            if (!CheckProofOfWork(hash, pindex->nBits, GetConsensus())) return fail("CheckProofOfWork failed");
+            indexes.push_back(pindex);
+        }
+    } catch (const std::exception& e) {
+        return fail(e.what());
+    }
+    LogInfo("Loaded %d block index entries from %s", m_block_index.size(), fs::PathToString(path));
+    return true;
+}
+
 bool BlockManager::LoadBlockIndex(const std::optional<uint256>& snapshot_blockhash)
 {
-    if (!m_block_tree_db->LoadBlockIndexGuts(
+    const bool loaded_snapshot{m_opts.block_index_snapshot && LoadBlockIndexSnapshot()};
+    if (!loaded_snapshot && !m_block_tree_db->LoadBlockIndexGuts(
             GetConsensus(), [this](const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(cs_main) { return this->InsertBlockIndex(hash); }, m_interrupt)) {
         return false;
     }
@@ -1046,6 +1248,23 @@ bool BlockManager::ReadBlock(CBlock& block, const CBlockIndex& index) const
 }
 
 bool BlockManager::ReadRawBlock(std::vector<std::byte>& block, const FlatFilePos& pos) const
+{
+    return ReadRawBlock(pos, [&block](unsigned int blk_size) -> std::optional<std::span<std::byte>> {
+        block.resize(blk_size); // Zeroing of memory is intentional here
+        return block;
+    });
+}
+
+bool BlockManager::ReadRawBlock(std::span<std::byte> buffer, const FlatFilePos& pos, size_t& block_size) const
+{
+    return ReadRawBlock(pos, [&](unsigned int blk_size) -> std::optional<std::span<std::byte>> {
+        block_size = blk_size;
+        if (blk_size > buffer.size()) return std::nullopt;
+        return buffer.first(blk_size);
+    });
+}
+
+bool BlockManager::ReadRawBlock(const FlatFilePos& pos, const std::function<std::optional<std::span<std::byte>>(unsigned int)>& get_buffer) const
 {
     if (pos.nPos < STORAGE_HEADER_BYTES) {
         // If nPos is less than STORAGE_HEADER_BYTES, we can't read the header that precedes the block data
@@ -1078,8 +1297,9 @@ bool BlockManager::ReadRawBlock(std::vector<std::byte>& block, const FlatFilePos
             return false;
         }
 
-        block.resize(blk_size); // Zeroing of memory is intentional here
-        filein.read(block);
+        const auto block{get_buffer(blk_size)};
+        if (!block) return false;
+        filein.read(*block);
     } catch (const std::exception& e) {
         LogError("Read from block file failed: %s for %s while reading raw block", e.what(), pos.ToString());
         return false;
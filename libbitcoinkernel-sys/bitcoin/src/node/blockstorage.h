@@ -59,6 +59,11 @@ public:
     void ReadReindexing(bool& fReindexing);
     bool WriteFlag(const std::string& name, bool fValue);
     bool ReadFlag(const std::string& name, bool& fValue);
+    bool ReadBlockIndexSnapshotId(uint256& id);
+    bool WriteBlockIndexSnapshotId(const uint256& id);
+    //! Hash the number of the last block file and all block file and block
+    //! index records.
+    bool HashBlockTree(uint256& hash);
     bool LoadBlockIndexGuts(const Consensus::Params& consensusParams, std::function<CBlockIndex*(const uint256&)> insertBlockIndex, const util::SignalInterrupt& interrupt)
         EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 };
@@ -151,6 +156,15 @@ private:
     bool LoadBlockIndex(const std::optional<uint256>& snapshot_blockhash)
         EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
+    /**
+     * Populate m_block_index from the file written by WriteBlockIndexSnapshot().
+     * Return false, leaving m_block_index empty, if the file is missing, stale
+     * or corrupted.
+     */
+    bool LoadBlockIndexSnapshot() EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+
+    fs::path BlockIndexSnapshotPath() const { return m_opts.block_tree_db_params.path + ".snapshot"; }
+
     /** Return false if block file or undo file flushing fails. */
     [[nodiscard]] bool FlushBlockFile(int blockfile_num, bool fFinalize, bool finalize_undo);
 
@@ -172,6 +186,10 @@ private:
 
     AutoFile OpenUndoFile(const FlatFilePos& pos, bool fReadOnly = false) const;
 
+    /** Read the stored block at pos into the buffer returned by get_buffer for
+     *  its size. Aborts without logging if get_buffer returns std::nullopt. */
+    bool ReadRawBlock(const FlatFilePos& pos, const std::function<std::optional<std::span<std::byte>>(unsigned int)>& get_buffer) const;
+
     /* Calculate the block/rev files to delete based on height specified by user with RPC command pruneblockchain */
     void FindFilesToPruneManual(
         std::set<int>& setFilesToPrune,
@@ -304,6 +322,14 @@ public:
     bool LoadBlockIndexDB(const std::optional<uint256>& snapshot_blockhash)
         EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 
+    /**
+     * Flush the block index and write it to a file that the next
+     * LoadBlockIndexDB() reads instead of the block tree database, as long as
+     * the database did not change since. Does nothing unless the
+     * block_index_snapshot option is set.
+     */
+    bool WriteBlockIndexSnapshot() EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+
     /**
      * Remove any pruned block & undo files that are still on disk.
      * This could happen on some systems if the file was still being read while unlinked,
@@ -399,6 +425,9 @@ public:
     //! Create or update a prune lock identified by its name
     void UpdatePruneLock(const std::string& name, const PruneLockInfo& lock_info) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 
+    //! Delete the prune lock identified by its name, returns false if there was none
+    bool DeletePruneLock(const std::string& name) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+
     /** Open a block file (blk?????.dat) */
     AutoFile OpenBlockFile(const FlatFilePos& pos, bool fReadOnly) const;
 
@@ -414,6 +443,10 @@ public:
     bool ReadBlock(CBlock& block, const FlatFilePos& pos, const std::optional<uint256>& expected_hash) const;
     bool ReadBlock(CBlock& block, const CBlockIndex& index) const;
     bool ReadRawBlock(std::vector<std::byte>& block, const FlatFilePos& pos) const;
+    /** Read the stored block into buffer without allocating. If it does not
+     *  fit, block_size is set to the required size and false is returned
+     *  without reading the block data. */
+    bool ReadRawBlock(std::span<std::byte> buffer, const FlatFilePos& pos, size_t& block_size) const;
 
     bool ReadBlockUndo(CBlockUndo& blockundo, const CBlockIndex& index) const;
 
@@ -4,7 +4,10 @@
 
 #include <node/utxo_snapshot.h>
 
+#include <coins.h>
 #include <logging.h>
+#include <primitives/transaction.h>
+#include <serialize.h>
 #include <streams.h>
 #include <sync.h>
 #include <tinyformat.h>
@@ -17,6 +20,8 @@
 #include <cstdio>
 #include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace node {
 
@@ -81,6 +86,55 @@ std::optional<uint256> ReadSnapshotBaseBlockhash(fs::path chaindir)
     return base_blockhash;
 }
 
+uint64_t WriteSnapshotCoins(AutoFile& afile, CCoinsViewCursor& cursor,
+                            const std::function<void()>& interruption_point)
+{
+    COutPoint key;
+    Txid last_hash;
+    Coin coin;
+    unsigned int iter{0};
+    uint64_t written_coins_count{0};
+    std::vector<std::pair<uint32_t, Coin>> coins;
+
+    // To reduce space the serialization format of the snapshot avoids
+    // duplication of tx hashes. The code takes advantage of the guarantee by
+    // leveldb that keys are lexicographically sorted.
+    // In the coins vector we collect all coins that belong to a certain tx hash
+    // (key.hash) and when we have them all (key.hash != last_hash) we write
+    // them to file using the below lambda function.
+    // See also https://github.com/bitcoin/bitcoin/issues/25675
+    auto write_coins_to_file = [&]() {
+        afile << last_hash;
+        WriteCompactSize(afile, coins.size());
+        for (const auto& [n, coin] : coins) {
+            WriteCompactSize(afile, n);
+            afile << coin;
+            ++written_coins_count;
+        }
+    };
+
+    cursor.GetKey(key);
+    last_hash = key.hash;
+    while (cursor.Valid()) {
+        if (interruption_point && iter % 5000 == 0) interruption_point();
+        ++iter;
+        if (cursor.GetKey(key) && cursor.GetValue(coin)) {
+            if (key.hash != last_hash) {
+                write_coins_to_file();
+                last_hash = key.hash;
+                coins.clear();
+            }
+            coins.emplace_back(key.n, coin);
+        }
+        cursor.Next();
+    }
+
+    if (!coins.empty()) {
+        write_coins_to_file();
+    }
+    return written_coins_count;
+}
+
 std::optional<fs::path> FindSnapshotChainstateDir(const fs::path& data_dir)
 {
     fs::path possible_dir =
@@ -17,12 +17,15 @@
 #include <util/fs.h>
 
 #include <cstdint>
+#include <functional>
 #include <optional>
 #include <string_view>
 
 // UTXO set snapshot magic bytes
 static constexpr std::array<uint8_t, 5> SNAPSHOT_MAGIC_BYTES = {'u', 't', 'x', 'o', 0xff};
 
+class AutoFile;
+class CCoinsViewCursor;
 class Chainstate;
 
 namespace node {
@@ -119,6 +122,14 @@ bool WriteSnapshotBaseBlockhash(Chainstate& snapshot_chainstate)
 std::optional<uint256> ReadSnapshotBaseBlockhash(fs::path chaindir)
     EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 
+//! Write the coins of the cursor in the format expected after the
+//! SnapshotMetadata of a snapshot file. The cursor has to iterate in key
+//! order, as a CCoinsViewDB cursor does, so that coins of the same
+//! transaction can be written after a single txid. Returns the number of
+//! coins written.
+uint64_t WriteSnapshotCoins(AutoFile& afile, CCoinsViewCursor& cursor,
+                            const std::function<void()>& interruption_point = {});
+
 //! Suffix appended to the chainstate (leveldb) dir when created based upon
 //! a snapshot.
 constexpr std::string_view SNAPSHOT_CHAINSTATE_SUFFIX = "_snapshot";
@@ -92,6 +92,14 @@ public:
         READWRITE(AsBase<CBlockHeader>(obj), obj.vtx);
     }
 
+    /** Read the transactions from the stream's buffer, hashing all of them together. */
+    template <HashingTxStream Stream>
+    void Unserialize(Stream& s)
+    {
+        s >> AsBase<CBlockHeader>(*this);
+        UnserializedTransaction::UnserializeMany(vtx, s);
+    }
+
     void SetNull()
     {
         CBlockHeader::SetNull();
@@ -7,16 +7,20 @@
 
 #include <consensus/amount.h>
 #include <crypto/hex_base.h>
+#include <crypto/sha256.h>
 #include <hash.h>
 #include <primitives/transaction_identifier.h>
 #include <script/script.h>
 #include <serialize.h>
+#include <span.h>
 #include <tinyformat.h>
 #include <uint256.h>
 
 #include <algorithm>
 #include <cassert>
+#include <span>
 #include <stdexcept>
+#include <vector>
 
 std::string COutPoint::ToString() const
 {
@@ -92,8 +96,77 @@ Wtxid CTransaction::ComputeWitnessHash() const
     return Wtxid::FromUint256((HashWriter{} << TX_WITH_WITNESS(*this)).GetHash());
 }
 
+namespace {
+constexpr size_t VERSION_SIZE{sizeof(CTransaction::version)};
+constexpr size_t LOCK_TIME_SIZE{sizeof(CTransaction::nLockTime)};
+
+//! Whether the serialization is the stripped one, so that the txid equals the wtxid.
+bool IsStripped(const SerializedTransaction& tx)
+{
+    return tx.stripped_begin == VERSION_SIZE && tx.stripped_end + LOCK_TIME_SIZE == tx.bytes.size();
+}
+} // namespace
+
+TransactionHashes HashSerializedTransaction(const SerializedTransaction& tx)
+{
+    if (IsStripped(tx)) {
+        const uint256 hash{(HashWriter{} << tx.bytes).GetHash()};
+        return {Txid::FromUint256(hash), Wtxid::FromUint256(hash)};
+    }
+
+    HashWriter txid_hasher{};
+    txid_hasher << tx.bytes.first(VERSION_SIZE);
+    txid_hasher << tx.bytes.subspan(tx.stripped_begin, tx.stripped_end - tx.stripped_begin);
+    txid_hasher << tx.bytes.last(LOCK_TIME_SIZE);
+    return {Txid::FromUint256(txid_hasher.GetHash()), Wtxid::FromUint256((HashWriter{} << tx.bytes).GetHash())};
+}
+
+std::vector<TransactionHashes> HashSerializedTransactions(std::span<const SerializedTransaction> txs)
+{
+    // The stripped serializations of transactions with witnesses are not contiguous in
+    // the bytes read, so copy them out first.
+    size_t scratch_size{0};
+    for (const auto& tx : txs) {
+        if (!IsStripped(tx)) scratch_size += VERSION_SIZE + tx.stripped_end - tx.stripped_begin + LOCK_TIME_SIZE;
+    }
+    std::vector<std::byte> scratch;
+    scratch.reserve(scratch_size);
+
+    std::vector<const unsigned char*> inputs;
+    std::vector<size_t> sizes;
+    inputs.reserve(2 * txs.size());
+    sizes.reserve(2 * txs.size());
+    const auto add_input{[&](std::span<const std::byte> bytes) {
+        inputs.push_back(UCharCast(bytes.data()));
+        sizes.push_back(bytes.size());
+    }};
+    for (const auto& tx : txs) {
+        add_input(tx.bytes);
+        if (IsStripped(tx)) continue;
+        const size_t stripped_pos{scratch.size()};
+        scratch.insert(scratch.end(), tx.bytes.begin(), tx.bytes.begin() + VERSION_SIZE);
+        scratch.insert(scratch.end(), tx.bytes.begin() + tx.stripped_begin, tx.bytes.begin() + tx.stripped_end);
+        scratch.insert(scratch.end(), tx.bytes.end() - LOCK_TIME_SIZE, tx.bytes.end());
+        add_input(std::span{scratch}.subspan(stripped_pos));
+    }
+
+    std::vector<unsigned char> digests(32 * inputs.size());
+    SHA256DMulti(digests.data(), inputs.data(), sizes.data(), inputs.size());
+
+    std::vector<TransactionHashes> hashes;
+    hashes.reserve(txs.size());
+    size_t input{0};
+    for (const auto& tx : txs) {
+        const uint256 witness_hash{std::span{digests}.subspan(32 * input++, 32)};
+        const uint256 hash{IsStripped(tx) ? witness_hash : uint256{std::span{digests}.subspan(32 * input++, 32)}};
+        hashes.push_back({Txid::FromUint256(hash), Wtxid::FromUint256(witness_hash)});
+    }
+    return hashes;
+}
+
 CTransaction::CTransaction(const CMutableTransaction& tx) : vin(tx.vin), vout(tx.vout), version{tx.version}, nLockTime{tx.nLockTime}, m_has_witness{ComputeHasWitness()}, hash{ComputeHash()}, m_witness_hash{ComputeWitnessHash()} {}
 CTransaction::CTransaction(CMutableTransaction&& tx) : vin(std::move(tx.vin)), vout(std::move(tx.vout)), version{tx.version}, nLockTime{tx.nLockTime}, m_has_witness{ComputeHasWitness()}, hash{ComputeHash()}, m_witness_hash{ComputeWitnessHash()} {}
+CTransaction::CTransaction(UnserializedTransaction&& tx) : vin(std::move(tx.m_tx.vin)), vout(std::move(tx.m_tx.vout)), version{tx.m_tx.version}, nLockTime{tx.m_tx.nLockTime}, m_has_witness{ComputeHasWitness()}, hash{tx.m_hashes.hash}, m_witness_hash{tx.m_hashes.witness_hash} {}
 
 CAmount CTransaction::GetValueOut() const
 {
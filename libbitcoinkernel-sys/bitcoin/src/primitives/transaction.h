@@ -13,14 +13,17 @@
 #include <serialize.h>
 #include <uint256.h>
 
+#include <concepts>
 #include <cstddef>
 #include <cstdint>
 #include <ios>
 #include <limits>
 #include <memory>
 #include <numeric>
+#include <span>
 #include <string>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -187,6 +190,7 @@ public:
 };
 
 struct CMutableTransaction;
+class UnserializedTransaction;
 
 struct TransactionSerParams {
     const bool allow_witness;
@@ -195,6 +199,41 @@ struct TransactionSerParams {
 static constexpr TransactionSerParams TX_WITH_WITNESS{.allow_witness = true};
 static constexpr TransactionSerParams TX_NO_WITNESS{.allow_witness = false};
 
+/** A stream that reads from contiguous memory, with data() pointing at the next byte to read. */
+template <typename Stream>
+concept SpanReadStream = requires(const Stream& s) {
+    { s.data() } -> std::same_as<const std::byte*>;
+    { s.size() } -> std::same_as<size_t>;
+};
+
+/** A stream transactions can be hashed from while they are read, possibly wrapped in a ParamsStream. */
+template <typename Stream>
+concept HashingTxStream = SpanReadStream<Stream> ||
+    (ContainsStream<Stream> && SpanReadStream<std::remove_cvref_t<decltype(std::declval<Stream&>().GetStream())>>);
+
+/** The txid and wtxid of a transaction. */
+struct TransactionHashes {
+    Txid hash;
+    Wtxid witness_hash;
+};
+
+/** The bytes a transaction was read from, which remain valid until the stream they are
+ *  read from has been read to its end. */
+struct SerializedTransaction {
+    //! The transaction as it was read, nLockTime included
+    std::span<const std::byte> bytes;
+    //! Where its inputs start, after the marker and flag if there are any
+    size_t stripped_begin;
+    //! Where its outputs end, before any witnesses
+    size_t stripped_end;
+};
+
+/** Hash a serialized transaction without reserializing it. */
+TransactionHashes HashSerializedTransaction(const SerializedTransaction& tx);
+
+/** Hash many serialized transactions, such as all transactions of a block, together. */
+std::vector<TransactionHashes> HashSerializedTransactions(std::span<const SerializedTransaction> txs);
+
 /**
  * Basic transaction serialization format:
  * - uint32_t version
@@ -212,10 +251,18 @@ static constexpr TransactionSerParams TX_NO_WITNESS{.allow_witness = false};
  *   - CScriptWitness scriptWitness; (deserialized into CTxIn)
  * - uint32_t nLockTime
  */
-template<typename Stream, typename TxType>
-void UnserializeTransaction(TxType& tx, Stream& s, const TransactionSerParams& params)
+template<typename Stream, typename TxType, typename OnRead>
+void UnserializeTransaction(TxType& tx, Stream& s, const TransactionSerParams& params, OnRead&& on_read)
 {
     const bool fAllowWitness = params.allow_witness;
+    /* When hashing the transaction from the bytes read, the remaining size of the stream
+     * at its start and the part of it that makes up the serialization without witness. */
+    size_t start_size{0};
+    size_t stripped_begin{sizeof(tx.version)};
+    size_t stripped_end{0};
+    if constexpr (HashingTxStream<Stream>) {
+        start_size = s.size();
+    }
 
     s >> tx.version;
     unsigned char flags = 0;
@@ -227,6 +274,7 @@ void UnserializeTransaction(TxType& tx, Stream& s, const TransactionSerParams& p
         /* We read a dummy or an empty vin. */
         s >> flags;
         if (flags != 0) {
+            stripped_begin += 2 * sizeof(flags);
             s >> tx.vin;
             s >> tx.vout;
         }
@@ -234,6 +282,9 @@ void UnserializeTransaction(TxType& tx, Stream& s, const TransactionSerParams& p
         /* We read a non-empty vin. Assume a normal vout follows. */
         s >> tx.vout;
     }
+    if constexpr (HashingTxStream<Stream>) {
+        stripped_end = start_size - s.size();
+    }
     if ((flags & 1) && fAllowWitness) {
         /* The witness flag is present, and we support witnesses. */
         flags ^= 1;
@@ -249,9 +300,29 @@ void UnserializeTransaction(TxType& tx, Stream& s, const TransactionSerParams& p
         /* Unknown flag in the serialization */
         throw std::ios_base::failure("Unknown transaction optional data");
     }
+    if constexpr (HashingTxStream<Stream>) {
+        /* Hand out the bytes read before reading nLockTime, as a stream may drop its
+         * buffer once it has been read to the end. */
+        if (s.size() >= sizeof(tx.nLockTime)) {
+            const size_t read_size{start_size - s.size()};
+            const std::byte* read_pos;
+            if constexpr (ContainsStream<Stream>) {
+                read_pos = s.GetStream().data();
+            } else {
+                read_pos = s.data();
+            }
+            on_read(SerializedTransaction{{read_pos - read_size, read_size + sizeof(tx.nLockTime)}, stripped_begin, stripped_end});
+        }
+    }
     s >> tx.nLockTime;
 }
 
+template<typename Stream, typename TxType>
+void UnserializeTransaction(TxType& tx, Stream& s, const TransactionSerParams& params)
+{
+    UnserializeTransaction(tx, s, params, [](const SerializedTransaction&) {});
+}
+
 template<typename Stream, typename TxType>
 void SerializeTransaction(const TxType& tx, Stream& s, const TransactionSerParams& params)
 {
@@ -323,6 +394,8 @@ public:
     /** Convert a CMutableTransaction into a CTransaction. */
     explicit CTransaction(const CMutableTransaction& tx);
     explicit CTransaction(CMutableTransaction&& tx);
+    /** Take over a transaction along with the hashes computed while reading it. */
+    explicit CTransaction(UnserializedTransaction&& tx);
 
     template <typename Stream>
     inline void Serialize(Stream& s) const {
@@ -335,6 +408,12 @@ public:
     CTransaction(deserialize_type, const TransactionSerParams& params, Stream& s) : CTransaction(CMutableTransaction(deserialize, params, s)) {}
     template <typename Stream>
     CTransaction(deserialize_type, Stream& s) : CTransaction(CMutableTransaction(deserialize, s)) {}
+    /** Streams reading from contiguous memory have the txid and wtxid hashed from the bytes
+     *  read, instead of serializing the transaction again. */
+    template <HashingTxStream Stream>
+    CTransaction(deserialize_type, const TransactionSerParams& params, Stream& s) : CTransaction(UnserializedTransaction(deserialize, params, s)) {}
+    template <HashingTxStream Stream>
+    CTransaction(deserialize_type, Stream& s) : CTransaction(UnserializedTransaction(deserialize, s.template GetParams<TransactionSerParams>(), s)) {}
 
     bool IsNull() const {
         return vin.empty() && vout.empty();
@@ -423,4 +502,48 @@ struct CMutableTransaction
 typedef std::shared_ptr<const CTransaction> CTransactionRef;
 template <typename Tx> static inline CTransactionRef MakeTransactionRef(Tx&& txIn) { return std::make_shared<const CTransaction>(std::forward<Tx>(txIn)); }
 
+/** A transaction read from a HashingTxStream, together with its txid and wtxid. */
+class UnserializedTransaction
+{
+    CMutableTransaction m_tx;
+    TransactionHashes m_hashes;
+
+    UnserializedTransaction(CMutableTransaction&& tx, const TransactionHashes& hashes) : m_tx{std::move(tx)}, m_hashes{hashes} {}
+
+    friend class CTransaction;
+
+public:
+    template <HashingTxStream Stream>
+    UnserializedTransaction(deserialize_type, const TransactionSerParams& params, Stream& s)
+    {
+        UnserializeTransaction(m_tx, s, params, [&](const SerializedTransaction& tx) { m_hashes = HashSerializedTransaction(tx); });
+    }
+
+    /** Read a vector of transactions, such as those of a block, hashing all of them together. */
+    template <HashingTxStream Stream>
+    static void UnserializeMany(std::vector<CTransactionRef>& txs, Stream& s)
+    {
+        const TransactionSerParams& params{s.template GetParams<TransactionSerParams>()};
+        txs.clear();
+        const size_t count{ReadCompactSize(s)};
+        std::vector<CMutableTransaction> read_txs;
+        std::vector<SerializedTransaction> serialized_txs;
+        std::vector<TransactionHashes> hashes;
+        // Grow as transactions are read rather than trusting the count.
+        while (read_txs.size() < count) {
+            auto& tx{read_txs.emplace_back()};
+            const bool last{read_txs.size() == count};
+            UnserializeTransaction(tx, s, params, [&](const SerializedTransaction& serialized) {
+                serialized_txs.push_back(serialized);
+                // The stream may end with this transaction, so hash them all before it does.
+                if (last) hashes = HashSerializedTransactions(serialized_txs);
+            });
+        }
+        txs.reserve(count);
+        for (size_t i{0}; i < count; ++i) {
+            txs.push_back(std::make_shared<const CTransaction>(UnserializedTransaction{std::move(read_txs[i]), hashes[i]}));
+        }
+    }
+};
+
 #endif // BITCOIN_PRIMITIVES_TRANSACTION_H
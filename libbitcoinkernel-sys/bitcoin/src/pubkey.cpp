@@ -241,6 +241,33 @@ bool XOnlyPubKey::VerifySchnorr(const uint256& msg, std::span<const unsigned cha
     return secp256k1_schnorrsig_verify(secp256k1_context_static, sigbytes.data(), msg.begin(), 32, &pubkey);
 }
 
+void SchnorrSignatureBatch::Add(const XOnlyPubKey& pubkey, const uint256& msg, std::span<const unsigned char> sigbytes)
+{
+    assert(sigbytes.size() == 64);
+    Entry& entry{m_entries.emplace_back(pubkey, msg)};
+    std::copy(sigbytes.begin(), sigbytes.end(), entry.sig.begin());
+}
+
+bool SchnorrSignatureBatch::Verify() const
+{
+    const size_t n{m_entries.size()};
+    if (n == 0) return true;
+    if (n == 1) return m_entries[0].pubkey.VerifySchnorr(m_entries[0].msg, m_entries[0].sig);
+
+    std::vector<secp256k1_xonly_pubkey> pubkeys(n);
+    std::vector<const secp256k1_xonly_pubkey*> pubkey_ptrs(n);
+    std::vector<const unsigned char*> sigs(n);
+    std::vector<const unsigned char*> msgs(n);
+    const std::vector<size_t> msglens(n, 32);
+    for (size_t i{0}; i < n; ++i) {
+        if (!secp256k1_xonly_pubkey_parse(secp256k1_context_static, &pubkeys[i], m_entries[i].pubkey.data())) return false;
+        pubkey_ptrs[i] = &pubkeys[i];
+        sigs[i] = m_entries[i].sig.data();
+        msgs[i] = m_entries[i].msg.begin();
+    }
+    return secp256k1_schnorrsig_verify_batch(secp256k1_context_static, sigs.data(), msgs.data(), msglens.data(), pubkey_ptrs.data(), n);
+}
+
 static const HashWriter HASHER_TAPTWEAK{TaggedHash("TapTweak")};
 
 uint256 XOnlyPubKey::ComputeTapTweakHash(const uint256* merkle_root) const
@@ -12,6 +12,7 @@
 #include <span.h>
 #include <uint256.h>
 
+#include <array>
 #include <cstring>
 #include <optional>
 #include <vector>
@@ -309,6 +310,35 @@ public:
     SERIALIZE_METHODS(XOnlyPubKey, obj) { READWRITE(obj.m_keydata); }
 };
 
+/** A set of Schnorr signatures that are verified together.
+ *
+ * Verify() succeeds if and only if all added signatures are valid, except
+ * with negligible probability, and is faster than verifying them one by one.
+ * It does not tell which signature is invalid; callers that need to know
+ * verify the signatures individually when the batch fails.
+ */
+class SchnorrSignatureBatch
+{
+private:
+    struct Entry {
+        XOnlyPubKey pubkey;
+        uint256 msg;
+        std::array<unsigned char, 64> sig;
+    };
+    std::vector<Entry> m_entries;
+
+public:
+    /** Add a signature to the batch. sigbytes must be exactly 64 bytes. */
+    void Add(const XOnlyPubKey& pubkey, const uint256& msg, std::span<const unsigned char> sigbytes);
+
+    /** Verify all signatures in the batch. An empty batch is valid. */
+    bool Verify() const;
+
+    void Clear() { m_entries.clear(); }
+    size_t size() const { return m_entries.size(); }
+    bool empty() const { return m_entries.empty(); }
+};
+
 /** An ElligatorSwift-encoded public key. */
 struct EllSwiftPubKey
 {
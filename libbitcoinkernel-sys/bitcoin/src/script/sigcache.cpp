@@ -78,6 +78,10 @@ bool CachingTransactionSignatureChecker::VerifySchnorrSignature(std::span<const
     uint256 entry;
     m_signature_cache.ComputeEntrySchnorr(entry, sighash, sig, pubkey);
     if (m_signature_cache.Get(entry, !store)) return true;
+    if (m_schnorr_batch && !store) {
+        m_schnorr_batch->Add(pubkey, sighash, sig);
+        return true;
+    }
     if (!TransactionSignatureChecker::VerifySchnorrSignature(sig, pubkey, sighash)) return false;
     if (store) m_signature_cache.Set(entry);
     return true;
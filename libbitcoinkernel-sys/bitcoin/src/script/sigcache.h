@@ -20,6 +20,7 @@
 
 class CPubKey;
 class CTransaction;
+class SchnorrSignatureBatch;
 class XOnlyPubKey;
 
 // DoS prevention: limit cache size to 32MiB (over 1000000 entries on 64-bit
@@ -58,6 +59,9 @@ public:
     bool Get(const uint256& entry, const bool erase);
 
     void Set(const uint256& entry);
+
+    //! Return the hit, miss, insert and eviction counters of the cache.
+    CuckooCache::cache_stats GetStats() const { return setValid.stats(); }
 };
 
 class CachingTransactionSignatureChecker : public TransactionSignatureChecker
@@ -65,9 +69,13 @@ class CachingTransactionSignatureChecker : public TransactionSignatureChecker
 private:
     bool store;
     SignatureCache& m_signature_cache;
+    //! If set, Schnorr signatures that miss the cache are added to this batch
+    //! and assumed valid, unless they are to be stored in the cache. The
+    //! caller must verify the batch for the result to be meaningful.
+    SchnorrSignatureBatch* m_schnorr_batch;
 
 public:
-    CachingTransactionSignatureChecker(const CTransaction* txToIn, unsigned int nInIn, const CAmount& amountIn, bool storeIn, SignatureCache& signature_cache, PrecomputedTransactionData& txdataIn) : TransactionSignatureChecker(txToIn, nInIn, amountIn, txdataIn, MissingDataBehavior::ASSERT_FAIL), store(storeIn), m_signature_cache(signature_cache)  {}
+    CachingTransactionSignatureChecker(const CTransaction* txToIn, unsigned int nInIn, const CAmount& amountIn, bool storeIn, SignatureCache& signature_cache, PrecomputedTransactionData& txdataIn, SchnorrSignatureBatch* schnorr_batch = nullptr) : TransactionSignatureChecker(txToIn, nInIn, amountIn, txdataIn, MissingDataBehavior::ASSERT_FAIL), store(storeIn), m_signature_cache(signature_cache), m_schnorr_batch(schnorr_batch) {}
 
     bool VerifyECDSASignature(const std::vector<unsigned char>& vchSig, const CPubKey& vchPubKey, const uint256& sighash) const override;
     bool VerifySchnorrSignature(std::span<const unsigned char> sig, const XOnlyPubKey& pubkey, const uint256& sighash) const override;
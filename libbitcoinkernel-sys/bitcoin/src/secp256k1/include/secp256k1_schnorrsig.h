@@ -183,6 +183,34 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_schnorrsig_verify(
     const secp256k1_xonly_pubkey *pubkey
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(5);
 
+/** Verify a batch of Schnorr signatures at once.
+ *
+ *  This is faster than verifying the signatures one by one with
+ *  secp256k1_schnorrsig_verify, but does not tell which signature is
+ *  incorrect if the batch fails to verify. The signatures are combined with
+ *  randomizers derived from a hash of the whole batch.
+ *
+ *  Returns: 1: all signatures are correct
+ *           0: at least one signature is incorrect, or memory for the
+ *              verification could not be allocated
+ *  Args:    ctx: pointer to a context object.
+ *  In:    sig64: array of pointers to the 64-byte signatures to verify.
+ *           msg: array of pointers to the messages being verified. A message
+ *                can only be NULL if its length is 0.
+ *        msglen: array of the lengths of the messages.
+ *        pubkey: array of pointers to the x-only public keys to verify with.
+ *        n_sigs: number of signatures. The arrays can only be NULL if this
+ *                is 0.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_schnorrsig_verify_batch(
+    const secp256k1_context *ctx,
+    const unsigned char * const *sig64,
+    const unsigned char * const *msg,
+    const size_t *msglen,
+    const secp256k1_xonly_pubkey * const *pubkey,
+    size_t n_sigs
+) SECP256K1_ARG_NONNULL(1);
+
 #ifdef __cplusplus
 }
 #endif
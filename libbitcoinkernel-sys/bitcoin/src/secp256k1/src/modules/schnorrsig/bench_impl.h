@@ -45,6 +45,27 @@ static void bench_schnorrsig_verify(void* arg, int iters) {
     }
 }
 
+#define BATCH_SIGS 64
+
+static void bench_schnorrsig_verify_batch(void* arg, int iters) {
+    bench_schnorrsig_data *data = (bench_schnorrsig_data *)arg;
+    int i;
+
+    for (i = 0; i < iters; i += BATCH_SIGS) {
+        secp256k1_xonly_pubkey pk[BATCH_SIGS];
+        const secp256k1_xonly_pubkey *pk_ptr[BATCH_SIGS];
+        size_t msglen[BATCH_SIGS];
+        size_t n = iters - i < BATCH_SIGS ? (size_t)(iters - i) : BATCH_SIGS;
+        size_t j;
+        for (j = 0; j < n; j++) {
+            CHECK(secp256k1_xonly_pubkey_parse(data->ctx, &pk[j], data->pk[i + j]) == 1);
+            pk_ptr[j] = &pk[j];
+            msglen[j] = MSGLEN;
+        }
+        CHECK(secp256k1_schnorrsig_verify_batch(data->ctx, &data->sigs[i], &data->msgs[i], msglen, pk_ptr, n));
+    }
+}
+
 static void run_schnorrsig_bench(int iters, int argc, char** argv) {
     int i;
     bench_schnorrsig_data data;
@@ -84,6 +105,7 @@ static void run_schnorrsig_bench(int iters, int argc, char** argv) {
 
     if (d || have_flag(argc, argv, "schnorrsig") || have_flag(argc, argv, "sign") || have_flag(argc, argv, "schnorrsig_sign")) run_benchmark("schnorrsig_sign", bench_schnorrsig_sign, NULL, NULL, (void *) &data, 10, iters);
     if (d || have_flag(argc, argv, "schnorrsig") || have_flag(argc, argv, "verify") || have_flag(argc, argv, "schnorrsig_verify")) run_benchmark("schnorrsig_verify", bench_schnorrsig_verify, NULL, NULL, (void *) &data, 10, iters);
+    if (d || have_flag(argc, argv, "schnorrsig") || have_flag(argc, argv, "verify") || have_flag(argc, argv, "schnorrsig_verify_batch")) run_benchmark("schnorrsig_verify_batch", bench_schnorrsig_verify_batch, NULL, NULL, (void *) &data, 10, iters);
 
     for (i = 0; i < iters; i++) {
         free((void *)data.keypairs[i]);
@@ -269,4 +269,164 @@ int secp256k1_schnorrsig_verify(const secp256k1_context* ctx, const unsigned cha
            secp256k1_fe_equal(&rx, &r.x);
 }
 
+
+/* Tag of the hashes the batch verification randomizers are derived from. */
+static const unsigned char schnorrsig_batch_tag[] = {'B', 'I', 'P', '0', '3', '4', '0', '/', 'b', 'a', 't', 'c', 'h'};
+
+/* Computes the randomizer of the signature at index i of a batch. The
+ * randomizer of the first signature is 1, the others are derived from a hash
+ * committing to all signatures, messages and public keys of the batch. */
+static void secp256k1_schnorrsig_batch_randomizer(secp256k1_scalar *a, const secp256k1_sha256 *seed, size_t i) {
+    secp256k1_sha256 sha;
+    unsigned char buf[32];
+    unsigned char index[8];
+    int j;
+
+    if (i == 0) {
+        secp256k1_scalar_set_int(a, 1);
+        return;
+    }
+    for (j = 0; j < 8; j++) {
+        index[j] = (unsigned char)((uint64_t)i >> (8 * j));
+    }
+    sha = *seed;
+    secp256k1_sha256_write(&sha, index, sizeof(index));
+    secp256k1_sha256_finalize(&sha, buf);
+    secp256k1_scalar_set_b32(a, buf, NULL);
+}
+
+typedef struct {
+    const secp256k1_context *ctx;
+    const secp256k1_sha256 *seed;
+    const unsigned char * const *sig64;
+    const unsigned char * const *msg;
+    const size_t *msglen;
+    const secp256k1_xonly_pubkey * const *pubkey;
+    /* The randomizer of the last signature the callback was called for, as
+     * the points are usually requested in order. */
+    size_t randomizer_idx;
+    secp256k1_scalar randomizer;
+} secp256k1_schnorrsig_batch_data;
+
+/* Provides a_i*R_i as point 2*i and a_i*e_i*P_i as point 2*i+1. */
+static int secp256k1_schnorrsig_batch_callback(secp256k1_scalar *sc, secp256k1_ge *pt, size_t idx, void *cbdata) {
+    secp256k1_schnorrsig_batch_data *data = (secp256k1_schnorrsig_batch_data *)cbdata;
+    size_t i = idx / 2;
+
+    if (i != data->randomizer_idx) {
+        secp256k1_schnorrsig_batch_randomizer(&data->randomizer, data->seed, i);
+        data->randomizer_idx = i;
+    }
+    *sc = data->randomizer;
+    if (idx % 2 == 0) {
+        secp256k1_fe rx;
+        if (!secp256k1_fe_set_b32_limit(&rx, &data->sig64[i][0])) {
+            return 0;
+        }
+        return secp256k1_ge_set_xo_var(pt, &rx, 0);
+    } else {
+        secp256k1_scalar e;
+        unsigned char buf[32];
+        if (!secp256k1_xonly_pubkey_load(data->ctx, pt, data->pubkey[i])) {
+            return 0;
+        }
+        secp256k1_fe_get_b32(buf, &pt->x);
+        secp256k1_schnorrsig_challenge(&e, &data->sig64[i][0], data->msg[i], data->msglen[i], buf);
+        secp256k1_scalar_mul(sc, sc, &e);
+        return 1;
+    }
+}
+
+int secp256k1_schnorrsig_verify_batch(const secp256k1_context* ctx, const unsigned char * const *sig64, const unsigned char * const *msg, const size_t *msglen, const secp256k1_xonly_pubkey * const *pubkey, size_t n_sigs) {
+    secp256k1_schnorrsig_batch_data data;
+    secp256k1_sha256 seed;
+    secp256k1_scalar s_sum;
+    secp256k1_gej rj;
+    secp256k1_scratch *scratch;
+    size_t n_points;
+    size_t scratch_size;
+    size_t i;
+    int ret;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(n_sigs == 0 || sig64 != NULL);
+    ARG_CHECK(n_sigs == 0 || msg != NULL);
+    ARG_CHECK(n_sigs == 0 || msglen != NULL);
+    ARG_CHECK(n_sigs == 0 || pubkey != NULL);
+    ARG_CHECK(n_sigs <= ECMULT_MAX_POINTS_PER_BATCH / 2);
+
+    if (n_sigs == 0) {
+        return 1;
+    }
+    if (n_sigs == 1) {
+        return secp256k1_schnorrsig_verify(ctx, sig64[0], msg[0], msglen[0], pubkey[0]);
+    }
+
+    /* Commit to the whole batch, so the randomizers cannot be predicted
+     * before the signatures are fixed. */
+    secp256k1_sha256_initialize_tagged(&seed, schnorrsig_batch_tag, sizeof(schnorrsig_batch_tag));
+    for (i = 0; i < n_sigs; i++) {
+        unsigned char buf[32];
+        unsigned char len[8];
+        secp256k1_ge pk;
+        int j;
+
+        ARG_CHECK(sig64[i] != NULL);
+        ARG_CHECK(msg[i] != NULL || msglen[i] == 0);
+        ARG_CHECK(pubkey[i] != NULL);
+        if (!secp256k1_xonly_pubkey_load(ctx, &pk, pubkey[i])) {
+            return 0;
+        }
+        for (j = 0; j < 8; j++) {
+            len[j] = (unsigned char)((uint64_t)msglen[i] >> (8 * j));
+        }
+        secp256k1_fe_get_b32(buf, &pk.x);
+        secp256k1_sha256_write(&seed, sig64[i], 64);
+        secp256k1_sha256_write(&seed, buf, sizeof(buf));
+        secp256k1_sha256_write(&seed, len, sizeof(len));
+        secp256k1_sha256_write(&seed, msg[i], msglen[i]);
+    }
+
+    /* Compute s_sum = -sum(a_i*s_i). */
+    secp256k1_scalar_set_int(&s_sum, 0);
+    for (i = 0; i < n_sigs; i++) {
+        secp256k1_scalar s;
+        secp256k1_scalar a;
+        int overflow;
+
+        secp256k1_scalar_set_b32(&s, &sig64[i][32], &overflow);
+        if (overflow) {
+            return 0;
+        }
+        secp256k1_schnorrsig_batch_randomizer(&a, &seed, i);
+        secp256k1_scalar_mul(&s, &s, &a);
+        secp256k1_scalar_add(&s_sum, &s_sum, &s);
+    }
+    secp256k1_scalar_negate(&s_sum, &s_sum);
+
+    /* Check that s_sum*G + sum(a_i*R_i) + sum(a_i*e_i*P_i) is infinity. */
+    n_points = 2 * n_sigs;
+    if (n_points >= ECMULT_PIPPENGER_THRESHOLD) {
+        scratch_size = secp256k1_pippenger_scratch_size(n_points, secp256k1_pippenger_bucket_window(n_points)) + PIPPENGER_SCRATCH_OBJECTS * ALIGNMENT;
+    } else {
+        scratch_size = secp256k1_strauss_scratch_size(n_points) + STRAUSS_SCRATCH_OBJECTS * ALIGNMENT;
+    }
+    scratch = secp256k1_scratch_create(&ctx->error_callback, scratch_size);
+    if (scratch == NULL) {
+        return 0;
+    }
+    data.ctx = ctx;
+    data.seed = &seed;
+    data.sig64 = sig64;
+    data.msg = msg;
+    data.msglen = msglen;
+    data.pubkey = pubkey;
+    data.randomizer_idx = 0;
+    secp256k1_scalar_set_int(&data.randomizer, 1);
+    ret = secp256k1_ecmult_multi_var(&ctx->error_callback, scratch, &rj, &s_sum, secp256k1_schnorrsig_batch_callback, (void *)&data, n_points);
+    secp256k1_scratch_destroy(&ctx->error_callback, scratch);
+
+    return ret && secp256k1_gej_is_infinity(&rj);
+}
+
 #endif
@@ -966,6 +966,102 @@ static void test_schnorrsig_taproot(void) {
     CHECK(secp256k1_xonly_pubkey_tweak_add_check(CTX, output_pk_bytes, pk_parity, &internal_pk, tweak) == 1);
 }
 
+#define N_BATCH_SIGS 60
+static void test_schnorrsig_verify_batch(void) {
+    unsigned char sk[32];
+    unsigned char msg[N_BATCH_SIGS][40];
+    size_t msglen[N_BATCH_SIGS];
+    unsigned char sig[N_BATCH_SIGS][64];
+    secp256k1_keypair keypair;
+    secp256k1_xonly_pubkey pk[N_BATCH_SIGS];
+    const unsigned char *sig_ptr[N_BATCH_SIGS];
+    const unsigned char *msg_ptr[N_BATCH_SIGS];
+    const secp256k1_xonly_pubkey *pk_ptr[N_BATCH_SIGS];
+    secp256k1_scalar s;
+    size_t i;
+    size_t n;
+
+    for (i = 0; i < N_BATCH_SIGS; i++) {
+        testrand256(sk);
+        CHECK(secp256k1_keypair_create(CTX, &keypair, sk));
+        CHECK(secp256k1_keypair_xonly_pub(CTX, &pk[i], NULL, &keypair));
+        msglen[i] = testrand_int(sizeof(msg[i]) + 1);
+        testrand_bytes_test(msg[i], sizeof(msg[i]));
+        CHECK(secp256k1_schnorrsig_sign_custom(CTX, sig[i], msg[i], msglen[i], &keypair, NULL));
+        sig_ptr[i] = sig[i];
+        msg_ptr[i] = msg[i];
+        pk_ptr[i] = &pk[i];
+    }
+
+    /* Batches of up to N_BATCH_SIGS signatures use both Strauss' and
+     * Pippenger's algorithm. */
+    CHECK(secp256k1_schnorrsig_verify_batch(CTX, NULL, NULL, NULL, NULL, 0));
+    for (n = 1; n <= N_BATCH_SIGS; n += 1 + n / 4) {
+        CHECK(secp256k1_schnorrsig_verify_batch(CTX, sig_ptr, msg_ptr, msglen, pk_ptr, n));
+    }
+    CHECK(secp256k1_schnorrsig_verify_batch(CTX, sig_ptr, msg_ptr, msglen, pk_ptr, N_BATCH_SIGS));
+
+    {
+        /* A single incorrect signature or message makes the batch fail */
+        size_t sig_idx = testrand_int(N_BATCH_SIGS);
+        size_t byte_idx = testrand_int(64);
+        unsigned char xorbyte = testrand_int(254)+1;
+        sig[sig_idx][byte_idx] ^= xorbyte;
+        CHECK(!secp256k1_schnorrsig_verify_batch(CTX, sig_ptr, msg_ptr, msglen, pk_ptr, N_BATCH_SIGS));
+        sig[sig_idx][byte_idx] ^= xorbyte;
+
+        if (msglen[sig_idx] > 0) {
+            byte_idx = testrand_int(msglen[sig_idx]);
+            msg[sig_idx][byte_idx] ^= xorbyte;
+            CHECK(!secp256k1_schnorrsig_verify_batch(CTX, sig_ptr, msg_ptr, msglen, pk_ptr, N_BATCH_SIGS));
+            msg[sig_idx][byte_idx] ^= xorbyte;
+        }
+
+        /* Swapping the public keys of two signatures makes the batch fail */
+        pk_ptr[0] = &pk[1];
+        pk_ptr[1] = &pk[0];
+        CHECK(!secp256k1_schnorrsig_verify_batch(CTX, sig_ptr, msg_ptr, msglen, pk_ptr, N_BATCH_SIGS));
+        pk_ptr[0] = &pk[0];
+        pk_ptr[1] = &pk[1];
+
+        CHECK(secp256k1_schnorrsig_verify_batch(CTX, sig_ptr, msg_ptr, msglen, pk_ptr, N_BATCH_SIGS));
+    }
+
+    {
+        /* Errors that cancel out in the sum of the signatures are caught by
+         * the randomizers */
+        unsigned char sig0[64];
+        unsigned char sig1[64];
+        memcpy(sig0, sig[0], 64);
+        memcpy(sig1, sig[1], 64);
+        secp256k1_scalar_set_b32(&s, &sig[0][32], NULL);
+        secp256k1_scalar_add(&s, &s, &secp256k1_scalar_one);
+        secp256k1_scalar_get_b32(&sig[0][32], &s);
+        secp256k1_scalar_set_b32(&s, &sig[1][32], NULL);
+        secp256k1_scalar_negate(&s, &s);
+        secp256k1_scalar_add(&s, &s, &secp256k1_scalar_one);
+        secp256k1_scalar_negate(&s, &s);
+        secp256k1_scalar_get_b32(&sig[1][32], &s);
+        CHECK(!secp256k1_schnorrsig_verify_batch(CTX, sig_ptr, msg_ptr, msglen, pk_ptr, 2));
+        memcpy(sig[0], sig0, 64);
+        memcpy(sig[1], sig1, 64);
+    }
+
+    {
+        /* Overflowing r and s */
+        unsigned char sig_last[64];
+        memcpy(sig_last, sig[N_BATCH_SIGS - 1], 64);
+        memset(&sig[N_BATCH_SIGS - 1][32], 0xFF, 32);
+        CHECK(!secp256k1_schnorrsig_verify_batch(CTX, sig_ptr, msg_ptr, msglen, pk_ptr, N_BATCH_SIGS));
+        memcpy(sig[N_BATCH_SIGS - 1], sig_last, 64);
+        memset(&sig[N_BATCH_SIGS - 1][0], 0xFF, 32);
+        CHECK(!secp256k1_schnorrsig_verify_batch(CTX, sig_ptr, msg_ptr, msglen, pk_ptr, N_BATCH_SIGS));
+        memcpy(sig[N_BATCH_SIGS - 1], sig_last, 64);
+        CHECK(secp256k1_schnorrsig_verify_batch(CTX, sig_ptr, msg_ptr, msglen, pk_ptr, N_BATCH_SIGS));
+    }
+}
+#undef N_BATCH_SIGS
+
 /* --- Test registry --- */
 REPEAT_TEST(test_schnorrsig_sign)
 REPEAT_TEST(test_schnorrsig_sign_verify)
@@ -978,6 +1074,7 @@ static const struct tf_test_entry tests_schnorrsig[] = {
     CASE1(test_schnorrsig_sign),
     CASE1(test_schnorrsig_sign_verify),
     CASE1(test_schnorrsig_taproot),
+    CASE1(test_schnorrsig_verify_batch),
 };
 
 #endif
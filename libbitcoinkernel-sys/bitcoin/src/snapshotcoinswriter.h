@@ -0,0 +1,222 @@
+// Copyright (c) 2025 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_SNAPSHOTCOINSWRITER_H
+#define BITCOIN_SNAPSHOTCOINSWRITER_H
+
+#include <coins.h>
+#include <hash.h>
+#include <kernel/coinstats.h>
+#include <primitives/transaction.h>
+#include <streams.h>
+#include <sync.h>
+#include <tinyformat.h>
+#include <txdb.h>
+#include <uint256.h>
+#include <util/threadnames.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <map>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * Writes the coins of a UTXO snapshot to the coins database of the snapshot
+ * chainstate while the snapshot file is being read, and computes their
+ * serialized hash (see kernel::SerializeCoinForHash) on the way.
+ *
+ * The reading thread passes the coins in batches to Add(). A pool of worker
+ * threads serializes the coins of a batch for the hash and writes them to the
+ * database in their own database batches. The serialized coins are hashed in
+ * the order the batches were added, by whichever worker completes the batch
+ * that is next in order. At most max_in_flight batches are written or waiting
+ * to be hashed at a time.
+ *
+ * Without worker threads, batches are written and hashed by Add() itself.
+ */
+class SnapshotCoinsWriter
+{
+public:
+    using Coins = std::vector<std::pair<COutPoint, Coin>>;
+
+private:
+    CCoinsViewDB& m_db;
+    const size_t m_max_in_flight;
+
+    Mutex m_mutex;
+    //! Add() and Finish() block on this while batches are in flight
+    std::condition_variable m_producer_cv;
+    //! Worker threads block on this when out of work
+    std::condition_variable m_worker_cv;
+
+    //! Batches waiting to be written, with their sequence number
+    std::deque<std::pair<uint64_t, Coins>> m_queue GUARDED_BY(m_mutex);
+    //! Serialized coins of written batches, keyed by sequence number
+    std::map<uint64_t, DataStream> m_serialized GUARDED_BY(m_mutex);
+    //! Number of batches added so far
+    uint64_t m_added GUARDED_BY(m_mutex){0};
+    //! Number of batches hashed so far
+    uint64_t m_hashed GUARDED_BY(m_mutex){0};
+    //! Whether a worker is hashing. Only that worker accesses m_hasher.
+    bool m_hashing GUARDED_BY(m_mutex){false};
+    bool m_request_stop GUARDED_BY(m_mutex){false};
+    //! The first error encountered by a worker
+    std::exception_ptr m_error GUARDED_BY(m_mutex);
+
+    HashWriter m_hasher;
+
+    std::vector<std::thread> m_worker_threads;
+
+    DataStream Write(const Coins& coins)
+    {
+        DataStream serialized;
+        for (const auto& [outpoint, coin] : coins) {
+            kernel::SerializeCoinForHash(serialized, outpoint, coin);
+        }
+        m_db.WriteCoins(coins);
+        return serialized;
+    }
+
+    void WorkerLoop() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        while (true) {
+            m_worker_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_request_stop || m_error || !m_queue.empty(); });
+            // After an error, the remaining batches are left in the queue.
+            if (m_request_stop || m_error) return;
+            auto [seq, coins]{std::move(m_queue.front())};
+            m_queue.pop_front();
+            bool hashing{false};
+            try {
+                DataStream serialized;
+                {
+                    REVERSE_LOCK(lock, m_mutex);
+                    serialized = Write(coins);
+                }
+                m_serialized.emplace(seq, std::move(serialized));
+                if (m_hashing) continue;
+                m_hashing = hashing = true;
+                while (true) {
+                    auto node{m_serialized.extract(m_hashed)};
+                    if (node.empty()) break;
+                    {
+                        REVERSE_LOCK(lock, m_mutex);
+                        m_hasher.write(std::span{node.mapped()});
+                    }
+                    ++m_hashed;
+                }
+                m_hashing = false;
+            } catch (...) {
+                // Errors never escape the thread. Add() and Finish() report
+                // them, and the other workers stop taking batches.
+                if (!m_error) m_error = std::current_exception();
+                if (hashing) m_hashing = false;
+                m_worker_cv.notify_all();
+            }
+            m_producer_cv.notify_all();
+        }
+    }
+
+    //! Stop and join the worker threads. Batches that were not written yet
+    //! are dropped.
+    void Stop() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WITH_LOCK(m_mutex, m_request_stop = true);
+        m_worker_cv.notify_all();
+        for (std::thread& t : m_worker_threads) {
+            if (t.joinable()) t.join();
+        }
+    }
+
+    //! Join the worker threads and rethrow the error of a failed write, so
+    //! that no worker outlives the failure.
+    [[noreturn]] void Fail(std::exception_ptr error) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        Stop();
+        std::rethrow_exception(error);
+    }
+
+public:
+    SnapshotCoinsWriter(CCoinsViewDB& db, int worker_threads_num, size_t max_in_flight)
+        : m_db{db},
+          m_max_in_flight{std::max<size_t>(max_in_flight, 1)}
+    {
+        if (worker_threads_num <= 0) return;
+        m_worker_threads.reserve(worker_threads_num);
+        try {
+            for (int n = 0; n < worker_threads_num; ++n) {
+                m_worker_threads.emplace_back([this, n]() {
+                    util::ThreadRename(strprintf("snapload.%i", n));
+                    WorkerLoop();
+                });
+            }
+        } catch (...) {
+            Stop();
+            throw;
+        }
+    }
+
+    // Since this class manages its own resources, which are the worker
+    // threads, copy and move operations are not appropriate.
+    SnapshotCoinsWriter(const SnapshotCoinsWriter&) = delete;
+    SnapshotCoinsWriter& operator=(const SnapshotCoinsWriter&) = delete;
+    SnapshotCoinsWriter(SnapshotCoinsWriter&&) = delete;
+    SnapshotCoinsWriter& operator=(SnapshotCoinsWriter&&) = delete;
+
+    //! Stops the worker threads. Batches that were not written yet are
+    //! dropped.
+    ~SnapshotCoinsWriter()
+    {
+        Stop();
+    }
+
+    //! Queue a batch of coins to be written and hashed after the batches
+    //! added before it. Blocks while max_in_flight batches are in flight.
+    //! Rethrows the error of a failed write, after joining the worker
+    //! threads.
+    void Add(Coins coins) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        if (m_worker_threads.empty()) {
+            const DataStream serialized{Write(coins)};
+            m_hasher.write(std::span{serialized});
+            return;
+        }
+        std::exception_ptr error;
+        {
+            WAIT_LOCK(m_mutex, lock);
+            m_producer_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_error || m_added - m_hashed < m_max_in_flight; });
+            error = m_error;
+            if (!error) m_queue.emplace_back(m_added++, std::move(coins));
+        }
+        if (error) Fail(error);
+        m_worker_cv.notify_one();
+    }
+
+    //! Wait until all batches are written and return the serialized hash of
+    //! their coins. Rethrows the error of a failed write, after joining the
+    //! worker threads. Must only be called once, after the last batch was
+    //! added.
+    uint256 Finish() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        if (!m_worker_threads.empty()) {
+            std::exception_ptr error;
+            {
+                WAIT_LOCK(m_mutex, lock);
+                m_producer_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_error || m_hashed == m_added; });
+                error = m_error;
+            }
+            if (error) Fail(error);
+        }
+        return m_hasher.GetHash();
+    }
+};
+
+#endif // BITCOIN_SNAPSHOTCOINSWRITER_H
@@ -0,0 +1,119 @@
+// Copyright (c) 2025 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <blockfilereader.h>
+#include <chainparams.h>
+#include <consensus/amount.h>
+#include <primitives/block.h>
+#include <primitives/transaction.h>
+#include <script/script.h>
+#include <streams.h>
+#include <test/util/setup_common.h>
+#include <util/fs.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+CBlock MakeBlock(const uint256& prev_hash, uint32_t nonce)
+{
+    CMutableTransaction coinbase;
+    coinbase.vin.emplace_back();
+    coinbase.vin[0].scriptSig = CScript{} << nonce;
+    coinbase.vout.emplace_back(COIN, CScript{} << OP_TRUE);
+    CBlock block;
+    block.hashPrevBlock = prev_hash;
+    block.nNonce = nonce;
+    block.vtx.push_back(MakeTransactionRef(coinbase));
+    return block;
+}
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(blockfilereader_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(read_blocks)
+{
+    const auto& message_start{Params().MessageStart()};
+    std::vector<CBlock> blocks;
+    for (uint32_t i{0}; i < 20; ++i) {
+        blocks.push_back(MakeBlock(blocks.empty() ? uint256{} : blocks.back().GetHash(), i));
+    }
+
+    // Frame the blocks as in a block file, with some garbage before the first
+    // one and a frame that does not deserialize in the middle.
+    DataStream stream;
+    stream << std::vector<uint8_t>{0xde, 0xad};
+    for (size_t i{0}; i < blocks.size(); ++i) {
+        if (i == blocks.size() / 2) {
+            stream << message_start << uint32_t{100} << std::vector<uint8_t>(100, 0xff);
+        }
+        DataStream block_stream;
+        block_stream << TX_WITH_WITNESS(blocks[i]);
+        stream << message_start << uint32_t(block_stream.size());
+        stream.write(block_stream);
+    }
+    const fs::path path{m_path_root / "blk.dat"};
+    {
+        AutoFile file{fsbridge::fopen(path, "wb")};
+        file << std::span{stream};
+        BOOST_CHECK_EQUAL(file.fclose(), 0);
+    }
+
+    for (int threads : {0, 3}) {
+        std::atomic<int> checked{0};
+        AutoFile file{fsbridge::fopen(path, "rb")};
+        BlockFileReader reader{
+            file, message_start,
+            /*skip=*/[&](const uint256& hash) { return hash == blocks[3].GetHash(); },
+            /*check=*/[&](const CBlock&) { ++checked; },
+            threads, /*max_in_flight=*/2};
+
+        size_t next{0};
+        bool had_error{false};
+        while (auto item{reader.Next()}) {
+            if (!item->error.empty()) {
+                // The garbage frame is reported once, in file order.
+                BOOST_CHECK(!had_error);
+                BOOST_CHECK_EQUAL(next, blocks.size() / 2);
+                BOOST_CHECK(!item->block);
+                had_error = true;
+                continue;
+            }
+            BOOST_REQUIRE(next < blocks.size());
+            const CBlock& expected{blocks[next]};
+            BOOST_CHECK_EQUAL(item->hash, expected.GetHash());
+            BOOST_CHECK_EQUAL(item->prev_hash, expected.hashPrevBlock);
+            BOOST_CHECK_EQUAL(item->size, GetSerializeSize(TX_WITH_WITNESS(expected)));
+            if (next == 3) {
+                // Skipped blocks are not deserialized, but their data is kept.
+                BOOST_CHECK(!item->block);
+                CBlock block;
+                SpanReader{item->data} >> TX_WITH_WITNESS(block);
+                BOOST_CHECK_EQUAL(block.GetHash(), expected.GetHash());
+            } else {
+                BOOST_REQUIRE(item->block);
+                BOOST_CHECK_EQUAL(item->block->GetHash(), expected.GetHash());
+                BOOST_CHECK(item->data.empty());
+            }
+            ++next;
+        }
+        BOOST_CHECK(had_error);
+        BOOST_CHECK_EQUAL(next, blocks.size());
+        BOOST_CHECK_EQUAL(checked.load(), int(blocks.size()) - 1);
+    }
+
+    // Stopping early joins the threads without reading the rest of the file.
+    AutoFile file{fsbridge::fopen(path, "rb")};
+    BlockFileReader reader{file, message_start, /*skip=*/{}, /*check=*/{}, /*worker_threads_num=*/3, /*max_in_flight=*/1};
+    auto item{reader.Next()};
+    BOOST_REQUIRE(item);
+    BOOST_CHECK_EQUAL(item->hash, blocks[0].GetHash());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
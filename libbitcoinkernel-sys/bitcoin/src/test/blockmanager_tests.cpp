@@ -19,6 +19,7 @@
 
 using node::STORAGE_HEADER_BYTES;
 using node::BlockManager;
+using node::BlockTreeDB;
 using node::KernelNotifications;
 using node::MAX_BLOCKFILE_SIZE;
 
@@ -153,6 +154,109 @@ BOOST_FIXTURE_TEST_CASE(blockmanager_readblock_hash_mismatch, TestingSetup)
     BOOST_CHECK(!m_node.chainman->m_blockman.ReadBlock(block, index));
 }
 
+BOOST_FIXTURE_TEST_CASE(blockmanager_block_index_snapshot, TestChain100Setup)
+{
+    KernelNotifications notifications{Assert(m_node.shutdown_request), m_node.exit_status, *Assert(m_node.warnings)};
+    const BlockManager::Options blockman_opts{
+        .chainparams = Params(),
+        .blocks_dir = m_args.GetBlocksDirPath(),
+        .notifications = notifications,
+        .block_tree_db_params = DBParams{
+            .path = m_path_root / "snapshot_index",
+            .cache_bytes = 0,
+        },
+        .block_index_snapshot = true,
+    };
+    std::vector<CBlockHeader> headers;
+    {
+        LOCK(cs_main);
+        for (const CBlockIndex* index{m_node.chainman->ActiveChain().Tip()}; index; index = index->pprev) {
+            headers.push_back(index->GetBlockHeader());
+        }
+    }
+    std::reverse(headers.begin(), headers.end());
+
+    {
+        BlockManager blockman{*Assert(m_node.shutdown_signal), blockman_opts};
+        LOCK(cs_main);
+        CBlockIndex* best_header{nullptr};
+        for (const CBlockHeader& header : headers) {
+            blockman.AddToBlockIndex(header, best_header)->nTx = header.nTime;
+        }
+        BOOST_CHECK(blockman.WriteBlockIndexSnapshot());
+    }
+    BOOST_CHECK(fs::exists(m_path_root / "snapshot_index.snapshot"));
+
+    const auto check_block_index{[&](BlockManager& blockman) EXCLUSIVE_LOCKS_REQUIRED(cs_main) {
+        BOOST_CHECK_EQUAL(blockman.m_block_index.size(), headers.size());
+        for (const CBlockHeader& header : headers) {
+            const CBlockIndex* index{blockman.LookupBlockIndex(header.GetHash())};
+            BOOST_REQUIRE(index);
+            // The header includes the hash of the previous entry.
+            BOOST_CHECK_EQUAL(index->GetBlockHeader().GetHash(), header.GetHash());
+            BOOST_CHECK_EQUAL(index->nTx, header.nTime);
+            BOOST_CHECK(index->IsValid(BLOCK_VALID_TREE));
+        }
+    }};
+    {
+        // The snapshot is loaded while it matches the database.
+        BlockManager blockman{*Assert(m_node.shutdown_signal), blockman_opts};
+        LOCK(cs_main);
+        {
+            ASSERT_DEBUG_LOG(strprintf("Loaded %d block index entries", headers.size()));
+            BOOST_CHECK(blockman.LoadBlockIndexDB(std::nullopt));
+        }
+        check_block_index(blockman);
+    }
+    {
+        // Software that does not know about the snapshot changes the status
+        // of a block, leaving its id and the block files in place.
+        BlockTreeDB db{blockman_opts.block_tree_db_params};
+        const auto key{std::make_pair(uint8_t{'b'}, headers.back().GetHash())};
+        CDiskBlockIndex index;
+        BOOST_REQUIRE(db.Read(key, index));
+        index.nStatus |= BLOCK_OPT_WITNESS;
+        BOOST_CHECK(db.Write(key, index));
+    }
+    {
+        BlockManager blockman{*Assert(m_node.shutdown_signal), blockman_opts};
+        LOCK(cs_main);
+        {
+            ASSERT_DEBUG_LOG("written for a different block tree state");
+            BOOST_CHECK(blockman.LoadBlockIndexDB(std::nullopt));
+        }
+        check_block_index(blockman);
+        BOOST_CHECK(blockman.LookupBlockIndex(headers.back().GetHash())->nStatus & BLOCK_OPT_WITNESS);
+        BOOST_CHECK(blockman.WriteBlockIndexSnapshot());
+    }
+    {
+        // Software that does not know about the snapshot stores a block,
+        // leaving its id in the database.
+        BlockTreeDB db{blockman_opts.block_tree_db_params};
+        CBlockFileInfo info;
+        info.AddBlock(/*nHeightIn=*/1, /*nTimeIn=*/1);
+        BOOST_CHECK(db.Write(std::make_pair(uint8_t{'f'}, 0), info));
+    }
+    {
+        BlockManager blockman{*Assert(m_node.shutdown_signal), blockman_opts};
+        LOCK(cs_main);
+        {
+            ASSERT_DEBUG_LOG("written for a different block tree state");
+            BOOST_CHECK(blockman.LoadBlockIndexDB(std::nullopt));
+        }
+        check_block_index(blockman);
+        // Writing to the block index invalidates the snapshot.
+        BOOST_CHECK(blockman.WriteBlockIndexDB());
+    }
+    BlockManager blockman{*Assert(m_node.shutdown_signal), blockman_opts};
+    LOCK(cs_main);
+    {
+        ASSERT_DEBUG_LOG("No block index snapshot matches the block tree database");
+        BOOST_CHECK(blockman.LoadBlockIndexDB(std::nullopt));
+    }
+    check_block_index(blockman);
+}
+
 BOOST_AUTO_TEST_CASE(blockmanager_flush_block_file)
 {
     KernelNotifications notifications{Assert(m_node.shutdown_request), m_node.exit_status, *Assert(m_node.warnings)};
@@ -135,6 +135,29 @@ struct FrozenCleanupCheck {
     }
 };
 
+//! Check whose failure only shows when its batch is verified.
+struct BatchCheck {
+    struct Batch {
+        static std::atomic<size_t> n_verified;
+        bool valid{true};
+        bool Verify() const
+        {
+            n_verified.fetch_add(1, std::memory_order_relaxed);
+            return valid;
+        }
+    };
+    std::optional<int> m_result;
+    BatchCheck(std::optional<int> result) : m_result(result){};
+    std::optional<int> operator()() const { return m_result; }
+    std::optional<int> operator()(Batch& batch) const
+    {
+        if (m_result.has_value()) batch.valid = false;
+        return std::nullopt;
+    }
+};
+static_assert(BatchableCheck<BatchCheck, int>);
+static_assert(!BatchableCheck<FixedCheck, int>);
+
 // Static Allocations
 std::mutex FrozenCleanupCheck::m{};
 std::atomic<uint64_t> FrozenCleanupCheck::nFrozen{0};
@@ -143,11 +166,13 @@ Mutex UniqueCheck::m;
 std::unordered_multiset<size_t> UniqueCheck::results;
 std::atomic<size_t> FakeCheckCheckCompletion::n_calls{0};
 std::atomic<size_t> MemoryCheck::fake_allocated_memory{0};
+std::atomic<size_t> BatchCheck::Batch::n_verified{0};
 
 // Queue Typedefs
 typedef CCheckQueue<FakeCheckCheckCompletion> Correct_Queue;
 typedef CCheckQueue<FakeCheck> Standard_Queue;
 typedef CCheckQueue<FixedCheck> Fixed_Queue;
+typedef CCheckQueue<BatchCheck> Batch_Queue;
 typedef CCheckQueue<UniqueCheck> Unique_Queue;
 typedef CCheckQueue<MemoryCheck> Memory_Queue;
 typedef CCheckQueue<FrozenCleanupCheck> FrozenCleanup_Queue;
@@ -239,6 +264,32 @@ BOOST_AUTO_TEST_CASE(test_CheckQueue_Catches_Failure)
         }
     }
 }
+/** Test that a failure deferred to a batch is attributed to its check */
+BOOST_AUTO_TEST_CASE(test_CheckQueue_Batch_Failure)
+{
+    auto batch_queue = std::make_unique<Batch_Queue>(QUEUE_BATCH_SIZE, SCRIPT_CHECK_THREADS);
+    BatchCheck::Batch::n_verified = 0;
+    for (size_t i = 0; i < 100; ++i) {
+        const size_t failing{m_rng.randrange<size_t>(1000)};
+        const bool fails{i % 2 == 0};
+        CCheckQueueControl<BatchCheck> control(*batch_queue);
+        for (size_t k = 0; k < 1000; k += 10) {
+            std::vector<BatchCheck> vChecks;
+            for (size_t j = k; j < k + 10; ++j) {
+                vChecks.emplace_back(fails && j == failing ? std::make_optional<int>(static_cast<int>(j)) : std::nullopt);
+            }
+            control.Add(std::move(vChecks));
+        }
+        auto result = control.Complete();
+        if (fails) {
+            BOOST_REQUIRE(result.has_value() && *result == static_cast<int>(failing));
+        } else {
+            BOOST_REQUIRE(!result.has_value());
+        }
+    }
+    BOOST_CHECK(BatchCheck::Batch::n_verified > 0);
+}
+
 // Test that a block validation which fails does not interfere with
 // future blocks, ie, the bad state is cleared.
 BOOST_AUTO_TEST_CASE(test_CheckQueue_Recovers_From_Failure)
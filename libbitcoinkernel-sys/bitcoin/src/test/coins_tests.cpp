@@ -1121,4 +1121,102 @@ BOOST_AUTO_TEST_CASE(ccoins_emplace_duplicate_keeps_usage_balanced)
     BOOST_CHECK(cache.AccessCoin(outpoint) == coin1);
 }
 
+BOOST_AUTO_TEST_CASE(compact_coins_map_simulation_test)
+{
+    constexpr size_t MAX_MEMORY_BYTES{64 << 10};
+    CompactCoinsMap map{MAX_MEMORY_BYTES, /*deterministic=*/true};
+    BOOST_CHECK_LE(map.DynamicMemoryUsage(), MAX_MEMORY_BYTES * 11 / 10);
+
+    // Few enough outpoints that they are often replaced and erased, and
+    // enough that the map runs full.
+    std::vector<COutPoint> outpoints;
+    for (int i{0}; i < 2000; ++i) {
+        outpoints.emplace_back(Txid::FromUint256(m_rng.rand256()), m_rng.randrange(4));
+    }
+    std::map<COutPoint, Coin> expected;
+    size_t full{0};
+    for (unsigned i{0}; i < NUM_SIMULATION_ITERATIONS; ++i) {
+        const COutPoint& outpoint{outpoints[m_rng.randrange(outpoints.size())]};
+        if (m_rng.randrange(3) == 0) {
+            map.Erase(outpoint);
+            expected.erase(outpoint);
+        } else {
+            // A mix of scripts that are compressed and that are not.
+            CScript script;
+            if (m_rng.randbool()) {
+                script = GetScriptForDestination(PKHash(uint160(m_rng.randbytes(20))));
+            } else {
+                script << m_rng.randbytes(m_rng.randrange(80));
+            }
+            const Coin coin{CTxOut{m_rng.randrange(MAX_MONEY), script}, static_cast<int>(m_rng.randrange(1 << 20)), m_rng.randbool()};
+            if (map.Insert(outpoint, coin)) {
+                expected.insert_or_assign(outpoint, coin);
+            } else {
+                // A full map no longer holds the outpoint, and is cleared.
+                BOOST_CHECK(!map.Contains(outpoint));
+                map.Clear();
+                expected.clear();
+                ++full;
+            }
+        }
+        if (i % 1000 == 0) {
+            BOOST_CHECK_EQUAL(map.size(), expected.size());
+            for (const auto& [outpoint, coin] : expected) {
+                const auto found{map.Get(outpoint)};
+                BOOST_REQUIRE(found);
+                BOOST_CHECK(*found == coin);
+            }
+        }
+        BOOST_CHECK_EQUAL(map.Contains(outpoint), expected.contains(outpoint));
+        const auto found{map.Get(outpoint)};
+        BOOST_CHECK_EQUAL(found.has_value(), expected.contains(outpoint));
+    }
+    BOOST_CHECK(full > 0);
+    // The memory is allocated up front, so it did not grow.
+    BOOST_CHECK_LE(map.DynamicMemoryUsage(), MAX_MEMORY_BYTES * 11 / 10);
+}
+
+BOOST_AUTO_TEST_CASE(background_flush_failed_write)
+{
+    //! A base whose writes fail, like a database on a full disk.
+    class FailingCoinsView : public CCoinsView
+    {
+    public:
+        bool BatchWrite(CoinsViewCacheCursor& cursor, const uint256& hashBlock) override { return false; }
+    };
+
+    FailingCoinsView base;
+    int write_errors{0};
+    CCoinsViewBackgroundFlush flush_view{&base, [&] { ++write_errors; }};
+    CCoinsViewCacheTest cache{&flush_view};
+
+    const COutPoint outpoint{Txid::FromUint256(m_rng.rand256()), 0};
+    const Coin coin{CTxOut{1000, CScript() << OP_TRUE}, 1, false};
+    const uint256 best_block{m_rng.rand256()};
+    cache.AddCoin(outpoint, Coin{coin}, /*possible_overwrite=*/false);
+    cache.SetBestBlock(best_block);
+    // The write is only attempted once it was handed to the background thread.
+    BOOST_CHECK(cache.Flush());
+    BOOST_CHECK(!flush_view.WaitForFlush());
+
+    // The coins that failed to be written are still served.
+    const auto found{flush_view.GetCoin(outpoint)};
+    BOOST_REQUIRE(found);
+    BOOST_CHECK(*found == coin);
+    BOOST_CHECK(flush_view.HaveCoin(outpoint));
+    BOOST_CHECK(flush_view.GetBestBlock() == best_block);
+    BOOST_CHECK(cache.AccessCoin(outpoint) == coin);
+    BOOST_CHECK_EQUAL(write_errors, 0);
+
+    // Later flushes fail right away, and so do reads that need the coins to
+    // be on disk.
+    cache.AddCoin(COutPoint{Txid::FromUint256(m_rng.rand256()), 0}, Coin{coin}, /*possible_overwrite=*/false);
+    BOOST_CHECK(!cache.Flush());
+    BOOST_CHECK_THROW(flush_view.Cursor(), std::runtime_error);
+    BOOST_CHECK_THROW(flush_view.EstimateSize(), std::runtime_error);
+    BOOST_CHECK_THROW(flush_view.GetHeadBlocks(), std::runtime_error);
+    BOOST_CHECK_EQUAL(write_errors, 3);
+    BOOST_CHECK(flush_view.HaveCoin(outpoint));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -3,11 +3,15 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <chainparams.h>
+#include <coins.h>
+#include <consensus/amount.h>
 #include <index/coinstatsindex.h>
 #include <interfaces/chain.h>
 #include <kernel/coinstats.h>
+#include <script/script.h>
 #include <test/util/setup_common.h>
 #include <test/util/validation.h>
+#include <txdb.h>
 #include <validation.h>
 
 #include <boost/test/unit_test.hpp>
@@ -114,4 +118,44 @@ BOOST_FIXTURE_TEST_CASE(coinstatsindex_unclean_shutdown, TestChain100Setup)
     }
 }
 
+BOOST_FIXTURE_TEST_CASE(coinstats_parallel, TestChain100Setup)
+{
+    // Fill a coins database with coins of random txids, some of which have
+    // several outputs.
+    CCoinsViewDB db{{.path = "coinstats", .cache_bytes = 1 << 23, .memory_only = true}, {}};
+    uint64_t coins_count{0};
+    {
+        CCoinsViewCache cache{&db};
+        for (uint32_t i{0}; i < 1000; ++i) {
+            const Txid txid{Txid::FromUint256(m_rng.rand256())};
+            for (uint32_t n{0}; n <= i % 3; ++n) {
+                cache.AddCoin(COutPoint{txid, n}, Coin{CTxOut{m_rng.randrange<CAmount>(COIN), CScript{} << OP_TRUE}, 1, false}, /*possible_overwrite=*/false);
+                ++coins_count;
+            }
+        }
+        cache.SetBestBlock(WITH_LOCK(cs_main, return m_node.chainman->ActiveChain().Tip()->GetBlockHash()));
+        BOOST_REQUIRE(cache.Flush());
+    }
+
+    for (const auto hash_type : {kernel::CoinStatsHashType::HASH_SERIALIZED, kernel::CoinStatsHashType::MUHASH, kernel::CoinStatsHashType::NONE}) {
+        const auto expected{kernel::ComputeUTXOStats(hash_type, &db, m_node.chainman->m_blockman)};
+        BOOST_REQUIRE(expected);
+        BOOST_CHECK_EQUAL(expected->coins_count, coins_count);
+        BOOST_CHECK_EQUAL(expected->nTransactions, 1000U);
+        BOOST_CHECK_EQUAL(expected->nHeight, 100);
+        // The partial accumulators of the ranges combine to the same hash.
+        for (const int threads : {0, 1, 4}) {
+            const auto stats{kernel::ComputeUTXOStats(hash_type, db, m_node.chainman->m_blockman, threads)};
+            BOOST_REQUIRE(stats);
+            BOOST_CHECK_EQUAL(stats->hashSerialized, expected->hashSerialized);
+            BOOST_CHECK_EQUAL(stats->hashBlock, expected->hashBlock);
+            BOOST_CHECK_EQUAL(stats->coins_count, expected->coins_count);
+            BOOST_CHECK_EQUAL(stats->nTransactions, expected->nTransactions);
+            BOOST_CHECK_EQUAL(stats->nTransactionOutputs, expected->nTransactionOutputs);
+            BOOST_CHECK_EQUAL(stats->nBogoSize, expected->nBogoSize);
+            BOOST_CHECK(stats->total_amount == expected->total_amount);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
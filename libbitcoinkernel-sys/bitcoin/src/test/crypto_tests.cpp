@@ -1086,6 +1086,40 @@ BOOST_AUTO_TEST_CASE(sha256d64)
     }
 }
 
+BOOST_AUTO_TEST_CASE(sha256multi)
+{
+    // Cover padding boundaries and messages spanning several chunks, in lanes that
+    // finish at different times.
+    const std::vector<size_t> lengths{0, 1, 32, 55, 56, 63, 64, 65, 119, 120, 128, 300, 1000};
+    for (const auto implementation : {sha256_implementation::STANDARD, sha256_implementation::USE_SSE4,
+                                      sha256_implementation::USE_SSE4_AND_AVX2, sha256_implementation::USE_SSE4_AND_SHANI}) {
+        SHA256AutoDetect(implementation);
+        for (size_t count = 0; count <= 20; ++count) {
+            std::vector<std::vector<unsigned char>> messages;
+            std::vector<const unsigned char*> inputs;
+            std::vector<size_t> sizes;
+            for (size_t i = 0; i < count; ++i) {
+                messages.push_back(m_rng.randbytes(lengths[m_rng.randrange(lengths.size())]));
+            }
+            for (const auto& message : messages) {
+                inputs.push_back(message.data());
+                sizes.push_back(message.size());
+            }
+            std::vector<unsigned char> out(32 * count), outd(32 * count);
+            SHA256Multi(out.data(), inputs.data(), sizes.data(), count);
+            SHA256DMulti(outd.data(), inputs.data(), sizes.data(), count);
+            for (size_t i = 0; i < count; ++i) {
+                unsigned char expected[32], expectedd[32];
+                CSHA256().Write(messages[i].data(), messages[i].size()).Finalize(expected);
+                CHash256().Write(messages[i]).Finalize(expectedd);
+                BOOST_CHECK(memcmp(out.data() + 32 * i, expected, 32) == 0);
+                BOOST_CHECK(memcmp(outd.data() + 32 * i, expectedd, 32) == 0);
+            }
+        }
+    }
+    SHA256AutoDetect();
+}
+
 void CryptoTest::TestSHA3_256(const std::string& input, const std::string& output)
 {
     const auto in_bytes = ParseHex(input);
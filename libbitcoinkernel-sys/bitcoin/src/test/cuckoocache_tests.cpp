@@ -49,6 +49,37 @@ BOOST_AUTO_TEST_CASE(test_cuckoocache_no_fakes)
     }
 };
 
+/* Test the counters of the cache. All elements used here map to the first slot
+ * of the table, so inserting a second element has to evict one.
+ */
+BOOST_AUTO_TEST_CASE(test_cuckoocache_stats)
+{
+    CuckooCache::cache<uint256, SignatureCacheHasher> cc{};
+    cc.setup(16);
+    const auto element{[](uint8_t i) {
+        uint256 e;
+        *e.begin() = i;
+        return e;
+    }};
+
+    cc.insert(element(1));
+    // Inserting an element that is already in the table is not counted.
+    cc.insert(element(1));
+    BOOST_CHECK(cc.contains(element(1), false));
+    BOOST_CHECK(!cc.contains(element(2), false));
+    auto stats{cc.stats()};
+    BOOST_CHECK_EQUAL(stats.hits, 1U);
+    BOOST_CHECK_EQUAL(stats.misses, 1U);
+    BOOST_CHECK_EQUAL(stats.inserts, 1U);
+    BOOST_CHECK_EQUAL(stats.evictions, 0U);
+
+    cc.insert(element(2));
+    stats = cc.stats();
+    BOOST_CHECK_EQUAL(stats.inserts, 2U);
+    BOOST_CHECK_EQUAL(stats.evictions, 1U);
+    BOOST_CHECK(cc.contains(element(1), false) != cc.contains(element(2), false));
+}
+
 struct HitRateTest : BasicTestingSetup {
 /** This helper returns the hit rate when megabytes*load worth of entries are
  * inserted into a megabytes sized cache
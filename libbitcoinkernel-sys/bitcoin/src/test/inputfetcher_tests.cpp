@@ -0,0 +1,117 @@
+// Copyright (c) 2025 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <coins.h>
+#include <consensus/amount.h>
+#include <inputfetcher.h>
+#include <primitives/block.h>
+#include <primitives/transaction.h>
+#include <script/script.h>
+#include <test/util/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace {
+
+//! Read-only coins view that can be queried from several threads and
+//! records the outpoints written to it.
+class InputFetcherTestView : public CCoinsView
+{
+public:
+    std::map<COutPoint, Coin> m_coins;
+    mutable std::atomic<int> m_reads{0};
+    std::set<COutPoint> m_written;
+
+    std::optional<Coin> GetCoin(const COutPoint& outpoint) const override
+    {
+        ++m_reads;
+        if (auto it{m_coins.find(outpoint)}; it != m_coins.end()) return it->second;
+        return std::nullopt;
+    }
+
+    bool BatchWrite(CoinsViewCacheCursor& cursor, const uint256&) override
+    {
+        for (auto it{cursor.Begin()}; it != cursor.End(); it = cursor.NextAndMaybeErase(*it)) {
+            m_written.insert(it->first);
+        }
+        return true;
+    }
+};
+
+CMutableTransaction SpendingTx(const std::vector<COutPoint>& prevouts)
+{
+    CMutableTransaction tx;
+    for (const auto& prevout : prevouts) tx.vin.emplace_back(prevout);
+    tx.vout.emplace_back(COIN, CScript{} << OP_TRUE);
+    return tx;
+}
+
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(inputfetcher_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(fetch_inputs)
+{
+    InputFetcherTestView db;
+    std::vector<COutPoint> outpoints;
+    for (uint32_t i{0}; i < 100; ++i) {
+        outpoints.emplace_back(Txid::FromUint256(m_rng.rand256()), i);
+        db.m_coins.emplace(outpoints.back(), Coin{CTxOut{COIN, CScript{} << OP_TRUE}, 1, false});
+    }
+    const COutPoint missing{Txid::FromUint256(m_rng.rand256()), 0};
+
+    CBlock block;
+    CMutableTransaction coinbase;
+    coinbase.vin.emplace_back();
+    coinbase.vout.emplace_back(COIN, CScript{} << OP_TRUE);
+    block.vtx.push_back(MakeTransactionRef(coinbase));
+    const auto tx1{MakeTransactionRef(SpendingTx({outpoints.begin(), outpoints.begin() + 50}))};
+    block.vtx.push_back(tx1);
+    // Spends an output created in the same block, an already cached coin and
+    // coins that are not cached yet.
+    std::vector<COutPoint> prevouts{COutPoint{tx1->GetHash(), 0}, outpoints[50]};
+    prevouts.insert(prevouts.end(), outpoints.begin() + 51, outpoints.end());
+    prevouts.push_back(missing);
+    block.vtx.push_back(MakeTransactionRef(SpendingTx(prevouts)));
+
+    {
+        InputFetcher fetcher{/*batch_size=*/4, /*worker_threads_num=*/0};
+        CCoinsViewCache cache{&db};
+        fetcher.FetchInputs(cache, db, block);
+        BOOST_CHECK_EQUAL(cache.GetCacheSize(), 0U);
+        BOOST_CHECK_EQUAL(db.m_reads.load(), 0);
+    }
+
+    InputFetcher fetcher{/*batch_size=*/4, /*worker_threads_num=*/3};
+    CCoinsViewCache cache{&db};
+    const Coin cached{CTxOut{2 * COIN, CScript{} << OP_TRUE}, 2, false};
+    cache.AddCoin(outpoints[50], Coin{cached}, /*possible_overwrite=*/true);
+
+    for (int round{0}; round < 2; ++round) {
+        db.m_reads = 0;
+        fetcher.FetchInputs(cache, db, block);
+        // The cached coin, the in-block output and the already fetched coins
+        // of the previous round are not read again.
+        BOOST_CHECK_EQUAL(db.m_reads.load(), round == 0 ? 100 : 1);
+        BOOST_CHECK_EQUAL(cache.GetCacheSize(), 100U);
+        for (const auto& outpoint : outpoints) {
+            BOOST_CHECK(cache.HaveCoinInCache(outpoint));
+        }
+        BOOST_CHECK(cache.AccessCoin(outpoints[50]).out == cached.out);
+        BOOST_CHECK(!cache.HaveCoinInCache(COutPoint{tx1->GetHash(), 0}));
+        BOOST_CHECK(!cache.HaveCoinInCache(missing));
+    }
+
+    // Fetched coins are not dirty, so only the added coin is written back.
+    BOOST_CHECK(cache.Flush());
+    BOOST_CHECK(db.m_written == std::set<COutPoint>{outpoints[50]});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
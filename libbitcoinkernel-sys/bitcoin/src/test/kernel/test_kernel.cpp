@@ -10,19 +10,32 @@
 
 #include <test/kernel/block_data.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <charconv>
+#include <chrono>
 #include <cstdint>
 #include <cstdlib>
 #include <filesystem>
 #include <format>
+#include <fstream>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <limits>
+#include <map>
 #include <memory>
 #include <optional>
 #include <random>
 #include <ranges>
+#include <set>
 #include <span>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 using namespace btck;
@@ -524,6 +537,22 @@ BOOST_AUTO_TEST_CASE(btck_script_verify_tests)
         /*amount*/ 88480,
         /*input_index*/ 0,
         /*is_taproot*/ true);
+
+    Transaction taproot_tx{hex_string_to_byte_vec("01000000000101d1f1c1f8cdf6759167b90f52c9ad358a369f95284e841d7a2536cef31c0549580100000000fdffffff020000000000000000316a2f49206c696b65205363686e6f7272207369677320616e6420492063616e6e6f74206c69652e204062697462756734329e06010000000000225120a37c3903c8d0db6512e2b40b0dffa05e5a3ab73603ce8c9c4b7771e5412328f90140a60c383f71bac0ec919b1d7dbc3eb72dd56e7aa99583615564f9f99b8ae4e837b758773a5b2e4c51348854c8389f008e05029db7f464a5ff2e01d5e6e626174affd30a00")};
+    std::vector<int> results;
+    auto status{ScriptVerifyStatus::OK};
+    for (unsigned int worker_threads : {0, 2}) {
+        BOOST_CHECK(VerifyAllInputs(taproot_tx, spent_outputs, ScriptVerificationFlags::ALL, worker_threads, results, status));
+        BOOST_CHECK(status == ScriptVerifyStatus::OK);
+        BOOST_CHECK_EQUAL(results.size(), 1);
+        BOOST_CHECK_EQUAL(results[0], 1);
+    }
+
+    std::vector<TransactionOutput> bad_spent_outputs;
+    bad_spent_outputs.emplace_back(taproot_spent_script_pubkey, 88481);
+    BOOST_CHECK(!VerifyAllInputs(taproot_tx, bad_spent_outputs, ScriptVerificationFlags::ALL, 2, results, status));
+    BOOST_CHECK(status == ScriptVerifyStatus::OK);
+    BOOST_CHECK_EQUAL(results[0], 0);
 }
 
 BOOST_AUTO_TEST_CASE(logging_tests)
@@ -824,6 +853,859 @@ BOOST_AUTO_TEST_CASE(btck_chainman_in_memory_tests)
     BOOST_CHECK(context.interrupt());
 }
 
+BOOST_AUTO_TEST_CASE(btck_chainman_cache_sizes_tests)
+{
+    auto test_directory{TestDirectory{"cache_sizes_test_bitcoin_kernel"}};
+
+    auto notifications{std::make_shared<TestKernelNotifications>()};
+    auto context{create_context(notifications, ChainType::REGTEST)};
+
+    ChainstateManagerOptions chainman_opts{context, test_directory.m_directory.string(), (test_directory.m_directory / "blocks").string()};
+    chainman_opts.SetCacheSize(16 << 20);
+    BOOST_CHECK(!chainman_opts.SetCacheSizes(1 << 20, 0, 4 << 20));
+    BOOST_CHECK(chainman_opts.SetCacheSizes(1 << 20, 1 << 20, 4 << 20));
+    auto chainman{std::make_unique<ChainMan>(context, chainman_opts)};
+
+    const size_t mid{REGTEST_BLOCK_DATA.size() / 2};
+    for (size_t i{0}; i < REGTEST_BLOCK_DATA.size(); i++) {
+        if (i == mid) {
+            BOOST_CHECK(!chainman->ResizeCaches(1 << 20, 0));
+            BOOST_CHECK(chainman->ResizeCaches(1 << 20, 64 << 10));
+        }
+        Block block{hex_string_to_byte_vec(REGTEST_BLOCK_DATA[i])};
+        bool new_block{false};
+        BOOST_CHECK(chainman->ProcessBlock(block, &new_block));
+        BOOST_CHECK(new_block);
+    }
+    BOOST_CHECK_EQUAL(chainman->GetChain().Height(), static_cast<int>(REGTEST_BLOCK_DATA.size()));
+}
+
+class VerificationNotifications : public TestKernelNotifications
+{
+public:
+    std::promise<ChainstateVerificationResult> m_result;
+
+    void ChainstateVerifiedHandler(ChainstateVerificationResult result, std::string_view message) override
+    {
+        m_result.set_value(result);
+    }
+};
+
+BOOST_AUTO_TEST_CASE(btck_chainman_verification_tests)
+{
+    auto test_directory{TestDirectory{"verification_test_bitcoin_kernel"}};
+
+    {
+        auto notifications{std::make_shared<TestKernelNotifications>()};
+        auto context{create_context(notifications, ChainType::REGTEST)};
+        auto chainman{create_chainman(test_directory, false, false, false, false, context)};
+        for (auto& raw_block : REGTEST_BLOCK_DATA) {
+            Block block{hex_string_to_byte_vec(raw_block)};
+            bool new_block{false};
+            BOOST_CHECK(chainman->ProcessBlock(block, &new_block));
+        }
+    }
+
+    {
+        // Verify all blocks at the highest level on creation.
+        auto notifications{std::make_shared<VerificationNotifications>()};
+        auto context{create_context(notifications, ChainType::REGTEST)};
+        ChainstateManagerOptions chainman_opts{context, test_directory.m_directory.string(), (test_directory.m_directory / "blocks").string()};
+        BOOST_CHECK(!chainman_opts.SetCheckLevel(5));
+        BOOST_CHECK(!chainman_opts.SetCheckLevel(-1));
+        BOOST_CHECK(chainman_opts.SetCheckLevel(4));
+        chainman_opts.SetCheckBlocks(0);
+        chainman_opts.SetRequireFullVerification(false);
+        ChainMan chainman{context, chainman_opts};
+        BOOST_CHECK_EQUAL(chainman.GetChain().Height(), static_cast<int>(REGTEST_BLOCK_DATA.size()));
+        // The notification is only sent for background verification.
+        BOOST_CHECK(notifications->m_result.get_future().wait_for(std::chrono::seconds{0}) == std::future_status::timeout);
+    }
+
+    // Verify the blocks on a thread after creation.
+    auto notifications{std::make_shared<VerificationNotifications>()};
+    auto result{notifications->m_result.get_future()};
+    auto context{create_context(notifications, ChainType::REGTEST)};
+    ChainstateManagerOptions chainman_opts{context, test_directory.m_directory.string(), (test_directory.m_directory / "blocks").string()};
+    BOOST_CHECK(chainman_opts.SetCheckLevel(4));
+    chainman_opts.SetCheckBlocks(50);
+    chainman_opts.SetBackgroundVerification(true);
+    ChainMan chainman{context, chainman_opts};
+    BOOST_CHECK(result.get() == ChainstateVerificationResult::SUCCESS);
+    BOOST_CHECK_EQUAL(chainman.GetChain().Height(), static_cast<int>(REGTEST_BLOCK_DATA.size()));
+}
+
+BOOST_AUTO_TEST_CASE(btck_chainman_background_verification_process_block_tests)
+{
+    auto test_directory{TestDirectory{"background_verification_test_bitcoin_kernel"}};
+
+    {
+        auto notifications{std::make_shared<TestKernelNotifications>()};
+        auto context{create_context(notifications, ChainType::REGTEST)};
+        auto chainman{create_chainman(test_directory, false, false, false, false, context)};
+        for (size_t i{0}; i + 1 < REGTEST_BLOCK_DATA.size(); ++i) {
+            Block block{hex_string_to_byte_vec(REGTEST_BLOCK_DATA[i])};
+            bool new_block{false};
+            BOOST_CHECK(chainman->ProcessBlock(block, &new_block));
+        }
+    }
+
+    // A block processed right after creation is only connected once the
+    // verification of the flushed tip is done.
+    auto notifications{std::make_shared<VerificationNotifications>()};
+    auto result{notifications->m_result.get_future()};
+    auto context{create_context(notifications, ChainType::REGTEST)};
+    ChainstateManagerOptions chainman_opts{context, test_directory.m_directory.string(), (test_directory.m_directory / "blocks").string()};
+    chainman_opts.SetBackgroundVerification(true);
+    ChainMan chainman{context, chainman_opts};
+    Block block{hex_string_to_byte_vec(REGTEST_BLOCK_DATA.back())};
+    bool new_block{false};
+    BOOST_CHECK(chainman.ProcessBlock(block, &new_block));
+    BOOST_CHECK(new_block);
+    BOOST_CHECK(result.get() == ChainstateVerificationResult::SUCCESS);
+    BOOST_CHECK_EQUAL(chainman.GetChain().Height(), static_cast<int>(REGTEST_BLOCK_DATA.size()));
+}
+
+BOOST_AUTO_TEST_CASE(btck_chainman_block_index_snapshot_tests)
+{
+    auto test_directory{TestDirectory{"block_index_snapshot_test_bitcoin_kernel"}};
+    const auto snapshot_path{test_directory.m_directory / "blocks" / "index.snapshot"};
+
+    auto notifications{std::make_shared<TestKernelNotifications>()};
+    auto context{create_context(notifications, ChainType::REGTEST)};
+    auto create_chainman{[&]() {
+        ChainstateManagerOptions chainman_opts{context, test_directory.m_directory.string(), (test_directory.m_directory / "blocks").string()};
+        chainman_opts.SetBlockIndexSnapshot(true);
+        return std::make_unique<ChainMan>(context, chainman_opts);
+    }};
+    auto process_blocks{[](ChainMan& chainman, size_t begin, size_t end) {
+        for (size_t i{begin}; i < end; i++) {
+            Block block{hex_string_to_byte_vec(REGTEST_BLOCK_DATA[i])};
+            bool new_block{false};
+            BOOST_CHECK(chainman.ProcessBlock(block, &new_block));
+            BOOST_CHECK(new_block);
+        }
+    }};
+
+    const size_t mid{REGTEST_BLOCK_DATA.size() / 2};
+    process_blocks(*create_chainman(), 0, mid);
+    BOOST_CHECK(std::filesystem::exists(snapshot_path));
+
+    {
+        // The block index is loaded from the snapshot and can be extended.
+        auto chainman{create_chainman()};
+        BOOST_CHECK_EQUAL(chainman->GetChain().Height(), static_cast<int>(mid));
+        process_blocks(*chainman, mid, REGTEST_BLOCK_DATA.size());
+    }
+
+    {
+        // A corrupted snapshot is ignored in favor of the database.
+        std::fstream file{snapshot_path, std::ios::binary | std::ios::in | std::ios::out};
+        file.seekg(100);
+        const char byte{static_cast<char>(file.get())};
+        file.seekp(100);
+        file.put(~byte);
+    }
+    auto chainman{create_chainman()};
+    BOOST_CHECK_EQUAL(chainman->GetChain().Height(), static_cast<int>(REGTEST_BLOCK_DATA.size()));
+    auto tip{chainman->GetChain().Tip()};
+    check_equal(chainman->ReadBlock(tip).value().ToBytes(), hex_string_to_byte_vec(REGTEST_BLOCK_DATA.back()));
+}
+
+BOOST_AUTO_TEST_CASE(btck_chainman_process_headers_tests)
+{
+    auto test_directory{TestDirectory{"process_headers_test_bitcoin_kernel"}};
+    auto notifications{std::make_shared<TestKernelNotifications>()};
+    auto context{create_context(notifications, ChainType::REGTEST)};
+    auto chainman{create_chainman(test_directory, false, false, false, false, context)};
+
+    std::vector<std::byte> headers;
+    for (auto& raw_block : REGTEST_BLOCK_DATA) {
+        auto block_data{hex_string_to_byte_vec(raw_block)};
+        headers.insert(headers.end(), block_data.begin(), block_data.begin() + 80);
+    }
+
+    BlockValidationResult result{BlockValidationResult::CONSENSUS};
+    BOOST_CHECK(!chainman->ProcessHeaders(std::span{headers}.first(79), &result));
+    BOOST_CHECK(result == BlockValidationResult::UNSET);
+
+    // Headers are added to the block tree without extending the chain.
+    auto entry{chainman->ProcessHeaders(headers, &result)};
+    BOOST_REQUIRE(entry);
+    BOOST_CHECK(result == BlockValidationResult::UNSET);
+    BOOST_CHECK_EQUAL(entry->GetHeight(), static_cast<int>(REGTEST_BLOCK_DATA.size()));
+    Block last_block{hex_string_to_byte_vec(REGTEST_BLOCK_DATA.back())};
+    check_equal(entry->GetHash().ToBytes(), last_block.GetHash().ToBytes());
+    BOOST_CHECK_EQUAL(chainman->GetChain().Height(), 0);
+
+    // Known headers are accepted again, processing stops at a rejected one.
+    headers[10 * 80 + 4] ^= std::byte{0x01};
+    entry = chainman->ProcessHeaders(headers, &result);
+    BOOST_REQUIRE(entry);
+    BOOST_CHECK_EQUAL(entry->GetHeight(), 10);
+    BOOST_CHECK(result == BlockValidationResult::MISSING_PREV);
+
+    // The blocks of the headers can be processed afterwards.
+    for (auto& raw_block : REGTEST_BLOCK_DATA) {
+        Block block{hex_string_to_byte_vec(raw_block)};
+        bool new_block{false};
+        BOOST_CHECK(chainman->ProcessBlock(block, &new_block));
+    }
+    BOOST_CHECK_EQUAL(chainman->GetChain().Height(), static_cast<int>(REGTEST_BLOCK_DATA.size()));
+}
+
+class StatsNotifications : public TestKernelNotifications
+{
+public:
+    std::vector<std::pair<int32_t, ValidationStats>> m_block_stats;
+
+    void BlockConnectedStatsHandler(BlockTreeEntry entry, ValidationStatsView stats) override
+    {
+        m_block_stats.emplace_back(entry.GetHeight(), stats);
+    }
+};
+
+BOOST_AUTO_TEST_CASE(btck_chainman_validation_stats_tests)
+{
+    auto test_directory{TestDirectory{"validation_stats_test_bitcoin_kernel"}};
+    auto notifications{std::make_shared<StatsNotifications>()};
+    auto context{create_context(notifications, ChainType::REGTEST)};
+    auto chainman{create_chainman(test_directory, false, false, false, false, context)};
+
+    for (auto& raw_block : REGTEST_BLOCK_DATA) {
+        Block block{hex_string_to_byte_vec(raw_block)};
+        bool new_block{false};
+        BOOST_CHECK(chainman->ProcessBlock(block, &new_block));
+    }
+
+    // The genesis block is connected when the chainstate manager is created.
+    BOOST_REQUIRE_EQUAL(notifications->m_block_stats.size(), REGTEST_BLOCK_DATA.size() + 1);
+    int64_t transactions{0}, inputs{0}, sigops_cost{0};
+    std::chrono::microseconds total{0};
+    for (size_t i{0}; i < notifications->m_block_stats.size(); ++i) {
+        const auto& [height, stats] = notifications->m_block_stats[i];
+        BOOST_CHECK_EQUAL(height, static_cast<int32_t>(i));
+        BOOST_CHECK_EQUAL(stats.GetBlockCount(), 1);
+        if (i > 0) {
+            Block block{hex_string_to_byte_vec(REGTEST_BLOCK_DATA[i - 1])};
+            BOOST_CHECK_EQUAL(stats.GetTransactionCount(), static_cast<int64_t>(block.CountTransactions()));
+            BOOST_CHECK_GE(stats.GetInputCount(), stats.GetTransactionCount());
+        }
+        BOOST_CHECK(stats.GetTime(ValidationPhase::VERIFY) >= stats.GetTime(ValidationPhase::CONNECT_TRANSACTIONS));
+        BOOST_CHECK(stats.GetTime(ValidationPhase::TOTAL) >= stats.GetTime(ValidationPhase::CONNECT_BLOCK));
+        transactions += stats.GetTransactionCount();
+        inputs += stats.GetInputCount();
+        sigops_cost += stats.GetSigopsCost();
+        total += stats.GetTime(ValidationPhase::TOTAL);
+    }
+
+    // The totals of the chainstate manager add up the statistics of each block.
+    const auto totals{chainman->GetValidationStats()};
+    BOOST_CHECK_EQUAL(totals.GetBlockCount(), static_cast<int64_t>(REGTEST_BLOCK_DATA.size()) + 1);
+    BOOST_CHECK_EQUAL(totals.GetTransactionCount(), transactions);
+    BOOST_CHECK_EQUAL(totals.GetInputCount(), inputs);
+    BOOST_CHECK_EQUAL(totals.GetSigopsCost(), sigops_cost);
+    BOOST_CHECK_GT(totals.GetSigopsCost(), 0);
+    BOOST_CHECK(totals.GetTime(ValidationPhase::TOTAL) >= total);
+}
+
+class ScriptChecksNotifications : public TestKernelNotifications
+{
+public:
+    std::vector<std::tuple<int32_t, bool, std::string>> m_script_checks;
+
+    void ScriptChecksHandler(BlockTreeEntry entry, bool enabled, std::string_view reason) override
+    {
+        m_script_checks.emplace_back(entry.GetHeight(), enabled, reason);
+    }
+};
+
+BOOST_AUTO_TEST_CASE(btck_chainman_assumed_valid_tests)
+{
+    std::vector<std::byte> headers;
+    for (auto& raw_block : REGTEST_BLOCK_DATA) {
+        auto block_data{hex_string_to_byte_vec(raw_block)};
+        headers.insert(headers.end(), block_data.begin(), block_data.begin() + 80);
+    }
+    Block last_block{hex_string_to_byte_vec(REGTEST_BLOCK_DATA.back())};
+
+    auto connect_blocks{[&](const std::function<void(ChainstateManagerOptions&)>& set_options) {
+        auto test_directory{TestDirectory{"assumed_valid_test_bitcoin_kernel"}};
+        auto notifications{std::make_shared<ScriptChecksNotifications>()};
+        auto context{create_context(notifications, ChainType::REGTEST)};
+        ChainstateManagerOptions chainman_opts{context, test_directory.m_directory.string(), (test_directory.m_directory / "blocks").string()};
+        set_options(chainman_opts);
+        ChainMan chainman{context, chainman_opts};
+        BOOST_REQUIRE(chainman.ProcessHeaders(headers));
+        for (auto& raw_block : REGTEST_BLOCK_DATA) {
+            Block block{hex_string_to_byte_vec(raw_block)};
+            bool new_block{false};
+            BOOST_CHECK(chainman.ProcessBlock(block, &new_block));
+        }
+        BOOST_CHECK_EQUAL(chainman.GetChain().Height(), static_cast<int>(REGTEST_BLOCK_DATA.size()));
+        return notifications->m_script_checks;
+    }};
+
+    // Regtest has no assumed valid block, so the scripts are always verified.
+    auto script_checks{connect_blocks([](ChainstateManagerOptions&) {})};
+    BOOST_REQUIRE_EQUAL(script_checks.size(), 1U);
+    BOOST_CHECK_EQUAL(std::get<0>(script_checks[0]), 1);
+    BOOST_CHECK(std::get<1>(script_checks[0]));
+    BOOST_CHECK_EQUAL(std::get<2>(script_checks[0]), "assumevalid=0 (always verify)");
+
+    // The chain is too short for any of its blocks to be buried by two weeks
+    // of work below the best header.
+    script_checks = connect_blocks([&](ChainstateManagerOptions& opts) { opts.SetAssumedValidBlock(last_block.GetHash()); });
+    BOOST_REQUIRE_EQUAL(script_checks.size(), 1U);
+    BOOST_CHECK(std::get<1>(script_checks[0]));
+    BOOST_CHECK_EQUAL(std::get<2>(script_checks[0]), "block too recent relative to best header");
+
+    std::array<std::byte, 32> minimum_chain_work;
+    minimum_chain_work.fill(std::byte{0xff});
+    script_checks = connect_blocks([&](ChainstateManagerOptions& opts) {
+        opts.SetAssumedValidBlock(last_block.GetHash());
+        opts.SetMinimumChainWork(minimum_chain_work);
+    });
+    BOOST_REQUIRE_EQUAL(script_checks.size(), 1U);
+    BOOST_CHECK_EQUAL(std::get<2>(script_checks[0]), "best header chainwork below minimumchainwork");
+
+    script_checks = connect_blocks([&](ChainstateManagerOptions& opts) {
+        opts.SetAssumedValidBlock(last_block.GetHash());
+        opts.SetAssumedValidBlock(std::nullopt);
+    });
+    BOOST_REQUIRE_EQUAL(script_checks.size(), 1U);
+    BOOST_CHECK_EQUAL(std::get<2>(script_checks[0]), "assumevalid=0 (always verify)");
+}
+
+class CountingValidationInterface : public ValidationInterface
+{
+public:
+    std::atomic<int> m_connected{0};
+    std::atomic<bool> m_on_caller_thread{false};
+    std::thread::id m_caller_thread{std::this_thread::get_id()};
+
+    void BlockConnected(Block block, BlockTreeEntry entry) override
+    {
+        if (std::this_thread::get_id() == m_caller_thread) m_on_caller_thread = true;
+        ++m_connected;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(btck_chainman_async_validation_interface_tests)
+{
+    auto test_directory{TestDirectory{"async_validation_interface_test_bitcoin_kernel"}};
+
+    auto validation_interface{std::make_shared<CountingValidationInterface>()};
+    ContextOptions options{};
+    ChainParams params{ChainType::REGTEST};
+    options.SetChainParams(params);
+    options.SetValidationInterface(validation_interface);
+    options.SetValidationInterfaceQueueDepth(4);
+    Context context{options};
+
+    auto chainman{create_chainman(test_directory, false, false, false, false, context)};
+    for (auto& raw_block : REGTEST_BLOCK_DATA) {
+        Block block{hex_string_to_byte_vec(raw_block)};
+        bool new_block{false};
+        BOOST_CHECK(chainman->ProcessBlock(block, &new_block));
+        BOOST_CHECK(new_block);
+    }
+
+    context.SyncValidationInterfaceQueue();
+    // The genesis block is connected when the chainstate manager is created.
+    BOOST_CHECK_EQUAL(validation_interface->m_connected.load(), static_cast<int>(REGTEST_BLOCK_DATA.size()) + 1);
+    BOOST_CHECK(!validation_interface->m_on_caller_thread);
+}
+
+class MempoolValidationInterface : public ValidationInterface
+{
+public:
+    std::atomic<int> m_added{0};
+    std::atomic<int> m_removed_for_block{0};
+
+    void TransactionAddedToMempool(Transaction transaction) override
+    {
+        ++m_added;
+    }
+
+    void TransactionRemovedFromMempool(Transaction transaction, MempoolRemovalReason reason) override
+    {
+        if (reason == MempoolRemovalReason::BLOCK) ++m_removed_for_block;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(btck_chainman_mempool_tests)
+{
+    auto test_directory{TestDirectory{"mempool_test_bitcoin_kernel"}};
+
+    auto validation_interface{std::make_shared<MempoolValidationInterface>()};
+    ContextOptions options{};
+    ChainParams params{ChainType::REGTEST};
+    options.SetChainParams(params);
+    options.SetValidationInterface(validation_interface);
+    Context context{options};
+
+    {
+        auto chainman{create_chainman(test_directory, false, false, false, false, context)};
+        BOOST_CHECK(!chainman->GetMempool());
+    }
+
+    ChainstateManagerOptions chainman_opts{context, test_directory.m_directory.string(), (test_directory.m_directory / "blocks").string()};
+    chainman_opts.SetMempool(true);
+    ChainMan chainman{context, chainman_opts};
+    auto mempool{chainman.GetMempool()};
+    BOOST_REQUIRE(mempool);
+
+    // Connect all blocks but the last one, whose transaction is then
+    // submitted to the mempool.
+    for (size_t i{0}; i + 1 < REGTEST_BLOCK_DATA.size(); ++i) {
+        Block block{hex_string_to_byte_vec(REGTEST_BLOCK_DATA[i])};
+        bool new_block{false};
+        BOOST_CHECK(chainman.ProcessBlock(block, &new_block));
+    }
+    Block last_block{hex_string_to_byte_vec(REGTEST_BLOCK_DATA.back())};
+    std::vector<Transaction> transactions{Transaction{last_block.GetTransaction(1)}};
+    Block confirmed_block{hex_string_to_byte_vec(REGTEST_BLOCK_DATA[REGTEST_BLOCK_DATA.size() - 2])};
+    std::vector<Transaction> confirmed{Transaction{confirmed_block.GetTransaction(1)}};
+
+    auto results{mempool->AcceptTransactions(confirmed)};
+    BOOST_REQUIRE_EQUAL(results.size(), 1U);
+    BOOST_CHECK(results[0].status == MempoolAcceptStatus::REJECTED);
+    BOOST_CHECK(results[0].result != TxValidationResult::UNSET);
+
+    results = mempool->AcceptPackage(transactions, /*test_accept=*/true);
+    BOOST_REQUIRE_EQUAL(results.size(), 1U);
+    BOOST_CHECK(results[0].status == MempoolAcceptStatus::ACCEPTED);
+    BOOST_CHECK_EQUAL(mempool->Size(), 0U);
+
+    results = mempool->AcceptTransactions(transactions);
+    BOOST_CHECK(results[0].status == MempoolAcceptStatus::ACCEPTED);
+    BOOST_CHECK(results[0].result == TxValidationResult::UNSET);
+    BOOST_CHECK_EQUAL(mempool->Size(), 1U);
+    BOOST_CHECK(mempool->Contains(transactions[0].Txid()));
+    BOOST_CHECK(!mempool->Contains(confirmed[0].Txid()));
+
+    results = mempool->AcceptPackage(transactions);
+    BOOST_CHECK(results[0].status == MempoolAcceptStatus::ALREADY_IN_MEMPOOL);
+
+    // Connecting the block removes its transaction from the mempool.
+    bool new_block{false};
+    BOOST_CHECK(chainman.ProcessBlock(last_block, &new_block));
+    BOOST_CHECK_EQUAL(mempool->Size(), 0U);
+
+    context.SyncValidationInterfaceQueue();
+    BOOST_CHECK_EQUAL(validation_interface->m_added.load(), 1);
+    BOOST_CHECK_EQUAL(validation_interface->m_removed_for_block.load(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(btck_chainman_validation_cache_tests)
+{
+    auto test_directory{TestDirectory{"validation_cache_test_bitcoin_kernel"}};
+
+    ContextOptions options{};
+    ChainParams params{ChainType::REGTEST};
+    options.SetChainParams(params);
+    Context context{options};
+
+    ChainstateManagerOptions chainman_opts{context, test_directory.m_directory.string(), (test_directory.m_directory / "blocks").string()};
+    chainman_opts.SetMempool(true);
+    chainman_opts.SetValidationCacheSizes(1 << 20, 1 << 20);
+    ChainMan chainman{context, chainman_opts};
+
+    for (const auto cache_type : {ValidationCacheType::SIGNATURE, ValidationCacheType::SCRIPT_EXECUTION}) {
+        auto stats{chainman.GetValidationCacheStats(cache_type)};
+        BOOST_CHECK_EQUAL(stats.GetHits(), 0U);
+        BOOST_CHECK_EQUAL(stats.GetMisses(), 0U);
+        BOOST_CHECK_EQUAL(stats.GetInserts(), 0U);
+        BOOST_CHECK_EQUAL(stats.GetEvictions(), 0U);
+    }
+
+    // Scripts checked while connecting a block are looked up, but not added.
+    for (size_t i{0}; i + 1 < REGTEST_BLOCK_DATA.size(); ++i) {
+        Block block{hex_string_to_byte_vec(REGTEST_BLOCK_DATA[i])};
+        bool new_block{false};
+        BOOST_CHECK(chainman.ProcessBlock(block, &new_block));
+    }
+    auto script_stats{chainman.GetValidationCacheStats(ValidationCacheType::SCRIPT_EXECUTION)};
+    BOOST_CHECK_EQUAL(script_stats.GetHits(), 0U);
+    BOOST_CHECK(script_stats.GetMisses() > 0);
+    BOOST_CHECK_EQUAL(script_stats.GetInserts(), 0U);
+    auto misses{script_stats.GetMisses()};
+
+    // Transactions accepted to the mempool are added, so they are found when
+    // the block containing them is connected.
+    Block last_block{hex_string_to_byte_vec(REGTEST_BLOCK_DATA.back())};
+    std::vector<Transaction> transactions{Transaction{last_block.GetTransaction(1)}};
+    auto results{chainman.GetMempool()->AcceptTransactions(transactions)};
+    BOOST_CHECK(results[0].status == MempoolAcceptStatus::ACCEPTED);
+    script_stats = chainman.GetValidationCacheStats(ValidationCacheType::SCRIPT_EXECUTION);
+    BOOST_CHECK_EQUAL(script_stats.GetInserts(), 1U);
+    BOOST_CHECK(script_stats.GetMisses() > misses);
+
+    bool new_block{false};
+    BOOST_CHECK(chainman.ProcessBlock(last_block, &new_block));
+    script_stats = chainman.GetValidationCacheStats(ValidationCacheType::SCRIPT_EXECUTION);
+    BOOST_CHECK_EQUAL(script_stats.GetHits(), 1U);
+    BOOST_CHECK_EQUAL(script_stats.GetEvictions(), 0U);
+
+    auto signature_stats{chainman.GetValidationCacheStats(ValidationCacheType::SIGNATURE)};
+    BOOST_CHECK(signature_stats.GetMisses() > 0);
+    BOOST_CHECK_EQUAL(signature_stats.GetEvictions(), 0U);
+    ValidationCacheStats signature_stats_copy{signature_stats};
+    BOOST_CHECK_EQUAL(signature_stats_copy.GetMisses(), signature_stats.GetMisses());
+}
+
+//! Mine a regtest block on top of prev that only has a coinbase transaction.
+Block mine_block(const Block& prev, int32_t height)
+{
+    const auto write_le32{[](std::vector<std::byte>& out, uint32_t value) {
+        for (int i{0}; i < 4; ++i) out.push_back(std::byte(value >> (8 * i)));
+    }};
+
+    std::vector<std::byte> coinbase;
+    write_le32(coinbase, 1);
+    coinbase.push_back(std::byte{1});
+    coinbase.insert(coinbase.end(), 32, std::byte{0});
+    write_le32(coinbase, 0xffffffff);
+    // The BIP34 height push, for heights from 128 to 32767.
+    coinbase.insert(coinbase.end(), {std::byte{3}, std::byte{2}, std::byte(height), std::byte(height >> 8)});
+    write_le32(coinbase, 0xffffffff);
+    coinbase.push_back(std::byte{1});
+    coinbase.insert(coinbase.end(), 8, std::byte{0});
+    coinbase.insert(coinbase.end(), {std::byte{1}, std::byte{0x51}}); // OP_TRUE
+    write_le32(coinbase, 0);
+
+    const auto prev_bytes{prev.ToBytes()};
+    uint32_t prev_time{0};
+    for (int i{0}; i < 4; ++i) prev_time |= std::to_integer<uint32_t>(prev_bytes[68 + i]) << (8 * i);
+
+    std::vector<std::byte> block;
+    write_le32(block, 0x20000000);
+    const auto prev_hash{prev.GetHash().ToBytes()};
+    block.insert(block.end(), prev_hash.begin(), prev_hash.end());
+    const auto merkle_root{Transaction{coinbase}.Txid().ToBytes()};
+    block.insert(block.end(), merkle_root.begin(), merkle_root.end());
+    write_le32(block, prev_time + 1);
+    write_le32(block, 0x207fffff);
+    write_le32(block, 0);
+    block.push_back(std::byte{1});
+    block.insert(block.end(), coinbase.begin(), coinbase.end());
+
+    for (uint32_t nonce{0};; ++nonce) {
+        for (int i{0}; i < 4; ++i) block[76 + i] = std::byte(nonce >> (8 * i));
+        Block candidate{block};
+        // Enough work for the regtest target of 0x7fffff << 232.
+        if (candidate.GetHash().ToBytes()[31] < std::byte{0x7f}) return candidate;
+    }
+}
+
+//! Create the block at height index + 1 of the regtest chain that the
+//! assumeutxo data for height 200 commits to, see CreateBlockChain() in
+//! test/util/mining.cpp.
+Block assumeutxo_chain_block(const std::array<std::byte, 32>& prev_hash, uint32_t index)
+{
+    const auto write_le32{[](std::vector<std::byte>& out, uint32_t value) {
+        for (int i{0}; i < 4; ++i) out.push_back(std::byte(value >> (8 * i)));
+    }};
+    const uint32_t height{index + 1};
+
+    std::vector<std::byte> coinbase;
+    write_le32(coinbase, 2);
+    coinbase.push_back(std::byte{1});
+    coinbase.insert(coinbase.end(), 32, std::byte{0});
+    write_le32(coinbase, 0xffffffff);
+    // The height as a script number, followed by OP_0.
+    if (height <= 16) {
+        coinbase.insert(coinbase.end(), {std::byte{2}, std::byte(0x50 + height), std::byte{0}});
+    } else if (height < 128) {
+        coinbase.insert(coinbase.end(), {std::byte{3}, std::byte{1}, std::byte(height), std::byte{0}});
+    } else {
+        coinbase.insert(coinbase.end(), {std::byte{4}, std::byte{2}, std::byte(height), std::byte{0}, std::byte{0}});
+    }
+    write_le32(coinbase, 0xfffffffe);
+    coinbase.push_back(std::byte{1});
+    // The block subsidy, which halves every 150 blocks on regtest.
+    const uint64_t subsidy{height < 150 ? 5'000'000'000U : 2'500'000'000U};
+    for (int i{0}; i < 8; ++i) coinbase.push_back(std::byte(subsidy >> (8 * i)));
+    // P2WSH of OP_TRUE.
+    coinbase.insert(coinbase.end(), {std::byte{0x22}, std::byte{0}, std::byte{0x20}});
+    const auto witness_program{hex_string_to_byte_vec("4ae81572f06e1b88fd5ced7a1a000945432e83e1551e6f721ee9c00b8cc33260")};
+    coinbase.insert(coinbase.end(), witness_program.begin(), witness_program.end());
+    write_le32(coinbase, index);
+
+    std::vector<std::byte> block;
+    write_le32(block, 4);
+    block.insert(block.end(), prev_hash.begin(), prev_hash.end());
+    const auto merkle_root{Transaction{coinbase}.Txid().ToBytes()};
+    block.insert(block.end(), merkle_root.begin(), merkle_root.end());
+    // One second after the previous block, starting at the genesis block time.
+    write_le32(block, 1296688602 + height);
+    write_le32(block, 0x207fffff);
+    write_le32(block, 0);
+    block.push_back(std::byte{1});
+    block.insert(block.end(), coinbase.begin(), coinbase.end());
+
+    // The first nonce that meets the regtest target of 0x7fffff << 232.
+    std::array<std::byte, 32> target{};
+    target[29] = std::byte{0xff};
+    target[30] = std::byte{0xff};
+    target[31] = std::byte{0x7f};
+    for (uint32_t nonce{0};; ++nonce) {
+        for (int i{0}; i < 4; ++i) block[76 + i] = std::byte(nonce >> (8 * i));
+        Block candidate{block};
+        const auto hash{candidate.GetHash().ToBytes()};
+        if (!std::ranges::lexicographical_compare(target | std::views::reverse, hash | std::views::reverse)) return candidate;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(btck_chainman_snapshot_tests)
+{
+    auto notifications{std::make_shared<TestKernelNotifications>()};
+    auto context{create_context(notifications, ChainType::REGTEST)};
+
+    auto dump_directory{TestDirectory{"snapshot_dump_test_bitcoin_kernel"}};
+    const auto snapshot_path{dump_directory.m_directory / "utxo.dat"};
+    std::vector<std::byte> headers;
+    std::array<std::byte, 32> tip_hash;
+    std::array<std::byte, 32> utxo_set_hash;
+    {
+        auto chainman{create_chainman(dump_directory, false, false, false, false, context)};
+        tip_hash = chainman->GetChain().Tip().GetHash().ToBytes();
+        for (uint32_t index{0}; index < 200; ++index) {
+            Block block{assumeutxo_chain_block(tip_hash, index)};
+            bool new_block{false};
+            BOOST_REQUIRE(chainman->ProcessBlock(block, &new_block));
+            const auto block_bytes{block.ToBytes()};
+            headers.insert(headers.end(), block_bytes.begin(), block_bytes.begin() + 80);
+            tip_hash = block.GetHash().ToBytes();
+        }
+        BOOST_CHECK_EQUAL(chainman->GetChain().Height(), 200);
+        utxo_set_hash = chainman->ComputeUtxoStats(UtxoSetHashType::HASH_SERIALIZED).GetHash();
+        BOOST_CHECK(chainman->DumpSnapshot(snapshot_path.string()));
+    }
+
+    // A chainstate manager that only knows the headers activates the
+    // snapshot, whose base block becomes its tip.
+    auto load_directory{TestDirectory{"snapshot_load_test_bitcoin_kernel"}};
+    auto chainman{create_chainman(load_directory, false, false, false, false, context)};
+    BOOST_CHECK(!chainman->LoadSnapshot(snapshot_path.string()));
+    BOOST_REQUIRE(chainman->ProcessHeaders(headers));
+    BOOST_CHECK_EQUAL(chainman->GetChain().Height(), 0);
+    BOOST_REQUIRE(chainman->LoadSnapshot(snapshot_path.string()));
+    const auto tip{chainman->GetChain().Tip()};
+    BOOST_CHECK_EQUAL(tip.GetHeight(), 200);
+    BOOST_CHECK(tip.GetHash().ToBytes() == tip_hash);
+    const auto stats{chainman->ComputeUtxoStats(UtxoSetHashType::HASH_SERIALIZED)};
+    BOOST_CHECK(stats.GetBlockHash().ToBytes() == tip_hash);
+    BOOST_CHECK(stats.GetHash() == utxo_set_hash);
+    BOOST_CHECK(!chainman->LoadSnapshot(snapshot_path.string()));
+}
+
+BOOST_AUTO_TEST_CASE(btck_chainman_prune_tests)
+{
+    auto test_directory{TestDirectory{"prune_test_bitcoin_kernel"}};
+    auto notifications{std::make_shared<TestKernelNotifications>()};
+    auto context{create_context(notifications, ChainType::REGTEST)};
+
+    {
+        auto chainman{create_chainman(test_directory, false, false, false, false, context)};
+        BOOST_CHECK(!chainman->PruneToHeight(1));
+    }
+
+    ChainstateManagerOptions chainman_opts{context, test_directory.m_directory.string(), (test_directory.m_directory / "blocks").string()};
+    BOOST_CHECK(!chainman_opts.SetPruneTarget(1));
+    BOOST_CHECK(!chainman_opts.SetPruneTarget(550 * 1024 * 1024 - 1));
+    BOOST_CHECK(chainman_opts.SetPruneTarget(550 * 1024 * 1024));
+    BOOST_CHECK(chainman_opts.SetPruneTarget(0));
+    BOOST_CHECK(chainman_opts.SetPruneTarget(std::numeric_limits<uint64_t>::max()));
+    ChainMan chainman{context, chainman_opts};
+
+    for (const auto& data : REGTEST_BLOCK_DATA) {
+        Block block{hex_string_to_byte_vec(data)};
+        bool new_block{false};
+        BOOST_CHECK(chainman.ProcessBlock(block, &new_block));
+    }
+
+    BOOST_CHECK(chainman.SetPruneLock("index", 100));
+    BOOST_CHECK(chainman.SetPruneLock("index", 150));
+    BOOST_CHECK(!chainman.SetPruneLock("index", -1));
+    BOOST_CHECK(chainman.DeletePruneLock("index"));
+    BOOST_CHECK(!chainman.DeletePruneLock("index"));
+
+    // The regtest chain is shorter than its prune-after height.
+    BOOST_CHECK(!chainman.PruneToHeight(100));
+    BOOST_CHECK(!chainman.PruneToHeight(REGTEST_BLOCK_DATA.size() + 1));
+
+    BOOST_CHECK(chainman.ReadBlock(chainman.GetChain().GetByHeight(1)));
+}
+
+BOOST_AUTO_TEST_CASE(btck_chainman_prune_reload_tests)
+{
+    auto test_directory{TestDirectory{"prune_reload_test_bitcoin_kernel"}};
+    auto notifications{std::make_shared<TestKernelNotifications>()};
+    auto context{create_context(notifications, ChainType::REGTEST)};
+
+    ChainstateManagerOptions chainman_opts{context, test_directory.m_directory.string(), (test_directory.m_directory / "blocks").string()};
+    BOOST_CHECK(chainman_opts.SetPruneTarget(std::numeric_limits<uint64_t>::max()));
+    // Spread the chain over several block files, so that some can be pruned.
+    chainman_opts.SetFastPrune(true);
+
+    // Regtest blocks are only pruned once the chain reaches height 1000.
+    constexpr int32_t tip_height{1000};
+    {
+        ChainMan chainman{context, chainman_opts};
+        std::optional<Block> tip;
+        for (const auto& data : REGTEST_BLOCK_DATA) {
+            tip.emplace(hex_string_to_byte_vec(data));
+            bool new_block{false};
+            BOOST_CHECK(chainman.ProcessBlock(*tip, &new_block));
+        }
+        for (int32_t height = REGTEST_BLOCK_DATA.size() + 1; height <= tip_height; ++height) {
+            tip.emplace(mine_block(*tip, height));
+            bool new_block{false};
+            BOOST_REQUIRE(chainman.ProcessBlock(*tip, &new_block));
+            BOOST_CHECK(new_block);
+        }
+        BOOST_REQUIRE_EQUAL(chainman.GetChain().Height(), tip_height);
+
+        BOOST_CHECK(chainman.PruneToHeight(tip_height));
+        BOOST_CHECK(!chainman.ReadBlock(chainman.GetChain().GetByHeight(1)));
+        BOOST_CHECK(chainman.ReadBlock(chainman.GetChain().GetByHeight(tip_height)));
+    }
+
+    {
+        // The pruned block tree is loaded again in prune mode.
+        ChainMan chainman{context, chainman_opts};
+        BOOST_CHECK_EQUAL(chainman.GetChain().Height(), tip_height);
+        BOOST_CHECK(!chainman.ReadBlock(chainman.GetChain().GetByHeight(1)));
+        BOOST_CHECK(chainman.ReadBlock(chainman.GetChain().GetByHeight(tip_height)));
+    }
+
+    // Without a prune target it cannot be loaded.
+    BOOST_CHECK(chainman_opts.SetPruneTarget(0));
+    BOOST_CHECK_THROW(ChainMan(context, chainman_opts), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(btck_chainman_background_coins_flush_tests)
+{
+    auto test_directory{TestDirectory{"background_coins_flush_test_bitcoin_kernel"}};
+    auto reference_directory{TestDirectory{"background_coins_flush_reference_test_bitcoin_kernel"}};
+    auto notifications{std::make_shared<TestKernelNotifications>()};
+    auto context{create_context(notifications, ChainType::REGTEST)};
+
+    std::array<std::byte, 32> reference_hash;
+    {
+        auto chainman{create_chainman(reference_directory, false, false, true, true, context)};
+        for (const auto& data : REGTEST_BLOCK_DATA) {
+            Block block{hex_string_to_byte_vec(data)};
+            bool new_block{false};
+            BOOST_CHECK(chainman->ProcessBlock(block, &new_block));
+        }
+        reference_hash = chainman->ComputeUtxoStats(UtxoSetHashType::MUHASH).GetHash();
+    }
+
+    {
+        ChainstateManagerOptions chainman_opts{context, test_directory.m_directory.string(), (test_directory.m_directory / "blocks").string()};
+        // A tiny coins cache is flushed after every block, so the coins are
+        // read while the previous flush is being written.
+        BOOST_CHECK(chainman_opts.SetCacheSizes(1 << 20, 1 << 20, 1));
+        chainman_opts.SetBackgroundCoinsFlush(true);
+        ChainMan chainman{context, chainman_opts};
+
+        for (const auto& data : REGTEST_BLOCK_DATA) {
+            Block block{hex_string_to_byte_vec(data)};
+            bool new_block{false};
+            BOOST_CHECK(chainman.ProcessBlock(block, &new_block));
+            std::vector<OutPoint> outpoints{OutPoint{block.GetTransaction(0).Txid(), 0}};
+            auto coins{chainman.GetCoins(outpoints)};
+            BOOST_REQUIRE(coins);
+            BOOST_CHECK((*coins)[0]);
+        }
+        BOOST_CHECK_EQUAL(chainman.GetChain().Height(), static_cast<int>(REGTEST_BLOCK_DATA.size()));
+        BOOST_CHECK(chainman.ComputeUtxoStats(UtxoSetHashType::MUHASH).GetHash() == reference_hash);
+    }
+
+    // The coins written in the background are on disk after a restart.
+    auto chainman{create_chainman(test_directory, false, false, false, false, context)};
+    BOOST_CHECK_EQUAL(chainman->GetChain().Height(), static_cast<int>(REGTEST_BLOCK_DATA.size()));
+    BOOST_CHECK(chainman->ComputeUtxoStats(UtxoSetHashType::MUHASH).GetHash() == reference_hash);
+}
+
+BOOST_AUTO_TEST_CASE(btck_chainman_compact_coins_cache_tests)
+{
+    auto test_directory{TestDirectory{"compact_coins_cache_test_bitcoin_kernel"}};
+    auto reference_directory{TestDirectory{"compact_coins_cache_reference_test_bitcoin_kernel"}};
+    auto notifications{std::make_shared<TestKernelNotifications>()};
+    auto context{create_context(notifications, ChainType::REGTEST)};
+
+    // All outputs created in the chain, spent and unspent.
+    std::vector<OutPoint> outpoints;
+    for (const auto& data : REGTEST_BLOCK_DATA) {
+        Block block{hex_string_to_byte_vec(data)};
+        for (size_t i{0}; i < block.CountTransactions(); ++i) {
+            auto tx{block.GetTransaction(i)};
+            for (size_t j{0}; j < tx.CountOutputs(); ++j) {
+                outpoints.emplace_back(tx.Txid(), static_cast<uint32_t>(j));
+            }
+        }
+    }
+
+    std::vector<std::optional<Coin>> reference_coins;
+    std::array<std::byte, 32> reference_hash;
+    {
+        auto chainman{create_chainman(reference_directory, false, false, true, true, context)};
+        for (const auto& data : REGTEST_BLOCK_DATA) {
+            Block block{hex_string_to_byte_vec(data)};
+            bool new_block{false};
+            BOOST_CHECK(chainman->ProcessBlock(block, &new_block));
+        }
+        auto coins{chainman->GetCoins(outpoints)};
+        BOOST_REQUIRE(coins);
+        reference_coins = std::move(*coins);
+        reference_hash = chainman->ComputeUtxoStats(UtxoSetHashType::MUHASH).GetHash();
+    }
+
+    auto check_coins{[&](const ChainMan& chainman) {
+        auto coins{chainman.GetCoins(outpoints)};
+        BOOST_REQUIRE(coins);
+        BOOST_REQUIRE_EQUAL(coins->size(), reference_coins.size());
+        for (size_t i{0}; i < coins->size(); ++i) {
+            BOOST_REQUIRE_EQUAL((*coins)[i].has_value(), reference_coins[i].has_value());
+            if (!(*coins)[i]) continue;
+            BOOST_CHECK_EQUAL((*coins)[i]->GetConfirmationHeight(), reference_coins[i]->GetConfirmationHeight());
+            BOOST_CHECK_EQUAL((*coins)[i]->GetOutput().Amount(), reference_coins[i]->GetOutput().Amount());
+        }
+    }};
+
+    auto make_chainman{[&]() {
+        ChainstateManagerOptions chainman_opts{context, test_directory.m_directory.string(), (test_directory.m_directory / "blocks").string()};
+        BOOST_CHECK(chainman_opts.SetCacheSizes(1 << 20, 1 << 20, 1 << 20));
+        chainman_opts.SetCompactCoinsCache(true);
+        return ChainMan{context, chainman_opts};
+    }};
+
+    {
+        // The coins written to the database while connecting the blocks are
+        // kept in the compact coins cache.
+        auto chainman{make_chainman()};
+        for (const auto& data : REGTEST_BLOCK_DATA) {
+            Block block{hex_string_to_byte_vec(data)};
+            bool new_block{false};
+            BOOST_CHECK(chainman.ProcessBlock(block, &new_block));
+        }
+        check_coins(chainman);
+        BOOST_CHECK(chainman.ComputeUtxoStats(UtxoSetHashType::MUHASH).GetHash() == reference_hash);
+    }
+
+    // After a restart, the coins read from the database are kept in the
+    // compact coins cache, and read from there the second time.
+    auto chainman{make_chainman()};
+    BOOST_CHECK_EQUAL(chainman.GetChain().Height(), static_cast<int>(REGTEST_BLOCK_DATA.size()));
+    check_coins(chainman);
+    check_coins(chainman);
+    BOOST_CHECK(chainman.ComputeUtxoStats(UtxoSetHashType::MUHASH).GetHash() == reference_hash);
+}
+
 BOOST_AUTO_TEST_CASE(btck_chainman_regtest_tests)
 {
     auto test_directory{TestDirectory{"regtest_test_bitcoin_kernel"}};
@@ -864,6 +1746,125 @@ BOOST_AUTO_TEST_CASE(btck_chainman_regtest_tests)
     auto read_block_2 = chainman->ReadBlock(tip_2).value();
     check_equal(read_block_2.ToBytes(), hex_string_to_byte_vec(REGTEST_BLOCK_DATA[REGTEST_BLOCK_DATA.size() - 2]));
 
+    auto raw_tip{hex_string_to_byte_vec(REGTEST_BLOCK_DATA[REGTEST_BLOCK_DATA.size() - 1])};
+    check_equal(chainman->ReadRawBlock(tip).value(), raw_tip);
+    check_equal(chainman->ReadRawBlock(tip, /*check_header=*/false).value(), raw_tip);
+    std::vector<std::byte> raw_buffer(raw_tip.size() - 1);
+    size_t raw_block_len{0};
+    BOOST_CHECK(!chainman->ReadRawBlockInto(tip, raw_buffer, raw_block_len));
+    BOOST_CHECK_EQUAL(raw_block_len, raw_tip.size());
+    raw_buffer.resize(raw_block_len + 10);
+    BOOST_CHECK(chainman->ReadRawBlockInto(tip, raw_buffer, raw_block_len));
+    BOOST_CHECK_EQUAL(raw_block_len, raw_tip.size());
+    check_equal(std::span{raw_buffer}.first(raw_block_len), raw_tip);
+
+    for (const int worker_threads : {0, 3}) {
+        auto reader{chainman->ReadBlocks(1, chain.Height(), /*read_spent_outputs=*/true, worker_threads, /*max_in_flight=*/4)};
+        int32_t expected_height{1};
+        while (auto item{reader.Next()}) {
+            BOOST_CHECK_EQUAL(item->entry.GetHeight(), expected_height);
+            check_equal(item->block.ToBytes(), hex_string_to_byte_vec(REGTEST_BLOCK_DATA[expected_height - 1]));
+            BOOST_CHECK(item->spent_outputs.has_value());
+            BOOST_CHECK_EQUAL(item->spent_outputs->Count(), item->block.CountTransactions() - 1);
+            ++expected_height;
+        }
+        BOOST_CHECK_EQUAL(expected_height, chain.Height() + 1);
+        BOOST_CHECK(!reader.Next());
+    }
+    {
+        auto reader{chainman->ReadBlocks(0, 0, /*read_spent_outputs=*/false, /*worker_threads=*/1, /*max_in_flight=*/1)};
+        auto item{reader.Next()};
+        BOOST_CHECK(item && !item->spent_outputs);
+        BOOST_CHECK(!reader.Next());
+    }
+    BOOST_CHECK_THROW(chainman->ReadBlocks(0, chain.Height() + 1, false, 1, 1), std::runtime_error);
+
+    std::map<std::pair<std::array<std::byte, 32>, uint32_t>, int64_t> coins;
+    for (const size_t shard_count : {1, 3, 300}) {
+        auto cursor{chainman->GetCoinsCursor(shard_count)};
+        BOOST_CHECK(cursor.GetBlockHash() == tip.GetHash());
+        BOOST_CHECK(!chainman->ResizeCaches(1 << 20, 1 << 20));
+        std::map<std::pair<std::array<std::byte, 32>, uint32_t>, int64_t> shard_coins;
+        for (size_t shard{0}; shard < shard_count; ++shard) {
+            while (true) {
+                auto batch{cursor.Next(shard, 7)};
+                BOOST_CHECK_LE(batch.size(), 7U);
+                if (batch.empty()) break;
+                for (const auto& [outpoint, coin] : batch) {
+                    BOOST_CHECK_LE(coin.GetConfirmationHeight(), static_cast<uint32_t>(chain.Height()));
+                    BOOST_CHECK(shard_coins.emplace(std::pair{outpoint.Txid().ToBytes(), outpoint.index()}, coin.GetOutput().Amount()).second);
+                }
+            }
+        }
+        BOOST_CHECK_THROW(cursor.Next(shard_count, 1), std::runtime_error);
+        if (coins.empty()) {
+            coins = std::move(shard_coins);
+            BOOST_CHECK(!coins.empty());
+        } else {
+            BOOST_CHECK(shard_coins == coins);
+        }
+    }
+    BOOST_CHECK_THROW(chainman->GetCoinsCursor(0), std::runtime_error);
+
+    // Look up the coins found by the cursor in reverse order, followed by an
+    // out point that does not exist.
+    std::vector<OutPoint> outpoints;
+    for (auto it{coins.rbegin()}; it != coins.rend(); ++it) {
+        outpoints.emplace_back(Txid{it->first.first}, it->first.second);
+    }
+    outpoints.emplace_back(Txid{coins.begin()->first.first}, std::numeric_limits<uint32_t>::max());
+    BOOST_CHECK(outpoints.back().Txid() == outpoints[coins.size() - 1].Txid());
+    BOOST_CHECK_EQUAL(outpoints.back().index(), std::numeric_limits<uint32_t>::max());
+    auto looked_up{chainman->GetCoins(outpoints)};
+    BOOST_REQUIRE(looked_up);
+    BOOST_REQUIRE_EQUAL(looked_up->size(), outpoints.size());
+    size_t i{0};
+    for (auto it{coins.rbegin()}; it != coins.rend(); ++it, ++i) {
+        BOOST_REQUIRE((*looked_up)[i]);
+        BOOST_CHECK_EQUAL((*looked_up)[i]->GetOutput().Amount(), it->second);
+    }
+    BOOST_CHECK(!looked_up->back());
+    BOOST_CHECK(chainman->GetCoins({})->empty());
+
+    int64_t total_amount{0};
+    std::set<std::array<std::byte, 32>> coin_txids;
+    for (const auto& [outpoint, amount] : coins) {
+        total_amount += amount;
+        coin_txids.insert(outpoint.first);
+    }
+    for (const auto hash_type : {UtxoSetHashType::HASH_SERIALIZED, UtxoSetHashType::MUHASH, UtxoSetHashType::NONE}) {
+        const auto stats{chainman->ComputeUtxoStats(hash_type)};
+        BOOST_CHECK_EQUAL(stats.GetHeight(), chain.Height());
+        BOOST_CHECK(stats.GetBlockHash() == tip.GetHash());
+        BOOST_CHECK_EQUAL(stats.GetCoinsCount(), coins.size());
+        BOOST_CHECK_EQUAL(stats.GetTransactionCount(), coin_txids.size());
+        BOOST_CHECK_EQUAL(stats.GetTotalAmount(), total_amount);
+        BOOST_CHECK_EQUAL((stats.GetHash() == std::array<std::byte, 32>{}), hash_type == UtxoSetHashType::NONE);
+        const auto parallel_stats{chainman->ComputeUtxoStats(hash_type, /*worker_threads=*/3)};
+        BOOST_CHECK(parallel_stats.GetHash() == stats.GetHash());
+        BOOST_CHECK_EQUAL(parallel_stats.GetCoinsCount(), stats.GetCoinsCount());
+        BOOST_CHECK_EQUAL(parallel_stats.GetTransactionCount(), stats.GetTransactionCount());
+        BOOST_CHECK_EQUAL(parallel_stats.GetTotalAmount(), stats.GetTotalAmount());
+    }
+    BOOST_CHECK_THROW(chainman->ComputeUtxoStats(UtxoSetHashType::MUHASH, -1), std::runtime_error);
+
+    // The dumped snapshot starts with its metadata. Regtest has no assumeutxo
+    // data for the tip, so loading it back is rejected.
+    const auto snapshot_path{test_directory.m_directory / "utxo.dat"};
+    BOOST_CHECK(chainman->DumpSnapshot(snapshot_path.string()));
+    BOOST_CHECK(!chainman->DumpSnapshot(snapshot_path.string()));
+    BOOST_CHECK(!std::filesystem::exists(snapshot_path.string() + ".incomplete"));
+    {
+        std::ifstream snapshot_file{snapshot_path, std::ios::binary};
+        std::array<char, 5> magic{};
+        snapshot_file.read(magic.data(), magic.size());
+        BOOST_CHECK(snapshot_file);
+        BOOST_CHECK(std::string_view(magic.data(), magic.size()) == std::string_view("utxo\xff", 5));
+    }
+    BOOST_CHECK(!chainman->LoadSnapshot(snapshot_path.string()));
+    BOOST_CHECK(!chainman->LoadSnapshot((test_directory.m_directory / "missing.dat").string()));
+    BOOST_CHECK(chainman->ComputeUtxoStats(UtxoSetHashType::NONE).GetBlockHash() == tip.GetHash());
+
     Txid txid = read_block.Transactions()[0].Txid();
     Txid txid_2 = read_block_2.Transactions()[0].Txid();
     BOOST_CHECK(txid != txid_2);
@@ -905,6 +1906,11 @@ BOOST_AUTO_TEST_CASE(btck_chainman_regtest_tests)
             for (size_t i{0}; i < inputs.size(); ++i) {
                 BOOST_CHECK(spent_outputs[i].GetScriptPubkey().Verify(spent_outputs[i].Amount(), transaction, spent_outputs, i, ScriptVerificationFlags::ALL, status));
             }
+            if (!inputs.empty()) {
+                std::vector<int> results;
+                BOOST_CHECK(VerifyAllInputs(transaction, spent_outputs, ScriptVerificationFlags::ALL, 4, results, status));
+                BOOST_CHECK(std::ranges::all_of(results, [](int result) { return result == 1; }));
+            }
         }
     }
 
@@ -0,0 +1,72 @@
+// Copyright (c) 2025 The Bitcoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <chain.h>
+#include <coins.h>
+#include <consensus/amount.h>
+#include <kernel/coinstats.h>
+#include <primitives/transaction.h>
+#include <script/script.h>
+#include <snapshotcoinswriter.h>
+#include <sync.h>
+#include <test/util/setup_common.h>
+#include <txdb.h>
+#include <uint256.h>
+#include <validation.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+BOOST_FIXTURE_TEST_SUITE(snapshotcoinswriter_tests, TestChain100Setup)
+
+BOOST_AUTO_TEST_CASE(write_coins)
+{
+    // Coins of random txids in outpoint order, some of which have several
+    // outputs.
+    std::vector<Txid> txids;
+    for (int i{0}; i < 500; ++i) {
+        txids.push_back(Txid::FromUint256(m_rng.rand256()));
+    }
+    std::sort(txids.begin(), txids.end());
+    SnapshotCoinsWriter::Coins coins;
+    for (size_t i{0}; i < txids.size(); ++i) {
+        for (uint32_t n{0}; n <= i % 3; ++n) {
+            coins.emplace_back(COutPoint{txids[i], n}, Coin{CTxOut{m_rng.randrange<CAmount>(COIN), CScript{} << OP_TRUE}, 1, false});
+        }
+    }
+    const uint256 tip_hash{WITH_LOCK(cs_main, return m_node.chainman->ActiveChain().Tip()->GetBlockHash())};
+
+    for (const int threads : {0, 3}) {
+        CCoinsViewDB db{{.path = "snapshot", .cache_bytes = 1 << 20, .memory_only = true}, {}};
+        uint256 hash;
+        {
+            // Batches split the outputs of some transactions.
+            SnapshotCoinsWriter writer{db, threads, /*max_in_flight=*/2};
+            for (size_t i{0}; i < coins.size(); i += 7) {
+                writer.Add({coins.begin() + i, coins.begin() + std::min(i + 7, coins.size())});
+            }
+            hash = writer.Finish();
+        }
+
+        // The hash matches the one computed from the database.
+        CCoinsViewCache cache{&db};
+        cache.SetBestBlock(tip_hash);
+        BOOST_REQUIRE(cache.Flush());
+        const auto stats{kernel::ComputeUTXOStats(kernel::CoinStatsHashType::HASH_SERIALIZED, &db, m_node.chainman->m_blockman)};
+        BOOST_REQUIRE(stats);
+        BOOST_CHECK_EQUAL(stats->coins_count, coins.size());
+        BOOST_CHECK_EQUAL(hash, stats->hashSerialized);
+    }
+
+    // Destroying the writer without finishing joins the worker threads.
+    CCoinsViewDB db{{.path = "snapshot", .cache_bytes = 1 << 20, .memory_only = true}, {}};
+    SnapshotCoinsWriter writer{db, /*worker_threads_num=*/3, /*max_in_flight=*/1};
+    writer.Add({coins.begin(), coins.begin() + 7});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
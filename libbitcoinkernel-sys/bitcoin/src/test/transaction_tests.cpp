@@ -16,6 +16,7 @@
 #include <key.h>
 #include <policy/policy.h>
 #include <policy/settings.h>
+#include <primitives/block.h>
 #include <primitives/transaction_identifier.h>
 #include <script/interpreter.h>
 #include <script/script.h>
@@ -33,6 +34,7 @@
 #include <util/string.h>
 #include <validation.h>
 
+#include <algorithm>
 #include <functional>
 #include <map>
 #include <string>
@@ -388,6 +390,85 @@ BOOST_AUTO_TEST_CASE(basic_transaction_tests)
     BOOST_CHECK_MESSAGE(!CheckTransaction(CTransaction(tx), state) || !state.IsValid(), "Transaction with duplicate txins should be invalid.");
 }
 
+BOOST_AUTO_TEST_CASE(tx_unserialize_hashes)
+{
+    // Transactions read from contiguous memory are hashed from the bytes read, which must
+    // give the txid and wtxid of the transaction serialized again.
+    std::vector<CMutableTransaction> txs;
+    for (const UniValue& tests : {read_json(json_tests::tx_valid), read_json(json_tests::tx_invalid)}) {
+        for (unsigned int idx = 0; idx < tests.size(); idx++) {
+            const UniValue& test = tests[idx];
+            if (test[0].isArray() && test.size() == 3 && test[1].isStr()) {
+                DataStream stream(ParseHex(test[1].get_str()));
+                txs.emplace_back(deserialize, TX_WITH_WITNESS, stream);
+            }
+        }
+    }
+    BOOST_REQUIRE(std::ranges::any_of(txs, [](const auto& tx) { return tx.HasWitness(); }));
+
+    std::vector<CTransactionRef> expected_txs;
+    for (const auto& mtx : txs) {
+        const CTransaction expected{mtx};
+        expected_txs.push_back(MakeTransactionRef(mtx));
+
+        for (const auto& params : {TX_WITH_WITNESS, TX_NO_WITNESS}) {
+            DataStream stream;
+            stream << params(expected);
+            SpanReader reader{stream};
+            const CTransaction from_reader(deserialize, params, reader);
+            const CTransaction from_stream(deserialize, params, stream);
+            const CTransaction reserialized{CMutableTransaction(from_stream)};
+            BOOST_CHECK(reader.empty());
+            BOOST_CHECK(stream.empty());
+            for (const auto* tx : {&from_reader, &from_stream}) {
+                BOOST_CHECK_EQUAL(tx->GetHash(), expected.GetHash());
+                BOOST_CHECK_EQUAL(tx->GetWitnessHash(), reserialized.GetWitnessHash());
+            }
+        }
+    }
+
+    // As part of a larger stream, and wrapped in a ParamsStream.
+    DataStream all_txs;
+    all_txs << TX_WITH_WITNESS(expected_txs);
+    std::vector<CTransactionRef> read_txs;
+    BOOST_CHECK_NO_THROW(all_txs >> TX_WITH_WITNESS(read_txs));
+    BOOST_REQUIRE_EQUAL(read_txs.size(), expected_txs.size());
+    for (size_t i{0}; i < expected_txs.size(); ++i) {
+        BOOST_CHECK_EQUAL(read_txs[i]->GetHash(), expected_txs[i]->GetHash());
+        BOOST_CHECK_EQUAL(read_txs[i]->GetWitnessHash(), expected_txs[i]->GetWitnessHash());
+    }
+
+    // The transactions of a block are hashed together.
+    CBlock block;
+    block.vtx = expected_txs;
+    DataStream block_stream;
+    block_stream << TX_WITH_WITNESS(block);
+    CBlock read_block;
+    BOOST_CHECK_NO_THROW(block_stream >> TX_WITH_WITNESS(read_block));
+    BOOST_CHECK(block_stream.empty());
+    BOOST_CHECK_EQUAL(read_block.GetHash(), block.GetHash());
+    BOOST_REQUIRE_EQUAL(read_block.vtx.size(), expected_txs.size());
+    for (size_t i{0}; i < expected_txs.size(); ++i) {
+        BOOST_CHECK_EQUAL(read_block.vtx[i]->GetHash(), expected_txs[i]->GetHash());
+        BOOST_CHECK_EQUAL(read_block.vtx[i]->GetWitnessHash(), expected_txs[i]->GetWitnessHash());
+    }
+    DataStream serialized_block;
+    serialized_block << TX_WITH_WITNESS(block);
+    for (size_t size : {size_t{80}, serialized_block.size() / 2, serialized_block.size() - 1}) {
+        DataStream stream{std::span{serialized_block.data(), size}};
+        BOOST_CHECK_THROW(stream >> TX_WITH_WITNESS(read_block), std::ios_base::failure);
+    }
+
+    // A truncated transaction fails to unserialize instead of being hashed past its end.
+    const auto witness_tx{std::ranges::find_if(txs, [](const auto& tx) { return tx.HasWitness(); })};
+    DataStream serialized;
+    serialized << TX_WITH_WITNESS(*witness_tx);
+    for (size_t size{0}; size < serialized.size(); ++size) {
+        DataStream stream{std::span{serialized.data(), size}};
+        BOOST_CHECK_THROW(CTransaction(deserialize, TX_WITH_WITNESS, stream), std::ios_base::failure);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(test_Get)
 {
     FillableSigningProvider keystore;
@@ -56,6 +56,7 @@ struct TestOpts {
     bool setup_net{true};
     bool setup_validation_interface{true};
     bool min_validation_cache{false}; // Equivalent of -maxsigcachebytes=0
+    bool input_fetch{true}; // Fetch block inputs on worker threads before connecting
 };
 
 /** Basic testing setup.
@@ -60,6 +60,23 @@ BOOST_AUTO_TEST_CASE(validation_chainstate_resize_caches)
 
         // The view cache should be empty since we had to destruct to downsize.
         BOOST_CHECK(!c1.CoinsTip().HaveCoinInCache(outpoint));
+
+        // The coins database is not reopened while a cursor reads from it,
+        // so only the coinsview cache is resized.
+        auto cursor{c1.CoinsDB().Cursor()};
+        ++c1.m_coins_db_cursors;
+        c1.ResizeCoinsCaches(1 << 23, 1 << 22);
+        BOOST_CHECK_EQUAL(c1.m_coinstip_cache_size_bytes, size_t{1} << 23);
+        BOOST_CHECK_EQUAL(c1.m_coinsdb_cache_size_bytes, size_t{1} << 23);
+        BOOST_CHECK(cursor->Valid());
+        COutPoint key;
+        BOOST_CHECK(cursor->GetKey(key));
+        BOOST_CHECK(key == outpoint);
+        cursor.reset();
+        --c1.m_coins_db_cursors;
+
+        c1.ResizeCoinsCaches(1 << 23, 1 << 22);
+        BOOST_CHECK_EQUAL(c1.m_coinsdb_cache_size_bytes, size_t{1} << 22);
     }
 }
 
@@ -12,11 +12,14 @@
 #include <random.h>
 #include <serialize.h>
 #include <uint256.h>
+#include <util/threadnames.h>
 #include <util/vector.h>
 
 #include <cassert>
 #include <cstdlib>
+#include <exception>
 #include <iterator>
+#include <stdexcept>
 #include <utility>
 
 static constexpr uint8_t DB_COIN{'C'};
@@ -182,14 +185,32 @@ private:
     friend class CCoinsViewDB;
 };
 
+void CCoinsViewDB::WriteCoins(std::span<const std::pair<COutPoint, Coin>> coins)
+{
+    CDBBatch batch(*m_db);
+    for (const auto& [outpoint, coin] : coins) {
+        batch.Write(CoinEntry(&outpoint), coin);
+        if (batch.ApproximateSize() > m_options.batch_write_bytes) {
+            m_db->WriteBatch(batch);
+            batch.Clear();
+        }
+    }
+    m_db->WriteBatch(batch);
+}
+
 std::unique_ptr<CCoinsViewCursor> CCoinsViewDB::Cursor() const
+{
+    return Cursor(COutPoint{Txid{}, 0});
+}
+
+std::unique_ptr<CCoinsViewCursor> CCoinsViewDB::Cursor(const COutPoint& start) const
 {
     auto i = std::make_unique<CCoinsViewDBCursor>(
         const_cast<CDBWrapper&>(*m_db).NewIterator(), GetBestBlock());
     /* It seems that there are no "const iterators" for LevelDB.  Since we
        only need read operations on it, use a const-cast to get around
        that restriction.  */
-    i->pcursor->Seek(DB_COIN);
+    i->pcursor->Seek(CoinEntry(&start));
     // Cache key of first record
     if (i->pcursor->Valid()) {
         CoinEntry entry(&i->keyTmp.second);
@@ -231,3 +252,209 @@ void CCoinsViewDBCursor::Next()
         keyTmp.first = entry.key;
     }
 }
+
+CCoinsViewBackgroundFlush::CCoinsViewBackgroundFlush(CCoinsView* view, std::function<void()> write_error_cb)
+    : CCoinsViewBacked(view), m_write_error_cb{std::move(write_error_cb)}
+{
+    m_thread = std::thread([this] {
+        util::ThreadRename("coinsflush");
+        ThreadWrite();
+    });
+}
+
+CCoinsViewBackgroundFlush::~CCoinsViewBackgroundFlush()
+{
+    WITH_LOCK(m_mutex, m_request_stop = true);
+    m_cv.notify_all();
+    m_thread.join();
+}
+
+void CCoinsViewBackgroundFlush::ThreadWrite()
+{
+    WAIT_LOCK(m_mutex, lock);
+    while (true) {
+        m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return (m_generation && !m_write_failed) || m_request_stop; });
+        // A pending generation is written even if a stop was requested.
+        if (!m_generation || m_write_failed) return;
+        Generation& generation{*m_generation};
+        bool success{false};
+        {
+            REVERSE_LOCK(lock, m_mutex);
+            try {
+                // The generation is wiped as a whole once written.
+                CoinsViewCacheCursor cursor{generation.sentinel, generation.coins, /*will_erase=*/true};
+                success = base->BatchWrite(cursor, generation.best_block);
+                if (!success) LogError("Failed to write coins in the background");
+            } catch (const std::exception& e) {
+                LogError("Failed to write coins in the background: %s", e.what());
+            }
+        }
+        if (!success) {
+            // Keep serving the coins that did not make it to disk. The write
+            // is not retried, as the base may hold part of them already.
+            m_write_failed = true;
+            m_cv.notify_all();
+            continue;
+        }
+        auto written{std::move(m_generation)};
+        {
+            REVERSE_LOCK(lock, m_mutex);
+            written.reset();
+        }
+        m_cv.notify_all();
+    }
+}
+
+bool CCoinsViewBackgroundFlush::WaitForFlush() const
+{
+    WAIT_LOCK(m_mutex, lock);
+    m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return !m_generation || m_write_failed; });
+    return !m_write_failed;
+}
+
+void CCoinsViewBackgroundFlush::CheckFlushed() const
+{
+    if (WaitForFlush()) return;
+    if (m_write_error_cb) m_write_error_cb();
+    throw std::runtime_error("Coins failed to be written in the background");
+}
+
+std::optional<Coin> CCoinsViewBackgroundFlush::GetCoin(const COutPoint& outpoint) const
+{
+    {
+        LOCK(m_mutex);
+        if (m_generation) {
+            if (auto it{m_generation->coins.find(outpoint)}; it != m_generation->coins.end()) {
+                if (it->second.coin.IsSpent()) return std::nullopt;
+                return it->second.coin;
+            }
+        }
+    }
+    // Coins not in the generation are not touched by its write.
+    return base->GetCoin(outpoint);
+}
+
+bool CCoinsViewBackgroundFlush::HaveCoin(const COutPoint& outpoint) const
+{
+    {
+        LOCK(m_mutex);
+        if (m_generation) {
+            if (auto it{m_generation->coins.find(outpoint)}; it != m_generation->coins.end()) {
+                return !it->second.coin.IsSpent();
+            }
+        }
+    }
+    return base->HaveCoin(outpoint);
+}
+
+uint256 CCoinsViewBackgroundFlush::GetBestBlock() const
+{
+    {
+        LOCK(m_mutex);
+        if (m_generation) return m_generation->best_block;
+    }
+    return base->GetBestBlock();
+}
+
+std::vector<uint256> CCoinsViewBackgroundFlush::GetHeadBlocks() const
+{
+    CheckFlushed();
+    return base->GetHeadBlocks();
+}
+
+bool CCoinsViewBackgroundFlush::BatchWrite(CoinsViewCacheCursor& cursor, const uint256& hashBlock)
+{
+    // Like a failed synchronous write, this is reported by the caller.
+    if (!WaitForFlush()) return false;
+
+    auto generation{std::make_unique<Generation>()};
+    generation->best_block = hashBlock;
+    for (auto it{cursor.Begin()}; it != cursor.End(); it = cursor.NextAndMaybeErase(*it)) {
+        if (!it->second.IsDirty()) continue;
+        auto gen_it{generation->coins.try_emplace(
+            it->first, cursor.WillErase(*it) ? std::move(it->second.coin) : Coin{it->second.coin}).first};
+        CCoinsCacheEntry::SetDirty(*gen_it, generation->sentinel);
+    }
+
+    WITH_LOCK(m_mutex, m_generation = std::move(generation));
+    m_cv.notify_all();
+    return true;
+}
+
+std::unique_ptr<CCoinsViewCursor> CCoinsViewBackgroundFlush::Cursor() const
+{
+    CheckFlushed();
+    return base->Cursor();
+}
+
+size_t CCoinsViewBackgroundFlush::EstimateSize() const
+{
+    CheckFlushed();
+    return base->EstimateSize();
+}
+
+CCoinsViewCompact::CCoinsViewCompact(CCoinsView* view, size_t max_memory_bytes)
+    : CCoinsViewBacked(view), m_map{std::make_unique<CompactCoinsMap>(max_memory_bytes)}
+{
+}
+
+void CCoinsViewCompact::Insert(const COutPoint& outpoint, const Coin& coin) const
+{
+    if (!m_map->Insert(outpoint, coin)) {
+        m_map->Clear();
+        m_map->Insert(outpoint, coin);
+    }
+}
+
+std::optional<Coin> CCoinsViewCompact::GetCoin(const COutPoint& outpoint) const
+{
+    if (auto coin{WITH_LOCK(m_mutex, return m_map->Get(outpoint))}) return coin;
+    auto coin{base->GetCoin(outpoint)};
+    if (coin) {
+        LOCK(m_mutex);
+        Insert(outpoint, *coin);
+    }
+    return coin;
+}
+
+bool CCoinsViewCompact::HaveCoin(const COutPoint& outpoint) const
+{
+    if (WITH_LOCK(m_mutex, return m_map->Contains(outpoint))) return true;
+    return base->HaveCoin(outpoint);
+}
+
+bool CCoinsViewCompact::BatchWrite(CoinsViewCacheCursor& cursor, const uint256& hashBlock)
+{
+    {
+        LOCK(m_mutex);
+        // The cursor is passed on to the base below, so only look at the
+        // entries here.
+        for (auto it{cursor.Begin()}; it != cursor.End(); it = it->second.Next()) {
+            if (!it->second.IsDirty()) continue;
+            if (it->second.coin.IsSpent()) {
+                m_map->Erase(it->first);
+            } else {
+                Insert(it->first, it->second.coin);
+            }
+        }
+    }
+    if (!base->BatchWrite(cursor, hashBlock)) {
+        // The base is in an undefined state now, so do not serve any coins
+        // that may not be in it.
+        WITH_LOCK(m_mutex, m_map->Clear());
+        return false;
+    }
+    return true;
+}
+
+void CCoinsViewCompact::Resize(size_t max_memory_bytes)
+{
+    LOCK(m_mutex);
+    m_map.reset();
+    m_map = std::make_unique<CompactCoinsMap>(max_memory_bytes);
+}
+
+size_t CCoinsViewCompact::DynamicMemoryUsage() const
+{
+    return WITH_LOCK(m_mutex, return m_map->DynamicMemoryUsage());
+}
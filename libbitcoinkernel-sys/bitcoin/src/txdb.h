@@ -12,10 +12,15 @@
 #include <sync.h>
 #include <util/fs.h>
 
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <optional>
+#include <span>
+#include <thread>
+#include <utility>
 #include <vector>
 
 class COutPoint;
@@ -31,6 +36,12 @@ struct CoinsViewOptions {
     //! If non-zero, randomly exit when the database is flushed with (1/ratio)
     //! probability.
     int simulate_crash_ratio = 0;
+    //! Write the coins cache to the database on a background thread when it
+    //! is flushed, see CCoinsViewBackgroundFlush.
+    bool background_flush = false;
+    //! Keep part of the coins cache memory for coins in compressed form, see
+    //! CCoinsViewCompact.
+    bool compact_cache = false;
 };
 
 /** CCoinsView backed by the coin database (chainstate/) */
@@ -49,11 +60,19 @@ public:
     std::vector<uint256> GetHeadBlocks() const override;
     bool BatchWrite(CoinsViewCacheCursor& cursor, const uint256 &hashBlock) override;
     std::unique_ptr<CCoinsViewCursor> Cursor() const override;
+    //! Get a cursor positioned at the first coin at or after start, in database order.
+    std::unique_ptr<CCoinsViewCursor> Cursor(const COutPoint& start) const;
 
     //! Whether an unsupported database format is used.
     bool NeedsUpgrade();
     size_t EstimateSize() const override;
 
+    //! Write coins straight to the database, bypassing BatchWrite and the
+    //! best block bookkeeping. Only meant for populating a new database, such
+    //! as the one of a snapshot chainstate, and safe to call from several
+    //! threads at once.
+    void WriteCoins(std::span<const std::pair<COutPoint, Coin>> coins);
+
     //! Dynamically alter the underlying leveldb cache size.
     void ResizeCache(size_t new_cache_size) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
@@ -61,4 +80,116 @@ public:
     std::optional<fs::path> StoragePath() { return m_db->StoragePath(); }
 };
 
+/**
+ * CCoinsView that writes the coins passed to BatchWrite to its base on a
+ * background thread, so that flushing the coins cache does not block block
+ * validation until the coins are on disk.
+ *
+ * BatchWrite moves the dirty coins into an immutable generation and returns
+ * once the write of the generation has been handed to the background thread.
+ * Until that write has completed, reads are served from the generation first
+ * and fall through to the base for coins that it does not hold. Only one
+ * generation is written at a time: BatchWrite waits for the previous one.
+ *
+ * If a write fails, the generation is kept and coins keep being read from it,
+ * but it is never written. Every later BatchWrite fails right away, like a
+ * failed synchronous write. Reads that need the coins to be on disk report
+ * the failure through the write error callback and throw.
+ *
+ * The base marks the transition between its best blocks as usual, so a crash
+ * during a background write is recovered from by replaying the blocks, just
+ * like a crash during a synchronous one.
+ */
+class CCoinsViewBackgroundFlush final : public CCoinsViewBacked
+{
+private:
+    //! The dirty coins of a flush and the block they are the state of.
+    struct Generation {
+        CCoinsMapMemoryResource resource{};
+        CoinsCachePair sentinel{};
+        CCoinsMap coins{0, SaltedOutpointHasher{}, CCoinsMap::key_equal{}, &resource};
+        uint256 best_block;
+
+        Generation() { sentinel.second.SelfRef(sentinel); }
+    };
+
+    mutable Mutex m_mutex;
+    //! Signalled when a generation is handed to the writer, when it has been
+    //! written, and on shutdown.
+    mutable std::condition_variable m_cv;
+    //! The generation being written, if any, or the one that failed to be
+    //! written. It is not modified until it has been written, so it may be
+    //! read while the lock is not held.
+    std::unique_ptr<Generation> m_generation GUARDED_BY(m_mutex);
+    //! Whether m_generation failed to be written.
+    bool m_write_failed GUARDED_BY(m_mutex){false};
+    bool m_request_stop GUARDED_BY(m_mutex){false};
+    const std::function<void()> m_write_error_cb;
+    std::thread m_thread;
+
+    void ThreadWrite() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    //! Wait for the pending generation like WaitForFlush, and report a failed
+    //! write and throw if it could not be written.
+    void CheckFlushed() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+public:
+    //! @param[in] write_error_cb Called before a read fails because a
+    //!                           generation could not be written.
+    CCoinsViewBackgroundFlush(CCoinsView* view, std::function<void()> write_error_cb);
+
+    CCoinsViewBackgroundFlush(const CCoinsViewBackgroundFlush&) = delete;
+    CCoinsViewBackgroundFlush& operator=(const CCoinsViewBackgroundFlush&) = delete;
+
+    //! Writes the pending generation, if any, before returning.
+    ~CCoinsViewBackgroundFlush() override;
+
+    std::optional<Coin> GetCoin(const COutPoint& outpoint) const override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    bool HaveCoin(const COutPoint& outpoint) const override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    uint256 GetBestBlock() const override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    std::vector<uint256> GetHeadBlocks() const override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    bool BatchWrite(CoinsViewCacheCursor& cursor, const uint256& hashBlock) override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    std::unique_ptr<CCoinsViewCursor> Cursor() const override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    size_t EstimateSize() const override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    /**
+     * Wait until the pending generation, if any, has been written to the base,
+     * or failed to be.
+     *
+     * @returns false if writing any generation failed.
+     */
+    bool WaitForFlush() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+};
+
+/**
+ * CCoinsView that keeps the coins read from its base, and the coins written
+ * to it, in a CompactCoinsMap. Coins that drop out of the coins cache above
+ * it can then be read again without going to disk, while taking a fraction of
+ * the memory they take in the coins cache.
+ *
+ * It only holds coins as they are in the base, as writes are passed through
+ * right away, so it never has to be flushed. When the map is full, it is
+ * cleared. Reads may happen concurrently, but not concurrently with BatchWrite.
+ */
+class CCoinsViewCompact final : public CCoinsViewBacked
+{
+private:
+    mutable Mutex m_mutex;
+    std::unique_ptr<CompactCoinsMap> m_map GUARDED_BY(m_mutex);
+
+    void Insert(const COutPoint& outpoint, const Coin& coin) const EXCLUSIVE_LOCKS_REQUIRED(m_mutex);
+
+public:
+    CCoinsViewCompact(CCoinsView* view, size_t max_memory_bytes);
+
+    std::optional<Coin> GetCoin(const COutPoint& outpoint) const override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    bool HaveCoin(const COutPoint& outpoint) const override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    bool BatchWrite(CoinsViewCacheCursor& cursor, const uint256& hashBlock) override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    //! Replace the map by an empty one of the given size.
+    void Resize(size_t max_memory_bytes) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    size_t DynamicMemoryUsage() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+};
+
 #endif // BITCOIN_TXDB_H
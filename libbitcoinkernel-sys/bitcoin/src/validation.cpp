@@ -8,6 +8,7 @@
 #include <validation.h>
 
 #include <arith_uint256.h>
+#include <blockfilereader.h>
 #include <chain.h>
 #include <checkqueue.h>
 #include <clientversion.h>
@@ -17,6 +18,7 @@
 #include <consensus/tx_check.h>
 #include <consensus/tx_verify.h>
 #include <consensus/validation.h>
+#include <core_memusage.h>
 #include <cuckoocache.h>
 #include <flatfile.h>
 #include <hash.h>
@@ -44,6 +46,7 @@
 #include <script/script.h>
 #include <script/sigcache.h>
 #include <signet.h>
+#include <snapshotcoinswriter.h>
 #include <tinyformat.h>
 #include <txdb.h>
 #include <txmempool.h>
@@ -112,6 +115,10 @@ const std::vector<std::string> CHECKLEVEL_DOC {
  *  noticeably interfere with the pruning mechanism.
  * */
 static constexpr int PRUNE_LOCK_BUFFER{10};
+/** Maximum memory usage of the deserialized out of order blocks kept while
+ *  importing a block file, as counted by RecursiveDynamicUsage(). Beyond this,
+ *  they are re-read from disk once their parent is found. */
+static constexpr size_t MAX_OUT_OF_ORDER_BLOCKS_USAGE{64 << 20}; // 64 MiB
 
 TRACEPOINT_SEMAPHORE(validation, block_connected);
 TRACEPOINT_SEMAPHORE(utxocache, flush);
@@ -1929,14 +1936,28 @@ CAmount GetBlockSubsidy(int nHeight, const Consensus::Params& consensusParams)
     return nSubsidy;
 }
 
-CoinsViews::CoinsViews(DBParams db_params, CoinsViewOptions options)
-    : m_dbview{std::move(db_params), std::move(options)},
-      m_catcherview(&m_dbview) {}
+CoinsViews::CoinsViews(DBParams db_params, CoinsViewOptions options, std::function<void()> flush_error_cb)
+    : m_dbview{std::move(db_params), options},
+      m_catcherview(&m_dbview)
+{
+    CCoinsView* base{&m_catcherview};
+    if (options.background_flush) {
+        m_flushview = std::make_unique<CCoinsViewBackgroundFlush>(base, std::move(flush_error_cb));
+        base = m_flushview.get();
+    }
+    if (options.compact_cache) {
+        // Sized once the size of the coins cache is known.
+        m_compactview = std::make_unique<CCoinsViewCompact>(base, /*max_memory_bytes=*/0);
+    }
+}
 
 void CoinsViews::InitCache()
 {
     AssertLockHeld(::cs_main);
-    m_cacheview = std::make_unique<CCoinsViewCache>(&m_catcherview);
+    CCoinsView* base{&m_catcherview};
+    if (m_flushview) base = m_flushview.get();
+    if (m_compactview) base = m_compactview.get();
+    m_cacheview = std::make_unique<CCoinsViewCache>(base);
 }
 
 Chainstate::Chainstate(
@@ -1974,7 +1995,10 @@ void Chainstate::InitCoinsDB(
             .wipe_data = should_wipe,
             .obfuscate = true,
             .options = m_chainman.m_options.coins_db},
-        m_chainman.m_options.coins_view);
+        m_chainman.m_options.coins_view,
+        [&notifications = m_chainman.GetNotifications()] {
+            notifications.fatalError(_("Failed to write to coin database."));
+        });
 
     m_coinsdb_cache_size_bytes = cache_size_bytes;
 }
@@ -1985,6 +2009,14 @@ void Chainstate::InitCoinsCache(size_t cache_size_bytes)
     assert(m_coins_views != nullptr);
     m_coinstip_cache_size_bytes = cache_size_bytes;
     m_coins_views->InitCache();
+    if (m_coins_views->m_compactview) m_coins_views->m_compactview->Resize(CompactCoinsCacheSize());
+}
+
+size_t Chainstate::CompactCoinsCacheSize() const
+{
+    AssertLockHeld(::cs_main);
+    if (!m_coins_views || !m_coins_views->m_compactview) return 0;
+    return m_coinstip_cache_size_bytes / 100 * COMPACT_COINS_CACHE_PERCENT;
 }
 
 // Note that though this is marked const, we may end up modifying `m_cached_finished_ibd`, which
@@ -2092,10 +2124,18 @@ void UpdateCoins(const CTransaction& tx, CCoinsViewCache& inputs, CTxUndo &txund
 }
 
 std::optional<std::pair<ScriptError, std::string>> CScriptCheck::operator()() {
+    return Run(nullptr);
+}
+
+std::optional<std::pair<ScriptError, std::string>> CScriptCheck::operator()(SchnorrSignatureBatch& schnorr_batch) {
+    return Run(&schnorr_batch);
+}
+
+std::optional<std::pair<ScriptError, std::string>> CScriptCheck::Run(SchnorrSignatureBatch* schnorr_batch) {
     const CScript &scriptSig = ptxTo->vin[nIn].scriptSig;
     const CScriptWitness *witness = &ptxTo->vin[nIn].scriptWitness;
     ScriptError error{SCRIPT_ERR_UNKNOWN_ERROR};
-    if (VerifyScript(scriptSig, m_tx_out.scriptPubKey, witness, m_flags, CachingTransactionSignatureChecker(ptxTo, nIn, m_tx_out.nValue, cacheStore, *m_signature_cache, *txdata), &error)) {
+    if (VerifyScript(scriptSig, m_tx_out.scriptPubKey, witness, m_flags, CachingTransactionSignatureChecker(ptxTo, nIn, m_tx_out.nValue, cacheStore, *m_signature_cache, *txdata, schnorr_batch), &error)) {
         return std::nullopt;
     } else {
         auto debug_str = strprintf("input %i of %s (wtxid %s), spending %s:%i", nIn, ptxTo->GetHash().ToString(), ptxTo->GetWitnessHash().ToString(), ptxTo->vin[nIn].prevout.hash.ToString(), ptxTo->vin[nIn].prevout.n);
@@ -2383,6 +2423,7 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
 
     const auto time_start{SteadyClock::now()};
     const CChainParams& params{m_chainman.GetParams()};
+    kernel::ValidationStats& stats{m_chainman.m_validation_stats};
 
     // Check it again in case a previous version let a bad block in
     // NOTE: We don't currently (re-)invoke ContextualCheckBlock() or
@@ -2412,7 +2453,7 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
     uint256 hashPrevBlock = pindex->pprev == nullptr ? uint256() : pindex->pprev->GetBlockHash();
     assert(hashPrevBlock == view.GetBestBlock());
 
-    m_chainman.num_blocks_total++;
+    stats.blocks++;
 
     // Special case for the genesis block, skipping connection of its transactions
     // (its coinbase is unspendable)
@@ -2463,11 +2504,11 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
     }
 
     const auto time_1{SteadyClock::now()};
-    m_chainman.time_check += time_1 - time_start;
+    stats.time_check += time_1 - time_start;
     LogDebug(BCLog::BENCH, "    - Sanity checks: %.2fms [%.2fs (%.2fms/blk)]\n",
              Ticks<MillisecondsDouble>(time_1 - time_start),
-             Ticks<SecondsDouble>(m_chainman.time_check),
-             Ticks<MillisecondsDouble>(m_chainman.time_check) / m_chainman.num_blocks_total);
+             Ticks<SecondsDouble>(stats.time_check),
+             Ticks<MillisecondsDouble>(stats.time_check) / stats.blocks);
 
     // Do not allow blocks that contain transactions which 'overwrite' older transactions,
     // unless those are already completely spent.
@@ -2565,11 +2606,11 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
     script_verify_flags flags{GetBlockScriptFlags(*pindex, m_chainman)};
 
     const auto time_2{SteadyClock::now()};
-    m_chainman.time_forks += time_2 - time_1;
+    stats.time_forks += time_2 - time_1;
     LogDebug(BCLog::BENCH, "    - Fork checks: %.2fms [%.2fs (%.2fms/blk)]\n",
              Ticks<MillisecondsDouble>(time_2 - time_1),
-             Ticks<SecondsDouble>(m_chainman.time_forks),
-             Ticks<MillisecondsDouble>(m_chainman.time_forks) / m_chainman.num_blocks_total);
+             Ticks<SecondsDouble>(stats.time_forks),
+             Ticks<MillisecondsDouble>(stats.time_forks) / stats.blocks);
 
     const bool fScriptChecks{!!script_check_reason};
     if (script_check_reason != m_last_script_check_reason_logged && GetRole() == ChainstateRole::NORMAL) {
@@ -2581,6 +2622,7 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
                     pindex->nHeight, block_hash.ToString());
         }
         m_last_script_check_reason_logged = script_check_reason;
+        m_chainman.GetNotifications().scriptChecks(*pindex, fScriptChecks, fScriptChecks ? script_check_reason : "");
     }
 
     CBlockUndo blockundo;
@@ -2595,6 +2637,10 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
 
     std::vector<PrecomputedTransactionData> txsdata(block.vtx.size());
 
+    // Read the coins spent by the block into the coins cache in parallel, so
+    // the loop below does not hit the database one input at a time.
+    m_chainman.GetInputFetcher().FetchInputs(CoinsTip(), CoinsCacheBase(), block);
+
     std::vector<int> prevheights;
     CAmount nFees = 0;
     int nInputs = 0;
@@ -2679,12 +2725,15 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
         UpdateCoins(tx, view, i == 0 ? undoDummy : blockundo.vtxundo.back(), pindex->nHeight);
     }
     const auto time_3{SteadyClock::now()};
-    m_chainman.time_connect += time_3 - time_2;
+    stats.time_connect += time_3 - time_2;
+    stats.transactions += block.vtx.size();
+    stats.inputs += nInputs;
+    stats.sigops_cost += nSigOpsCost;
     LogDebug(BCLog::BENCH, "      - Connect %u transactions: %.2fms (%.3fms/tx, %.3fms/txin) [%.2fs (%.2fms/blk)]\n", (unsigned)block.vtx.size(),
              Ticks<MillisecondsDouble>(time_3 - time_2), Ticks<MillisecondsDouble>(time_3 - time_2) / block.vtx.size(),
              nInputs <= 1 ? 0 : Ticks<MillisecondsDouble>(time_3 - time_2) / (nInputs - 1),
-             Ticks<SecondsDouble>(m_chainman.time_connect),
-             Ticks<MillisecondsDouble>(m_chainman.time_connect) / m_chainman.num_blocks_total);
+             Ticks<SecondsDouble>(stats.time_connect),
+             Ticks<MillisecondsDouble>(stats.time_connect) / stats.blocks);
 
     CAmount blockReward = nFees + GetBlockSubsidy(pindex->nHeight, params.GetConsensus());
     if (block.vtx[0]->GetValueOut() > blockReward && state.IsValid()) {
@@ -2702,12 +2751,12 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
         return false;
     }
     const auto time_4{SteadyClock::now()};
-    m_chainman.time_verify += time_4 - time_2;
+    stats.time_verify += time_4 - time_2;
     LogDebug(BCLog::BENCH, "    - Verify %u txins: %.2fms (%.3fms/txin) [%.2fs (%.2fms/blk)]\n", nInputs - 1,
              Ticks<MillisecondsDouble>(time_4 - time_2),
              nInputs <= 1 ? 0 : Ticks<MillisecondsDouble>(time_4 - time_2) / (nInputs - 1),
-             Ticks<SecondsDouble>(m_chainman.time_verify),
-             Ticks<MillisecondsDouble>(m_chainman.time_verify) / m_chainman.num_blocks_total);
+             Ticks<SecondsDouble>(stats.time_verify),
+             Ticks<MillisecondsDouble>(stats.time_verify) / stats.blocks);
 
     if (fJustCheck) {
         return true;
@@ -2718,11 +2767,11 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
     }
 
     const auto time_5{SteadyClock::now()};
-    m_chainman.time_undo += time_5 - time_4;
+    stats.time_undo += time_5 - time_4;
     LogDebug(BCLog::BENCH, "    - Write undo data: %.2fms [%.2fs (%.2fms/blk)]\n",
              Ticks<MillisecondsDouble>(time_5 - time_4),
-             Ticks<SecondsDouble>(m_chainman.time_undo),
-             Ticks<MillisecondsDouble>(m_chainman.time_undo) / m_chainman.num_blocks_total);
+             Ticks<SecondsDouble>(stats.time_undo),
+             Ticks<MillisecondsDouble>(stats.time_undo) / stats.blocks);
 
     if (!pindex->IsValid(BLOCK_VALID_SCRIPTS)) {
         pindex->RaiseValidity(BLOCK_VALID_SCRIPTS);
@@ -2733,11 +2782,11 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
     view.SetBestBlock(pindex->GetBlockHash());
 
     const auto time_6{SteadyClock::now()};
-    m_chainman.time_index += time_6 - time_5;
+    stats.time_index += time_6 - time_5;
     LogDebug(BCLog::BENCH, "    - Index writing: %.2fms [%.2fs (%.2fms/blk)]\n",
              Ticks<MillisecondsDouble>(time_6 - time_5),
-             Ticks<SecondsDouble>(m_chainman.time_index),
-             Ticks<MillisecondsDouble>(m_chainman.time_index) / m_chainman.num_blocks_total);
+             Ticks<SecondsDouble>(stats.time_index),
+             Ticks<MillisecondsDouble>(stats.time_index) / stats.blocks);
 
     TRACEPOINT(validation, block_connected,
         block_hash.data(),
@@ -2755,7 +2804,7 @@ CoinsCacheSizeState Chainstate::GetCoinsCacheSizeState()
 {
     AssertLockHeld(::cs_main);
     return this->GetCoinsCacheSizeState(
-        m_coinstip_cache_size_bytes,
+        m_coinstip_cache_size_bytes - CompactCoinsCacheSize(),
         m_mempool ? m_mempool->m_opts.max_size_bytes : 0);
 }
 
@@ -2879,6 +2928,12 @@ bool Chainstate::FlushStateToDisk(
             if (fFlushForPrune) {
                 LOG_TIME_MILLIS_WITH_CATEGORY("unlink pruned files", BCLog::BENCH);
 
+                // Blocks may be needed to replay the coins that are being
+                // written in the background after a crash.
+                if (!WaitForCoinsFlush()) {
+                    return FatalError(m_chainman.GetNotifications(), state, _("Failed to write to coin database."));
+                }
+
                 m_blockman.UnlinkPrunedFiles(setFilesToPrune);
             }
 
@@ -2900,6 +2955,11 @@ bool Chainstate::FlushStateToDisk(
                 if (empty_cache ? !CoinsTip().Flush() : !CoinsTip().Sync()) {
                     return FatalError(m_chainman.GetNotifications(), state, _("Failed to write to coin database."));
                 }
+                // Only let the coins be written in the background if the
+                // caller does not rely on them being on disk.
+                if ((mode == FlushStateMode::ALWAYS || fFlushForPrune) && !WaitForCoinsFlush()) {
+                    return FatalError(m_chainman.GetNotifications(), state, _("Failed to write to coin database."));
+                }
                 full_flush_completed = true;
                 TRACEPOINT(utxocache, flush,
                     int64_t{Ticks<std::chrono::microseconds>(NodeClock::now() - nNow)},
@@ -2925,6 +2985,13 @@ bool Chainstate::FlushStateToDisk(
     return true;
 }
 
+bool Chainstate::WaitForCoinsFlush()
+{
+    AssertLockHeld(::cs_main);
+    Assert(m_coins_views);
+    return !m_coins_views->m_flushview || m_coins_views->m_flushview->WaitForFlush();
+}
+
 void Chainstate::ForceFlushStateToDisk()
 {
     BlockValidationState state;
@@ -3134,6 +3201,8 @@ bool Chainstate::ConnectTip(
     if (m_mempool) AssertLockHeld(m_mempool->cs);
 
     assert(pindexNew->pprev == m_chain.Tip());
+    kernel::ValidationStats& stats{m_chainman.m_validation_stats};
+    const kernel::ValidationStats stats_before{stats};
     // Read block from disk.
     const auto time_1{SteadyClock::now()};
     if (!block_to_connect) {
@@ -3149,7 +3218,8 @@ bool Chainstate::ConnectTip(
     const auto time_2{SteadyClock::now()};
     SteadyClock::time_point time_3;
     // When adding aggregate statistics in the future, keep in mind that
-    // num_blocks_total may be zero until the ConnectBlock() call below.
+    // stats.blocks may be zero until the ConnectBlock() call below.
+    stats.time_load += time_2 - time_1;
     LogDebug(BCLog::BENCH, "  - Load block from disk: %.2fms\n",
              Ticks<MillisecondsDouble>(time_2 - time_1));
     {
@@ -3165,31 +3235,31 @@ bool Chainstate::ConnectTip(
             return false;
         }
         time_3 = SteadyClock::now();
-        m_chainman.time_connect_total += time_3 - time_2;
-        assert(m_chainman.num_blocks_total > 0);
+        stats.time_connect_total += time_3 - time_2;
+        assert(stats.blocks > 0);
         LogDebug(BCLog::BENCH, "  - Connect total: %.2fms [%.2fs (%.2fms/blk)]\n",
                  Ticks<MillisecondsDouble>(time_3 - time_2),
-                 Ticks<SecondsDouble>(m_chainman.time_connect_total),
-                 Ticks<MillisecondsDouble>(m_chainman.time_connect_total) / m_chainman.num_blocks_total);
+                 Ticks<SecondsDouble>(stats.time_connect_total),
+                 Ticks<MillisecondsDouble>(stats.time_connect_total) / stats.blocks);
         bool flushed = view.Flush();
         assert(flushed);
     }
     const auto time_4{SteadyClock::now()};
-    m_chainman.time_flush += time_4 - time_3;
+    stats.time_flush += time_4 - time_3;
     LogDebug(BCLog::BENCH, "  - Flush: %.2fms [%.2fs (%.2fms/blk)]\n",
              Ticks<MillisecondsDouble>(time_4 - time_3),
-             Ticks<SecondsDouble>(m_chainman.time_flush),
-             Ticks<MillisecondsDouble>(m_chainman.time_flush) / m_chainman.num_blocks_total);
+             Ticks<SecondsDouble>(stats.time_flush),
+             Ticks<MillisecondsDouble>(stats.time_flush) / stats.blocks);
     // Write the chain state to disk, if necessary.
     if (!FlushStateToDisk(state, FlushStateMode::IF_NEEDED)) {
         return false;
     }
     const auto time_5{SteadyClock::now()};
-    m_chainman.time_chainstate += time_5 - time_4;
+    stats.time_chainstate += time_5 - time_4;
     LogDebug(BCLog::BENCH, "  - Writing chainstate: %.2fms [%.2fs (%.2fms/blk)]\n",
              Ticks<MillisecondsDouble>(time_5 - time_4),
-             Ticks<SecondsDouble>(m_chainman.time_chainstate),
-             Ticks<MillisecondsDouble>(m_chainman.time_chainstate) / m_chainman.num_blocks_total);
+             Ticks<SecondsDouble>(stats.time_chainstate),
+             Ticks<MillisecondsDouble>(stats.time_chainstate) / stats.blocks);
     // Remove conflicting transactions from the mempool.;
     if (m_mempool) {
         m_mempool->removeForBlock(block_to_connect->vtx, pindexNew->nHeight);
@@ -3200,16 +3270,17 @@ bool Chainstate::ConnectTip(
     UpdateTip(pindexNew);
 
     const auto time_6{SteadyClock::now()};
-    m_chainman.time_post_connect += time_6 - time_5;
-    m_chainman.time_total += time_6 - time_1;
+    stats.time_post_connect += time_6 - time_5;
+    stats.time_total += time_6 - time_1;
     LogDebug(BCLog::BENCH, "  - Connect postprocess: %.2fms [%.2fs (%.2fms/blk)]\n",
              Ticks<MillisecondsDouble>(time_6 - time_5),
-             Ticks<SecondsDouble>(m_chainman.time_post_connect),
-             Ticks<MillisecondsDouble>(m_chainman.time_post_connect) / m_chainman.num_blocks_total);
+             Ticks<SecondsDouble>(stats.time_post_connect),
+             Ticks<MillisecondsDouble>(stats.time_post_connect) / stats.blocks);
     LogDebug(BCLog::BENCH, "- Connect block: %.2fms [%.2fs (%.2fms/blk)]\n",
              Ticks<MillisecondsDouble>(time_6 - time_1),
-             Ticks<SecondsDouble>(m_chainman.time_total),
-             Ticks<MillisecondsDouble>(m_chainman.time_total) / m_chainman.num_blocks_total);
+             Ticks<SecondsDouble>(stats.time_total),
+             Ticks<MillisecondsDouble>(stats.time_total) / stats.blocks);
+    m_chainman.GetNotifications().blockConnectedStats(*pindexNew, stats - stats_before);
 
     // If we are the background validation chainstate, check to see if we are done
     // validating the snapshot (i.e. our tip has reached the snapshot's base block).
@@ -3418,10 +3489,10 @@ bool ChainstateManager::NotifyHeaderTip()
     return fNotify;
 }
 
-static void LimitValidationInterfaceQueue(ValidationSignals& signals) LOCKS_EXCLUDED(cs_main) {
+static void LimitValidationInterfaceQueue(ValidationSignals& signals, size_t max_pending) LOCKS_EXCLUDED(cs_main) {
     AssertLockNotHeld(cs_main);
 
-    if (signals.CallbacksPending() > 10) {
+    if (signals.CallbacksPending() > max_pending) {
         signals.SyncWithValidationInterfaceQueue();
     }
 }
@@ -3460,7 +3531,7 @@ bool Chainstate::ActivateBestChain(BlockValidationState& state, std::shared_ptr<
         // Note that if a validationinterface callback ends up calling
         // ActivateBestChain this may lead to a deadlock! We should
         // probably have a DEBUG_LOCKORDER test for this in the future.
-        if (m_chainman.m_options.signals) LimitValidationInterfaceQueue(*m_chainman.m_options.signals);
+        if (m_chainman.m_options.signals) LimitValidationInterfaceQueue(*m_chainman.m_options.signals, m_chainman.m_options.max_pending_validation_callbacks);
 
         {
             LOCK(cs_main);
@@ -3547,6 +3618,12 @@ bool Chainstate::ActivateBestChain(BlockValidationState& state, std::shared_ptr<
                     // completed and interrupted operations.
                     break;
                 }
+            } else if (pindexFork != pindexNewTip) {
+                const CBlockIndex* snapshot_base{m_chainman.GetSnapshotBaseBlock()};
+                const double progress{snapshot_base && snapshot_base->m_chain_tx_count > 0 ?
+                                          std::min(1.0, double(pindexNewTip->m_chain_tx_count) / snapshot_base->m_chain_tx_count) :
+                                          1.0};
+                m_chainman.GetNotifications().backgroundBlockTip(*pindexNewTip, progress);
             }
             } // release MempoolMutex
             // Notify external listeners about the new tip, even if pindexFork == pindexNewTip.
@@ -3675,7 +3752,7 @@ bool Chainstate::InvalidateBlock(BlockValidationState& state, CBlockIndex* pinde
         if (m_chainman.m_interrupt) break;
 
         // Make sure the queue of validation callbacks doesn't grow unboundedly.
-        if (m_chainman.m_options.signals) LimitValidationInterfaceQueue(*m_chainman.m_options.signals);
+        if (m_chainman.m_options.signals) LimitValidationInterfaceQueue(*m_chainman.m_options.signals, m_chainman.m_options.max_pending_validation_callbacks);
 
         LOCK(cs_main);
         // Lock for as long as disconnectpool is in scope to make sure MaybeUpdateMempoolForReorg is
@@ -5059,61 +5136,56 @@ void ChainstateManager::LoadExternalBlockFile(
     const auto start{SteadyClock::now()};
     const CChainParams& params{GetParams()};
 
+    //! A deserialized block whose parent is not known yet.
+    struct OutOfOrderBlock {
+        FlatFilePos pos;
+        std::shared_ptr<const CBlock> block;
+        size_t usage;
+    };
+    // Out of order blocks of this file, keyed by parent hash, so that they can
+    // be processed without reading them again once their parent is found.
+    std::multimap<uint256, OutOfOrderBlock> out_of_order;
+    size_t out_of_order_usage{0};
+
     int nLoaded = 0;
     try {
-        BufferedFile blkdat{file_in, 2 * MAX_BLOCK_SERIALIZED_SIZE, MAX_BLOCK_SERIALIZED_SIZE + 8};
-        // nRewind indicates where to resume scanning in case something goes wrong,
-        // such as a block fails to deserialize.
-        uint64_t nRewind = blkdat.GetPos();
-        while (!blkdat.eof()) {
+        // Blocks that are already stored are not deserialized. The check is
+        // repeated below, as the block may be stored in the meantime.
+        auto have_block{[&](const uint256& hash) {
+            LOCK(cs_main);
+            const CBlockIndex* pindex{m_blockman.LookupBlockIndex(hash)};
+            return pindex && (pindex->nStatus & BLOCK_HAVE_DATA);
+        }};
+        // Run the context-free checks ahead of AcceptBlock, which then skips
+        // them for blocks that passed.
+        auto check_block{[&](const CBlock& block) {
+            BlockValidationState state;
+            CheckBlock(block, state, params.GetConsensus());
+        }};
+        const int threads{std::clamp(m_options.worker_threads_num, 0, MAX_SCRIPTCHECK_THREADS)};
+        BlockFileReader reader{file_in, params.MessageStart(), have_block, check_block, threads, /*max_in_flight=*/2 * size_t(threads) + 4};
+        while (auto item{reader.Next()}) {
             if (m_interrupt) return;
 
-            blkdat.SetPos(nRewind);
-            nRewind++; // start one byte further next time, in case of failure
-            blkdat.SetLimit(); // remove former limit
-            unsigned int nSize = 0;
-            try {
-                // locate a header
-                MessageStartChars buf;
-                blkdat.FindByte(std::byte(params.MessageStart()[0]));
-                nRewind = blkdat.GetPos() + 1;
-                blkdat >> buf;
-                if (buf != params.MessageStart()) {
-                    continue;
-                }
-                // read size
-                blkdat >> nSize;
-                if (nSize < 80 || nSize > MAX_BLOCK_SERIALIZED_SIZE)
-                    continue;
-            } catch (const std::exception&) {
-                // no valid block header found; don't complain
-                // (this happens at the end of every blk.dat file)
-                break;
-            }
+            const FlatFilePos pos{dbp ? dbp->nFile : 0, static_cast<unsigned int>(item->pos)};
+            if (dbp) dbp->nPos = pos.nPos;
             try {
-                // read block header
-                const uint64_t nBlockPos{blkdat.GetPos()};
-                if (dbp)
-                    dbp->nPos = nBlockPos;
-                blkdat.SetLimit(nBlockPos + nSize);
-                CBlockHeader header;
-                blkdat >> header;
-                const uint256 hash{header.GetHash()};
-                // Skip the rest of this block (this may read from disk into memory); position to the marker before the
-                // next block, but it's still possible to rewind to the start of the current block (without a disk read).
-                nRewind = nBlockPos + nSize;
-                blkdat.SkipTo(nRewind);
-
-                std::shared_ptr<CBlock> pblock{}; // needs to remain available after the cs_main lock is released to avoid duplicate reads from disk
+                if (!item->error.empty()) throw std::ios_base::failure{item->error};
+                const uint256& hash{item->hash};
+                std::shared_ptr<const CBlock> pblock{};
 
                 {
                     LOCK(cs_main);
                     // detect out of order blocks, and store them for later
-                    if (hash != params.GetConsensus().hashGenesisBlock && !m_blockman.LookupBlockIndex(header.hashPrevBlock)) {
+                    if (hash != params.GetConsensus().hashGenesisBlock && !m_blockman.LookupBlockIndex(item->prev_hash)) {
                         LogDebug(BCLog::REINDEX, "%s: Out of order block %s, parent %s not known\n", __func__, hash.ToString(),
-                                 header.hashPrevBlock.ToString());
-                        if (dbp && blocks_with_unknown_parent) {
-                            blocks_with_unknown_parent->emplace(header.hashPrevBlock, *dbp);
+                                 item->prev_hash.ToString());
+                        const size_t usage{item->block ? RecursiveDynamicUsage(item->block) : 0};
+                        if (item->block && out_of_order_usage + usage <= MAX_OUT_OF_ORDER_BLOCKS_USAGE) {
+                            out_of_order_usage += usage;
+                            out_of_order.emplace(item->prev_hash, OutOfOrderBlock{pos, std::move(item->block), usage});
+                        } else if (blocks_with_unknown_parent) {
+                            blocks_with_unknown_parent->emplace(item->prev_hash, pos);
                         }
                         continue;
                     }
@@ -5121,14 +5193,15 @@ void ChainstateManager::LoadExternalBlockFile(
                     // process in case the block isn't known yet
                     const CBlockIndex* pindex = m_blockman.LookupBlockIndex(hash);
                     if (!pindex || (pindex->nStatus & BLOCK_HAVE_DATA) == 0) {
-                        // This block can be processed immediately; rewind to its start, read and deserialize it.
-                        blkdat.SetPos(nBlockPos);
-                        pblock = std::make_shared<CBlock>();
-                        blkdat >> TX_WITH_WITNESS(*pblock);
-                        nRewind = blkdat.GetPos();
+                        if (!item->block) {
+                            // The block was skipped by the reader, but is needed after all.
+                            item->block = std::make_shared<CBlock>();
+                            SpanReader{item->data} >> TX_WITH_WITNESS(*item->block);
+                        }
+                        pblock = item->block;
 
                         BlockValidationState state;
-                        if (AcceptBlock(pblock, state, nullptr, true, dbp, nullptr, true)) {
+                        if (AcceptBlock(pblock, state, nullptr, true, dbp ? &pos : nullptr, nullptr, true)) {
                             nLoaded++;
                         }
                         if (state.IsError()) {
@@ -5177,17 +5250,33 @@ void ChainstateManager::LoadExternalBlockFile(
 
                 NotifyHeaderTip();
 
-                if (!blocks_with_unknown_parent) continue;
-
                 // Recursively process earlier encountered successors of this block
                 std::deque<uint256> queue;
                 queue.push_back(hash);
                 while (!queue.empty()) {
                     uint256 head = queue.front();
                     queue.pop_front();
-                    auto range = blocks_with_unknown_parent->equal_range(head);
+                    auto range = out_of_order.equal_range(head);
                     while (range.first != range.second) {
-                        std::multimap<uint256, FlatFilePos>::iterator it = range.first;
+                        auto child{out_of_order.extract(range.first++).mapped()};
+                        out_of_order_usage -= child.usage;
+                        const auto& block_hash{child.block->GetHash()};
+                        LogDebug(BCLog::REINDEX, "%s: Processing out of order child %s of %s", __func__, block_hash.ToString(), head.ToString());
+                        {
+                            LOCK(cs_main);
+                            BlockValidationState dummy;
+                            if (AcceptBlock(child.block, dummy, nullptr, true, dbp ? &child.pos : nullptr, nullptr, true)) {
+                                nLoaded++;
+                                queue.push_back(block_hash);
+                            }
+                        }
+                        NotifyHeaderTip();
+                    }
+
+                    if (!blocks_with_unknown_parent) continue;
+                    auto disk_range = blocks_with_unknown_parent->equal_range(head);
+                    while (disk_range.first != disk_range.second) {
+                        std::multimap<uint256, FlatFilePos>::iterator it = disk_range.first;
                         std::shared_ptr<CBlock> pblockrecursive = std::make_shared<CBlock>();
                         if (m_blockman.ReadBlock(*pblockrecursive, it->second, {})) {
                             const auto& block_hash{pblockrecursive->GetHash()};
@@ -5199,7 +5288,7 @@ void ChainstateManager::LoadExternalBlockFile(
                                 queue.push_back(block_hash);
                             }
                         }
-                        range.first++;
+                        disk_range.first++;
                         blocks_with_unknown_parent->erase(it);
                         NotifyHeaderTip();
                     }
@@ -5216,12 +5305,19 @@ void ChainstateManager::LoadExternalBlockFile(
                 // the reindex process is not the place to attempt to clean and/or compact the block files. if so desired, a studious node operator
                 // may use knowledge of the fact that the block files are not entirely pristine in order to prepare a set of pristine, and
                 // perhaps ordered, block files for later reindexing.
-                LogDebug(BCLog::REINDEX, "%s: unexpected data at file offset 0x%x - %s. continuing\n", __func__, (nRewind - 1), e.what());
+                LogDebug(BCLog::REINDEX, "%s: unexpected data at file offset 0x%x - %s. continuing\n", __func__, item->pos, e.what());
             }
         }
     } catch (const std::runtime_error& e) {
         GetNotifications().fatalError(strprintf(_("System error while loading external block file: %s"), e.what()));
     }
+    // Out of order blocks whose parent is in a later file are re-read from
+    // disk once it is found.
+    if (blocks_with_unknown_parent) {
+        for (const auto& [prev_hash, child] : out_of_order) {
+            blocks_with_unknown_parent->emplace(prev_hash, child.pos);
+        }
+    }
     LogInfo("Loaded %i blocks from external file in %dms", nLoaded, Ticks<std::chrono::milliseconds>(SteadyClock::now() - start));
 }
 
@@ -5564,15 +5660,27 @@ std::string Chainstate::ToString()
 bool Chainstate::ResizeCoinsCaches(size_t coinstip_size, size_t coinsdb_size)
 {
     AssertLockHeld(::cs_main);
+    if (m_coins_db_cursors > 0 && coinsdb_size != m_coinsdb_cache_size_bytes) {
+        // Reopening the database would invalidate the cursors, so its cache
+        // keeps its size until a later resize.
+        LogDebug(BCLog::COINDB, "[%s] not resizing coinsdb cache while cursors are open", this->ToString());
+        coinsdb_size = m_coinsdb_cache_size_bytes;
+    }
     if (coinstip_size == m_coinstip_cache_size_bytes &&
             coinsdb_size == m_coinsdb_cache_size_bytes) {
         // Cache sizes are unchanged, no need to continue.
         return true;
     }
     size_t old_coinstip_size = m_coinstip_cache_size_bytes;
+    const bool resize_db{coinsdb_size != m_coinsdb_cache_size_bytes};
     m_coinstip_cache_size_bytes = coinstip_size;
     m_coinsdb_cache_size_bytes = coinsdb_size;
-    CoinsDB().ResizeCache(coinsdb_size);
+    if (resize_db) {
+        // The database is reopened, so it must not be written to meanwhile.
+        WaitForCoinsFlush();
+        CoinsDB().ResizeCache(coinsdb_size);
+    }
+    if (m_coins_views->m_compactview) m_coins_views->m_compactview->Resize(CompactCoinsCacheSize());
 
     LogInfo("[%s] resized coinsdb cache to %.1f MiB",
         this->ToString(), coinsdb_size * (1.0 / 1024 / 1024));
@@ -5837,9 +5945,9 @@ util::Result<CBlockIndex*> ChainstateManager::ActivateSnapshot(
     const bool chaintip_loaded = m_snapshot_chainstate->LoadChainTip();
     assert(chaintip_loaded);
 
-    // Transfer possession of the mempool to the snapshot chainstate.
+    // Transfer possession of the mempool, if any, to the snapshot chainstate.
     // Mempool is empty at this point because we're still in IBD.
-    Assert(m_active_chainstate->m_mempool->size() == 0);
+    Assert(!m_active_chainstate->m_mempool || m_active_chainstate->m_mempool->size() == 0);
     Assert(!m_snapshot_chainstate->m_mempool);
     m_snapshot_chainstate->m_mempool = m_active_chainstate->m_mempool;
     m_active_chainstate->m_mempool = nullptr;
@@ -5854,17 +5962,20 @@ util::Result<CBlockIndex*> ChainstateManager::ActivateSnapshot(
     return snapshot_start_block;
 }
 
-static void FlushSnapshotToDisk(CCoinsViewCache& coins_cache, bool snapshot_loaded)
+static void FlushSnapshotToDisk(CCoinsViewCache& coins_cache)
 {
     LOG_TIME_MILLIS_WITH_CATEGORY_MSG_ONCE(
-        strprintf("%s (%.2f MB)",
-                  snapshot_loaded ? "saving snapshot chainstate" : "flushing coins cache",
+        strprintf("saving snapshot chainstate (%.2f MB)",
                   coins_cache.DynamicMemoryUsage() / (1000 * 1000)),
         BCLog::LogFlags::ALL);
 
     coins_cache.Flush();
 }
 
+//! Number of coins of a UTXO snapshot that are written to the database and
+//! hashed as one unit of work when loading the snapshot.
+static constexpr size_t SNAPSHOT_LOAD_BATCH_COINS{10'000};
+
 struct StopHashingException : public std::exception
 {
     const char* what() const noexcept override
@@ -5918,6 +6029,21 @@ util::Result<void> ChainstateManager::PopulateAndValidateSnapshot(
     const uint64_t coins_count = metadata.m_coins_count;
     uint64_t coins_left = metadata.m_coins_count;
 
+    // As above, okay to immediately release cs_main here since no other context knows
+    // about the snapshot_chainstate.
+    CCoinsViewDB* snapshot_coinsdb = WITH_LOCK(::cs_main, return &snapshot_chainstate.CoinsDB());
+
+    // The coins are written straight to the coins database of the snapshot
+    // chainstate on the worker threads, bypassing its coins cache. Snapshots
+    // written by dumptxoutset list the coins in the order the serialized hash
+    // commits to them, so the hash is computed while loading. Otherwise it is
+    // computed from the database afterwards.
+    const int threads{std::clamp(m_options.worker_threads_num, 0, MAX_SCRIPTCHECK_THREADS)};
+    SnapshotCoinsWriter writer{*snapshot_coinsdb, threads, /*max_in_flight=*/2 * size_t(threads) + 4};
+    SnapshotCoinsWriter::Coins batch;
+    bool in_hash_order{true};
+    std::optional<Txid> last_txid;
+
     LogInfo("[snapshot] loading %d coins from snapshot %s", coins_left, base_blockhash.ToString());
     int64_t coins_processed{0};
 
@@ -5931,6 +6057,9 @@ util::Result<void> ChainstateManager::PopulateAndValidateSnapshot(
             if (coins_per_txid > coins_left) {
                 return util::Error{Untranslated("Mismatch in coins count in snapshot metadata and actual snapshot data")};
             }
+            if (last_txid && !(*last_txid < txid)) in_hash_order = false;
+            last_txid = txid;
+            const size_t txid_start{batch.size()};
 
             for (size_t i = 0; i < coins_per_txid; i++) {
                 COutPoint outpoint;
@@ -5948,46 +6077,48 @@ util::Result<void> ChainstateManager::PopulateAndValidateSnapshot(
                     return util::Error{Untranslated(strprintf("Bad snapshot data after deserializing %d coins - bad tx out value",
                               coins_count - coins_left))};
                 }
-                coins_cache.EmplaceCoinInternalDANGER(std::move(outpoint), std::move(coin));
+                batch.emplace_back(std::move(outpoint), std::move(coin));
 
                 --coins_left;
                 ++coins_processed;
 
                 if (coins_processed % 1000000 == 0) {
-                    LogInfo("[snapshot] %d coins loaded (%.2f%%, %.2f MB)",
+                    LogInfo("[snapshot] %d coins loaded (%.2f%%)",
                         coins_processed,
-                        static_cast<float>(coins_processed) * 100 / static_cast<float>(coins_count),
-                        coins_cache.DynamicMemoryUsage() / (1000 * 1000));
+                        static_cast<float>(coins_processed) * 100 / static_cast<float>(coins_count));
                 }
 
-                // Batch write and flush (if we need to) every so often.
-                //
-                // If our average Coin size is roughly 41 bytes, checking every 120,000 coins
-                // means <5MB of memory imprecision.
-                if (coins_processed % 120000 == 0) {
-                    if (m_interrupt) {
-                        return util::Error{Untranslated("Aborting after an interrupt was requested")};
-                    }
-
-                    const auto snapshot_cache_state = WITH_LOCK(::cs_main,
-                        return snapshot_chainstate.GetCoinsCacheSizeState());
-
-                    if (snapshot_cache_state >= CoinsCacheSizeState::CRITICAL) {
-                        // This is a hack - we don't know what the actual best block is, but that
-                        // doesn't matter for the purposes of flushing the cache here. We'll set this
-                        // to its correct value (`base_blockhash`) below after the coins are loaded.
-                        coins_cache.SetBestBlock(GetRandHash());
-
-                        // No need to acquire cs_main since this chainstate isn't being used yet.
-                        FlushSnapshotToDisk(coins_cache, /*snapshot_loaded=*/false);
-                    }
+                if (coins_processed % 120000 == 0 && m_interrupt) {
+                    return util::Error{Untranslated("Aborting after an interrupt was requested")};
                 }
             }
+
+            // The serialized hash commits to the coins of a transaction
+            // ordered by output index, which the database order of the
+            // outputs may differ from.
+            const auto txid_coins{std::ranges::subrange(batch.begin() + txid_start, batch.end())};
+            std::ranges::sort(txid_coins, {}, [](const auto& entry) { return entry.first.n; });
+            if (std::ranges::adjacent_find(txid_coins, {}, [](const auto& entry) { return entry.first.n; }) != txid_coins.end()) {
+                in_hash_order = false;
+            }
+            if (batch.size() >= SNAPSHOT_LOAD_BATCH_COINS) {
+                writer.Add(std::exchange(batch, {}));
+            }
         } catch (const std::ios_base::failure&) {
             return util::Error{Untranslated(strprintf("Bad snapshot format or truncated snapshot after deserializing %d coins",
                       coins_processed))};
+        } catch (const std::exception& e) {
+            // The writer joined its worker threads before rethrowing their error.
+            return util::Error{Untranslated(strprintf("Failed to write snapshot coins: %s", e.what()))};
         }
     }
+    uint256 loaded_hash;
+    try {
+        if (!batch.empty()) writer.Add(std::move(batch));
+        loaded_hash = writer.Finish();
+    } catch (const std::exception& e) {
+        return util::Error{Untranslated(strprintf("Failed to write snapshot coins: %s", e.what()))};
+    }
 
     // Important that we set this. This and the coins_cache accesses above are
     // sort of a layer violation, but either we reach into the innards of
@@ -6009,36 +6140,39 @@ util::Result<void> ChainstateManager::PopulateAndValidateSnapshot(
             coins_count))};
     }
 
-    LogInfo("[snapshot] loaded %d (%.2f MB) coins from snapshot %s",
+    LogInfo("[snapshot] loaded %d coins from snapshot %s",
         coins_count,
-        coins_cache.DynamicMemoryUsage() / (1000 * 1000),
         base_blockhash.ToString());
 
     // No need to acquire cs_main since this chainstate isn't being used yet.
-    FlushSnapshotToDisk(coins_cache, /*snapshot_loaded=*/true);
+    // This only writes the best block, the coins are already in the database.
+    FlushSnapshotToDisk(coins_cache);
+    if (!WITH_LOCK(::cs_main, return snapshot_chainstate.WaitForCoinsFlush())) {
+        return util::Error{Untranslated("Failed to write the snapshot chainstate")};
+    }
 
     assert(coins_cache.GetBestBlock() == base_blockhash);
 
-    // As above, okay to immediately release cs_main here since no other context knows
-    // about the snapshot_chainstate.
-    CCoinsViewDB* snapshot_coinsdb = WITH_LOCK(::cs_main, return &snapshot_chainstate.CoinsDB());
-
-    std::optional<CCoinsStats> maybe_stats;
-
-    try {
-        maybe_stats = ComputeUTXOStats(
-            CoinStatsHashType::HASH_SERIALIZED, snapshot_coinsdb, m_blockman, [&interrupt = m_interrupt] { SnapshotUTXOHashBreakpoint(interrupt); });
-    } catch (StopHashingException const&) {
-        return util::Error{Untranslated("Aborting after an interrupt was requested")};
-    }
-    if (!maybe_stats.has_value()) {
-        return util::Error{Untranslated("Failed to generate coins stats")};
+    uint256 hash_serialized{loaded_hash};
+    if (!in_hash_order) {
+        LogInfo("[snapshot] coins are not in hash order, hashing the coins database");
+        std::optional<CCoinsStats> maybe_stats;
+        try {
+            maybe_stats = ComputeUTXOStats(
+                CoinStatsHashType::HASH_SERIALIZED, snapshot_coinsdb, m_blockman, [&interrupt = m_interrupt] { SnapshotUTXOHashBreakpoint(interrupt); });
+        } catch (StopHashingException const&) {
+            return util::Error{Untranslated("Aborting after an interrupt was requested")};
+        }
+        if (!maybe_stats.has_value()) {
+            return util::Error{Untranslated("Failed to generate coins stats")};
+        }
+        hash_serialized = maybe_stats->hashSerialized;
     }
 
     // Assert that the deserialized chainstate contents match the expected assumeutxo value.
-    if (AssumeutxoHash{maybe_stats->hashSerialized} != au_data.hash_serialized) {
+    if (AssumeutxoHash{hash_serialized} != au_data.hash_serialized) {
         return util::Error{Untranslated(strprintf("Bad snapshot content hash: expected %s, got %s",
-            au_data.hash_serialized.ToString(), maybe_stats->hashSerialized.ToString()))};
+            au_data.hash_serialized.ToString(), hash_serialized.ToString()))};
     }
 
     snapshot_chainstate.m_chain.SetTip(*snapshot_start_block);
@@ -6297,6 +6431,7 @@ static ChainstateManager::Options&& Flatten(ChainstateManager::Options&& opts)
 
 ChainstateManager::ChainstateManager(const util::SignalInterrupt& interrupt, Options options, node::BlockManager::Options blockman_options)
     : m_script_check_queue{/*batch_size=*/128, std::clamp(options.worker_threads_num, 0, MAX_SCRIPTCHECK_THREADS)},
+      m_input_fetcher{/*batch_size=*/16, std::clamp(options.input_fetch_threads_num, 0, MAX_INPUTFETCH_THREADS)},
       m_interrupt{interrupt},
       m_options{Flatten(std::move(options))},
       m_blockman{interrupt, std::move(blockman_options)},
@@ -13,14 +13,17 @@
 #include <consensus/amount.h>
 #include <cuckoocache.h>
 #include <deploymentstatus.h>
+#include <inputfetcher.h>
 #include <kernel/chain.h>
 #include <kernel/chainparams.h>
 #include <kernel/chainstatemanager_opts.h>
 #include <kernel/cs_main.h> // IWYU pragma: export
+#include <kernel/validation_stats.h>
 #include <node/blockstorage.h>
 #include <policy/feerate.h>
 #include <policy/packages.h>
 #include <policy/policy.h>
+#include <pubkey.h>
 #include <script/script_error.h>
 #include <script/sigcache.h>
 #include <script/verify_flags.h>
@@ -84,6 +87,8 @@ static const uint64_t MIN_DISK_SPACE_FOR_BLOCK_FILES = 550 * 1024 * 1024;
 
 /** Maximum number of dedicated script-checking threads allowed */
 static constexpr int MAX_SCRIPTCHECK_THREADS{15};
+/** Maximum number of dedicated block input fetching threads allowed */
+static constexpr int MAX_INPUTFETCH_THREADS{15};
 
 /** Current sync state passed to tip changed callbacks. */
 enum class SynchronizationState {
@@ -342,7 +347,13 @@ private:
     PrecomputedTransactionData *txdata;
     SignatureCache* m_signature_cache;
 
+    std::optional<std::pair<ScriptError, std::string>> Run(SchnorrSignatureBatch* schnorr_batch);
+
 public:
+    //! Schnorr signatures that miss the signature cache can be deferred to a
+    //! batch shared by several checks, see CCheckQueue.
+    using Batch = SchnorrSignatureBatch;
+
     CScriptCheck(const CTxOut& outIn, const CTransaction& txToIn, SignatureCache& signature_cache, unsigned int nInIn, script_verify_flags flags, bool cacheIn, PrecomputedTransactionData* txdataIn) :
         m_tx_out(outIn), ptxTo(&txToIn), nIn(nInIn), m_flags(flags), cacheStore(cacheIn), txdata(txdataIn), m_signature_cache(&signature_cache) { }
 
@@ -352,6 +363,9 @@ public:
     CScriptCheck& operator=(CScriptCheck&&) = default;
 
     std::optional<std::pair<ScriptError, std::string>> operator()();
+    //! Run the check, adding Schnorr signatures to the batch instead of
+    //! verifying them. Success only holds if the batch verifies.
+    std::optional<std::pair<ScriptError, std::string>> operator()(SchnorrSignatureBatch& schnorr_batch);
 };
 
 // CScriptCheck is used a lot in std::vector, make sure that's efficient
@@ -481,22 +495,36 @@ public:
     //! This view wraps access to the leveldb instance and handles read errors gracefully.
     CCoinsViewErrorCatcher m_catcherview GUARDED_BY(cs_main);
 
+    //! If background flushing is enabled, this view writes the coins flushed from the cache
+    //! to the database on a background thread, and serves them until they are written.
+    std::unique_ptr<CCoinsViewBackgroundFlush> m_flushview GUARDED_BY(cs_main);
+
+    //! If the compact coins cache is enabled, this view keeps coins that were read from or
+    //! written to the database in compressed form, taking COMPACT_COINS_CACHE_PERCENT of
+    //! the coins cache memory.
+    std::unique_ptr<CCoinsViewCompact> m_compactview GUARDED_BY(cs_main);
+
     //! This is the top layer of the cache hierarchy - it keeps as many coins in memory as
     //! can fit per the dbcache setting.
     std::unique_ptr<CCoinsViewCache> m_cacheview GUARDED_BY(cs_main);
 
-    //! This constructor initializes CCoinsViewDB and CCoinsViewErrorCatcher instances, but it
-    //! *does not* create a CCoinsViewCache instance by default. This is done separately because the
+    //! This constructor initializes CCoinsViewDB, CCoinsViewErrorCatcher and, if enabled,
+    //! CCoinsViewBackgroundFlush and CCoinsViewCompact instances, but it *does not* create a CCoinsViewCache instance by default. This is done separately because the
     //! presence of the cache has implications on whether or not we're allowed to flush the cache's
     //! state to disk, which should not be done until the health of the database is verified.
     //!
-    //! All arguments forwarded onto CCoinsViewDB.
-    CoinsViews(DBParams db_params, CoinsViewOptions options);
+    //! The database arguments are forwarded onto CCoinsViewDB, and flush_error_cb onto
+    //! CCoinsViewBackgroundFlush.
+    CoinsViews(DBParams db_params, CoinsViewOptions options, std::function<void()> flush_error_cb = {});
 
     //! Initialize the CCoinsViewCache member.
     void InitCache() EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 };
 
+//! Share of the coins cache memory, in percent, that is given to the compact
+//! coins cache when it is enabled.
+static constexpr size_t COMPACT_COINS_CACHE_PERCENT{50};
+
 enum class CoinsCacheSizeState
 {
     //! The coins cache is in immediate need of a flush.
@@ -651,6 +679,25 @@ public:
         return Assert(m_coins_views)->m_dbview;
     }
 
+    //! @returns A reference to the view the in-memory cache of the UTXO set is
+    //!     backed by. Unlike CoinsDB(), it includes the coins that are still
+    //!     being written to disk in the background and the compact coins
+    //!     cache.
+    CCoinsView& CoinsCacheBase() EXCLUSIVE_LOCKS_REQUIRED(::cs_main)
+    {
+        AssertLockHeld(::cs_main);
+        Assert(m_coins_views);
+        if (m_coins_views->m_compactview) return *m_coins_views->m_compactview;
+        if (m_coins_views->m_flushview) return *m_coins_views->m_flushview;
+        return m_coins_views->m_catcherview;
+    }
+
+    //! Wait until the coins that are written to disk in the background, if
+    //! any, are on disk.
+    //!
+    //! @returns false if writing them failed.
+    bool WaitForCoinsFlush() EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+
     //! @returns A pointer to the mempool.
     CTxMemPool* GetMempool()
     {
@@ -677,6 +724,14 @@ public:
     //! The cache size of the in-memory coins view.
     size_t m_coinstip_cache_size_bytes{0};
 
+    //! Number of cursors reading from the coins database. The database is
+    //! not reopened to resize its cache while there are any.
+    size_t m_coins_db_cursors GUARDED_BY(::cs_main){0};
+
+    //! The part of m_coinstip_cache_size_bytes given to the compact coins
+    //! cache, or zero if it is not enabled.
+    size_t CompactCoinsCacheSize() const EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+
     //! Resize the CoinsViews caches dynamically and flush state to disk.
     //! @returns true unless an error occurred during the flush.
     bool ResizeCoinsCaches(size_t coinstip_size, size_t coinsdb_size)
@@ -946,6 +1001,10 @@ private:
     //! To reduce space the serialization format of the snapshot avoids
     //! duplication of tx hashes. The code takes advantage of the guarantee by
     //! leveldb that keys are lexicographically sorted.
+    //!
+    //! The file is read on the calling thread, while the coins are written to
+    //! the database and serialized for the hash on the worker threads (see
+    //! ChainstateManagerOpts::worker_threads_num).
     [[nodiscard]] util::Result<void> PopulateAndValidateSnapshot(
         Chainstate& snapshot_chainstate,
         AutoFile& coins_file,
@@ -980,20 +1039,12 @@ private:
     //! A queue for script verifications that have to be performed by worker threads.
     CCheckQueue<CScriptCheck> m_script_check_queue;
 
+    //! Fetches the inputs of a block on worker threads before it is connected.
+    InputFetcher m_input_fetcher;
+
     //! Timers and counters used for benchmarking validation in both background
     //! and active chainstates.
-    SteadyClock::duration GUARDED_BY(::cs_main) time_check{};
-    SteadyClock::duration GUARDED_BY(::cs_main) time_forks{};
-    SteadyClock::duration GUARDED_BY(::cs_main) time_connect{};
-    SteadyClock::duration GUARDED_BY(::cs_main) time_verify{};
-    SteadyClock::duration GUARDED_BY(::cs_main) time_undo{};
-    SteadyClock::duration GUARDED_BY(::cs_main) time_index{};
-    SteadyClock::duration GUARDED_BY(::cs_main) time_total{};
-    int64_t GUARDED_BY(::cs_main) num_blocks_total{0};
-    SteadyClock::duration GUARDED_BY(::cs_main) time_connect_total{};
-    SteadyClock::duration GUARDED_BY(::cs_main) time_flush{};
-    SteadyClock::duration GUARDED_BY(::cs_main) time_chainstate{};
-    SteadyClock::duration GUARDED_BY(::cs_main) time_post_connect{};
+    kernel::ValidationStats m_validation_stats GUARDED_BY(::cs_main);
 
 public:
     using Options = kernel::ChainstateManagerOpts;
@@ -1173,9 +1224,15 @@ public:
      * It reads all blocks contained in the given file and attempts to process them (add them to the
      * block index). The blocks may be out of order within each file and across files. Often this
      * function reads a block but finds that its parent hasn't been read yet, so the block can't be
-     * processed yet. The function will add an entry to the blocks_with_unknown_parent map (which is
-     * passed as an argument), so that when the block's parent is later read and processed, this
-     * function can re-read the child block from disk and process it.
+     * processed yet. Such blocks are kept in memory, up to a limit, and processed once their parent
+     * is read later in the same file. Otherwise, the function will add an entry to the
+     * blocks_with_unknown_parent map (which is passed as an argument), so that when the block's
+     * parent is later read and processed, this function can re-read the child block from disk and
+     * process it.
+     *
+     * Reading and framing the blocks, and deserializing and checking them, is done ahead of their
+     * processing on the worker threads (see ChainstateManagerOpts::worker_threads_num), while the
+     * blocks are processed in file order on the calling thread.
      *
      * Because a block's parent may be in a later file, not just later in the same file, the
      * blocks_with_unknown_parent map must be passed in and out with each call. It's a multimap,
@@ -1183,7 +1240,8 @@ public:
      * or stale blocks exist). It maps from parent-hash to child-disk-position.
      *
      * This function can also be used to read blocks from user-specified block files using the
-     * -loadblock= option. There's no unknown-parent tracking, so the last two arguments are omitted.
+     * -loadblock= option. There's no unknown-parent tracking across files, so the last two arguments
+     * are omitted.
      *
      *
      * @param[in]     file_in                       File containing blocks to read
@@ -1340,6 +1398,12 @@ public:
 
     CCheckQueue<CScriptCheck>& GetCheckQueue() { return m_script_check_queue; }
 
+    InputFetcher& GetInputFetcher() { return m_input_fetcher; }
+
+    //! The totals of the validation timers and counters over all blocks
+    //! connected so far.
+    kernel::ValidationStats GetValidationStats() const EXCLUSIVE_LOCKS_REQUIRED(::cs_main) { return m_validation_stats; }
+
     ~ChainstateManager();
 };
 
@@ -10,13 +10,17 @@ pub use block::{
 };
 pub use block_tree_entry::BlockTreeEntry;
 pub use script::{ScriptPubkey, ScriptPubkeyRef};
-pub use transaction::{Transaction, TransactionRef, TxOut, TxOutRef};
+pub use transaction::{
+    Transaction, TransactionRef, TxOut, TxOutPoint, TxOutPointRef, TxOutRef, Txid, TxidRef,
+};
 
 pub use block::{BlockHashExt, BlockSpentOutputsExt, CoinExt, TransactionSpentOutputsExt};
 pub use script::ScriptPubkeyExt;
-pub use transaction::{TransactionExt, TxOutExt};
+pub use transaction::{TransactionExt, TxInExt, TxOutExt, TxOutPointExt, TxidExt};
 
-pub use verify::{verify, ScriptVerifyError, ScriptVerifyStatus};
+pub use verify::{
+    verify, verify_all_inputs, verify_transactions, ScriptVerifyError, ScriptVerifyStatus,
+};
 
 pub mod verify_flags {
     pub use super::verify::{
@@ -7,12 +7,12 @@ use libbitcoinkernel_sys::{
     btck_transaction_get_input_at, btck_transaction_get_output_at, btck_transaction_get_txid,
     btck_transaction_input_copy, btck_transaction_input_destroy,
     btck_transaction_input_get_out_point, btck_transaction_out_point_copy,
-    btck_transaction_out_point_destroy, btck_transaction_out_point_get_index,
-    btck_transaction_out_point_get_txid, btck_transaction_output_copy,
-    btck_transaction_output_create, btck_transaction_output_destroy,
+    btck_transaction_out_point_create, btck_transaction_out_point_destroy,
+    btck_transaction_out_point_get_index, btck_transaction_out_point_get_txid,
+    btck_transaction_output_copy, btck_transaction_output_create, btck_transaction_output_destroy,
     btck_transaction_output_get_amount, btck_transaction_output_get_script_pubkey,
-    btck_transaction_to_bytes, btck_txid_copy, btck_txid_destroy, btck_txid_equals,
-    btck_txid_to_bytes,
+    btck_transaction_to_bytes, btck_txid_copy, btck_txid_create, btck_txid_destroy,
+    btck_txid_equals, btck_txid_to_bytes,
 };
 
 use crate::{
@@ -565,6 +565,19 @@ unsafe impl Send for TxOutPoint {}
 unsafe impl Sync for TxOutPoint {}
 
 impl TxOutPoint {
+    /// Creates an outpoint referencing the output at `index` of the
+    /// transaction with the given txid.
+    pub fn new(txid: &impl TxidExt, index: u32) -> Result<Self, KernelError> {
+        let inner = unsafe { btck_transaction_out_point_create(txid.as_ptr(), index) };
+        if inner.is_null() {
+            Err(KernelError::Internal(
+                "Failed to create outpoint".to_string(),
+            ))
+        } else {
+            Ok(TxOutPoint { inner })
+        }
+    }
+
     /// Returns a borrowed reference to this outpoint.
     pub fn as_ref(&self) -> TxOutPointRef<'_> {
         unsafe { TxOutPointRef::from_ptr(self.inner as *const _) }
@@ -662,6 +675,24 @@ unsafe impl Send for Txid {}
 unsafe impl Sync for Txid {}
 
 impl Txid {
+    pub fn new(raw_bytes: &[u8]) -> Result<Self, KernelError> {
+        if raw_bytes.len() != 32 {
+            return Err(KernelError::InvalidLength {
+                expcted: 32,
+                actual: raw_bytes.len(),
+            });
+        }
+        let inner = unsafe { btck_txid_create(raw_bytes.as_ptr()) };
+
+        if inner.is_null() {
+            Err(KernelError::Internal(
+                "Failed to create txid from bytes".to_string(),
+            ))
+        } else {
+            Ok(Txid { inner })
+        }
+    }
+
     pub fn as_ref(&self) -> TxidRef<'_> {
         unsafe { TxidRef::from_ptr(self.inner as *const _) }
     }
@@ -709,6 +740,20 @@ impl PartialEq<TxidRef<'_>> for Txid {
 
 impl Eq for Txid {}
 
+impl From<[u8; 32]> for Txid {
+    fn from(txid: [u8; 32]) -> Self {
+        Txid::new(txid.as_slice()).expect("32-bytes array should always be valid")
+    }
+}
+
+impl TryFrom<&[u8]> for Txid {
+    type Error = KernelError;
+
+    fn try_from(bytes: &[u8]) -> Result<Self, Self::Error> {
+        Txid::new(bytes)
+    }
+}
+
 #[derive(Debug)]
 pub struct TxidRef<'a> {
     inner: *const btck_Txid,
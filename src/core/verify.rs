@@ -1,6 +1,6 @@
 use libbitcoinkernel_sys::{
-    btck_ScriptVerificationFlags, btck_ScriptVerifyStatus, btck_TransactionOutput,
-    btck_script_pubkey_verify,
+    btck_ScriptVerificationFlags, btck_ScriptVerifyStatus, btck_Transaction,
+    btck_TransactionOutput, btck_script_pubkey_verify, btck_transactions_verify_all_inputs,
 };
 
 use crate::{
@@ -131,6 +131,105 @@ pub fn verify(
     }
 }
 
+/// Verifies all inputs of a transaction against the outputs they spend.
+///
+/// The signature hash data is computed once for the transaction and the
+/// per-input checks are spread over `worker_threads` additional threads.
+///
+/// # Arguments
+/// * `tx_to` - The transaction whose inputs should be verified
+/// * `flags` - Defaults to all if none
+/// * `spent_outputs` - The outputs being spent by this transaction, one per input
+/// * `worker_threads` - Number of threads used besides the calling one, 0 to verify on the calling thread only.
+///   At most one thread is used per 16 inputs.
+///
+/// # Returns
+/// * `Ok(results)` with one entry per input, [`ScriptVerifyError::Invalid`] for inputs that failed
+/// * [`KernelError::ScriptVerify`] if the batch could not be verified at all
+pub fn verify_all_inputs(
+    tx_to: &impl TransactionExt,
+    flags: Option<u32>,
+    spent_outputs: &[impl TxOutExt],
+    worker_threads: u32,
+) -> Result<Vec<Result<(), ScriptVerifyError>>, KernelError> {
+    verify_transactions(
+        std::slice::from_ref(tx_to),
+        flags,
+        spent_outputs,
+        worker_threads,
+    )
+}
+
+/// Verifies all inputs of multiple transactions in a single batch.
+///
+/// `spent_outputs` holds the spent outputs of every transaction concatenated
+/// in the order of `txs`, so its length must equal the total input count.
+///
+/// # Returns
+/// * `Ok(results)` with one entry per input, in the same order as `spent_outputs`
+/// * [`KernelError::ScriptVerify`] if the batch could not be verified at all
+pub fn verify_transactions(
+    txs: &[impl TransactionExt],
+    flags: Option<u32>,
+    spent_outputs: &[impl TxOutExt],
+    worker_threads: u32,
+) -> Result<Vec<Result<(), ScriptVerifyError>>, KernelError> {
+    let input_count: usize = txs.iter().map(|tx| tx.input_count()).sum();
+    if spent_outputs.len() != input_count {
+        return Err(KernelError::ScriptVerify(
+            ScriptVerifyError::SpentOutputsMismatch,
+        ));
+    }
+
+    let kernel_flags = if let Some(flag) = flags {
+        if (flag & !VERIFY_ALL) != 0 {
+            return Err(KernelError::ScriptVerify(ScriptVerifyError::InvalidFlags));
+        }
+        flag
+    } else {
+        VERIFY_ALL
+    };
+
+    let kernel_txs: Vec<*const btck_Transaction> = txs.iter().map(|tx| tx.as_ptr()).collect();
+    let kernel_spent_outputs: Vec<*const btck_TransactionOutput> =
+        spent_outputs.iter().map(|utxo| utxo.as_ptr()).collect();
+    let mut results: Vec<i32> = vec![0; input_count];
+    let mut status = ScriptVerifyStatus::Ok.into();
+
+    unsafe {
+        btck_transactions_verify_all_inputs(
+            kernel_txs.as_ptr() as *mut *const btck_Transaction,
+            kernel_txs.len(),
+            kernel_spent_outputs.as_ptr() as *mut *const btck_TransactionOutput,
+            kernel_spent_outputs.len(),
+            kernel_flags,
+            worker_threads,
+            results.as_mut_ptr(),
+            results.len(),
+            &mut status,
+        )
+    };
+
+    match ScriptVerifyStatus::from(status) {
+        ScriptVerifyStatus::Ok => Ok(results
+            .into_iter()
+            .map(|result| {
+                if c_helpers::verification_passed(result) {
+                    Ok(())
+                } else {
+                    Err(ScriptVerifyError::Invalid)
+                }
+            })
+            .collect()),
+        ScriptVerifyStatus::ErrorInvalidFlagsCombination => Err(KernelError::ScriptVerify(
+            ScriptVerifyError::InvalidFlagsCombination,
+        )),
+        ScriptVerifyStatus::ErrorSpentOutputsRequired => Err(KernelError::ScriptVerify(
+            ScriptVerifyError::SpentOutputsRequired,
+        )),
+    }
+}
+
 /// Status of script verification operations.
 ///
 /// Indicates the result of verifying a transaction script, including any
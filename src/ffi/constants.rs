@@ -1,7 +1,9 @@
 use crate::{
-    btck_BlockValidationResult, btck_ChainType, btck_LogCategory, btck_LogLevel,
+    btck_BlockValidationResult, btck_ChainType, btck_ChainstateVerificationResult,
+    btck_LogCategory, btck_LogLevel, btck_MempoolAcceptStatus, btck_MempoolRemovalReason,
     btck_ScriptVerificationFlags, btck_ScriptVerifyStatus, btck_SynchronizationState,
-    btck_ValidationMode, btck_Warning,
+    btck_TxValidationResult, btck_UtxoSetHashType, btck_ValidationCacheType, btck_ValidationMode,
+    btck_ValidationPhase, btck_Warning,
 };
 
 // Synchronization States
@@ -13,6 +15,13 @@ pub const BTCK_SYNCHRONIZATION_STATE_POST_INIT: btck_SynchronizationState = 2;
 pub const BTCK_WARNING_UNKNOWN_NEW_RULES_ACTIVATED: btck_Warning = 0;
 pub const BTCK_WARNING_LARGE_WORK_INVALID_CHAIN: btck_Warning = 1;
 
+// Chainstate Verification Results
+pub const BTCK_CHAINSTATE_VERIFICATION_RESULT_SUCCESS: btck_ChainstateVerificationResult = 0;
+pub const BTCK_CHAINSTATE_VERIFICATION_RESULT_INTERRUPTED: btck_ChainstateVerificationResult = 1;
+pub const BTCK_CHAINSTATE_VERIFICATION_RESULT_FAILURE: btck_ChainstateVerificationResult = 2;
+pub const BTCK_CHAINSTATE_VERIFICATION_RESULT_INSUFFICIENT_DBCACHE:
+    btck_ChainstateVerificationResult = 3;
+
 // Validation Modes
 pub const BTCK_VALIDATION_MODE_VALID: btck_ValidationMode = 0;
 pub const BTCK_VALIDATION_MODE_INVALID: btck_ValidationMode = 1;
@@ -78,3 +87,55 @@ pub const BTCK_CHAIN_TYPE_TESTNET: btck_ChainType = 1;
 pub const BTCK_CHAIN_TYPE_TESTNET_4: btck_ChainType = 2;
 pub const BTCK_CHAIN_TYPE_SIGNET: btck_ChainType = 3;
 pub const BTCK_CHAIN_TYPE_REGTEST: btck_ChainType = 4;
+
+// UTXO set hash types
+pub const BTCK_UTXO_SET_HASH_TYPE_HASH_SERIALIZED: btck_UtxoSetHashType = 0;
+pub const BTCK_UTXO_SET_HASH_TYPE_MUHASH: btck_UtxoSetHashType = 1;
+pub const BTCK_UTXO_SET_HASH_TYPE_NONE: btck_UtxoSetHashType = 2;
+
+// Validation phases
+pub const BTCK_VALIDATION_PHASE_LOAD_BLOCK: btck_ValidationPhase = 0;
+pub const BTCK_VALIDATION_PHASE_CHECK_BLOCK: btck_ValidationPhase = 1;
+pub const BTCK_VALIDATION_PHASE_FORK_CHECKS: btck_ValidationPhase = 2;
+pub const BTCK_VALIDATION_PHASE_CONNECT_TRANSACTIONS: btck_ValidationPhase = 3;
+pub const BTCK_VALIDATION_PHASE_VERIFY: btck_ValidationPhase = 4;
+pub const BTCK_VALIDATION_PHASE_WRITE_UNDO: btck_ValidationPhase = 5;
+pub const BTCK_VALIDATION_PHASE_WRITE_INDEX: btck_ValidationPhase = 6;
+pub const BTCK_VALIDATION_PHASE_CONNECT_BLOCK: btck_ValidationPhase = 7;
+pub const BTCK_VALIDATION_PHASE_FLUSH_VIEW: btck_ValidationPhase = 8;
+pub const BTCK_VALIDATION_PHASE_WRITE_CHAINSTATE: btck_ValidationPhase = 9;
+pub const BTCK_VALIDATION_PHASE_POST_CONNECT: btck_ValidationPhase = 10;
+pub const BTCK_VALIDATION_PHASE_TOTAL: btck_ValidationPhase = 11;
+
+// Validation cache types
+pub const BTCK_VALIDATION_CACHE_TYPE_SIGNATURE: btck_ValidationCacheType = 0;
+pub const BTCK_VALIDATION_CACHE_TYPE_SCRIPT_EXECUTION: btck_ValidationCacheType = 1;
+
+// Mempool removal reasons
+pub const BTCK_MEMPOOL_REMOVAL_REASON_EXPIRY: btck_MempoolRemovalReason = 0;
+pub const BTCK_MEMPOOL_REMOVAL_REASON_SIZE_LIMIT: btck_MempoolRemovalReason = 1;
+pub const BTCK_MEMPOOL_REMOVAL_REASON_REORG: btck_MempoolRemovalReason = 2;
+pub const BTCK_MEMPOOL_REMOVAL_REASON_BLOCK: btck_MempoolRemovalReason = 3;
+pub const BTCK_MEMPOOL_REMOVAL_REASON_CONFLICT: btck_MempoolRemovalReason = 4;
+pub const BTCK_MEMPOOL_REMOVAL_REASON_REPLACED: btck_MempoolRemovalReason = 5;
+
+// Mempool accept statuses
+pub const BTCK_MEMPOOL_ACCEPT_STATUS_ACCEPTED: btck_MempoolAcceptStatus = 0;
+pub const BTCK_MEMPOOL_ACCEPT_STATUS_ALREADY_IN_MEMPOOL: btck_MempoolAcceptStatus = 1;
+pub const BTCK_MEMPOOL_ACCEPT_STATUS_REJECTED: btck_MempoolAcceptStatus = 2;
+pub const BTCK_MEMPOOL_ACCEPT_STATUS_NOT_PROCESSED: btck_MempoolAcceptStatus = 3;
+
+// Transaction validation results
+pub const BTCK_TX_VALIDATION_RESULT_UNSET: btck_TxValidationResult = 0;
+pub const BTCK_TX_VALIDATION_RESULT_CONSENSUS: btck_TxValidationResult = 1;
+pub const BTCK_TX_VALIDATION_RESULT_INPUTS_NOT_STANDARD: btck_TxValidationResult = 2;
+pub const BTCK_TX_VALIDATION_RESULT_NOT_STANDARD: btck_TxValidationResult = 3;
+pub const BTCK_TX_VALIDATION_RESULT_MISSING_INPUTS: btck_TxValidationResult = 4;
+pub const BTCK_TX_VALIDATION_RESULT_PREMATURE_SPEND: btck_TxValidationResult = 5;
+pub const BTCK_TX_VALIDATION_RESULT_WITNESS_MUTATED: btck_TxValidationResult = 6;
+pub const BTCK_TX_VALIDATION_RESULT_WITNESS_STRIPPED: btck_TxValidationResult = 7;
+pub const BTCK_TX_VALIDATION_RESULT_CONFLICT: btck_TxValidationResult = 8;
+pub const BTCK_TX_VALIDATION_RESULT_MEMPOOL_POLICY: btck_TxValidationResult = 9;
+pub const BTCK_TX_VALIDATION_RESULT_NO_MEMPOOL: btck_TxValidationResult = 10;
+pub const BTCK_TX_VALIDATION_RESULT_RECONSIDERABLE: btck_TxValidationResult = 11;
+pub const BTCK_TX_VALIDATION_RESULT_UNKNOWN: btck_TxValidationResult = 12;
@@ -11,11 +11,13 @@ use ffi::{
     BTCK_BLOCK_VALIDATION_RESULT_HEADER_LOW_WORK, BTCK_BLOCK_VALIDATION_RESULT_INVALID_HEADER,
     BTCK_BLOCK_VALIDATION_RESULT_INVALID_PREV, BTCK_BLOCK_VALIDATION_RESULT_MISSING_PREV,
     BTCK_BLOCK_VALIDATION_RESULT_MUTATED, BTCK_BLOCK_VALIDATION_RESULT_TIME_FUTURE,
-    BTCK_BLOCK_VALIDATION_RESULT_UNSET, BTCK_CHAIN_TYPE_MAINNET, BTCK_CHAIN_TYPE_REGTEST,
-    BTCK_CHAIN_TYPE_SIGNET, BTCK_CHAIN_TYPE_TESTNET, BTCK_CHAIN_TYPE_TESTNET_4,
-    BTCK_SYNCHRONIZATION_STATE_INIT_DOWNLOAD, BTCK_SYNCHRONIZATION_STATE_INIT_REINDEX,
-    BTCK_SYNCHRONIZATION_STATE_POST_INIT, BTCK_VALIDATION_MODE_INTERNAL_ERROR,
-    BTCK_VALIDATION_MODE_INVALID, BTCK_VALIDATION_MODE_VALID,
+    BTCK_BLOCK_VALIDATION_RESULT_UNSET, BTCK_CHAINSTATE_VERIFICATION_RESULT_FAILURE,
+    BTCK_CHAINSTATE_VERIFICATION_RESULT_INSUFFICIENT_DBCACHE,
+    BTCK_CHAINSTATE_VERIFICATION_RESULT_INTERRUPTED, BTCK_CHAINSTATE_VERIFICATION_RESULT_SUCCESS,
+    BTCK_CHAIN_TYPE_MAINNET, BTCK_CHAIN_TYPE_REGTEST, BTCK_CHAIN_TYPE_SIGNET,
+    BTCK_CHAIN_TYPE_TESTNET, BTCK_CHAIN_TYPE_TESTNET_4, BTCK_SYNCHRONIZATION_STATE_INIT_DOWNLOAD,
+    BTCK_SYNCHRONIZATION_STATE_INIT_REINDEX, BTCK_SYNCHRONIZATION_STATE_POST_INIT,
+    BTCK_VALIDATION_MODE_INTERNAL_ERROR, BTCK_VALIDATION_MODE_INVALID, BTCK_VALIDATION_MODE_VALID,
     BTCK_WARNING_LARGE_WORK_INVALID_CHAIN, BTCK_WARNING_UNKNOWN_NEW_RULES_ACTIVATED,
 };
 use libbitcoinkernel_sys::*;
@@ -95,23 +97,29 @@ impl fmt::Display for KernelError {
 }
 
 pub use crate::core::{
-    verify, Block, BlockHash, BlockSpentOutputs, BlockSpentOutputsRef, BlockTreeEntry, Coin,
-    CoinRef, ScriptPubkey, ScriptPubkeyRef, ScriptVerifyError, ScriptVerifyStatus, Transaction,
-    TransactionRef, TransactionSpentOutputs, TransactionSpentOutputsRef, TxOut, TxOutRef,
+    verify, verify_all_inputs, verify_transactions, Block, BlockHash, BlockSpentOutputs,
+    BlockSpentOutputsRef, BlockTreeEntry, Coin, CoinRef, ScriptPubkey, ScriptPubkeyRef,
+    ScriptVerifyError, ScriptVerifyStatus, Transaction, TransactionRef, TransactionSpentOutputs,
+    TransactionSpentOutputsRef, TxOut, TxOutPoint, TxOutPointRef, TxOutRef, Txid, TxidRef,
 };
 
 pub use crate::log::{disable_logging, Log, LogCategory, LogLevel, Logger};
 
 pub use crate::notifications::{
-    BlockCheckedCallback, BlockTipCallback, BlockValidationResult, FatalErrorCallback,
-    FlushErrorCallback, HeaderTipCallback, NotificationCallbackRegistry, ProgressCallback,
-    SynchronizationState, ValidationCallbackRegistry, ValidationMode, Warning, WarningSetCallback,
-    WarningUnsetCallback,
+    BackgroundBlockTipCallback, BlockCheckedCallback, BlockConnectedStatsCallback,
+    BlockTipCallback, BlockValidationResult, ChainstateVerificationResult,
+    ChainstateVerifiedCallback, FatalErrorCallback, FlushErrorCallback, HeaderTipCallback,
+    MempoolRemovalReason, NotificationCallbackRegistry, ProgressCallback, ScriptChecksCallback,
+    SynchronizationState, TransactionAddedToMempoolCallback, TransactionRemovedFromMempoolCallback,
+    ValidationCallbackRegistry, ValidationMode, Warning, WarningSetCallback, WarningUnsetCallback,
 };
 
 pub use crate::state::{
-    Chain, ChainParams, ChainType, ChainstateManager, ChainstateManagerOptions, Context,
-    ContextBuilder,
+    BlockReader, BlockReaderBuilder, Chain, ChainParams, ChainType, ChainstateManager,
+    ChainstateManagerOptions, CoinsCursor, CoinsShard, Context, ContextBuilder, Mempool,
+    MempoolAcceptResult, MempoolAcceptStatus, ProcessHeadersResult, TxValidationResult,
+    UtxoSetHashType, UtxoStats, ValidationCacheStats, ValidationCacheType, ValidationPhase,
+    ValidationStats, BLOCK_HEADER_SIZE,
 };
 
 pub use crate::core::verify_flags::{
@@ -122,6 +130,6 @@ pub use crate::core::verify_flags::{
 pub mod prelude {
     pub use crate::core::{
         BlockHashExt, BlockSpentOutputsExt, CoinExt, ScriptPubkeyExt, TransactionExt,
-        TransactionSpentOutputsExt, TxOutExt,
+        TransactionSpentOutputsExt, TxInExt, TxOutExt, TxOutPointExt, TxidExt,
     };
 }
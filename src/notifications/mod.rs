@@ -2,11 +2,19 @@ pub mod notification;
 pub mod types;
 pub mod validation;
 
-pub use types::{BlockValidationResult, SynchronizationState, ValidationMode, Warning};
+pub use types::{
+    BlockValidationResult, ChainstateVerificationResult, MempoolRemovalReason,
+    SynchronizationState, ValidationMode, Warning,
+};
 
 pub use notification::{
-    BlockTipCallback, FatalErrorCallback, FlushErrorCallback, HeaderTipCallback,
-    NotificationCallbackRegistry, ProgressCallback, WarningSetCallback, WarningUnsetCallback,
+    BackgroundBlockTipCallback, BlockConnectedStatsCallback, BlockTipCallback,
+    ChainstateVerifiedCallback, FatalErrorCallback, FlushErrorCallback, HeaderTipCallback,
+    NotificationCallbackRegistry, ProgressCallback, ScriptChecksCallback, WarningSetCallback,
+    WarningUnsetCallback,
 };
 
-pub use validation::{BlockCheckedCallback, ValidationCallbackRegistry};
+pub use validation::{
+    BlockCheckedCallback, TransactionAddedToMempoolCallback, TransactionRemovedFromMempoolCallback,
+    ValidationCallbackRegistry,
+};
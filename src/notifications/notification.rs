@@ -1,17 +1,21 @@
 use std::ffi::{c_char, c_void};
 
 use libbitcoinkernel_sys::{
-    btck_BlockTreeEntry, btck_SynchronizationState, btck_Warning,
-    btck_block_tree_entry_get_block_hash,
+    btck_BlockTreeEntry, btck_ChainstateVerificationResult, btck_SynchronizationState,
+    btck_ValidationStats, btck_Warning, btck_block_tree_entry_get_block_hash,
+    btck_validation_stats_copy,
 };
 
 use crate::{
     core::block::BlockHashRef,
-    ffi::{c_helpers, sealed::FromPtr},
-    BlockHash,
+    ffi::{
+        c_helpers,
+        sealed::{FromMutPtr, FromPtr},
+    },
+    BlockHash, ValidationStats,
 };
 
-use super::{SynchronizationState, Warning};
+use super::{ChainstateVerificationResult, SynchronizationState, Warning};
 
 /// The chain's tip was updated to the provided block hash.
 pub trait BlockTipCallback: Send + Sync {
@@ -59,6 +63,33 @@ pub trait FatalErrorCallback: Send + Sync {
     fn on_fatal_error(&self, message: String);
 }
 
+/// The background chainstate, which validates the blocks below a loaded
+/// snapshot, connected blocks up to the provided block hash. The progress is
+/// the fraction of the snapshot's transactions validated so far.
+pub trait BackgroundBlockTipCallback: Send + Sync {
+    fn on_background_block_tip(&self, hash: BlockHash, verification_progress: f64);
+}
+
+/// The chainstate of a chainstate manager created with background
+/// verification was verified. The message describes a failure. The callback
+/// runs on the verification thread and must not drop the chainstate manager.
+pub trait ChainstateVerifiedCallback: Send + Sync {
+    fn on_chainstate_verified(&self, result: ChainstateVerificationResult, message: String);
+}
+
+/// A block was connected to a chainstate. The statistics hold the time spent
+/// in each phase of connecting it and the work done.
+pub trait BlockConnectedStatsCallback: Send + Sync {
+    fn on_block_connected_stats(&self, hash: BlockHash, stats: ValidationStats);
+}
+
+/// Script verification was enabled or disabled, starting at the provided
+/// block hash, depending on whether the block is covered by the assumed valid
+/// block. The reason why scripts are verified is empty if they are not.
+pub trait ScriptChecksCallback: Send + Sync {
+    fn on_script_checks(&self, hash: BlockHash, enabled: bool, reason: String);
+}
+
 impl<F> BlockTipCallback for F
 where
     F: Fn(SynchronizationState, BlockHash, f64) + Send + Sync + 'static,
@@ -128,6 +159,42 @@ where
     }
 }
 
+impl<F> BackgroundBlockTipCallback for F
+where
+    F: Fn(BlockHash, f64) + Send + Sync + 'static,
+{
+    fn on_background_block_tip(&self, hash: BlockHash, verification_progress: f64) {
+        self(hash, verification_progress)
+    }
+}
+
+impl<F> ChainstateVerifiedCallback for F
+where
+    F: Fn(ChainstateVerificationResult, String) + Send + Sync + 'static,
+{
+    fn on_chainstate_verified(&self, result: ChainstateVerificationResult, message: String) {
+        self(result, message)
+    }
+}
+
+impl<F> BlockConnectedStatsCallback for F
+where
+    F: Fn(BlockHash, ValidationStats) + Send + Sync + 'static,
+{
+    fn on_block_connected_stats(&self, hash: BlockHash, stats: ValidationStats) {
+        self(hash, stats)
+    }
+}
+
+impl<F> ScriptChecksCallback for F
+where
+    F: Fn(BlockHash, bool, String) + Send + Sync + 'static,
+{
+    fn on_script_checks(&self, hash: BlockHash, enabled: bool, reason: String) {
+        self(hash, enabled, reason)
+    }
+}
+
 /// Registry for managing notification interface callback handlers.
 #[derive(Default)]
 pub struct NotificationCallbackRegistry {
@@ -138,6 +205,10 @@ pub struct NotificationCallbackRegistry {
     warning_unset_handler: Option<Box<dyn WarningUnsetCallback>>,
     flush_error_handler: Option<Box<dyn FlushErrorCallback>>,
     fatal_error_handler: Option<Box<dyn FatalErrorCallback>>,
+    background_block_tip_handler: Option<Box<dyn BackgroundBlockTipCallback>>,
+    chainstate_verified_handler: Option<Box<dyn ChainstateVerifiedCallback>>,
+    block_connected_stats_handler: Option<Box<dyn BlockConnectedStatsCallback>>,
+    script_checks_handler: Option<Box<dyn ScriptChecksCallback>>,
 }
 
 impl NotificationCallbackRegistry {
@@ -200,6 +271,41 @@ impl NotificationCallbackRegistry {
         self.fatal_error_handler = Some(Box::new(handler) as Box<dyn FatalErrorCallback>);
         self
     }
+
+    pub fn register_background_block_tip<T>(&mut self, handler: T) -> &mut Self
+    where
+        T: BackgroundBlockTipCallback + 'static,
+    {
+        self.background_block_tip_handler =
+            Some(Box::new(handler) as Box<dyn BackgroundBlockTipCallback>);
+        self
+    }
+
+    pub fn register_chainstate_verified<T>(&mut self, handler: T) -> &mut Self
+    where
+        T: ChainstateVerifiedCallback + 'static,
+    {
+        self.chainstate_verified_handler =
+            Some(Box::new(handler) as Box<dyn ChainstateVerifiedCallback>);
+        self
+    }
+
+    pub fn register_block_connected_stats<T>(&mut self, handler: T) -> &mut Self
+    where
+        T: BlockConnectedStatsCallback + 'static,
+    {
+        self.block_connected_stats_handler =
+            Some(Box::new(handler) as Box<dyn BlockConnectedStatsCallback>);
+        self
+    }
+
+    pub fn register_script_checks<T>(&mut self, handler: T) -> &mut Self
+    where
+        T: ScriptChecksCallback + 'static,
+    {
+        self.script_checks_handler = Some(Box::new(handler) as Box<dyn ScriptChecksCallback>);
+        self
+    }
 }
 
 pub(crate) unsafe extern "C" fn notification_user_data_destroy_wrapper(user_data: *mut c_void) {
@@ -299,6 +405,64 @@ pub(crate) unsafe extern "C" fn notification_fatal_error_wrapper(
     }
 }
 
+pub(crate) unsafe extern "C" fn notification_background_block_tip_wrapper(
+    user_data: *mut c_void,
+    entry: *const btck_BlockTreeEntry,
+    verification_progress: f64,
+) {
+    let registry = &*(user_data as *mut NotificationCallbackRegistry);
+    if let Some(ref handler) = registry.background_block_tip_handler {
+        let hash_ptr = btck_block_tree_entry_get_block_hash(entry);
+        let block_hash = BlockHashRef::from_ptr(hash_ptr).to_owned();
+        handler.on_background_block_tip(block_hash, verification_progress);
+    }
+}
+
+pub(crate) unsafe extern "C" fn notification_chainstate_verified_wrapper(
+    user_data: *mut c_void,
+    result: btck_ChainstateVerificationResult,
+    message: *const c_char,
+    message_len: usize,
+) {
+    let registry = &*(user_data as *mut NotificationCallbackRegistry);
+    if let Some(ref handler) = registry.chainstate_verified_handler {
+        handler.on_chainstate_verified(result.into(), c_helpers::to_string(message, message_len));
+    }
+}
+
+pub(crate) unsafe extern "C" fn notification_block_connected_stats_wrapper(
+    user_data: *mut c_void,
+    entry: *const btck_BlockTreeEntry,
+    stats: *const btck_ValidationStats,
+) {
+    let registry = &*(user_data as *mut NotificationCallbackRegistry);
+    if let Some(ref handler) = registry.block_connected_stats_handler {
+        let hash_ptr = btck_block_tree_entry_get_block_hash(entry);
+        let block_hash = BlockHashRef::from_ptr(hash_ptr).to_owned();
+        let stats = ValidationStats::from_ptr(btck_validation_stats_copy(stats));
+        handler.on_block_connected_stats(block_hash, stats);
+    }
+}
+
+pub(crate) unsafe extern "C" fn notification_script_checks_wrapper(
+    user_data: *mut c_void,
+    entry: *const btck_BlockTreeEntry,
+    enabled: i32,
+    reason: *const c_char,
+    reason_len: usize,
+) {
+    let registry = &*(user_data as *mut NotificationCallbackRegistry);
+    if let Some(ref handler) = registry.script_checks_handler {
+        let hash_ptr = btck_block_tree_entry_get_block_hash(entry);
+        let block_hash = BlockHashRef::from_ptr(hash_ptr).to_owned();
+        handler.on_script_checks(
+            block_hash,
+            c_helpers::enabled(enabled),
+            c_helpers::to_string(reason, reason_len),
+        );
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use std::sync::{Arc, Mutex};
@@ -315,6 +479,10 @@ mod tests {
         assert!(registry.warning_unset_handler.is_none());
         assert!(registry.flush_error_handler.is_none());
         assert!(registry.fatal_error_handler.is_none());
+        assert!(registry.background_block_tip_handler.is_none());
+        assert!(registry.chainstate_verified_handler.is_none());
+        assert!(registry.block_connected_stats_handler.is_none());
+        assert!(registry.script_checks_handler.is_none());
     }
 
     #[test]
@@ -380,6 +548,18 @@ mod tests {
 
         let fatal_error_handler = |_message| {};
         let _: Box<dyn FatalErrorCallback> = Box::new(fatal_error_handler);
+
+        let background_block_tip_handler = |_hash, _progress| {};
+        let _: Box<dyn BackgroundBlockTipCallback> = Box::new(background_block_tip_handler);
+
+        let chainstate_verified_handler = |_result, _message| {};
+        let _: Box<dyn ChainstateVerifiedCallback> = Box::new(chainstate_verified_handler);
+
+        let block_connected_stats_handler = |_hash, _stats| {};
+        let _: Box<dyn BlockConnectedStatsCallback> = Box::new(block_connected_stats_handler);
+
+        let script_checks_handler = |_hash, _enabled, _reason| {};
+        let _: Box<dyn ScriptChecksCallback> = Box::new(script_checks_handler);
     }
 
     #[test]
@@ -1,8 +1,9 @@
 use std::marker::PhantomData;
 
 use libbitcoinkernel_sys::{
-    btck_BlockValidationResult, btck_BlockValidationState, btck_SynchronizationState,
-    btck_ValidationMode, btck_Warning, btck_block_validation_state_get_block_validation_result,
+    btck_BlockValidationResult, btck_BlockValidationState, btck_ChainstateVerificationResult,
+    btck_MempoolRemovalReason, btck_SynchronizationState, btck_ValidationMode, btck_Warning,
+    btck_block_validation_state_get_block_validation_result,
     btck_block_validation_state_get_validation_mode,
 };
 
@@ -12,9 +13,15 @@ use crate::{
     BTCK_BLOCK_VALIDATION_RESULT_HEADER_LOW_WORK, BTCK_BLOCK_VALIDATION_RESULT_INVALID_HEADER,
     BTCK_BLOCK_VALIDATION_RESULT_INVALID_PREV, BTCK_BLOCK_VALIDATION_RESULT_MISSING_PREV,
     BTCK_BLOCK_VALIDATION_RESULT_MUTATED, BTCK_BLOCK_VALIDATION_RESULT_TIME_FUTURE,
-    BTCK_BLOCK_VALIDATION_RESULT_UNSET, BTCK_SYNCHRONIZATION_STATE_INIT_DOWNLOAD,
-    BTCK_SYNCHRONIZATION_STATE_INIT_REINDEX, BTCK_SYNCHRONIZATION_STATE_POST_INIT,
-    BTCK_VALIDATION_MODE_INTERNAL_ERROR, BTCK_VALIDATION_MODE_INVALID, BTCK_VALIDATION_MODE_VALID,
+    BTCK_BLOCK_VALIDATION_RESULT_UNSET, BTCK_CHAINSTATE_VERIFICATION_RESULT_FAILURE,
+    BTCK_CHAINSTATE_VERIFICATION_RESULT_INSUFFICIENT_DBCACHE,
+    BTCK_CHAINSTATE_VERIFICATION_RESULT_INTERRUPTED, BTCK_CHAINSTATE_VERIFICATION_RESULT_SUCCESS,
+    BTCK_MEMPOOL_REMOVAL_REASON_BLOCK, BTCK_MEMPOOL_REMOVAL_REASON_CONFLICT,
+    BTCK_MEMPOOL_REMOVAL_REASON_EXPIRY, BTCK_MEMPOOL_REMOVAL_REASON_REORG,
+    BTCK_MEMPOOL_REMOVAL_REASON_REPLACED, BTCK_MEMPOOL_REMOVAL_REASON_SIZE_LIMIT,
+    BTCK_SYNCHRONIZATION_STATE_INIT_DOWNLOAD, BTCK_SYNCHRONIZATION_STATE_INIT_REINDEX,
+    BTCK_SYNCHRONIZATION_STATE_POST_INIT, BTCK_VALIDATION_MODE_INTERNAL_ERROR,
+    BTCK_VALIDATION_MODE_INVALID, BTCK_VALIDATION_MODE_VALID,
     BTCK_WARNING_LARGE_WORK_INVALID_CHAIN, BTCK_WARNING_UNKNOWN_NEW_RULES_ACTIVATED,
 };
 
@@ -86,6 +93,45 @@ impl From<btck_Warning> for Warning {
     }
 }
 
+/// Result of verifying the chainstate in the background.
+///
+/// Reported by the chainstate verified notification of a chainstate manager
+/// created with background verification.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+#[repr(u8)]
+pub enum ChainstateVerificationResult {
+    /// The blocks at the tip were verified and the best chain was activated
+    Success = BTCK_CHAINSTATE_VERIFICATION_RESULT_SUCCESS,
+    /// The verification was interrupted through the context
+    Interrupted = BTCK_CHAINSTATE_VERIFICATION_RESULT_INTERRUPTED,
+    /// The databases are corrupted, reindexing may fix this
+    Failure = BTCK_CHAINSTATE_VERIFICATION_RESULT_FAILURE,
+    /// The coins cache is too small to run all checks at the check level
+    InsufficientDbcache = BTCK_CHAINSTATE_VERIFICATION_RESULT_INSUFFICIENT_DBCACHE,
+}
+
+impl From<ChainstateVerificationResult> for btck_ChainstateVerificationResult {
+    fn from(result: ChainstateVerificationResult) -> Self {
+        result as btck_ChainstateVerificationResult
+    }
+}
+
+impl From<btck_ChainstateVerificationResult> for ChainstateVerificationResult {
+    fn from(value: btck_ChainstateVerificationResult) -> Self {
+        match value {
+            BTCK_CHAINSTATE_VERIFICATION_RESULT_SUCCESS => ChainstateVerificationResult::Success,
+            BTCK_CHAINSTATE_VERIFICATION_RESULT_INTERRUPTED => {
+                ChainstateVerificationResult::Interrupted
+            }
+            BTCK_CHAINSTATE_VERIFICATION_RESULT_FAILURE => ChainstateVerificationResult::Failure,
+            BTCK_CHAINSTATE_VERIFICATION_RESULT_INSUFFICIENT_DBCACHE => {
+                ChainstateVerificationResult::InsufficientDbcache
+            }
+            _ => panic!("Unknown chainstate verification result: {}", value),
+        }
+    }
+}
+
 /// Result of data structure validation.
 ///
 /// Indicates whether a validated data structure (block, transaction, etc.)
@@ -168,6 +214,46 @@ impl From<btck_BlockValidationResult> for BlockValidationResult {
     }
 }
 
+/// Reason why a transaction was removed from the mempool.
+///
+/// Reported by the transaction removed from mempool validation callback.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+#[repr(u8)]
+pub enum MempoolRemovalReason {
+    /// The transaction expired from the mempool
+    Expiry = BTCK_MEMPOOL_REMOVAL_REASON_EXPIRY,
+    /// The transaction was evicted to keep the mempool within its size limit
+    SizeLimit = BTCK_MEMPOOL_REMOVAL_REASON_SIZE_LIMIT,
+    /// The transaction was removed during a reorganization
+    Reorg = BTCK_MEMPOOL_REMOVAL_REASON_REORG,
+    /// The transaction was included in a connected block
+    Block = BTCK_MEMPOOL_REMOVAL_REASON_BLOCK,
+    /// The transaction conflicts with a transaction of a connected block
+    Conflict = BTCK_MEMPOOL_REMOVAL_REASON_CONFLICT,
+    /// The transaction was replaced by one paying a higher fee
+    Replaced = BTCK_MEMPOOL_REMOVAL_REASON_REPLACED,
+}
+
+impl From<MempoolRemovalReason> for btck_MempoolRemovalReason {
+    fn from(reason: MempoolRemovalReason) -> Self {
+        reason as btck_MempoolRemovalReason
+    }
+}
+
+impl From<btck_MempoolRemovalReason> for MempoolRemovalReason {
+    fn from(value: btck_MempoolRemovalReason) -> Self {
+        match value {
+            BTCK_MEMPOOL_REMOVAL_REASON_EXPIRY => MempoolRemovalReason::Expiry,
+            BTCK_MEMPOOL_REMOVAL_REASON_SIZE_LIMIT => MempoolRemovalReason::SizeLimit,
+            BTCK_MEMPOOL_REMOVAL_REASON_REORG => MempoolRemovalReason::Reorg,
+            BTCK_MEMPOOL_REMOVAL_REASON_BLOCK => MempoolRemovalReason::Block,
+            BTCK_MEMPOOL_REMOVAL_REASON_CONFLICT => MempoolRemovalReason::Conflict,
+            BTCK_MEMPOOL_REMOVAL_REASON_REPLACED => MempoolRemovalReason::Replaced,
+            _ => panic!("Unknown mempool removal reason: {}", value),
+        }
+    }
+}
+
 pub trait BlockValidationStateExt: AsPtr<btck_BlockValidationState> {
     fn mode(&self) -> ValidationMode {
         unsafe { btck_block_validation_state_get_validation_mode(self.as_ptr()).into() }
@@ -549,4 +635,22 @@ mod tests {
             assert_eq!(result, back);
         }
     }
+
+    #[test]
+    fn test_all_mempool_removal_reasons() {
+        let reasons = [
+            MempoolRemovalReason::Expiry,
+            MempoolRemovalReason::SizeLimit,
+            MempoolRemovalReason::Reorg,
+            MempoolRemovalReason::Block,
+            MempoolRemovalReason::Conflict,
+            MempoolRemovalReason::Replaced,
+        ];
+
+        for reason in reasons {
+            let btck_reason: btck_MempoolRemovalReason = reason.into();
+            let back: MempoolRemovalReason = btck_reason.into();
+            assert_eq!(reason, back);
+        }
+    }
 }
@@ -1,11 +1,14 @@
 use std::ffi::c_void;
 
-use libbitcoinkernel_sys::{btck_Block, btck_BlockTreeEntry, btck_BlockValidationState};
+use libbitcoinkernel_sys::{
+    btck_Block, btck_BlockTreeEntry, btck_BlockValidationState, btck_MempoolRemovalReason,
+    btck_Transaction,
+};
 
 use crate::{
     ffi::sealed::{FromMutPtr, FromPtr},
-    notifications::types::BlockValidationStateRef,
-    Block, BlockTreeEntry,
+    notifications::types::{BlockValidationStateRef, MempoolRemovalReason},
+    Block, BlockTreeEntry, Transaction,
 };
 
 /// Exposes the result after validating a block.
@@ -64,6 +67,43 @@ where
     }
 }
 
+/// Callback for when a transaction is added to the mempool.
+pub trait TransactionAddedToMempoolCallback: Send + Sync {
+    fn on_transaction_added_to_mempool(&self, transaction: Transaction);
+}
+
+impl<F> TransactionAddedToMempoolCallback for F
+where
+    F: Fn(Transaction) + Send + Sync + 'static,
+{
+    fn on_transaction_added_to_mempool(&self, transaction: Transaction) {
+        self(transaction)
+    }
+}
+
+/// Callback for when a transaction is removed from the mempool, including
+/// when it is included in a connected block.
+pub trait TransactionRemovedFromMempoolCallback: Send + Sync {
+    fn on_transaction_removed_from_mempool(
+        &self,
+        transaction: Transaction,
+        reason: MempoolRemovalReason,
+    );
+}
+
+impl<F> TransactionRemovedFromMempoolCallback for F
+where
+    F: Fn(Transaction, MempoolRemovalReason) + Send + Sync + 'static,
+{
+    fn on_transaction_removed_from_mempool(
+        &self,
+        transaction: Transaction,
+        reason: MempoolRemovalReason,
+    ) {
+        self(transaction, reason)
+    }
+}
+
 /// Registry for managing validation interface callback handlers.
 #[derive(Default)]
 pub struct ValidationCallbackRegistry {
@@ -71,6 +111,9 @@ pub struct ValidationCallbackRegistry {
     new_pow_valid_block_handler: Option<Box<dyn NewPoWValidBlockCallback>>,
     block_connected_handler: Option<Box<dyn BlockConnectedCallback>>,
     block_disconnected_handler: Option<Box<dyn BlockDisconnectedCallback>>,
+    transaction_added_to_mempool_handler: Option<Box<dyn TransactionAddedToMempoolCallback>>,
+    transaction_removed_from_mempool_handler:
+        Option<Box<dyn TransactionRemovedFromMempoolCallback>>,
 }
 
 impl ValidationCallbackRegistry {
@@ -111,6 +154,24 @@ impl ValidationCallbackRegistry {
             Some(Box::new(handler) as Box<dyn BlockDisconnectedCallback>);
         self
     }
+
+    pub fn register_transaction_added_to_mempool<T>(&mut self, handler: T) -> &mut Self
+    where
+        T: TransactionAddedToMempoolCallback + 'static,
+    {
+        self.transaction_added_to_mempool_handler =
+            Some(Box::new(handler) as Box<dyn TransactionAddedToMempoolCallback>);
+        self
+    }
+
+    pub fn register_transaction_removed_from_mempool<T>(&mut self, handler: T) -> &mut Self
+    where
+        T: TransactionRemovedFromMempoolCallback + 'static,
+    {
+        self.transaction_removed_from_mempool_handler =
+            Some(Box::new(handler) as Box<dyn TransactionRemovedFromMempoolCallback>);
+        self
+    }
 }
 
 pub(crate) unsafe extern "C" fn validation_user_data_destroy_wrapper(user_data: *mut c_void) {
@@ -180,6 +241,31 @@ pub(crate) unsafe extern "C" fn validation_block_disconnected_wrapper(
     }
 }
 
+pub(crate) unsafe extern "C" fn validation_transaction_added_to_mempool_wrapper(
+    user_data: *mut c_void,
+    transaction: *mut btck_Transaction,
+) {
+    let transaction = Transaction::from_ptr(transaction);
+    let registry = &*(user_data as *mut ValidationCallbackRegistry);
+
+    if let Some(ref handler) = registry.transaction_added_to_mempool_handler {
+        handler.on_transaction_added_to_mempool(transaction);
+    }
+}
+
+pub(crate) unsafe extern "C" fn validation_transaction_removed_from_mempool_wrapper(
+    user_data: *mut c_void,
+    transaction: *mut btck_Transaction,
+    reason: btck_MempoolRemovalReason,
+) {
+    let transaction = Transaction::from_ptr(transaction);
+    let registry = &*(user_data as *mut ValidationCallbackRegistry);
+
+    if let Some(ref handler) = registry.transaction_removed_from_mempool_handler {
+        handler.on_transaction_removed_from_mempool(transaction, reason.into());
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use std::sync::{Arc, Mutex};
@@ -246,6 +332,21 @@ mod tests {
         assert!(registry.new_pow_valid_block_handler.is_none());
         assert!(registry.block_connected_handler.is_none());
         assert!(registry.block_disconnected_handler.is_none());
+        assert!(registry.transaction_added_to_mempool_handler.is_none());
+        assert!(registry.transaction_removed_from_mempool_handler.is_none());
+    }
+
+    #[test]
+    fn test_mempool_transaction_registration() {
+        fn added_handler(_transaction: Transaction) {}
+        fn removed_handler(_transaction: Transaction, _reason: MempoolRemovalReason) {}
+
+        let mut registry = ValidationCallbackRegistry::new();
+        registry
+            .register_transaction_added_to_mempool(added_handler)
+            .register_transaction_removed_from_mempool(removed_handler);
+        assert!(registry.transaction_added_to_mempool_handler.is_some());
+        assert!(registry.transaction_removed_from_mempool_handler.is_some());
     }
 
     #[test]
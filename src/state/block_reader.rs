@@ -0,0 +1,148 @@
+use std::marker::PhantomData;
+use std::ops::RangeInclusive;
+use std::ptr;
+
+use libbitcoinkernel_sys::{
+    btck_Block, btck_BlockReader, btck_BlockSpentOutputs, btck_BlockTreeEntry,
+    btck_block_reader_create, btck_block_reader_destroy, btck_block_reader_next,
+};
+
+use crate::{
+    ffi::{
+        c_helpers,
+        sealed::{AsPtr, FromMutPtr, FromPtr},
+    },
+    Block, BlockSpentOutputs, BlockTreeEntry, KernelError,
+};
+
+use super::ChainstateManager;
+
+/// Default number of threads reading ahead of the caller.
+pub const DEFAULT_BLOCK_READER_THREADS: usize = 4;
+
+/// Default number of blocks held in memory ahead of the caller.
+pub const DEFAULT_BLOCK_READER_MAX_IN_FLIGHT: usize = 16;
+
+/// A block yielded by a [`BlockReader`].
+pub struct ReadBlock<'a> {
+    /// The entry of the block in the block tree.
+    pub entry: BlockTreeEntry<'a>,
+    /// The block read from disk.
+    pub block: Block,
+    /// The block's spent outputs, if the reader was configured to read them.
+    pub spent_outputs: Option<BlockSpentOutputs>,
+}
+
+/// Builder for a [`BlockReader`], created through
+/// [`ChainstateManager::block_reader`].
+pub struct BlockReaderBuilder<'a> {
+    chainman: &'a ChainstateManager,
+    heights: RangeInclusive<i32>,
+    spent_outputs: bool,
+    worker_threads: usize,
+    max_in_flight: usize,
+}
+
+impl<'a> BlockReaderBuilder<'a> {
+    pub(crate) fn new(chainman: &'a ChainstateManager, heights: RangeInclusive<i32>) -> Self {
+        BlockReaderBuilder {
+            chainman,
+            heights,
+            spent_outputs: true,
+            worker_threads: DEFAULT_BLOCK_READER_THREADS,
+            max_in_flight: DEFAULT_BLOCK_READER_MAX_IN_FLIGHT,
+        }
+    }
+
+    /// Whether the spent outputs of each block are read too. Defaults to true.
+    pub fn spent_outputs(mut self, spent_outputs: bool) -> Self {
+        self.spent_outputs = spent_outputs;
+        self
+    }
+
+    /// Set the number of threads reading ahead of the caller. If 0, each
+    /// block is read when it is requested.
+    pub fn worker_threads(mut self, worker_threads: usize) -> Self {
+        self.worker_threads = worker_threads;
+        self
+    }
+
+    /// Set the maximum number of blocks held in memory ahead of the caller.
+    /// Must be non-zero.
+    pub fn max_in_flight(mut self, max_in_flight: usize) -> Self {
+        self.max_in_flight = max_in_flight;
+        self
+    }
+
+    /// Create the [`BlockReader`]. Fails if the height range is not within the
+    /// active chain.
+    pub fn build(self) -> Result<BlockReader<'a>, KernelError> {
+        let worker_threads = i32::try_from(self.worker_threads).map_err(|_| {
+            KernelError::InvalidOptions("Too many block reader threads.".to_string())
+        })?;
+        let inner = unsafe {
+            btck_block_reader_create(
+                self.chainman.as_ptr(),
+                *self.heights.start(),
+                *self.heights.end(),
+                c_helpers::to_c_bool(self.spent_outputs),
+                worker_threads,
+                self.max_in_flight,
+            )
+        };
+        if inner.is_null() {
+            return Err(KernelError::InvalidOptions(
+                "Failed to create block reader.".to_string(),
+            ));
+        }
+        Ok(BlockReader {
+            inner,
+            marker: PhantomData,
+        })
+    }
+}
+
+/// Reads a range of blocks of the active chain on a pool of threads and
+/// yields them in ascending height order.
+///
+/// A block that fails to be read is yielded as an error, after which
+/// iteration continues with the next block.
+pub struct BlockReader<'a> {
+    inner: *mut btck_BlockReader,
+    marker: PhantomData<&'a ChainstateManager>,
+}
+
+unsafe impl Send for BlockReader<'_> {}
+
+impl<'a> Iterator for BlockReader<'a> {
+    type Item = Result<ReadBlock<'a>, KernelError>;
+
+    fn next(&mut self) -> Option<Self::Item> {
+        let mut entry: *const btck_BlockTreeEntry = ptr::null();
+        let mut block: *mut btck_Block = ptr::null_mut();
+        let mut spent_outputs: *mut btck_BlockSpentOutputs = ptr::null_mut();
+        let result = unsafe {
+            btck_block_reader_next(self.inner, &mut entry, &mut block, &mut spent_outputs)
+        };
+        if !c_helpers::success(result) {
+            return Some(Err(KernelError::Internal(
+                "Failed to read block.".to_string(),
+            )));
+        }
+        if block.is_null() {
+            return None;
+        }
+        Some(Ok(ReadBlock {
+            entry: unsafe { BlockTreeEntry::from_ptr(entry) },
+            block: unsafe { Block::from_ptr(block) },
+            spent_outputs: (!spent_outputs.is_null())
+                .then(|| unsafe { BlockSpentOutputs::from_ptr(spent_outputs) }),
+        }))
+    }
+}
+
+impl Drop for BlockReader<'_> {
+    fn drop(&mut self) {
+        unsafe { btck_block_reader_destroy(self.inner) };
+    }
+}
@@ -1,26 +1,56 @@
 use std::ffi::CString;
+use std::ops::RangeInclusive;
+use std::ptr;
 
 use libbitcoinkernel_sys::{
-    btck_BlockHash, btck_ChainstateManager, btck_ChainstateManagerOptions, btck_block_read,
-    btck_block_spent_outputs_read, btck_chainstate_manager_create, btck_chainstate_manager_destroy,
+    btck_BlockHash, btck_ChainstateManager, btck_ChainstateManagerOptions, btck_Coin,
+    btck_TransactionOutPoint, btck_block_read, btck_block_read_raw, btck_block_read_raw_into,
+    btck_block_spent_outputs_read, btck_chainstate_manager_compute_utxo_stats,
+    btck_chainstate_manager_create, btck_chainstate_manager_delete_prune_lock,
+    btck_chainstate_manager_destroy, btck_chainstate_manager_dump_snapshot,
     btck_chainstate_manager_get_active_chain, btck_chainstate_manager_get_block_tree_entry_by_hash,
-    btck_chainstate_manager_import_blocks, btck_chainstate_manager_options_create,
-    btck_chainstate_manager_options_destroy, btck_chainstate_manager_options_set_wipe_dbs,
+    btck_chainstate_manager_get_coins, btck_chainstate_manager_get_mempool,
+    btck_chainstate_manager_get_validation_cache_stats,
+    btck_chainstate_manager_get_validation_stats, btck_chainstate_manager_import_blocks,
+    btck_chainstate_manager_load_snapshot, btck_chainstate_manager_options_create,
+    btck_chainstate_manager_options_destroy,
+    btck_chainstate_manager_options_set_assumed_valid_block,
+    btck_chainstate_manager_options_set_background_coins_flush,
+    btck_chainstate_manager_options_set_background_verification,
+    btck_chainstate_manager_options_set_block_index_snapshot,
+    btck_chainstate_manager_options_set_cache_size,
+    btck_chainstate_manager_options_set_cache_sizes,
+    btck_chainstate_manager_options_set_check_blocks,
+    btck_chainstate_manager_options_set_check_level,
+    btck_chainstate_manager_options_set_compact_coins_cache,
+    btck_chainstate_manager_options_set_fast_prune, btck_chainstate_manager_options_set_mempool,
+    btck_chainstate_manager_options_set_minimum_chain_work,
+    btck_chainstate_manager_options_set_prune_target,
+    btck_chainstate_manager_options_set_require_full_verification,
+    btck_chainstate_manager_options_set_validation_cache_sizes,
+    btck_chainstate_manager_options_set_wipe_dbs,
     btck_chainstate_manager_options_set_worker_threads_num,
     btck_chainstate_manager_options_update_block_tree_db_in_memory,
     btck_chainstate_manager_options_update_chainstate_db_in_memory,
-    btck_chainstate_manager_process_block,
+    btck_chainstate_manager_process_block, btck_chainstate_manager_process_headers,
+    btck_chainstate_manager_prune_to_height, btck_chainstate_manager_resize_caches,
+    btck_chainstate_manager_set_prune_lock, btck_coins_cursor_create,
 };
 
 use crate::{
+    c_serialize,
+    core::TxOutPointExt,
     ffi::{
         c_helpers,
         sealed::{AsPtr, FromMutPtr, FromPtr},
     },
-    Block, BlockHash, BlockSpentOutputs, BlockTreeEntry, KernelError,
+    Block, BlockHash, BlockSpentOutputs, BlockTreeEntry, BlockValidationResult, Coin, KernelError,
 };
 
-use super::{Chain, Context};
+use super::{
+    BlockReaderBuilder, Chain, CoinsCursor, Context, Mempool, UtxoSetHashType, UtxoStats,
+    ValidationCacheStats, ValidationCacheType, ValidationStats,
+};
 
 /// Result of processing a block with the chainstate manager
 #[derive(Debug, Clone, Copy, PartialEq, Eq)]
@@ -50,6 +80,28 @@ impl ProcessBlockResult {
     }
 }
 
+/// Size of a serialized block header in bytes.
+pub const BLOCK_HEADER_SIZE: usize = 80;
+
+/// Result of processing a batch of block headers with
+/// [`ChainstateManager::process_headers`]
+#[derive(Debug)]
+pub struct ProcessHeadersResult<'a> {
+    /// Block tree entry of the last accepted header, or `None` if no header
+    /// was accepted
+    pub last_accepted: Option<BlockTreeEntry<'a>>,
+    /// Why a header was rejected, or [`BlockValidationResult::Unset`] if all
+    /// headers were accepted
+    pub result: BlockValidationResult,
+}
+
+impl ProcessHeadersResult<'_> {
+    /// Returns true if a header was rejected
+    pub fn is_rejected(&self) -> bool {
+        self.result != BlockValidationResult::Unset
+    }
+}
+
 /// The chainstate manager is the central object for doing validation tasks as
 /// well as retrieving data from the chain. Internally it is a complex data
 /// structure with diverse functionality.
@@ -98,6 +150,41 @@ impl ChainstateManager {
         }
     }
 
+    /// Validate a batch of consecutive serialized block headers and add them
+    /// to the block tree, without processing their blocks. The headers are
+    /// validated in order while holding the validation lock once, and
+    /// processing stops at the first rejected header.
+    ///
+    /// Returns [`KernelError::InvalidLength`] if the length of `headers` is not
+    /// a multiple of [`BLOCK_HEADER_SIZE`].
+    pub fn process_headers(&self, headers: &[u8]) -> Result<ProcessHeadersResult<'_>, KernelError> {
+        if headers.len() % BLOCK_HEADER_SIZE != 0 {
+            return Err(KernelError::InvalidLength {
+                expcted: headers.len() - headers.len() % BLOCK_HEADER_SIZE,
+                actual: headers.len(),
+            });
+        }
+        if headers.is_empty() {
+            return Ok(ProcessHeadersResult {
+                last_accepted: None,
+                result: BlockValidationResult::Unset,
+            });
+        }
+        let mut result = BlockValidationResult::Unset.into();
+        let entry = unsafe {
+            btck_chainstate_manager_process_headers(
+                self.inner,
+                headers.as_ptr() as *const std::ffi::c_void,
+                headers.len(),
+                &mut result,
+            )
+        };
+        Ok(ProcessHeadersResult {
+            last_accepted: (!entry.is_null()).then(|| unsafe { BlockTreeEntry::from_ptr(entry) }),
+            result: result.into(),
+        })
+    }
+
     /// May be called after load_chainstate to initialize the
     /// [`ChainstateManager`]. Triggers the start of a reindex if the option was
     /// previously set for the chainstate and block manager. Can also import an
@@ -119,6 +206,115 @@ impl ChainstateManager {
         }
     }
 
+    /// Load an assumeutxo UTXO set snapshot, as written by
+    /// [`ChainstateManager::dump_snapshot`], into a new chainstate that becomes
+    /// the active one. The snapshot's base block header has to be known, and
+    /// its UTXO set hash has to be part of the chain parameters' assumeutxo
+    /// data. The blocks below the snapshot are validated in the background as
+    /// they are processed, reporting their progress through the background
+    /// block tip notification.
+    ///
+    /// # Arguments
+    /// * `path` - Path of the snapshot file
+    pub fn load_snapshot(&self, path: &str) -> Result<(), KernelError> {
+        let c_path = CString::new(path)?;
+        let result = unsafe {
+            btck_chainstate_manager_load_snapshot(
+                self.inner,
+                c_path.as_ptr(),
+                c_path.as_bytes().len(),
+            )
+        };
+        match c_helpers::success(result) {
+            true => Ok(()),
+            false => Err(KernelError::Internal(
+                "Failed to load snapshot.".to_string(),
+            )),
+        }
+    }
+
+    /// Write the UTXO set of the active chainstate at its current tip to a
+    /// snapshot file that can be loaded with
+    /// [`ChainstateManager::load_snapshot`]. Blocks may be processed while the
+    /// coins are written.
+    ///
+    /// # Arguments
+    /// * `path` - Path of the snapshot file, which must not exist yet
+    pub fn dump_snapshot(&self, path: &str) -> Result<(), KernelError> {
+        let c_path = CString::new(path)?;
+        let result = unsafe {
+            btck_chainstate_manager_dump_snapshot(
+                self.inner,
+                c_path.as_ptr(),
+                c_path.as_bytes().len(),
+            )
+        };
+        match c_helpers::success(result) {
+            true => Ok(()),
+            false => Err(KernelError::Internal(
+                "Failed to dump snapshot.".to_string(),
+            )),
+        }
+    }
+
+    /// Create or update a named prune lock. Blocks at and above `height`, and
+    /// a small buffer below it, are not pruned until the lock is updated or
+    /// deleted. This lets a consumer that processes blocks after they were
+    /// connected keep the blocks it has not processed yet. Locks are not
+    /// persisted and have to be set again after the chainstate manager is
+    /// created.
+    ///
+    /// # Arguments
+    /// * `name` - Name identifying the lock
+    /// * `height` - Height of the earliest block to keep, must not be negative
+    pub fn set_prune_lock(&self, name: &str, height: i32) -> Result<(), KernelError> {
+        let c_name = CString::new(name)?;
+        let result = unsafe {
+            btck_chainstate_manager_set_prune_lock(
+                self.inner,
+                c_name.as_ptr(),
+                c_name.as_bytes().len(),
+                height,
+            )
+        };
+        match c_helpers::success(result) {
+            true => Ok(()),
+            false => Err(KernelError::Internal(
+                "Failed to set prune lock.".to_string(),
+            )),
+        }
+    }
+
+    /// Delete a named prune lock set with
+    /// [`ChainstateManager::set_prune_lock`]. Returns false if there was no
+    /// lock with the name.
+    pub fn delete_prune_lock(&self, name: &str) -> Result<bool, KernelError> {
+        let c_name = CString::new(name)?;
+        let result = unsafe {
+            btck_chainstate_manager_delete_prune_lock(
+                self.inner,
+                c_name.as_ptr(),
+                c_name.as_bytes().len(),
+            )
+        };
+        Ok(c_helpers::success(result))
+    }
+
+    /// Delete the block and undo files containing only blocks up to `height`.
+    /// The last 288 blocks and the blocks protected by prune locks are kept.
+    /// Requires pruning to be enabled with
+    /// [`ChainstateManagerOptions::prune_target`] and the chain to be longer
+    /// than the prune-after height of the chain parameters.
+    pub fn prune_to_height(&self, height: i32) -> Result<(), KernelError> {
+        let result = unsafe { btck_chainstate_manager_prune_to_height(self.inner, height) };
+        match c_helpers::success(result) {
+            true => Ok(()),
+            false => Err(KernelError::Internal(
+                "Failed to prune block files.".to_string(),
+            )),
+        }
+    }
+
     /// Read a block from disk by its block tree entry.
     pub fn read_block_data(&self, entry: &BlockTreeEntry) -> Result<Block, KernelError> {
         let inner = unsafe { btck_block_read(self.inner, entry.as_ptr()) };
@@ -128,6 +324,67 @@ impl ChainstateManager {
         Ok(unsafe { Block::from_ptr(inner) })
     }
 
+    /// Read the serialized bytes of a block from disk by its block tree entry,
+    /// without deserializing it.
+    ///
+    /// # Arguments
+    /// * `entry` - The block tree entry of the block to read
+    /// * `check_header` - Whether to check the stored header against the entry's
+    ///   hash and its proof of work
+    pub fn read_block_raw(
+        &self,
+        entry: &BlockTreeEntry,
+        check_header: bool,
+    ) -> Result<Vec<u8>, KernelError> {
+        c_serialize(|callback, user_data| unsafe {
+            btck_block_read_raw(
+                self.inner,
+                entry.as_ptr(),
+                c_helpers::to_c_bool(check_header),
+                Some(callback),
+                user_data,
+            )
+        })
+    }
+
+    /// Read the serialized bytes of a block from disk into a caller provided
+    /// buffer, returning the number of bytes written. If the buffer is too
+    /// small, [`KernelError::InvalidLength`] reports the required size.
+    ///
+    /// # Arguments
+    /// * `entry` - The block tree entry of the block to read
+    /// * `buffer` - The buffer the block is read into
+    /// * `check_header` - Whether to check the stored header against the entry's
+    ///   hash and its proof of work
+    pub fn read_block_raw_into(
+        &self,
+        entry: &BlockTreeEntry,
+        buffer: &mut [u8],
+        check_header: bool,
+    ) -> Result<usize, KernelError> {
+        let mut block_len: usize = 0;
+        let result = unsafe {
+            btck_block_read_raw_into(
+                self.inner,
+                entry.as_ptr(),
+                c_helpers::to_c_bool(check_header),
+                buffer.as_mut_ptr() as *mut std::ffi::c_void,
+                buffer.len(),
+                &mut block_len,
+            )
+        };
+        if c_helpers::success(result) {
+            Ok(block_len)
+        } else if block_len > buffer.len() {
+            Err(KernelError::InvalidLength {
+                expcted: block_len,
+                actual: buffer.len(),
+            })
+        } else {
+            Err(KernelError::Internal("Failed to read block.".to_string()))
+        }
+    }
+
     /// Read a block's spent outputs data from disk by its block tree entry.
     pub fn read_spent_outputs(
         &self,
@@ -142,6 +399,147 @@ impl ChainstateManager {
         Ok(unsafe { BlockSpentOutputs::from_ptr(inner) })
     }
 
+    /// Resize the coins database cache and the in-memory coins cache at
+    /// runtime. Shrinking the in-memory cache below its current usage flushes
+    /// the chainstate to disk.
+    ///
+    /// # Arguments
+    /// * `coins_db_bytes` - New cache size of the coins database, must be non-zero
+    /// * `coins_bytes` - New size of the in-memory coins cache, must be non-zero
+    pub fn resize_caches(
+        &self,
+        coins_db_bytes: usize,
+        coins_bytes: usize,
+    ) -> Result<(), KernelError> {
+        let result = unsafe {
+            btck_chainstate_manager_resize_caches(self.inner, coins_db_bytes, coins_bytes)
+        };
+        match c_helpers::success(result) {
+            true => Ok(()),
+            false => Err(KernelError::Internal(
+                "Failed to resize coins caches.".to_string(),
+            )),
+        }
+    }
+
+    /// Create a builder for a [`crate::state::BlockReader`] that reads the
+    /// blocks of the active chain within the given height range on a pool of
+    /// threads, yielding them in height order.
+    pub fn block_reader(&self, heights: RangeInclusive<i32>) -> BlockReaderBuilder<'_> {
+        BlockReaderBuilder::new(self, heights)
+    }
+
+    /// Create a [`CoinsCursor`] over the coins (UTXO set) of the active
+    /// chainstate, split into `shards` shards that can be iterated
+    /// concurrently. The in-memory coins cache is flushed to disk first.
+    ///
+    /// The caches cannot be resized while the cursor exists.
+    ///
+    /// # Arguments
+    /// * `shards` - Number of shards, between 1 and 65536
+    pub fn coins_cursor(&self, shards: usize) -> Result<CoinsCursor<'_>, KernelError> {
+        let inner = unsafe { btck_coins_cursor_create(self.inner, shards) };
+        if inner.is_null() {
+            return Err(KernelError::Internal(
+                "Failed to create coins cursor.".to_string(),
+            ));
+        }
+        Ok(unsafe { CoinsCursor::from_raw(inner, shards) })
+    }
+
+    /// Look up the unspent coins of a batch of outpoints in the active
+    /// chainstate, holding the chainstate lock once for the whole batch.
+    /// Coins that are not in the in-memory cache are read from the coins
+    /// database in key order, without being added to the cache.
+    ///
+    /// Returns a coin for each outpoint, in the same order, which is `None` if
+    /// the outpoint is spent or does not exist.
+    pub fn get_coins<T: TxOutPointExt>(
+        &self,
+        outpoints: &[T],
+    ) -> Result<Vec<Option<Coin>>, KernelError> {
+        let c_outpoints: Vec<*const btck_TransactionOutPoint> =
+            outpoints.iter().map(|outpoint| outpoint.as_ptr()).collect();
+        let mut c_coins: Vec<*mut btck_Coin> = vec![ptr::null_mut(); outpoints.len()];
+        let result = unsafe {
+            btck_chainstate_manager_get_coins(
+                self.inner,
+                c_outpoints.as_ptr(),
+                c_outpoints.len(),
+                c_coins.as_mut_ptr(),
+            )
+        };
+        if !c_helpers::success(result) {
+            return Err(KernelError::Internal(
+                "Failed to look up coins.".to_string(),
+            ));
+        }
+        Ok(c_coins
+            .into_iter()
+            .map(|coin| (!coin.is_null()).then(|| unsafe { Coin::from_ptr(coin) }))
+            .collect())
+    }
+
+    /// Compute statistics about the coins (UTXO set) of the active
+    /// chainstate, including a hash of the given type committing to them.
+    /// The in-memory coins cache is flushed to disk first, and blocks are not
+    /// processed until the statistics are computed.
+    ///
+    /// # Arguments
+    /// * `hash_type` - The hash to compute over the coins
+    /// * `worker_threads` - Number of threads the coins are read and hashed
+    ///   on in parallel. If 0, everything runs on the calling thread.
+    pub fn compute_utxo_stats(
+        &self,
+        hash_type: UtxoSetHashType,
+        worker_threads: usize,
+    ) -> Result<UtxoStats, KernelError> {
+        let worker_threads = i32::try_from(worker_threads)
+            .map_err(|_| KernelError::InvalidOptions("Too many worker threads.".to_string()))?;
+        let inner = unsafe {
+            btck_chainstate_manager_compute_utxo_stats(self.inner, hash_type.into(), worker_threads)
+        };
+        if inner.is_null() {
+            return Err(KernelError::Internal(
+                "Failed to compute UTXO set statistics.".to_string(),
+            ));
+        }
+        Ok(unsafe { UtxoStats::from_ptr(inner) })
+    }
+
+    /// Returns the totals of the validation timers and counters over all
+    /// blocks connected so far. The statistics of single blocks are passed to
+    /// the [`BlockConnectedStatsCallback`](crate::BlockConnectedStatsCallback)
+    /// notification.
+    pub fn validation_stats(&self) -> ValidationStats {
+        unsafe {
+            ValidationStats::from_ptr(btck_chainstate_manager_get_validation_stats(self.inner))
+        }
+    }
+
+    /// Returns the hit, miss, insert and eviction counters of one of the
+    /// caches of successful validations. The counters are read while
+    /// validation may be running, so they are not necessarily consistent
+    /// with each other.
+    pub fn validation_cache_stats(&self, cache_type: ValidationCacheType) -> ValidationCacheStats {
+        unsafe {
+            ValidationCacheStats::from_ptr(btck_chainstate_manager_get_validation_cache_stats(
+                self.inner,
+                cache_type.into(),
+            ))
+        }
+    }
+
+    /// Returns the mempool of the chainstate manager, or `None` if it was
+    /// created without one, see [`ChainstateManagerOptions::mempool`].
+    pub fn mempool(&self) -> Option<Mempool<'_>> {
+        let ptr = unsafe { btck_chainstate_manager_get_mempool(self.inner) };
+        if ptr.is_null() {
+            return None;
+        }
+        Some(unsafe { Mempool::from_ptr(ptr) })
+    }
+
     pub fn active_chain(&self) -> Chain<'_> {
         let ptr = unsafe { btck_chainstate_manager_get_active_chain(self.inner) };
         unsafe { Chain::from_ptr(ptr) }
@@ -162,6 +560,12 @@ impl ChainstateManager {
     }
 }
 
+impl AsPtr<btck_ChainstateManager> for ChainstateManager {
+    fn as_ptr(&self) -> *const btck_ChainstateManager {
+        self.inner as *const _
+    }
+}
+
 impl Drop for ChainstateManager {
     fn drop(&mut self) {
         unsafe {
@@ -201,7 +605,9 @@ impl ChainstateManagerOptions {
         Ok(Self { inner })
     }
 
-    /// Set the number of worker threads used by script validation
+    /// Set the number of worker threads used by script validation, for
+    /// fetching the coins spent by a block before connecting it and for
+    /// deserializing blocks when importing block files
     pub fn worker_threads(self, worker_threads: i32) -> Self {
         unsafe {
             btck_chainstate_manager_options_set_worker_threads_num(self.inner, worker_threads);
@@ -223,6 +629,150 @@ impl ChainstateManagerOptions {
         self
     }
 
+    /// Set the total memory budget in bytes for the block tree db, the
+    /// chainstate db and the in-memory coins cache. The budget is split the
+    /// same way as the default of 450MiB.
+    pub fn cache_size(self, total_cache_bytes: usize) -> Self {
+        unsafe {
+            btck_chainstate_manager_options_set_cache_size(self.inner, total_cache_bytes);
+        }
+        self
+    }
+
+    /// Set the cache size in bytes of each component individually. This
+    /// overrides a previously set total budget. The coins db and coins cache
+    /// sizes must be non-zero.
+    pub fn cache_sizes(
+        self,
+        block_tree_db_bytes: usize,
+        coins_db_bytes: usize,
+        coins_bytes: usize,
+    ) -> Result<Self, KernelError> {
+        let result = unsafe {
+            btck_chainstate_manager_options_set_cache_sizes(
+                self.inner,
+                block_tree_db_bytes,
+                coins_db_bytes,
+                coins_bytes,
+            )
+        };
+        match c_helpers::success(result) {
+            true => Ok(self),
+            false => Err(KernelError::InvalidOptions(
+                "Coins db and coins cache sizes must be non-zero.".to_string(),
+            )),
+        }
+    }
+
+    /// Set the sizes in bytes of the caches of successful signature and
+    /// script validations. Transactions accepted to the mempool populate the
+    /// caches, so their scripts don't have to be checked again when the block
+    /// containing them is connected. Defaults to 16MiB each.
+    pub fn validation_cache_sizes(
+        self,
+        signature_cache_bytes: usize,
+        script_execution_cache_bytes: usize,
+    ) -> Self {
+        unsafe {
+            btck_chainstate_manager_options_set_validation_cache_sizes(
+                self.inner,
+                signature_cache_bytes,
+                script_execution_cache_bytes,
+            );
+        }
+        self
+    }
+
+    /// Set the block whose ancestors are assumed to have valid scripts. The
+    /// scripts of its ancestors are not verified once the best known header
+    /// has at least the minimum chain work and buries them by more than two
+    /// weeks of work. All other checks are still done. If `None`, the scripts
+    /// of all blocks are verified. Defaults to the assumed valid block of the
+    /// chain parameters.
+    pub fn assumed_valid_block(self, block_hash: Option<&BlockHash>) -> Self {
+        let block_hash = block_hash.map_or(ptr::null(), |block_hash| block_hash.as_ptr());
+        unsafe {
+            btck_chainstate_manager_options_set_assumed_valid_block(self.inner, block_hash);
+        }
+        self
+    }
+
+    /// Set the minimum chain work a chain needs before its blocks are
+    /// accepted during the initial block download and before script
+    /// verification is skipped below the assumed valid block. The work is
+    /// given in little-endian byte order, like the bytes of a block hash.
+    /// Defaults to the minimum chain work of the chain parameters.
+    pub fn minimum_chain_work(self, minimum_chain_work: [u8; 32]) -> Self {
+        unsafe {
+            btck_chainstate_manager_options_set_minimum_chain_work(
+                self.inner,
+                minimum_chain_work.as_ptr(),
+            );
+        }
+        self
+    }
+
+    /// Write the coins cache to the coins database on a background thread
+    /// when it is flushed, so blocks can be processed while the coins are
+    /// written. Flushes for pruning or that make the database hold the coins
+    /// of the tip still wait for the write. The memory used may temporarily
+    /// exceed the coins cache size by the size of the previous flush.
+    /// Defaults to false.
+    pub fn background_coins_flush(self, background_coins_flush: bool) -> Self {
+        unsafe {
+            btck_chainstate_manager_options_set_background_coins_flush(
+                self.inner,
+                c_helpers::to_c_bool(background_coins_flush),
+            );
+        }
+        self
+    }
+
+    /// Use half of the coins cache memory to keep coins in the compressed
+    /// form they are stored in on disk. Coins read from or written to the
+    /// coins database are kept there, so they can be read again without going
+    /// to disk, and more of the UTXO set fits in memory. The rest of the coins
+    /// cache is flushed twice as often. Defaults to false.
+    pub fn compact_coins_cache(self, compact_coins_cache: bool) -> Self {
+        unsafe {
+            btck_chainstate_manager_options_set_compact_coins_cache(
+                self.inner,
+                c_helpers::to_c_bool(compact_coins_cache),
+            );
+        }
+        self
+    }
+
+    /// Enable pruning of old block and undo files once they use more than
+    /// `prune_target_bytes` of disk space. The target must be at least 550MiB.
+    /// With `u64::MAX`, blocks are only pruned through
+    /// [`ChainstateManager::prune_to_height`]. A target of zero disables
+    /// pruning, which is the default.
+    pub fn prune_target(self, prune_target_bytes: u64) -> Result<Self, KernelError> {
+        let result = unsafe {
+            btck_chainstate_manager_options_set_prune_target(self.inner, prune_target_bytes)
+        };
+        match c_helpers::success(result) {
+            true => Ok(self),
+            false => Err(KernelError::InvalidOptions(
+                "Prune target must be at least 550MiB.".to_string(),
+            )),
+        }
+    }
+
+    /// Use small block files of 64KiB instead of 128MiB ones, so that a short
+    /// chain spans several files that can be pruned. Meant for testing.
+    /// Defaults to false.
+    pub fn fast_prune(self, fast_prune: bool) -> Self {
+        unsafe {
+            btck_chainstate_manager_options_set_fast_prune(
+                self.inner,
+                c_helpers::to_c_bool(fast_prune),
+            );
+        }
+        self
+    }
+
     /// Run the block tree db in-memory only. No database files will be written to disk.
     pub fn block_tree_db_in_memory(self, block_tree_db_in_memory: bool) -> Self {
         unsafe {
@@ -244,6 +794,83 @@ impl ChainstateManagerOptions {
         }
         self
     }
+
+    /// Set the number of blocks at the tip that are verified when the
+    /// chainstate manager is created. If 0 or larger than the height of the
+    /// chain, all blocks are verified. Defaults to 6.
+    pub fn check_blocks(self, check_blocks: i64) -> Self {
+        unsafe {
+            btck_chainstate_manager_options_set_check_blocks(self.inner, check_blocks);
+        }
+        self
+    }
+
+    /// Set how thoroughly the blocks at the tip are verified, between 0 (only
+    /// read them) and 4 (disconnect and reconnect them). Defaults to 3.
+    pub fn check_level(self, check_level: i32) -> Result<Self, KernelError> {
+        let result =
+            unsafe { btck_chainstate_manager_options_set_check_level(self.inner, check_level) };
+        match c_helpers::success(result) {
+            true => Ok(self),
+            false => Err(KernelError::InvalidOptions(
+                "Check level must be between 0 and 4.".to_string(),
+            )),
+        }
+    }
+
+    /// Require all checks at the check level to succeed. If disabled, checks
+    /// that need a larger coins cache than configured are skipped. Enabled by
+    /// default.
+    pub fn require_full_verification(self, require_full_verification: bool) -> Self {
+        unsafe {
+            btck_chainstate_manager_options_set_require_full_verification(
+                self.inner,
+                c_helpers::to_c_bool(require_full_verification),
+            );
+        }
+        self
+    }
+
+    /// Verify the chainstate on a background thread. The chainstate manager
+    /// is returned once the chainstate is loaded, and the result of the
+    /// verification is reported through the chainstate verified notification
+    /// registered on the [`Context`]. Until then, calls that access the
+    /// chainstate wait for the verification to finish.
+    pub fn background_verification(self, background_verification: bool) -> Self {
+        unsafe {
+            btck_chainstate_manager_options_set_background_verification(
+                self.inner,
+                c_helpers::to_c_bool(background_verification),
+            );
+        }
+        self
+    }
+
+    /// Write the block index to a flat file next to the block tree db when
+    /// the chainstate manager is dropped, and load it from there when the
+    /// next one is created, which is faster than reading it from the db. The
+    /// file is only used if the block index did not change since it was
+    /// written.
+    pub fn block_index_snapshot(self, block_index_snapshot: bool) -> Self {
+        unsafe {
+            btck_chainstate_manager_options_set_block_index_snapshot(
+                self.inner,
+                c_helpers::to_c_bool(block_index_snapshot),
+            );
+        }
+        self
+    }
+
+    /// Create a mempool together with the chainstate manager, which can be
+    /// retrieved through [`ChainstateManager::mempool`]. Transactions in the
+    /// mempool are removed when they are included in a connected block. The
+    /// mempool is not persisted when the chainstate manager is dropped.
+    pub fn mempool(self, mempool: bool) -> Self {
+        unsafe {
+            btck_chainstate_manager_options_set_mempool(self.inner, c_helpers::to_c_bool(mempool));
+        }
+        self
+    }
 }
 
 impl Drop for ChainstateManagerOptions {
@@ -310,6 +937,28 @@ mod tests {
         assert!(chainman.is_ok());
     }
 
+    #[test]
+    fn test_chainstate_manager_cache_sizes() {
+        let context = create_test_context();
+        let (_temp_dir, data_dir, blocks_dir) = create_test_dirs();
+
+        let opts = ChainstateManagerOptions::new(&context, &data_dir, &blocks_dir)
+            .unwrap()
+            .cache_size(16 << 20);
+        assert!(matches!(
+            opts.cache_sizes(1 << 20, 0, 4 << 20),
+            Err(KernelError::InvalidOptions(_))
+        ));
+
+        let opts = ChainstateManagerOptions::new(&context, &data_dir, &blocks_dir)
+            .unwrap()
+            .cache_sizes(1 << 20, 1 << 20, 4 << 20)
+            .unwrap();
+        let chainman = ChainstateManager::new(opts).unwrap();
+        assert!(chainman.resize_caches(2 << 20, 8 << 20).is_ok());
+        assert!(chainman.resize_caches(2 << 20, 0).is_err());
+    }
+
     #[test]
     fn test_process_block_result_new_block() {
         let result = ProcessBlockResult::NewBlock;
@@ -0,0 +1,157 @@
+use std::collections::VecDeque;
+use std::marker::PhantomData;
+use std::ptr;
+
+use libbitcoinkernel_sys::{
+    btck_Coin, btck_CoinsCursor, btck_TransactionOutPoint, btck_coins_cursor_destroy,
+    btck_coins_cursor_get_block_hash, btck_coins_cursor_next,
+};
+
+use crate::{
+    ffi::{c_helpers, sealed::FromMutPtr},
+    BlockHash, Coin, KernelError, TxOutPoint,
+};
+
+use super::ChainstateManager;
+
+/// Number of coins read from the kernel at once by a [`CoinsShard`].
+pub const COINS_CURSOR_BATCH_SIZE: usize = 256;
+
+/// A cursor over the coins (UTXO set) of the chainstate, created through
+/// [`ChainstateManager::coins_cursor`].
+///
+/// The coins are read as of the tip at the time the cursor was created, and
+/// are split into shards of disjoint ranges of txids. Each shard can be
+/// iterated on its own thread.
+pub struct CoinsCursor<'a> {
+    inner: *mut btck_CoinsCursor,
+    shard_count: usize,
+    marker: PhantomData<&'a ChainstateManager>,
+}
+
+unsafe impl Send for CoinsCursor<'_> {}
+unsafe impl Sync for CoinsCursor<'_> {}
+
+impl<'a> CoinsCursor<'a> {
+    pub(crate) unsafe fn from_raw(inner: *mut btck_CoinsCursor, shard_count: usize) -> Self {
+        CoinsCursor {
+            inner,
+            shard_count,
+            marker: PhantomData,
+        }
+    }
+
+    /// Returns the number of shards of the cursor.
+    pub fn shard_count(&self) -> usize {
+        self.shard_count
+    }
+
+    /// Returns the hash of the block up to which the coins are current.
+    pub fn block_hash(&self) -> BlockHash {
+        unsafe { BlockHash::from_ptr(btck_coins_cursor_get_block_hash(self.inner)) }
+    }
+
+    /// Returns an iterator over the coins of a shard. The position within the
+    /// shard is kept by the cursor, so a shard's coins are only yielded once,
+    /// even if several iterators are created for it.
+    ///
+    /// Returns [`KernelError::OutOfBounds`] if the index is invalid.
+    pub fn shard(&self, index: usize) -> Result<CoinsShard<'_>, KernelError> {
+        if index >= self.shard_count {
+            return Err(KernelError::OutOfBounds);
+        }
+        Ok(CoinsShard {
+            inner: self.inner,
+            index,
+            outpoints: vec![ptr::null_mut(); COINS_CURSOR_BATCH_SIZE],
+            coins: vec![ptr::null_mut(); COINS_CURSOR_BATCH_SIZE],
+            buffer: VecDeque::with_capacity(COINS_CURSOR_BATCH_SIZE),
+            done: false,
+            marker: PhantomData,
+        })
+    }
+
+    /// Returns an iterator over the shards of the cursor.
+    pub fn shards(&self) -> impl Iterator<Item = CoinsShard<'_>> {
+        (0..self.shard_count).map(|index| self.shard(index).unwrap())
+    }
+
+    /// Returns an iterator over the coins of all shards, one shard after the
+    /// other.
+    pub fn iter(&self) -> impl Iterator<Item = Result<(TxOutPoint, Coin), KernelError>> + '_ {
+        self.shards().flatten()
+    }
+}
+
+impl Drop for CoinsCursor<'_> {
+    fn drop(&mut self) {
+        unsafe { btck_coins_cursor_destroy(self.inner) };
+    }
+}
+
+/// Iterates over the coins of one shard of a [`CoinsCursor`] in database
+/// order, reading them from the kernel in batches.
+///
+/// A failure to read the coins is yielded as an error, after which iteration
+/// ends.
+pub struct CoinsShard<'c> {
+    inner: *mut btck_CoinsCursor,
+    index: usize,
+    outpoints: Vec<*mut btck_TransactionOutPoint>,
+    coins: Vec<*mut btck_Coin>,
+    buffer: VecDeque<(TxOutPoint, Coin)>,
+    done: bool,
+    marker: PhantomData<&'c ()>,
+}
+
+unsafe impl Send for CoinsShard<'_> {}
+
+impl CoinsShard<'_> {
+    /// Returns the index of the shard.
+    pub fn index(&self) -> usize {
+        self.index
+    }
+}
+
+impl Iterator for CoinsShard<'_> {
+    type Item = Result<(TxOutPoint, Coin), KernelError>;
+
+    fn next(&mut self) -> Option<Self::Item> {
+        if let Some(coin) = self.buffer.pop_front() {
+            return Some(Ok(coin));
+        }
+        if self.done {
+            return None;
+        }
+        let mut count: usize = 0;
+        let result = unsafe {
+            btck_coins_cursor_next(
+                self.inner,
+                self.index,
+                self.outpoints.as_mut_ptr(),
+                self.coins.as_mut_ptr(),
+                COINS_CURSOR_BATCH_SIZE,
+                &mut count,
+            )
+        };
+        if !c_helpers::success(result) {
+            self.done = true;
+            return Some(Err(KernelError::Internal(
+                "Failed to read coins.".to_string(),
+            )));
+        }
+        if count == 0 {
+            self.done = true;
+            return None;
+        }
+        for i in 0..count {
+            self.buffer.push_back(unsafe {
+                (
+                    TxOutPoint::from_ptr(self.outpoints[i]),
+                    Coin::from_ptr(self.coins[i]),
+                )
+            });
+        }
+        self.buffer.pop_front().map(Ok)
+    }
+}
@@ -7,25 +7,33 @@ use libbitcoinkernel_sys::{
     btck_context_destroy, btck_context_interrupt, btck_context_options_create,
     btck_context_options_destroy, btck_context_options_set_chainparams,
     btck_context_options_set_notifications, btck_context_options_set_validation_interface,
+    btck_context_options_set_validation_interface_queue_depth,
+    btck_context_sync_validation_interface_queue,
 };
 
 use crate::{
     ffi::c_helpers,
     notifications::{
         notification::{
-            notification_block_tip_wrapper, notification_fatal_error_wrapper,
-            notification_flush_error_wrapper, notification_header_tip_wrapper,
-            notification_progress_wrapper, notification_user_data_destroy_wrapper,
-            notification_warning_set_wrapper, notification_warning_unset_wrapper, BlockTipCallback,
-            FatalErrorCallback, FlushErrorCallback, HeaderTipCallback,
-            NotificationCallbackRegistry, ProgressCallback, WarningSetCallback,
-            WarningUnsetCallback,
+            notification_background_block_tip_wrapper, notification_block_connected_stats_wrapper,
+            notification_block_tip_wrapper, notification_chainstate_verified_wrapper,
+            notification_fatal_error_wrapper, notification_flush_error_wrapper,
+            notification_header_tip_wrapper, notification_progress_wrapper,
+            notification_script_checks_wrapper, notification_user_data_destroy_wrapper,
+            notification_warning_set_wrapper, notification_warning_unset_wrapper,
+            BackgroundBlockTipCallback, BlockConnectedStatsCallback, BlockTipCallback,
+            ChainstateVerifiedCallback, FatalErrorCallback, FlushErrorCallback, HeaderTipCallback,
+            NotificationCallbackRegistry, ProgressCallback, ScriptChecksCallback,
+            WarningSetCallback, WarningUnsetCallback,
         },
         validation::{
             validation_block_checked_wrapper, validation_block_connected_wrapper,
             validation_block_disconnected_wrapper, validation_new_pow_valid_block_wrapper,
+            validation_transaction_added_to_mempool_wrapper,
+            validation_transaction_removed_from_mempool_wrapper,
             validation_user_data_destroy_wrapper, BlockCheckedCallback, BlockConnectedCallback,
-            BlockDisconnectedCallback, NewPoWValidBlockCallback, ValidationCallbackRegistry,
+            BlockDisconnectedCallback, NewPoWValidBlockCallback, TransactionAddedToMempoolCallback,
+            TransactionRemovedFromMempoolCallback, ValidationCallbackRegistry,
         },
     },
     KernelError, BTCK_CHAIN_TYPE_MAINNET, BTCK_CHAIN_TYPE_REGTEST, BTCK_CHAIN_TYPE_SIGNET,
@@ -80,6 +88,14 @@ impl Context {
         }
     }
 
+    /// Blocks until all validation callbacks queued before this call have
+    /// been delivered. Only has an effect if the context was built with a
+    /// non-zero [`ContextBuilder::validation_queue_depth`]. Must not be called
+    /// from within a validation callback.
+    pub fn sync_validation_queue(&self) {
+        unsafe { btck_context_sync_validation_interface_queue(self.inner) };
+    }
+
     pub fn as_ptr(&self) -> *mut btck_Context {
         self.inner
     }
@@ -152,6 +168,10 @@ impl ContextBuilder {
                 warning_unset: Some(notification_warning_unset_wrapper),
                 flush_error: Some(notification_flush_error_wrapper),
                 fatal_error: Some(notification_fatal_error_wrapper),
+                background_block_tip: Some(notification_background_block_tip_wrapper),
+                chainstate_verified: Some(notification_chainstate_verified_wrapper),
+                block_connected_stats: Some(notification_block_connected_stats_wrapper),
+                script_checks: Some(notification_script_checks_wrapper),
             };
             btck_context_options_set_notifications(self.inner, holder);
         }
@@ -167,6 +187,10 @@ impl ContextBuilder {
                 pow_valid_block: Some(validation_new_pow_valid_block_wrapper),
                 block_connected: Some(validation_block_connected_wrapper),
                 block_disconnected: Some(validation_block_disconnected_wrapper),
+                transaction_added_to_mempool: Some(validation_transaction_added_to_mempool_wrapper),
+                transaction_removed_from_mempool: Some(
+                    validation_transaction_removed_from_mempool_wrapper,
+                ),
             };
             btck_context_options_set_validation_interface(self.inner, holder);
         }
@@ -179,6 +203,17 @@ impl ContextBuilder {
         self
     }
 
+    /// Deliver block connected and disconnected validation callbacks
+    /// asynchronously on a dedicated thread, so slow handlers do not stall
+    /// block connection until more than `queue_depth` callbacks are pending.
+    /// A depth of 0, the default, runs the callbacks on the validating thread.
+    pub fn validation_queue_depth(self, queue_depth: usize) -> ContextBuilder {
+        unsafe {
+            btck_context_options_set_validation_interface_queue_depth(self.inner, queue_depth)
+        };
+        self
+    }
+
     pub fn with_block_tip_notification<T>(mut self, handler: T) -> Self
     where
         T: BlockTipCallback + 'static,
@@ -242,6 +277,42 @@ impl ContextBuilder {
         self
     }
 
+    pub fn with_background_block_tip_notification<T>(mut self, handler: T) -> Self
+    where
+        T: BackgroundBlockTipCallback + 'static,
+    {
+        self.get_or_create_notification_registry()
+            .register_background_block_tip(handler);
+        self
+    }
+
+    pub fn with_chainstate_verified_notification<T>(mut self, handler: T) -> Self
+    where
+        T: ChainstateVerifiedCallback + 'static,
+    {
+        self.get_or_create_notification_registry()
+            .register_chainstate_verified(handler);
+        self
+    }
+
+    pub fn with_block_connected_stats_notification<T>(mut self, handler: T) -> Self
+    where
+        T: BlockConnectedStatsCallback + 'static,
+    {
+        self.get_or_create_notification_registry()
+            .register_block_connected_stats(handler);
+        self
+    }
+
+    pub fn with_script_checks_notification<T>(mut self, handler: T) -> Self
+    where
+        T: ScriptChecksCallback + 'static,
+    {
+        self.get_or_create_notification_registry()
+            .register_script_checks(handler);
+        self
+    }
+
     pub fn notifications<F>(mut self, configure: F) -> Self
     where
         F: FnOnce(&mut NotificationCallbackRegistry),
@@ -294,6 +365,24 @@ impl ContextBuilder {
         self
     }
 
+    pub fn with_transaction_added_to_mempool<T>(mut self, handler: T) -> Self
+    where
+        T: TransactionAddedToMempoolCallback + 'static,
+    {
+        self.get_or_create_validation_registry()
+            .register_transaction_added_to_mempool(handler);
+        self
+    }
+
+    pub fn with_transaction_removed_from_mempool<T>(mut self, handler: T) -> Self
+    where
+        T: TransactionRemovedFromMempoolCallback + 'static,
+    {
+        self.get_or_create_validation_registry()
+            .register_transaction_removed_from_mempool(handler);
+        self
+    }
+
     pub fn validation<F>(mut self, configure: F) -> Self
     where
         F: FnOnce(&mut ValidationCallbackRegistry),
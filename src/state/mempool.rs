@@ -0,0 +1,240 @@
+use std::marker::PhantomData;
+
+use libbitcoinkernel_sys::{
+    btck_Mempool, btck_MempoolAcceptStatus, btck_Transaction, btck_TxValidationResult,
+    btck_mempool_accept_package, btck_mempool_accept_transactions, btck_mempool_contains,
+    btck_mempool_size,
+};
+
+use crate::{
+    core::{TransactionExt, TxidExt},
+    ffi::{
+        c_helpers,
+        sealed::{AsPtr, FromMutPtr},
+        BTCK_MEMPOOL_ACCEPT_STATUS_ACCEPTED, BTCK_MEMPOOL_ACCEPT_STATUS_ALREADY_IN_MEMPOOL,
+        BTCK_MEMPOOL_ACCEPT_STATUS_NOT_PROCESSED, BTCK_MEMPOOL_ACCEPT_STATUS_REJECTED,
+        BTCK_TX_VALIDATION_RESULT_CONFLICT, BTCK_TX_VALIDATION_RESULT_CONSENSUS,
+        BTCK_TX_VALIDATION_RESULT_INPUTS_NOT_STANDARD, BTCK_TX_VALIDATION_RESULT_MEMPOOL_POLICY,
+        BTCK_TX_VALIDATION_RESULT_MISSING_INPUTS, BTCK_TX_VALIDATION_RESULT_NOT_STANDARD,
+        BTCK_TX_VALIDATION_RESULT_NO_MEMPOOL, BTCK_TX_VALIDATION_RESULT_PREMATURE_SPEND,
+        BTCK_TX_VALIDATION_RESULT_RECONSIDERABLE, BTCK_TX_VALIDATION_RESULT_UNKNOWN,
+        BTCK_TX_VALIDATION_RESULT_UNSET, BTCK_TX_VALIDATION_RESULT_WITNESS_MUTATED,
+        BTCK_TX_VALIDATION_RESULT_WITNESS_STRIPPED,
+    },
+};
+
+use super::ChainstateManager;
+
+/// Whether a transaction submitted to the mempool was accepted.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+#[repr(u8)]
+pub enum MempoolAcceptStatus {
+    /// The transaction is valid and was added to the mempool, or would have
+    /// been if it was only test accepted
+    Accepted = BTCK_MEMPOOL_ACCEPT_STATUS_ACCEPTED,
+    /// The transaction, or one with the same txid, is already in the mempool
+    AlreadyInMempool = BTCK_MEMPOOL_ACCEPT_STATUS_ALREADY_IN_MEMPOOL,
+    /// The transaction is invalid or does not meet the mempool policy
+    Rejected = BTCK_MEMPOOL_ACCEPT_STATUS_REJECTED,
+    /// The transaction was not validated, because its package was rejected
+    NotProcessed = BTCK_MEMPOOL_ACCEPT_STATUS_NOT_PROCESSED,
+}
+
+impl From<btck_MempoolAcceptStatus> for MempoolAcceptStatus {
+    fn from(value: btck_MempoolAcceptStatus) -> Self {
+        match value {
+            BTCK_MEMPOOL_ACCEPT_STATUS_ACCEPTED => MempoolAcceptStatus::Accepted,
+            BTCK_MEMPOOL_ACCEPT_STATUS_ALREADY_IN_MEMPOOL => MempoolAcceptStatus::AlreadyInMempool,
+            BTCK_MEMPOOL_ACCEPT_STATUS_REJECTED => MempoolAcceptStatus::Rejected,
+            BTCK_MEMPOOL_ACCEPT_STATUS_NOT_PROCESSED => MempoolAcceptStatus::NotProcessed,
+            _ => panic!("Unknown mempool accept status: {}", value),
+        }
+    }
+}
+
+/// Reason why a transaction was rejected by the mempool.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+#[repr(u32)]
+pub enum TxValidationResult {
+    /// Initial value - transaction has not been rejected
+    Unset = BTCK_TX_VALIDATION_RESULT_UNSET,
+    /// Invalid by consensus rules
+    Consensus = BTCK_TX_VALIDATION_RESULT_CONSENSUS,
+    /// Inputs failed the policy rules
+    InputsNotStandard = BTCK_TX_VALIDATION_RESULT_INPUTS_NOT_STANDARD,
+    /// Otherwise didn't meet the policy rules
+    NotStandard = BTCK_TX_VALIDATION_RESULT_NOT_STANDARD,
+    /// Some of the inputs are missing
+    MissingInputs = BTCK_TX_VALIDATION_RESULT_MISSING_INPUTS,
+    /// Spends a coinbase too early, or violates locktime or sequence locks
+    PrematureSpend = BTCK_TX_VALIDATION_RESULT_PREMATURE_SPEND,
+    /// Witness is non-standard, or present prior to segwit activation
+    WitnessMutated = BTCK_TX_VALIDATION_RESULT_WITNESS_MUTATED,
+    /// Transaction is missing a witness
+    WitnessStripped = BTCK_TX_VALIDATION_RESULT_WITNESS_STRIPPED,
+    /// Already known, or conflicts with a transaction in the chain
+    Conflict = BTCK_TX_VALIDATION_RESULT_CONFLICT,
+    /// Violated the fee, size, descendant or replacement limits of the mempool
+    MempoolPolicy = BTCK_TX_VALIDATION_RESULT_MEMPOOL_POLICY,
+    /// There is no mempool to validate the transaction against
+    NoMempool = BTCK_TX_VALIDATION_RESULT_NO_MEMPOOL,
+    /// Fails some policy, but might be acceptable in a different package
+    Reconsiderable = BTCK_TX_VALIDATION_RESULT_RECONSIDERABLE,
+    /// Not validated, because its package failed
+    Unknown = BTCK_TX_VALIDATION_RESULT_UNKNOWN,
+}
+
+impl From<btck_TxValidationResult> for TxValidationResult {
+    fn from(value: btck_TxValidationResult) -> Self {
+        match value {
+            BTCK_TX_VALIDATION_RESULT_UNSET => TxValidationResult::Unset,
+            BTCK_TX_VALIDATION_RESULT_CONSENSUS => TxValidationResult::Consensus,
+            BTCK_TX_VALIDATION_RESULT_INPUTS_NOT_STANDARD => TxValidationResult::InputsNotStandard,
+            BTCK_TX_VALIDATION_RESULT_NOT_STANDARD => TxValidationResult::NotStandard,
+            BTCK_TX_VALIDATION_RESULT_MISSING_INPUTS => TxValidationResult::MissingInputs,
+            BTCK_TX_VALIDATION_RESULT_PREMATURE_SPEND => TxValidationResult::PrematureSpend,
+            BTCK_TX_VALIDATION_RESULT_WITNESS_MUTATED => TxValidationResult::WitnessMutated,
+            BTCK_TX_VALIDATION_RESULT_WITNESS_STRIPPED => TxValidationResult::WitnessStripped,
+            BTCK_TX_VALIDATION_RESULT_CONFLICT => TxValidationResult::Conflict,
+            BTCK_TX_VALIDATION_RESULT_MEMPOOL_POLICY => TxValidationResult::MempoolPolicy,
+            BTCK_TX_VALIDATION_RESULT_NO_MEMPOOL => TxValidationResult::NoMempool,
+            BTCK_TX_VALIDATION_RESULT_RECONSIDERABLE => TxValidationResult::Reconsiderable,
+            BTCK_TX_VALIDATION_RESULT_UNKNOWN => TxValidationResult::Unknown,
+            _ => panic!("Unknown transaction validation result: {}", value),
+        }
+    }
+}
+
+/// Outcome of submitting a single transaction to the mempool.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct MempoolAcceptResult {
+    /// Whether the transaction was accepted
+    pub status: MempoolAcceptStatus,
+    /// Why the transaction was rejected, or [`TxValidationResult::Unset`]
+    pub result: TxValidationResult,
+}
+
+impl MempoolAcceptResult {
+    /// Returns true if the transaction was accepted or is already in the
+    /// mempool
+    pub fn is_accepted(&self) -> bool {
+        matches!(
+            self.status,
+            MempoolAcceptStatus::Accepted | MempoolAcceptStatus::AlreadyInMempool
+        )
+    }
+}
+
+type AcceptFn = unsafe extern "C" fn(
+    *mut btck_Mempool,
+    *const *const btck_Transaction,
+    usize,
+    i32,
+    *mut btck_MempoolAcceptStatus,
+    *mut btck_TxValidationResult,
+) -> i32;
+
+/// The transaction memory pool of a [`ChainstateManager`], created if
+/// [`ChainstateManagerOptions::mempool`](crate::ChainstateManagerOptions::mempool)
+/// is set.
+///
+/// Transactions are validated against the active chainstate and the policy
+/// rules of the mempool before they are added to it. Added and removed
+/// transactions are announced through the validation interface.
+pub struct Mempool<'a> {
+    inner: *mut btck_Mempool,
+    marker: PhantomData<&'a ChainstateManager>,
+}
+
+unsafe impl Send for Mempool<'_> {}
+unsafe impl Sync for Mempool<'_> {}
+
+impl<'a> Mempool<'a> {
+    fn accept<T: TransactionExt>(
+        &self,
+        accept_fn: AcceptFn,
+        transactions: &[T],
+        test_accept: bool,
+    ) -> Vec<MempoolAcceptResult> {
+        let c_transactions: Vec<*const btck_Transaction> =
+            transactions.iter().map(|tx| tx.as_ptr()).collect();
+        let mut statuses = vec![BTCK_MEMPOOL_ACCEPT_STATUS_NOT_PROCESSED; transactions.len()];
+        let mut results = vec![BTCK_TX_VALIDATION_RESULT_UNKNOWN; transactions.len()];
+        unsafe {
+            accept_fn(
+                self.inner,
+                c_transactions.as_ptr(),
+                c_transactions.len(),
+                c_helpers::to_c_bool(test_accept),
+                statuses.as_mut_ptr(),
+                results.as_mut_ptr(),
+            );
+        }
+        statuses
+            .into_iter()
+            .zip(results)
+            .map(|(status, result)| MempoolAcceptResult {
+                status: status.into(),
+                result: result.into(),
+            })
+            .collect()
+    }
+
+    /// Validate a batch of transactions and add the valid ones to the
+    /// mempool. The batch is validated under a single acquisition of the
+    /// validation lock, in order, so a transaction may spend the outputs of
+    /// one accepted before it, unless `test_accept` is set.
+    ///
+    /// # Arguments
+    /// * `transactions` - The transactions to submit
+    /// * `test_accept` - If true, the transactions are only validated
+    ///
+    /// # Returns
+    /// One result per transaction, in the same order.
+    pub fn accept_transactions<T: TransactionExt>(
+        &self,
+        transactions: &[T],
+        test_accept: bool,
+    ) -> Vec<MempoolAcceptResult> {
+        self.accept(btck_mempool_accept_transactions, transactions, test_accept)
+    }
+
+    /// Validate a package of related transactions, sorted topologically,
+    /// and add it to the mempool. A child can pay for parents below the
+    /// minimum fee rate. To be added, the package has to consist of a child
+    /// and its parents.
+    ///
+    /// # Arguments
+    /// * `transactions` - The transactions of the package, must not be empty
+    /// * `test_accept` - If true, the package is only validated
+    ///
+    /// # Returns
+    /// One result per transaction, in the same order. Transactions that were
+    /// not validated are reported as [`MempoolAcceptStatus::NotProcessed`].
+    pub fn accept_package<T: TransactionExt>(
+        &self,
+        transactions: &[T],
+        test_accept: bool,
+    ) -> Vec<MempoolAcceptResult> {
+        self.accept(btck_mempool_accept_package, transactions, test_accept)
+    }
+
+    /// Returns the number of transactions in the mempool.
+    pub fn size(&self) -> usize {
+        unsafe { btck_mempool_size(self.inner) }
+    }
+
+    /// Checks if the transaction with the given txid is in the mempool.
+    pub fn contains(&self, txid: &impl TxidExt) -> bool {
+        c_helpers::present(unsafe { btck_mempool_contains(self.inner, txid.as_ptr()) })
+    }
+}
+
+impl<'a> FromMutPtr<btck_Mempool> for Mempool<'a> {
+    unsafe fn from_ptr(ptr: *mut btck_Mempool) -> Self {
+        Mempool {
+            inner: ptr,
+            marker: PhantomData,
+        }
+    }
+}
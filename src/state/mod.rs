@@ -1,7 +1,21 @@
+pub mod block_reader;
 pub mod chain;
 pub mod chainstate;
+pub mod coins_cursor;
 pub mod context;
+pub mod mempool;
+pub mod utxo_stats;
+pub mod validation_cache_stats;
+pub mod validation_stats;
 
+pub use block_reader::{BlockReader, BlockReaderBuilder, ReadBlock};
 pub use chain::{Chain, ChainIterator};
-pub use chainstate::{ChainstateManager, ChainstateManagerOptions};
+pub use chainstate::{
+    ChainstateManager, ChainstateManagerOptions, ProcessHeadersResult, BLOCK_HEADER_SIZE,
+};
+pub use coins_cursor::{CoinsCursor, CoinsShard};
 pub use context::{ChainParams, ChainType, Context, ContextBuilder};
+pub use mempool::{Mempool, MempoolAcceptResult, MempoolAcceptStatus, TxValidationResult};
+pub use utxo_stats::{UtxoSetHashType, UtxoStats};
+pub use validation_cache_stats::{ValidationCacheStats, ValidationCacheType};
+pub use validation_stats::{ValidationPhase, ValidationStats};
@@ -0,0 +1,108 @@
+use libbitcoinkernel_sys::{
+    btck_UtxoSetHashType, btck_UtxoStats, btck_utxo_stats_copy, btck_utxo_stats_destroy,
+    btck_utxo_stats_get_block_hash, btck_utxo_stats_get_coins_count, btck_utxo_stats_get_hash,
+    btck_utxo_stats_get_height, btck_utxo_stats_get_total_amount,
+    btck_utxo_stats_get_transaction_count,
+};
+
+use crate::{
+    ffi::{
+        sealed::{AsPtr, FromMutPtr},
+        BTCK_UTXO_SET_HASH_TYPE_HASH_SERIALIZED, BTCK_UTXO_SET_HASH_TYPE_MUHASH,
+        BTCK_UTXO_SET_HASH_TYPE_NONE,
+    },
+    BlockHash,
+};
+
+/// The hash computed over the coins by
+/// [`ChainstateManager::compute_utxo_stats`](crate::ChainstateManager::compute_utxo_stats).
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+#[repr(u8)]
+pub enum UtxoSetHashType {
+    /// SHA256 of the serialized coins, as committed to by assumeutxo. Always
+    /// computed on a single thread, since it depends on the order of the coins.
+    HashSerialized = BTCK_UTXO_SET_HASH_TYPE_HASH_SERIALIZED,
+    /// MuHash3072 of the coins, which does not depend on their order
+    MuHash = BTCK_UTXO_SET_HASH_TYPE_MUHASH,
+    /// No hash, only the other statistics are computed
+    None = BTCK_UTXO_SET_HASH_TYPE_NONE,
+}
+
+impl From<UtxoSetHashType> for btck_UtxoSetHashType {
+    fn from(hash_type: UtxoSetHashType) -> Self {
+        hash_type as btck_UtxoSetHashType
+    }
+}
+
+/// Statistics about the coins (UTXO set) of the chainstate, including a hash
+/// committing to them.
+#[derive(Debug)]
+pub struct UtxoStats {
+    inner: *mut btck_UtxoStats,
+}
+
+unsafe impl Send for UtxoStats {}
+unsafe impl Sync for UtxoStats {}
+
+impl UtxoStats {
+    /// Returns the height of the block up to which the statistics were computed.
+    pub fn height(&self) -> i32 {
+        unsafe { btck_utxo_stats_get_height(self.inner) }
+    }
+
+    /// Returns the hash of the block up to which the statistics were computed.
+    pub fn block_hash(&self) -> BlockHash {
+        unsafe { BlockHash::from_ptr(btck_utxo_stats_get_block_hash(self.inner)) }
+    }
+
+    /// Returns the hash over the coins, of the type the statistics were
+    /// computed with. All zeros for [`UtxoSetHashType::None`].
+    pub fn hash(&self) -> [u8; 32] {
+        let mut hash = [0u8; 32];
+        unsafe { btck_utxo_stats_get_hash(self.inner, hash.as_mut_ptr()) };
+        hash
+    }
+
+    /// Returns the number of unspent coins.
+    pub fn coins_count(&self) -> u64 {
+        unsafe { btck_utxo_stats_get_coins_count(self.inner) }
+    }
+
+    /// Returns the number of transactions with unspent coins.
+    pub fn transaction_count(&self) -> u64 {
+        unsafe { btck_utxo_stats_get_transaction_count(self.inner) }
+    }
+
+    /// Returns the total amount of the unspent coins in satoshis, or `None`
+    /// if it overflowed.
+    pub fn total_amount(&self) -> Option<i64> {
+        let amount = unsafe { btck_utxo_stats_get_total_amount(self.inner) };
+        (amount >= 0).then_some(amount)
+    }
+}
+
+impl AsPtr<btck_UtxoStats> for UtxoStats {
+    fn as_ptr(&self) -> *const btck_UtxoStats {
+        self.inner as *const _
+    }
+}
+
+impl FromMutPtr<btck_UtxoStats> for UtxoStats {
+    unsafe fn from_ptr(ptr: *mut btck_UtxoStats) -> Self {
+        UtxoStats { inner: ptr }
+    }
+}
+
+impl Clone for UtxoStats {
+    fn clone(&self) -> Self {
+        UtxoStats {
+            inner: unsafe { btck_utxo_stats_copy(self.inner) },
+        }
+    }
+}
+
+impl Drop for UtxoStats {
+    fn drop(&mut self) {
+        unsafe { btck_utxo_stats_destroy(self.inner) }
+    }
+}
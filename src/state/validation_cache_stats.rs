@@ -0,0 +1,90 @@
+use libbitcoinkernel_sys::{
+    btck_ValidationCacheStats, btck_ValidationCacheType, btck_validation_cache_stats_copy,
+    btck_validation_cache_stats_destroy, btck_validation_cache_stats_get_evictions,
+    btck_validation_cache_stats_get_hits, btck_validation_cache_stats_get_inserts,
+    btck_validation_cache_stats_get_misses,
+};
+
+use crate::ffi::{
+    sealed::{AsPtr, FromMutPtr},
+    BTCK_VALIDATION_CACHE_TYPE_SCRIPT_EXECUTION, BTCK_VALIDATION_CACHE_TYPE_SIGNATURE,
+};
+
+/// The caches of successful validations kept by a
+/// [`ChainstateManager`](crate::ChainstateManager).
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+#[repr(u8)]
+pub enum ValidationCacheType {
+    /// Valid signatures, keyed by signature hash, public key and signature
+    Signature = BTCK_VALIDATION_CACHE_TYPE_SIGNATURE,
+    /// Transactions whose scripts passed with a set of script verification
+    /// flags
+    ScriptExecution = BTCK_VALIDATION_CACHE_TYPE_SCRIPT_EXECUTION,
+}
+
+impl From<ValidationCacheType> for btck_ValidationCacheType {
+    fn from(cache_type: ValidationCacheType) -> Self {
+        cache_type as btck_ValidationCacheType
+    }
+}
+
+/// A snapshot of the counters of one of the validation caches, see
+/// [`ChainstateManager::validation_cache_stats`](crate::ChainstateManager::validation_cache_stats).
+#[derive(Debug)]
+pub struct ValidationCacheStats {
+    inner: *mut btck_ValidationCacheStats,
+}
+
+unsafe impl Send for ValidationCacheStats {}
+unsafe impl Sync for ValidationCacheStats {}
+
+impl ValidationCacheStats {
+    /// Returns the number of lookups that found their entry in the cache.
+    pub fn hits(&self) -> u64 {
+        unsafe { btck_validation_cache_stats_get_hits(self.inner) }
+    }
+
+    /// Returns the number of lookups that did not find their entry in the
+    /// cache.
+    pub fn misses(&self) -> u64 {
+        unsafe { btck_validation_cache_stats_get_misses(self.inner) }
+    }
+
+    /// Returns the number of entries added to the cache.
+    pub fn inserts(&self) -> u64 {
+        unsafe { btck_validation_cache_stats_get_inserts(self.inner) }
+    }
+
+    /// Returns the number of entries dropped from the cache to make room for
+    /// new ones. A high number relative to the inserts means the cache is
+    /// too small.
+    pub fn evictions(&self) -> u64 {
+        unsafe { btck_validation_cache_stats_get_evictions(self.inner) }
+    }
+}
+
+impl AsPtr<btck_ValidationCacheStats> for ValidationCacheStats {
+    fn as_ptr(&self) -> *const btck_ValidationCacheStats {
+        self.inner as *const _
+    }
+}
+
+impl FromMutPtr<btck_ValidationCacheStats> for ValidationCacheStats {
+    unsafe fn from_ptr(ptr: *mut btck_ValidationCacheStats) -> Self {
+        ValidationCacheStats { inner: ptr }
+    }
+}
+
+impl Clone for ValidationCacheStats {
+    fn clone(&self) -> Self {
+        ValidationCacheStats {
+            inner: unsafe { btck_validation_cache_stats_copy(self.inner) },
+        }
+    }
+}
+
+impl Drop for ValidationCacheStats {
+    fn drop(&mut self) {
+        unsafe { btck_validation_cache_stats_destroy(self.inner) }
+    }
+}
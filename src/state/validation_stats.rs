@@ -0,0 +1,120 @@
+use std::time::Duration;
+
+use libbitcoinkernel_sys::{
+    btck_ValidationPhase, btck_ValidationStats, btck_validation_stats_copy,
+    btck_validation_stats_destroy, btck_validation_stats_get_block_count,
+    btck_validation_stats_get_input_count, btck_validation_stats_get_sigops_cost,
+    btck_validation_stats_get_time, btck_validation_stats_get_transaction_count,
+};
+
+use crate::ffi::{
+    sealed::{AsPtr, FromMutPtr},
+    BTCK_VALIDATION_PHASE_CHECK_BLOCK, BTCK_VALIDATION_PHASE_CONNECT_BLOCK,
+    BTCK_VALIDATION_PHASE_CONNECT_TRANSACTIONS, BTCK_VALIDATION_PHASE_FLUSH_VIEW,
+    BTCK_VALIDATION_PHASE_FORK_CHECKS, BTCK_VALIDATION_PHASE_LOAD_BLOCK,
+    BTCK_VALIDATION_PHASE_POST_CONNECT, BTCK_VALIDATION_PHASE_TOTAL, BTCK_VALIDATION_PHASE_VERIFY,
+    BTCK_VALIDATION_PHASE_WRITE_CHAINSTATE, BTCK_VALIDATION_PHASE_WRITE_INDEX,
+    BTCK_VALIDATION_PHASE_WRITE_UNDO,
+};
+
+/// A phase of connecting a block to the chain.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+#[repr(u8)]
+pub enum ValidationPhase {
+    /// Reading the block from disk, if it was not passed in
+    LoadBlock = BTCK_VALIDATION_PHASE_LOAD_BLOCK,
+    /// Context-free checks of the block and the assumevalid lookup
+    CheckBlock = BTCK_VALIDATION_PHASE_CHECK_BLOCK,
+    /// BIP30 and deployment checks
+    ForkChecks = BTCK_VALIDATION_PHASE_FORK_CHECKS,
+    /// Spending the inputs and queueing the script checks
+    ConnectTransactions = BTCK_VALIDATION_PHASE_CONNECT_TRANSACTIONS,
+    /// Connecting the transactions and waiting for the script checks
+    Verify = BTCK_VALIDATION_PHASE_VERIFY,
+    /// Writing the undo data
+    WriteUndo = BTCK_VALIDATION_PHASE_WRITE_UNDO,
+    /// Updating the block index
+    WriteIndex = BTCK_VALIDATION_PHASE_WRITE_INDEX,
+    /// All of the checks and writes above
+    ConnectBlock = BTCK_VALIDATION_PHASE_CONNECT_BLOCK,
+    /// Flushing the block's coins into the coins cache
+    FlushView = BTCK_VALIDATION_PHASE_FLUSH_VIEW,
+    /// Flushing the chainstate to disk, if needed
+    WriteChainstate = BTCK_VALIDATION_PHASE_WRITE_CHAINSTATE,
+    /// Updating the mempool and the chain tip
+    PostConnect = BTCK_VALIDATION_PHASE_POST_CONNECT,
+    /// All of the phases
+    Total = BTCK_VALIDATION_PHASE_TOTAL,
+}
+
+impl From<ValidationPhase> for btck_ValidationPhase {
+    fn from(phase: ValidationPhase) -> Self {
+        phase as btck_ValidationPhase
+    }
+}
+
+/// The time spent in the phases of connecting blocks and the work done while
+/// connecting them, either for a single block or the totals of a
+/// [`ChainstateManager`](crate::ChainstateManager).
+#[derive(Debug)]
+pub struct ValidationStats {
+    inner: *mut btck_ValidationStats,
+}
+
+unsafe impl Send for ValidationStats {}
+unsafe impl Sync for ValidationStats {}
+
+impl ValidationStats {
+    /// Returns the time spent in the given phase, with microsecond precision.
+    pub fn time(&self, phase: ValidationPhase) -> Duration {
+        let micros = unsafe { btck_validation_stats_get_time(self.inner, phase.into()) };
+        Duration::from_micros(micros.max(0) as u64)
+    }
+
+    /// Returns the number of blocks the statistics cover, including blocks
+    /// that were only checked and not connected.
+    pub fn block_count(&self) -> i64 {
+        unsafe { btck_validation_stats_get_block_count(self.inner) }
+    }
+
+    /// Returns the number of connected transactions.
+    pub fn transaction_count(&self) -> i64 {
+        unsafe { btck_validation_stats_get_transaction_count(self.inner) }
+    }
+
+    /// Returns the number of spent inputs, including the coinbase inputs.
+    pub fn input_count(&self) -> i64 {
+        unsafe { btck_validation_stats_get_input_count(self.inner) }
+    }
+
+    /// Returns the signature operations cost of the connected transactions.
+    pub fn sigops_cost(&self) -> i64 {
+        unsafe { btck_validation_stats_get_sigops_cost(self.inner) }
+    }
+}
+
+impl AsPtr<btck_ValidationStats> for ValidationStats {
+    fn as_ptr(&self) -> *const btck_ValidationStats {
+        self.inner as *const _
+    }
+}
+
+impl FromMutPtr<btck_ValidationStats> for ValidationStats {
+    unsafe fn from_ptr(ptr: *mut btck_ValidationStats) -> Self {
+        ValidationStats { inner: ptr }
+    }
+}
+
+impl Clone for ValidationStats {
+    fn clone(&self) -> Self {
+        ValidationStats {
+            inner: unsafe { btck_validation_stats_copy(self.inner) },
+        }
+    }
+}
+
+impl Drop for ValidationStats {
+    fn drop(&mut self) {
+        unsafe { btck_validation_stats_destroy(self.inner) }
+    }
+}
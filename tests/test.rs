@@ -3,15 +3,19 @@ mod tests {
     use bitcoin::consensus::deserialize;
     use bitcoinkernel::notifications::types::BlockValidationStateRef;
     use bitcoinkernel::{
-        prelude::*, verify, Block, BlockHash, BlockSpentOutputs, BlockTreeEntry, ChainParams,
-        ChainType, ChainstateManager, ChainstateManagerOptions, Coin, Context, ContextBuilder,
-        KernelError, Log, Logger, ScriptPubkey, ScriptVerifyError, Transaction,
-        TransactionSpentOutputs, TxOut, TxOutRef, VERIFY_ALL_PRE_TAPROOT, VERIFY_TAPROOT,
-        VERIFY_WITNESS,
+        prelude::*, verify, verify_all_inputs, verify_transactions, Block, BlockHash,
+        BlockSpentOutputs, BlockTreeEntry, BlockValidationResult, ChainParams, ChainType,
+        ChainstateManager, ChainstateManagerOptions, ChainstateVerificationResult, Coin, Context,
+        ContextBuilder, KernelError, Log, Logger, MempoolAcceptStatus, MempoolRemovalReason,
+        ScriptPubkey, ScriptVerifyError, Transaction, TransactionSpentOutputs, TxOut, TxOutPoint,
+        TxOutRef, TxValidationResult, Txid, UtxoSetHashType, ValidationCacheType, ValidationPhase,
+        ValidationStats, BLOCK_HEADER_SIZE, VERIFY_ALL_PRE_TAPROOT, VERIFY_TAPROOT, VERIFY_WITNESS,
     };
+    use std::collections::BTreeMap;
     use std::fs::File;
     use std::io::{BufRead, BufReader};
-    use std::sync::{Arc, Once};
+    use std::sync::atomic::{AtomicUsize, Ordering};
+    use std::sync::{mpsc, Arc, Mutex, Once};
     use tempdir::TempDir;
 
     struct TestLog {}
@@ -266,6 +270,572 @@ mod tests {
         }
     }
 
+    #[test]
+    fn test_read_block_raw() {
+        let (context, data_dir) = testing_setup();
+        let chainman = setup_chainman_with_blocks(&context, &data_dir);
+        let block_data = read_block_data();
+
+        let tip = chainman.active_chain().tip();
+        let raw_tip = chainman.read_block_raw(&tip, true).unwrap();
+        assert_eq!(&raw_tip, block_data.last().unwrap());
+        let unchecked = chainman.read_block_raw(&tip, false).unwrap();
+        assert_eq!(raw_tip, unchecked);
+
+        let mut small = vec![0u8; 10];
+        match chainman.read_block_raw_into(&tip, &mut small, true) {
+            Err(KernelError::InvalidLength { expcted, actual }) => {
+                assert_eq!(expcted, raw_tip.len());
+                assert_eq!(actual, 10);
+            }
+            other => panic!("unexpected result: {:?}", other),
+        }
+
+        let mut buffer = vec![0u8; raw_tip.len() + 16];
+        let len = chainman
+            .read_block_raw_into(&tip, &mut buffer, true)
+            .unwrap();
+        assert_eq!(&buffer[..len], raw_tip.as_slice());
+    }
+
+    #[test]
+    fn test_block_reader() {
+        let (context, data_dir) = testing_setup();
+        let chainman = setup_chainman_with_blocks(&context, &data_dir);
+        let block_data = read_block_data();
+        let tip_height = chainman.active_chain().height();
+
+        for worker_threads in [0, 3] {
+            let reader = chainman
+                .block_reader(1..=tip_height)
+                .worker_threads(worker_threads)
+                .max_in_flight(4)
+                .build()
+                .unwrap();
+            let mut count = 0;
+            for (index, read_block) in reader.enumerate() {
+                let read_block = read_block.unwrap();
+                assert_eq!(read_block.entry.height(), index as i32 + 1);
+                let raw_block: Vec<u8> = read_block.block.consensus_encode().unwrap();
+                assert_eq!(raw_block, block_data[index]);
+                let spent_outputs = read_block.spent_outputs.unwrap();
+                assert_eq!(
+                    spent_outputs.count(),
+                    read_block.block.transaction_count() - 1
+                );
+                count += 1;
+            }
+            assert_eq!(count, block_data.len());
+        }
+
+        let mut reader = chainman
+            .block_reader(0..=0)
+            .spent_outputs(false)
+            .build()
+            .unwrap();
+        assert!(reader.next().unwrap().unwrap().spent_outputs.is_none());
+        assert!(reader.next().is_none());
+
+        assert!(chainman.block_reader(0..=tip_height + 1).build().is_err());
+    }
+
+    #[test]
+    fn test_coins_cursor() {
+        let (context, data_dir) = testing_setup();
+        let chainman = setup_chainman_with_blocks(&context, &data_dir);
+        let tip_height = chainman.active_chain().height();
+
+        let collect = |shard: bitcoinkernel::CoinsShard| {
+            shard
+                .map(|item| {
+                    let (outpoint, coin) = item.unwrap();
+                    assert!(coin.confirmation_height() <= tip_height as u32);
+                    (
+                        (outpoint.txid().to_bytes(), outpoint.index()),
+                        coin.output().value(),
+                    )
+                })
+                .collect::<Vec<_>>()
+        };
+
+        let cursor = chainman.coins_cursor(1).unwrap();
+        assert_eq!(
+            cursor.block_hash().to_bytes(),
+            chainman.active_chain().tip().block_hash().to_bytes()
+        );
+        assert!(chainman.resize_caches(1 << 20, 1 << 20).is_err());
+        assert!(matches!(cursor.shard(1), Err(KernelError::OutOfBounds)));
+        let coins: BTreeMap<_, _> = collect(cursor.shard(0).unwrap()).into_iter().collect();
+        assert!(!coins.is_empty());
+        drop(cursor);
+
+        let cursor = chainman.coins_cursor(4).unwrap();
+        let sharded: BTreeMap<_, _> = std::thread::scope(|s| {
+            let handles: Vec<_> = cursor
+                .shards()
+                .map(|shard| s.spawn(move || collect(shard)))
+                .collect();
+            handles
+                .into_iter()
+                .flat_map(|handle| handle.join().unwrap())
+                .collect()
+        });
+        assert_eq!(sharded, coins);
+        // The shards are exhausted.
+        assert_eq!(cursor.iter().count(), 0);
+        drop(cursor);
+
+        let cursor = chainman.coins_cursor(3).unwrap();
+        assert_eq!(cursor.iter().count(), coins.len());
+        drop(cursor);
+
+        assert!(chainman.coins_cursor(0).is_err());
+        assert!(chainman.resize_caches(1 << 20, 1 << 20).is_ok());
+    }
+
+    #[test]
+    fn test_get_coins() {
+        let (context, data_dir) = testing_setup();
+        let chainman = setup_chainman_with_blocks(&context, &data_dir);
+
+        let cursor = chainman.coins_cursor(1).unwrap();
+        let coins: BTreeMap<_, _> = cursor
+            .iter()
+            .map(|item| {
+                let (outpoint, coin) = item.unwrap();
+                (
+                    (outpoint.txid().to_bytes(), outpoint.index()),
+                    coin.output().value(),
+                )
+            })
+            .collect();
+        drop(cursor);
+
+        // An outpoint spent by a transaction in the chain.
+        let spent = chainman
+            .active_chain()
+            .iter()
+            .find_map(|entry| {
+                let block = chainman.read_block_data(&entry).unwrap();
+                block.transactions().nth(1).map(|tx| {
+                    let input = tx.input(0).unwrap();
+                    let outpoint = input.outpoint();
+                    TxOutPoint::new(&outpoint.txid(), outpoint.index()).unwrap()
+                })
+            })
+            .unwrap();
+
+        let mut outpoints: Vec<TxOutPoint> = coins
+            .keys()
+            .rev()
+            .map(|(txid, index)| TxOutPoint::new(&Txid::from(*txid), *index).unwrap())
+            .collect();
+        outpoints.push(spent);
+        outpoints.push(TxOutPoint::new(&Txid::from([0u8; 32]), 0).unwrap());
+
+        let looked_up = chainman.get_coins(&outpoints).unwrap();
+        assert_eq!(looked_up.len(), outpoints.len());
+        for (coin, value) in looked_up.iter().zip(coins.values().rev()) {
+            assert_eq!(coin.as_ref().unwrap().output().value(), *value);
+        }
+        assert!(looked_up[coins.len()].is_none());
+        assert!(looked_up[coins.len() + 1].is_none());
+
+        assert!(chainman.get_coins::<TxOutPoint>(&[]).unwrap().is_empty());
+        assert!(matches!(
+            Txid::new(&[0u8; 31]),
+            Err(KernelError::InvalidLength { .. })
+        ));
+    }
+
+    #[test]
+    fn test_utxo_stats() {
+        let (context, data_dir) = testing_setup();
+        let chainman = setup_chainman_with_blocks(&context, &data_dir);
+        let tip = chainman.active_chain().tip();
+
+        let cursor = chainman.coins_cursor(1).unwrap();
+        let coins: Vec<_> = cursor.iter().map(|item| item.unwrap()).collect();
+        drop(cursor);
+        let total_amount: i64 = coins.iter().map(|(_, coin)| coin.output().value()).sum();
+
+        for hash_type in [
+            UtxoSetHashType::HashSerialized,
+            UtxoSetHashType::MuHash,
+            UtxoSetHashType::None,
+        ] {
+            let stats = chainman.compute_utxo_stats(hash_type, 0).unwrap();
+            assert_eq!(stats.height(), tip.height());
+            assert_eq!(stats.block_hash().to_bytes(), tip.block_hash().to_bytes());
+            assert_eq!(stats.coins_count(), coins.len() as u64);
+            assert!(stats.transaction_count() <= stats.coins_count());
+            assert_eq!(stats.total_amount(), Some(total_amount));
+            assert_eq!(
+                stats.hash() == [0u8; 32],
+                hash_type == UtxoSetHashType::None
+            );
+
+            let parallel = chainman.compute_utxo_stats(hash_type, 4).unwrap();
+            assert_eq!(parallel.hash(), stats.hash());
+            assert_eq!(parallel.coins_count(), stats.coins_count());
+            assert_eq!(parallel.transaction_count(), stats.transaction_count());
+            assert_eq!(parallel.clone().total_amount(), stats.total_amount());
+        }
+    }
+
+    #[test]
+    fn test_validation_stats() {
+        let (_, data_dir) = testing_setup();
+        let blocks_dir = data_dir.clone() + "/blocks";
+        let block_stats = Arc::new(Mutex::new(Vec::new()));
+        let block_stats_clone = block_stats.clone();
+        let context = ContextBuilder::new()
+            .chain_type(ChainType::Regtest)
+            .with_block_connected_stats_notification(
+                move |_hash: BlockHash, stats: ValidationStats| {
+                    block_stats_clone.lock().unwrap().push(stats);
+                },
+            )
+            .build()
+            .unwrap();
+        let chainman = ChainstateManager::new(
+            ChainstateManagerOptions::new(&context, &data_dir, &blocks_dir).unwrap(),
+        )
+        .unwrap();
+        let block_data = read_block_data();
+        for raw_block in block_data.iter() {
+            let block = Block::try_from(raw_block.as_slice()).unwrap();
+            assert!(chainman.process_block(&block).is_new_block());
+        }
+
+        // The genesis block is connected when the chainstate manager is created.
+        let block_stats = block_stats.lock().unwrap();
+        assert_eq!(block_stats.len(), block_data.len() + 1);
+        for stats in block_stats.iter() {
+            assert_eq!(stats.block_count(), 1);
+            assert!(
+                stats.time(ValidationPhase::Total) >= stats.time(ValidationPhase::ConnectBlock)
+            );
+        }
+
+        let totals = chainman.validation_stats();
+        assert_eq!(totals.block_count(), block_stats.len() as i64);
+        assert_eq!(
+            totals.transaction_count(),
+            block_stats
+                .iter()
+                .map(|stats| stats.transaction_count())
+                .sum()
+        );
+        assert_eq!(
+            totals.input_count(),
+            block_stats.iter().map(|stats| stats.input_count()).sum()
+        );
+        assert_eq!(
+            totals.sigops_cost(),
+            block_stats.iter().map(|stats| stats.sigops_cost()).sum()
+        );
+        assert!(totals.clone().sigops_cost() > 0);
+    }
+
+    #[test]
+    fn test_prune() {
+        let (context, data_dir) = testing_setup();
+        let blocks_dir = data_dir.clone() + "/blocks";
+        let options = ChainstateManagerOptions::new(&context, &data_dir, &blocks_dir).unwrap();
+        let err = options.prune_target(1).unwrap_err();
+        assert!(matches!(err, KernelError::InvalidOptions(_)));
+
+        let chainman = ChainstateManager::new(
+            ChainstateManagerOptions::new(&context, &data_dir, &blocks_dir)
+                .unwrap()
+                .prune_target(u64::MAX)
+                .unwrap(),
+        )
+        .unwrap();
+        for raw_block in read_block_data() {
+            let block = Block::new(raw_block.as_slice()).unwrap();
+            assert!(chainman.process_block(&block).is_new_block());
+        }
+
+        chainman.set_prune_lock("index", 100).unwrap();
+        chainman.set_prune_lock("index", 150).unwrap();
+        assert!(chainman.set_prune_lock("index", -1).is_err());
+        assert!(chainman.delete_prune_lock("index").unwrap());
+        assert!(!chainman.delete_prune_lock("index").unwrap());
+
+        // The regtest chain is shorter than its prune-after height.
+        assert!(chainman.prune_to_height(100).is_err());
+    }
+
+    /// Mine a regtest block on top of `prev` that only has a coinbase
+    /// transaction.
+    fn mine_block(prev: &Block, height: i32) -> Block {
+        let mut coinbase = vec![];
+        coinbase.extend_from_slice(&1u32.to_le_bytes());
+        coinbase.push(1);
+        coinbase.extend_from_slice(&[0; 32]);
+        coinbase.extend_from_slice(&u32::MAX.to_le_bytes());
+        // The BIP34 height push, for heights from 128 to 32767.
+        coinbase.extend_from_slice(&[3, 2, height as u8, (height >> 8) as u8]);
+        coinbase.extend_from_slice(&u32::MAX.to_le_bytes());
+        coinbase.push(1);
+        coinbase.extend_from_slice(&0u64.to_le_bytes());
+        coinbase.extend_from_slice(&[1, 0x51]); // OP_TRUE
+        coinbase.extend_from_slice(&0u32.to_le_bytes());
+
+        let prev_bytes = prev.consensus_encode().unwrap();
+        let prev_time = u32::from_le_bytes(prev_bytes[68..72].try_into().unwrap());
+
+        let mut block = vec![];
+        block.extend_from_slice(&0x20000000u32.to_le_bytes());
+        block.extend_from_slice(&prev.hash().to_bytes());
+        block.extend_from_slice(&Transaction::new(&coinbase).unwrap().txid().to_bytes());
+        block.extend_from_slice(&(prev_time + 1).to_le_bytes());
+        block.extend_from_slice(&0x207fffffu32.to_le_bytes());
+        block.extend_from_slice(&0u32.to_le_bytes());
+        block.push(1);
+        block.extend_from_slice(&coinbase);
+
+        for nonce in 0u32.. {
+            block[76..80].copy_from_slice(&nonce.to_le_bytes());
+            let candidate = Block::new(&block).unwrap();
+            // Enough work for the regtest target of 0x7fffff << 232.
+            if candidate.hash().to_bytes()[31] < 0x7f {
+                return candidate;
+            }
+        }
+        unreachable!()
+    }
+
+    #[test]
+    fn test_prune_reload() {
+        let (context, data_dir) = testing_setup();
+        let blocks_dir = data_dir.clone() + "/blocks";
+        let options = || {
+            ChainstateManagerOptions::new(&context, &data_dir, &blocks_dir)
+                .unwrap()
+                .prune_target(u64::MAX)
+                .unwrap()
+                // Spread the chain over several block files, so that some can
+                // be pruned.
+                .fast_prune(true)
+        };
+
+        // Regtest blocks are only pruned once the chain reaches height 1000.
+        let tip_height = 1000;
+        {
+            let chainman = ChainstateManager::new(options()).unwrap();
+            let mut tip = None;
+            for raw_block in read_block_data() {
+                let block = Block::new(raw_block.as_slice()).unwrap();
+                assert!(chainman.process_block(&block).is_new_block());
+                tip = Some(block);
+            }
+            let mut tip = tip.unwrap();
+            for height in chainman.active_chain().height() + 1..=tip_height {
+                tip = mine_block(&tip, height);
+                assert!(chainman.process_block(&tip).is_new_block());
+            }
+            assert_eq!(chainman.active_chain().height(), tip_height);
+
+            chainman.prune_to_height(tip_height).unwrap();
+            let chain = chainman.active_chain();
+            assert!(chainman
+                .read_block_data(&chain.at_height(1).unwrap())
+                .is_err());
+            assert!(chainman
+                .read_block_data(&chain.at_height(tip_height as usize).unwrap())
+                .is_ok());
+        }
+
+        // The pruned block tree is loaded again in prune mode.
+        let chainman = ChainstateManager::new(options()).unwrap();
+        assert_eq!(chainman.active_chain().height(), tip_height);
+        let chain = chainman.active_chain();
+        assert!(chainman
+            .read_block_data(&chain.at_height(1).unwrap())
+            .is_err());
+    }
+
+    #[test]
+    fn test_background_coins_flush() {
+        let (context, data_dir) = testing_setup();
+        let blocks_dir = data_dir.clone() + "/blocks";
+        let (_, reference_dir) = testing_setup();
+        let reference_hash = setup_chainman_with_blocks(&context, &reference_dir)
+            .compute_utxo_stats(UtxoSetHashType::MuHash, 0)
+            .unwrap()
+            .hash();
+
+        {
+            // A tiny coins cache is flushed after every block, so the coins
+            // are read while the previous flush is being written.
+            let chainman = ChainstateManager::new(
+                ChainstateManagerOptions::new(&context, &data_dir, &blocks_dir)
+                    .unwrap()
+                    .cache_sizes(1 << 20, 1 << 20, 1)
+                    .unwrap()
+                    .background_coins_flush(true),
+            )
+            .unwrap();
+            for raw_block in read_block_data() {
+                let block = Block::new(raw_block.as_slice()).unwrap();
+                assert!(chainman.process_block(&block).is_new_block());
+                let coinbase = block.transaction(0).unwrap();
+                let outpoint = TxOutPoint::new(&coinbase.txid(), 0).unwrap();
+                assert!(chainman.get_coins(&[outpoint]).unwrap()[0].is_some());
+            }
+            let stats = chainman
+                .compute_utxo_stats(UtxoSetHashType::MuHash, 0)
+                .unwrap();
+            assert_eq!(stats.hash(), reference_hash);
+        }
+
+        // The coins written in the background are on disk after a restart.
+        let chainman = ChainstateManager::new(
+            ChainstateManagerOptions::new(&context, &data_dir, &blocks_dir).unwrap(),
+        )
+        .unwrap();
+        assert_eq!(
+            chainman.active_chain().height(),
+            read_block_data().len() as i32
+        );
+        let stats = chainman
+            .compute_utxo_stats(UtxoSetHashType::MuHash, 0)
+            .unwrap();
+        assert_eq!(stats.hash(), reference_hash);
+    }
+
+    #[test]
+    fn test_compact_coins_cache() {
+        let (context, data_dir) = testing_setup();
+        let blocks_dir = data_dir.clone() + "/blocks";
+        let (_, reference_dir) = testing_setup();
+
+        // All outputs created in the chain, spent and unspent.
+        let mut outpoints = Vec::new();
+        for raw_block in read_block_data() {
+            let block = Block::new(raw_block.as_slice()).unwrap();
+            for i in 0..block.transaction_count() {
+                let tx = block.transaction(i).unwrap();
+                for j in 0..tx.output_count() {
+                    outpoints.push(TxOutPoint::new(&tx.txid(), j as u32).unwrap());
+                }
+            }
+        }
+
+        let reference = setup_chainman_with_blocks(&context, &reference_dir);
+        let reference_coins = reference.get_coins(&outpoints).unwrap();
+        let reference_hash = reference
+            .compute_utxo_stats(UtxoSetHashType::MuHash, 0)
+            .unwrap()
+            .hash();
+
+        let check_coins = |chainman: &ChainstateManager| {
+            let coins = chainman.get_coins(&outpoints).unwrap();
+            assert_eq!(coins.len(), reference_coins.len());
+            for (coin, reference_coin) in coins.iter().zip(&reference_coins) {
+                assert_eq!(coin.is_some(), reference_coin.is_some());
+                if let (Some(coin), Some(reference_coin)) = (coin, reference_coin) {
+                    assert_eq!(
+                        coin.confirmation_height(),
+                        reference_coin.confirmation_height()
+                    );
+                    assert_eq!(coin.output().value(), reference_coin.output().value());
+                }
+            }
+        };
+        let new_chainman = || {
+            ChainstateManager::new(
+                ChainstateManagerOptions::new(&context, &data_dir, &blocks_dir)
+                    .unwrap()
+                    .cache_sizes(1 << 20, 1 << 20, 1 << 20)
+                    .unwrap()
+                    .compact_coins_cache(true),
+            )
+            .unwrap()
+        };
+
+        {
+            let chainman = new_chainman();
+            for raw_block in read_block_data() {
+                let block = Block::new(raw_block.as_slice()).unwrap();
+                assert!(chainman.process_block(&block).is_new_block());
+            }
+            check_coins(&chainman);
+        }
+
+        // After a restart, the coins are read from the database into the
+        // compact coins cache, and from there the second time.
+        let chainman = new_chainman();
+        check_coins(&chainman);
+        check_coins(&chainman);
+        let stats = chainman
+            .compute_utxo_stats(UtxoSetHashType::MuHash, 0)
+            .unwrap();
+        assert_eq!(stats.hash(), reference_hash);
+    }
+    #[test]
+    fn test_validation_cache_stats() {
+        let (context, data_dir) = testing_setup();
+        let blocks_dir = data_dir.clone() + "/blocks";
+        let chainman = ChainstateManager::new(
+            ChainstateManagerOptions::new(&context, &data_dir, &blocks_dir)
+                .unwrap()
+                .mempool(true)
+                .validation_cache_sizes(1 << 20, 1 << 20),
+        )
+        .unwrap();
+
+        // Scripts checked while connecting a block are looked up, but not
+        // added to the cache.
+        let block_data = read_block_data();
+        let (last_raw_block, raw_blocks) = block_data.split_last().unwrap();
+        for raw_block in raw_blocks {
+            let block = Block::new(raw_block.as_slice()).unwrap();
+            assert!(chainman.process_block(&block).is_new_block());
+        }
+        let stats = chainman.validation_cache_stats(ValidationCacheType::ScriptExecution);
+        assert_eq!(stats.hits(), 0);
+        assert!(stats.misses() > 0);
+        assert_eq!(stats.inserts(), 0);
+
+        // A transaction accepted to the mempool is found in the cache when
+        // its block is connected.
+        let last_block = Block::new(last_raw_block.as_slice()).unwrap();
+        let tx = last_block.transaction(1).unwrap().to_owned();
+        let mempool = chainman.mempool().unwrap();
+        assert!(mempool.accept_transactions(&[tx], false)[0].is_accepted());
+        assert!(chainman.process_block(&last_block).is_new_block());
+        let stats = chainman.validation_cache_stats(ValidationCacheType::ScriptExecution);
+        assert_eq!(stats.inserts(), 1);
+        assert_eq!(stats.hits(), 1);
+        assert_eq!(stats.evictions(), 0);
+
+        let stats = chainman.validation_cache_stats(ValidationCacheType::Signature);
+        assert!(stats.clone().misses() > 0);
+        assert_eq!(stats.evictions(), 0);
+    }
+
+    #[test]
+    fn test_snapshot() {
+        let (context, data_dir) = testing_setup();
+        let chainman = setup_chainman_with_blocks(&context, &data_dir);
+        let snapshot_path = data_dir.clone() + "/utxo.dat";
+
+        chainman.dump_snapshot(&snapshot_path).unwrap();
+        assert!(chainman.dump_snapshot(&snapshot_path).is_err());
+        let snapshot = std::fs::read(&snapshot_path).unwrap();
+        assert_eq!(&snapshot[..5], b"utxo\xff");
+
+        // Regtest has no assumeutxo data for the tip of the test chain.
+        assert!(chainman.load_snapshot(&snapshot_path).is_err());
+        assert!(chainman
+            .load_snapshot(&(data_dir.clone() + "/missing.dat"))
+            .is_err());
+    }
+
     #[test]
     fn test_process_data() {
         let (context, data_dir) = testing_setup();
@@ -285,6 +855,246 @@ mod tests {
         }
     }
 
+    #[test]
+    fn test_background_verification() {
+        let (context, data_dir) = testing_setup();
+        let blocks_dir = data_dir.clone() + "/blocks";
+        drop(setup_chainman_with_blocks(&context, &data_dir));
+
+        let (sender, receiver) = mpsc::sync_channel(1);
+        let context = ContextBuilder::new()
+            .chain_type(ChainType::Regtest)
+            .with_chainstate_verified_notification(
+                move |result: ChainstateVerificationResult, _message: String| {
+                    sender.send(result).unwrap();
+                },
+            )
+            .build()
+            .unwrap();
+        assert!(
+            ChainstateManagerOptions::new(&context, &data_dir, &blocks_dir)
+                .unwrap()
+                .check_level(5)
+                .is_err()
+        );
+        let chainman = ChainstateManager::new(
+            ChainstateManagerOptions::new(&context, &data_dir, &blocks_dir)
+                .unwrap()
+                .check_blocks(0)
+                .check_level(4)
+                .unwrap()
+                .require_full_verification(false)
+                .background_verification(true),
+        )
+        .unwrap();
+        assert_eq!(
+            receiver.recv().unwrap(),
+            ChainstateVerificationResult::Success
+        );
+        assert_eq!(
+            chainman.active_chain().height(),
+            read_block_data().len() as i32
+        );
+    }
+
+    #[test]
+    fn test_assumed_valid_block() {
+        let (_, data_dir) = testing_setup();
+        let blocks_dir = data_dir.clone() + "/blocks";
+        let script_checks = Arc::new(Mutex::new(Vec::new()));
+        let script_checks_clone = script_checks.clone();
+        let context = ContextBuilder::new()
+            .chain_type(ChainType::Regtest)
+            .with_script_checks_notification(move |_hash: BlockHash, enabled, reason| {
+                script_checks_clone.lock().unwrap().push((enabled, reason));
+            })
+            .build()
+            .unwrap();
+        let block_data = read_block_data();
+        let last_block = Block::new(block_data.last().unwrap()).unwrap();
+        let chainman = ChainstateManager::new(
+            ChainstateManagerOptions::new(&context, &data_dir, &blocks_dir)
+                .unwrap()
+                .assumed_valid_block(Some(&last_block.hash()))
+                .minimum_chain_work([0xff; 32]),
+        )
+        .unwrap();
+
+        let headers: Vec<u8> = block_data
+            .iter()
+            .flat_map(|raw_block| raw_block[..BLOCK_HEADER_SIZE].iter().copied())
+            .collect();
+        assert!(!chainman.process_headers(&headers).unwrap().is_rejected());
+        for raw_block in block_data.iter() {
+            let block = Block::new(raw_block.as_slice()).unwrap();
+            assert!(chainman.process_block(&block).is_new_block());
+        }
+
+        // The best header has less work than the minimum, so the scripts of
+        // all blocks are verified.
+        let script_checks = script_checks.lock().unwrap();
+        assert_eq!(script_checks.len(), 1);
+        assert!(script_checks[0].0);
+        assert_eq!(
+            script_checks[0].1,
+            "best header chainwork below minimumchainwork"
+        );
+    }
+
+    #[test]
+    fn test_process_headers() {
+        let (context, data_dir) = testing_setup();
+        let blocks_dir = data_dir.clone() + "/blocks";
+        let block_data = read_block_data();
+        let chainman = ChainstateManager::new(
+            ChainstateManagerOptions::new(&context, &data_dir, &blocks_dir).unwrap(),
+        )
+        .unwrap();
+
+        let mut headers: Vec<u8> = block_data
+            .iter()
+            .flat_map(|raw_block| raw_block[..BLOCK_HEADER_SIZE].iter().copied())
+            .collect();
+        assert!(matches!(
+            chainman.process_headers(&headers[1..]),
+            Err(KernelError::InvalidLength { .. })
+        ));
+
+        let result = chainman.process_headers(&headers).unwrap();
+        assert!(!result.is_rejected());
+        let entry = result.last_accepted.unwrap();
+        assert_eq!(entry.height(), block_data.len() as i32);
+        let last_block = Block::new(block_data.last().unwrap()).unwrap();
+        assert_eq!(entry.block_hash().to_bytes(), last_block.hash().to_bytes());
+        assert_eq!(chainman.active_chain().height(), 0);
+
+        headers[10 * BLOCK_HEADER_SIZE + 4] ^= 1;
+        let result = chainman.process_headers(&headers).unwrap();
+        assert_eq!(result.result, BlockValidationResult::MissingPrev);
+        assert_eq!(result.last_accepted.unwrap().height(), 10);
+    }
+
+    #[test]
+    fn test_block_index_snapshot() {
+        let (context, data_dir) = testing_setup();
+        let blocks_dir = data_dir.clone() + "/blocks";
+        let block_data = read_block_data();
+        let create_chainman = || {
+            ChainstateManager::new(
+                ChainstateManagerOptions::new(&context, &data_dir, &blocks_dir)
+                    .unwrap()
+                    .block_index_snapshot(true),
+            )
+            .unwrap()
+        };
+
+        {
+            let chainman = create_chainman();
+            for raw_block in block_data.iter() {
+                let block = Block::new(raw_block.as_slice()).unwrap();
+                assert!(chainman.process_block(&block).is_new_block());
+            }
+        }
+        assert!(std::path::Path::new(&(blocks_dir.clone() + "/index.snapshot")).exists());
+
+        let chainman = create_chainman();
+        assert_eq!(chainman.active_chain().height(), block_data.len() as i32);
+    }
+
+    #[test]
+    fn test_async_validation_queue() {
+        let (_, data_dir) = testing_setup();
+        let connected = Arc::new(AtomicUsize::new(0));
+        let connected_clone = Arc::clone(&connected);
+        let context = Arc::new(
+            ContextBuilder::new()
+                .chain_type(ChainType::Regtest)
+                .with_block_connected(move |_block: Block, _entry: BlockTreeEntry| {
+                    connected_clone.fetch_add(1, Ordering::SeqCst);
+                })
+                .validation_queue_depth(4)
+                .build()
+                .unwrap(),
+        );
+
+        let _chainman = setup_chainman_with_blocks(&context, &data_dir);
+        context.sync_validation_queue();
+        // The genesis block is connected when the chainstate manager is created.
+        assert_eq!(
+            connected.load(Ordering::SeqCst),
+            read_block_data().len() + 1
+        );
+    }
+
+    #[test]
+    fn test_mempool() {
+        let (_, data_dir) = testing_setup();
+        let blocks_dir = data_dir.clone() + "/blocks";
+        let block_data = read_block_data();
+        let added = Arc::new(AtomicUsize::new(0));
+        let added_clone = Arc::clone(&added);
+        let removed_for_block = Arc::new(AtomicUsize::new(0));
+        let removed_for_block_clone = Arc::clone(&removed_for_block);
+        let context = Arc::new(
+            ContextBuilder::new()
+                .chain_type(ChainType::Regtest)
+                .with_transaction_added_to_mempool(move |_tx: Transaction| {
+                    added_clone.fetch_add(1, Ordering::SeqCst);
+                })
+                .with_transaction_removed_from_mempool(
+                    move |_tx: Transaction, reason: MempoolRemovalReason| {
+                        if reason == MempoolRemovalReason::Block {
+                            removed_for_block_clone.fetch_add(1, Ordering::SeqCst);
+                        }
+                    },
+                )
+                .build()
+                .unwrap(),
+        );
+        let chainman = ChainstateManager::new(
+            ChainstateManagerOptions::new(&context, &data_dir, &blocks_dir)
+                .unwrap()
+                .mempool(true),
+        )
+        .unwrap();
+        let mempool = chainman.mempool().unwrap();
+
+        // Connect all blocks but the last one, whose transaction is then
+        // submitted to the mempool.
+        let (last_raw_block, raw_blocks) = block_data.split_last().unwrap();
+        for raw_block in raw_blocks {
+            let block = Block::new(raw_block.as_slice()).unwrap();
+            assert!(chainman.process_block(&block).is_new_block());
+        }
+        let last_block = Block::new(last_raw_block.as_slice()).unwrap();
+        let tx = last_block.transaction(1).unwrap().to_owned();
+        let confirmed_block = Block::new(raw_blocks.last().unwrap().as_slice()).unwrap();
+        let confirmed_tx = confirmed_block.transaction(1).unwrap().to_owned();
+
+        let results = mempool.accept_transactions(&[confirmed_tx.clone()], false);
+        assert_eq!(results[0].status, MempoolAcceptStatus::Rejected);
+        assert_ne!(results[0].result, TxValidationResult::Unset);
+
+        let results = mempool.accept_package(&[tx.clone()], true);
+        assert_eq!(results[0].status, MempoolAcceptStatus::Accepted);
+        assert_eq!(mempool.size(), 0);
+
+        let results = mempool.accept_transactions(&[tx.clone()], false);
+        assert!(results[0].is_accepted());
+        assert_eq!(results[0].result, TxValidationResult::Unset);
+        assert_eq!(mempool.size(), 1);
+        assert!(mempool.contains(&tx.txid()));
+        assert!(!mempool.contains(&confirmed_tx.txid()));
+
+        let results = mempool.accept_package(&[tx.clone()], false);
+        assert_eq!(results[0].status, MempoolAcceptStatus::AlreadyInMempool);
+
+        assert!(chainman.process_block(&last_block).is_new_block());
+        assert_eq!(mempool.size(), 0);
+        assert_eq!(added.load(Ordering::SeqCst), 1);
+        assert_eq!(removed_for_block.load(Ordering::SeqCst), 1);
+    }
+
     #[test]
     fn test_validate_any() {
         let (context, data_dir) = testing_setup();
@@ -450,6 +1260,77 @@ mod tests {
         ));
     }
 
+    #[test]
+    fn test_verify_all_inputs() {
+        let legacy_script_pubkey = ScriptPubkey::try_from(
+            hex::decode("76a9144bfbaf6afb76cc5771bc6404810d1cc041a6933988ac")
+                .unwrap()
+                .as_slice(),
+        )
+        .unwrap();
+        let legacy_tx = Transaction::new(hex::decode("02000000013f7cebd65c27431a90bba7f796914fe8cc2ddfc3f2cbd6f7e5f2fc854534da95000000006b483045022100de1ac3bcdfb0332207c4a91f3832bd2c2915840165f876ab47c5f8996b971c3602201c6c053d750fadde599e6f5c4e1963df0f01fc0d97815e8157e3d59fe09ca30d012103699b464d1d8bc9e47d4fb1cdaa89a1c5783d68363c4dbc4b524ed3d857148617feffffff02836d3c01000000001976a914fc25d6d5c94003bf5b0c7b640a248e2c637fcfb088ac7ada8202000000001976a914fbed3d9b11183209a57999d54d59f67c019e756c88ac6acb0700").unwrap().as_slice()).unwrap();
+        let p2sh_script_pubkey = ScriptPubkey::try_from(
+            hex::decode("a91434c06f8c87e355e123bdc6dda4ffabc64b6989ef87")
+                .unwrap()
+                .as_slice(),
+        )
+        .unwrap();
+        let p2sh_tx = Transaction::new(hex::decode("01000000000101d9fd94d0ff0026d307c994d0003180a5f248146efb6371d040c5973f5f66d9df0400000017160014b31b31a6cb654cfab3c50567bcf124f48a0beaecffffffff012cbd1c000000000017a914233b74bf0823fa58bbbd26dfc3bb4ae715547167870247304402206f60569cac136c114a58aedd80f6fa1c51b49093e7af883e605c212bdafcd8d202200e91a55f408a021ad2631bc29a67bd6915b2d7e9ef0265627eabd7f7234455f6012103e7e802f50344303c76d12c089c8724c1b230e3b745693bbe16aad536293d15e300000000").unwrap().as_slice()).unwrap();
+
+        for worker_threads in [0, 2] {
+            let results = verify_all_inputs(
+                &p2sh_tx,
+                Some(VERIFY_ALL_PRE_TAPROOT),
+                &[TxOut::new(&p2sh_script_pubkey, 1900000)],
+                worker_threads,
+            )
+            .unwrap();
+            assert_eq!(results.len(), 1);
+            assert!(results[0].is_ok());
+        }
+
+        // The second transaction spends an output with the wrong amount
+        let results = verify_transactions(
+            &[legacy_tx.clone(), p2sh_tx.clone()],
+            Some(VERIFY_ALL_PRE_TAPROOT),
+            &[
+                TxOut::new(&legacy_script_pubkey, 0),
+                TxOut::new(&p2sh_script_pubkey, 900000),
+            ],
+            2,
+        )
+        .unwrap();
+        assert_eq!(results.len(), 2);
+        assert!(results[0].is_ok());
+        assert!(matches!(results[1], Err(ScriptVerifyError::Invalid)));
+
+        let result = verify_transactions(
+            &[legacy_tx, p2sh_tx.clone()],
+            Some(VERIFY_ALL_PRE_TAPROOT),
+            &[TxOut::new(&legacy_script_pubkey, 0)],
+            2,
+        );
+        assert!(matches!(
+            result,
+            Err(KernelError::ScriptVerify(
+                ScriptVerifyError::SpentOutputsMismatch
+            ))
+        ));
+
+        let result = verify_all_inputs(
+            &p2sh_tx,
+            Some(VERIFY_WITNESS),
+            &[TxOut::new(&p2sh_script_pubkey, 1900000)],
+            0,
+        );
+        assert!(matches!(
+            result,
+            Err(KernelError::ScriptVerify(
+                ScriptVerifyError::InvalidFlagsCombination
+            ))
+        ));
+    }
+
     #[test]
     fn test_chain_operations() {
         let (context, data_dir) = testing_setup();